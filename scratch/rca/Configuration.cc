@@ -35,6 +35,13 @@ Configuration::Configuration(int argc, char *argv[]) {
     cmd.AddValue("blockOffset", "The 1st page slice starts with the block with blockOffset", blockOffset);
     cmd.AddValue("timOffset", "Offset in number of Beacon Intervals from the DTIM that carries the first page slice of the page", timOffset);
     cmd.AddValue("Outputpath", "files path of each stations", OutputPath);
+    cmd.AddValue("SixLowPan", "Send the udp traffic over IPv6 with 6LoWPAN header compression (true/false)", sixLowPan);
+    cmd.AddValue("SixLowPanMaxFrameSize", "Largest 6LoWPAN frame, bigger packets are fragmented. 0 to use the MTU of the S1G device", sixLowPanMaxFrameSize);
+    cmd.AddValue("NRelay", "Number of relays. The stations are spread over them, twice as far from the AP as the relays. 0 for all the stations next to each other", NRelay);
+    cmd.AddValue("RelayDistance", "Distance between the AP and the relays in m", relayDistance);
+    cmd.AddValue("RelaySlotDurationCount", "Slot duration count of the RAW group added for the relays, with one slot per relay", relaySlotDurationCount);
+    cmd.AddValue("UseRelays", "Whether the stations associate with the relays (true) or directly with the AP from the same positions (false)", useRelays);
+    cmd.AddValue("StatisticsDatabase", "Path, without the .db extension, of the SQLite file receiving the node statistics every sampling interval, leave empty to omit", StatisticsDatabase);
 
 /*
     cmd.AddValue("SlotFormat", "format of NRawSlotCount, -1 will auto calculate based on raw slot num", SlotFormat);
@@ -75,6 +75,7 @@ struct Configuration {
 	string name = "test"; // empty string if no visualization TODO
 	string APPcapFile = "appcap"; // empty string if no visualization TODO
 	string NSSFile = "test.nss";
+	string StatisticsDatabase = "";
 
 	/*
 	 * Le's config params
@@ -91,6 +92,12 @@ struct Configuration {
 	 * Amina's configuration parameters
 	 * */
 	bool useV6 = false; //false
+	bool sixLowPan = false;
+	uint16_t sixLowPanMaxFrameSize = 0;
+	uint32_t NRelay = 0;
+	double relayDistance = 400;
+	uint32_t relaySlotDurationCount = 40;
+	bool useRelays = true;
 	uint32_t nControlLoops = 0;//  = 100;
 	uint32_t coapPayloadSize = 0;//  = 15;
 
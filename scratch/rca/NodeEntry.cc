@@ -42,11 +42,11 @@ void NodeEntry::UnsetAssociation(std::string context, Mac48Address address) {
 
 
 void NodeEntry::OnNrOfTransmissionsDuringRAWSlotChanged(std::string context, uint16_t oldValue, uint16_t newValue) {
-	stats->get(this->id).NumberOfTransmissionsDuringRAWSlot = newValue;
+	stats->NumberOfTransmissionsDuringRAWSlot[this->id] = newValue;
 }
 
 void NodeEntry::OnS1gBeaconMissed(std::string context, bool nextBeaconIsDTIM) {
-	stats->get(this->id).NumberOfBeaconsMissed++;
+	stats->NumberOfBeaconsMissed[this->id]++;
 }
 
 void NodeEntry::OnPhyTxBegin(std::string context, Ptr<const Packet> packet) {
@@ -63,7 +63,7 @@ void NodeEntry::OnPhyTxBegin(std::string context, Ptr<const Packet> packet) {
 	 cout << "[" << this->id << "] " << Simulator::Now().GetMicroSeconds() << "µs" << " Tx started after " << timeDiff.GetMicroSeconds() << "µs since last s1g beacon" << endl;
 	 }*/
 
-	stats->get(this->id).NumberOfTransmissions++;
+	stats->NumberOfTransmissions[this->id]++;
 }
 
 void NodeEntry::OnPhyTxEnd(std::string context, Ptr<const Packet> packet) {
@@ -73,7 +73,7 @@ void NodeEntry::OnPhyTxEnd(std::string context, Ptr<const Packet> packet) {
 	if (txMap.find(packet->GetUid()) != txMap.end()) {
 		Time oldTime = txMap[packet->GetUid()];
 		txMap.erase(packet->GetUid());
-		stats->get(this->id).TotalTransmitTime += (Simulator::Now() - oldTime);
+		stats->TotalTransmitTime[this->id] += (Simulator::Now() - oldTime);
 	} else
 		if(showLog) cout << "[" << this->id << "] " << Simulator::Now().GetMicroSeconds()
 		<< " End tx for packet " << packet->GetUid()
@@ -87,14 +87,14 @@ void NodeEntry::OnPhyTxDrop(std::string context, Ptr<const Packet> packet, DropR
 	if (txMap.find(packet->GetUid()) != txMap.end()) {
 		Time oldTime = txMap[packet->GetUid()];
 		txMap.erase(packet->GetUid());
-		stats->get(this->id).TotalTransmitTime += (Simulator::Now() - oldTime);
+		stats->TotalTransmitTime[this->id] += (Simulator::Now() - oldTime);
 	} else
 		if(showLog) cout << "[" << this->id << "] " << Simulator::Now().GetMicroSeconds()
 		<< " End tx for packet " << packet->GetUid()
 		<< " without a begin tx" << endl;
-	stats->get(this->id).NumberOfTransmissionsDropped++;
+	stats->NumberOfTransmissionsDropped[this->id]++;
 
-	stats->get(this->id).NumberOfDropsByReason[reason]++;
+	stats->NumberOfDropsByReason[this->id][reason]++;
 
 
 }
@@ -119,12 +119,12 @@ void NodeEntry::OnEndOfReceive(Ptr<const Packet> packet) {
 	WifiMacHeader hdr;
 	packet->PeekHeader(hdr);
 
-	stats->get(this->id).NumberOfReceives++;
+	stats->NumberOfReceives[this->id]++;
 	if (rxMap.find(packet->GetUid()) != rxMap.end()) {
 		Time oldTime = rxMap[packet->GetUid()];
 		rxMap.erase(packet->GetUid());
 
-		stats->get(this->id).TotalReceiveTime += (Simulator::Now() - oldTime);
+		stats->TotalReceiveTime[this->id] += (Simulator::Now() - oldTime);
 
 		if (hdr.IsS1gBeacon()) {
 			lastBeaconReceivedOn = Simulator::Now();
@@ -210,8 +210,8 @@ void NodeEntry::OnPhyRxDrop(std::string context, Ptr<const Packet> packet,
 
 			if (hdr->GetAddr1() == node->GetDevice(0)->GetAddress()) {
 
-				stats->get(this->id).NumberOfReceiveDroppedByDestination++;
-				stats->get(this->id).NumberOfDropsByReason[reason]++;
+				stats->NumberOfReceiveDroppedByDestination[this->id]++;
+				stats->NumberOfDropsByReason[this->id][reason]++;
 
 				//packet->Copy()->Print(cout);
 				//	cout  << Simulator::Now().GetMicroSeconds() << "[" << this->aId << "] "
@@ -224,21 +224,21 @@ void NodeEntry::OnPhyRxDrop(std::string context, Ptr<const Packet> packet,
 			delete chunk;
 	}
 
-	stats->get(this->id).NumberOfReceivesDropped++;
+	stats->NumberOfReceivesDropped[this->id]++;
 }
 
 void NodeEntry::OnPhyStateChange(std::string context, const Time start,	const Time duration, const WifiPhy::State state) {
 	/*switch (state) {
 
 	case WifiPhy::State::SLEEP:
-		stats->get(this->id).TotalDozeTime += duration;
+		stats->TotalDozeTime[this->id] += duration;
 		break;
 
 	case WifiPhy::State::IDLE:
 	case WifiPhy::State::TX:
 	case WifiPhy::State::RX:
 	case WifiPhy::State::SWITCHING:
-		stats->get(this->id).TotalActiveTime += duration;
+		stats->TotalActiveTime[this->id] += duration;
 		break;
 
 	case WifiPhy::State::CCA_BUSY:
@@ -251,21 +251,21 @@ void NodeEntry::OnPhyStateChange(std::string context, const Time start,	const Ti
 		switch (state)
 		{
 		case WifiPhy::State::IDLE: //Idle
-		stats->get(this->id).TotalIdleTime += duration;
+		stats->TotalIdleTime[this->id] += duration;
 		break;
 		case WifiPhy::State::RX: //Rx
-			stats->get(this->id).TotalRxTime += duration;
+			stats->TotalRxTime[this->id] += duration;
 			break;
 		case WifiPhy::State::TX: //Tx
-			stats->get(this->id).TotalTxTime += duration;
+			stats->TotalTxTime[this->id] += duration;
 			break;
 		case WifiPhy::State::SLEEP: //Sleep
-			stats->get(this->id).TotalSleepTime += duration;
+			stats->TotalSleepTime[this->id] += duration;
 			break;
 		}
 	}
-	stats->get(this->id).EnergyRxIdle = (stats->get(this->id).TotalRxTime.GetSeconds() + stats->get(this->id).TotalIdleTime.GetSeconds()) * 4.4;
-	stats->get(this->id).EnergyTx = stats->get(this->id).TotalTxTime.GetSeconds() * 7.2;
+	stats->EnergyRxIdle[this->id] = (stats->TotalRxTime[this->id].GetSeconds() + stats->TotalIdleTime[this->id].GetSeconds()) * 4.4;
+	stats->EnergyTx[this->id] = stats->TotalTxTime[this->id].GetSeconds() * 7.2;
 
 	/*cout << "[" << this->id << "] " << Simulator::Now().GetMicroSeconds() << "State change, new state is ";
 
@@ -357,7 +357,7 @@ void NodeEntry::OnTcpPacketSent(Ptr<const Packet> packet) {
 		}
 	}
 	 */
-	stats->get(this->id).NumberOfSentPackets++;
+	stats->NumberOfSentPackets[this->id]++;
 
 
 }
@@ -366,11 +366,11 @@ void NodeEntry::OnTcpEchoPacketReceived(Ptr<const Packet> packet, Address from)
 	SeqTsHeader seqTs = GetSeqTSFromPacket(packet);
 	if(seqTs.GetSeq() > 0) {
 		auto timeDiff = (Simulator::Now() - seqTs.GetTs());
-		stats->get(this->id).TotalPacketRoundtripTime += timeDiff;
-		stats->get(this->id).NumberOfSuccessfulRoundtripPacketsWithSeqHeader++;
+		stats->TotalPacketRoundtripTime[this->id] += timeDiff;
+		stats->NumberOfSuccessfulRoundtripPacketsWithSeqHeader[this->id]++;
 	}
 
-	stats->get(this->id).NumberOfSuccessfulRoundtripPackets++;
+	stats->NumberOfSuccessfulRoundtripPackets[this->id]++;
 	this->UpdateJitter(Simulator::Now() - this->timeSent);
 
 	/*
@@ -396,8 +396,8 @@ void NodeEntry::OnTcpEchoPacketReceived(Ptr<const Packet> packet, Address from)
 		 << InetSocketAddress::ConvertFrom(from).GetIpv4() << ") after "
 		 << std::to_string(timeDiff.GetMicroSeconds()) << "µs" << endl;
 
-		stats->get(this->id).NumberOfSuccessfulRoundtripPackets++;
-		stats->get(this->id).TotalPacketRoundtripTime += timeDiff;
+		stats->NumberOfSuccessfulRoundtripPackets[this->id]++;
+		stats->TotalPacketRoundtripTime[this->id] += timeDiff;
 
 	} catch (std::runtime_error e) {
 
@@ -418,53 +418,53 @@ void NodeEntry::OnTcpPacketReceivedAtAP(Ptr<const Packet> packet) {
 	SeqTsHeader seqTs = GetSeqTSFromPacket(packet);
 	if(seqTs.GetSeq() > 0) {
 		auto timeDiff = (Simulator::Now() - seqTs.GetTs());
-		stats->get(this->id).TotalPacketSentReceiveTime += timeDiff;
-		stats->get(this->id).NumberOfSuccessfulPacketsWithSeqHeader++;
-		stats->get(this->id).TotalPacketPayloadSize += packet->GetSize();
+		stats->TotalPacketSentReceiveTime[this->id] += timeDiff;
+		stats->NumberOfSuccessfulPacketsWithSeqHeader[this->id]++;
+		stats->TotalPacketPayloadSize[this->id] += packet->GetSize();
 	}
 
-	stats->get(this->id).NumberOfSuccessfulPackets++;
+	stats->NumberOfSuccessfulPackets[this->id]++;
 }
 
 void NodeEntry::OnTcpCongestionWindowChanged(uint32_t oldval, uint32_t newval) {
-	stats->get(this->id).TCPCongestionWindow = newval;
+	stats->TCPCongestionWindow[this->id] = newval;
 }
 
 void NodeEntry::OnTcpRTOChanged(Time oldval, Time newval) {
-	stats->get(this->id).TCPRTOValue = newval;
+	stats->TCPRTOValue[this->id] = newval;
 }
 
 void NodeEntry::OnTcpRTTChanged(Time oldval, Time newval) {
-	stats->get(this->id).TCPRTTValue = newval;
+	stats->TCPRTTValue[this->id] = newval;
 }
 
 void NodeEntry::OnTcpStateChanged(TcpSocket::TcpStates_t oldval, TcpSocket::TcpStates_t newval) {
 	tcpConnectedAtSTA = (newval == TcpSocket::TcpStates_t::ESTABLISHED);
-	stats->get(this->id).TCPConnected = tcpConnectedAtSTA && tcpConnectedAtAP;
+	stats->TCPConnected[this->id] = tcpConnectedAtSTA && tcpConnectedAtAP;
 }
 
 void NodeEntry::OnTcpStateChangedAtAP(TcpSocket::TcpStates_t oldval, TcpSocket::TcpStates_t newval) {
 	tcpConnectedAtAP = (newval	== TcpSocket::TcpStates_t::ESTABLISHED);
 	if(showLog) cout << "TCP connected at ap " << tcpConnectedAtAP;
 
-	stats->get(this->id).TCPConnected = tcpConnectedAtSTA && tcpConnectedAtAP;
+	stats->TCPConnected[this->id] = tcpConnectedAtSTA && tcpConnectedAtAP;
 }
 
 void NodeEntry::OnTcpRetransmission(Address to) {
-	stats->get(this->id).NumberOfTCPRetransmissions++;
+	stats->NumberOfTCPRetransmissions[this->id]++;
 }
 
 void NodeEntry::OnTcpRetransmissionAtAP() {
 	//cout << "[" << this->id << "] " << Simulator::Now().GetMicroSeconds() << " RETRANSMISSION SCHEDULED FROM AP " << std::endl;
-	stats->get(this->id).NumberOfTCPRetransmissionsFromAP++;
+	stats->NumberOfTCPRetransmissionsFromAP[this->id]++;
 }
 
 void NodeEntry::OnTcpSlowStartThresholdChanged(uint32_t oldVal, uint32_t newVal) {
-	stats->get(this->id).TCPSlowStartThreshold = newVal;
+	stats->TCPSlowStartThreshold[this->id] = newVal;
 }
 
 void NodeEntry::OnTcpEstimatedBWChanged(double oldVal, double newVal) {
-	stats->get(this->id).TCPEstimatedBandwidth = newVal;
+	stats->TCPEstimatedBandwidth[this->id] = newVal;
 }
 
 void NodeEntry::OnUdpPacketSent(Ptr<const Packet> packet) { //works
@@ -476,7 +476,7 @@ void NodeEntry::OnUdpPacketSent(Ptr<const Packet> packet) { //works
 	auto timeDiff = (Simulator::Now() - seqTs.GetTs());
 	if (this->id == 90)
 		cout << "++++++++++++++++++++++++++++++++++++++++++++++ TX at " << Simulator::Now() << "seq " << seqTs.GetSeq() << endl;
-	stats->get(this->id).NumberOfSentPackets++;
+	stats->NumberOfSentPackets[this->id]++;
 
 	/*		cout << "[" << this->id << "] "  << Simulator::Now().GetMicroSeconds() <<
 	 " Packet sent" << endl;
@@ -498,9 +498,9 @@ void NodeEntry::OnUdpEchoPacketReceived(Ptr<const Packet> packet, Address from)
 		pCopy->RemoveHeader(seqTs);
 		auto timeDiff = (Simulator::Now() - seqTs.GetTs());
 		if (seqTs.GetSeq() > 0)
-			stats->get(this->id).NumberOfSuccessfulRoundtripPacketsWithSeqHeader++;
-		stats->get(this->id).NumberOfSuccessfulRoundtripPackets++;
-		stats->get(this->id).TotalPacketRoundtripTime += timeDiff;
+			stats->NumberOfSuccessfulRoundtripPacketsWithSeqHeader[this->id]++;
+		stats->NumberOfSuccessfulRoundtripPackets[this->id]++;
+		stats->TotalPacketRoundtripTime[this->id] += timeDiff;
 		// RT jitter calculation [server to client direction]
 		this->UpdateJitter(Simulator::Now() - this->timeSent);
 
@@ -510,14 +510,14 @@ void NodeEntry::OnUdpEchoPacketReceived(Ptr<const Packet> packet, Address from)
 }
 
 void NodeEntry::OnCoapPacketSent(Ptr<const Packet> packet) {
-	stats->get(this->id).NumberOfSentPackets++;
+	stats->NumberOfSentPackets[this->id]++;
 }
 /* Jitter is calculated only for packet delivered in order
  * Dropped packets are ignored
  * */
 void NodeEntry::UpdateJitter (Time timeDiff)
 {
-	if (stats->get(this->id).NumberOfSuccessfulRoundtripPackets == 1)
+	if (stats->NumberOfSuccessfulRoundtripPackets[this->id] == 1)
 	{
 		delayFirst = timeDiff;
 	}
@@ -525,8 +525,8 @@ void NodeEntry::UpdateJitter (Time timeDiff)
 	{
 		delaySecond = timeDiff;
 		Time var = Abs(delayFirst - delaySecond);
-		stats->get (this->id).jitter = var;
-		stats->get (this->id).jitterAcc += pow (var.GetMilliSeconds (), 2);
+		stats->jitter[this->id] = var;
+		stats->jitterAcc[this->id] += pow (var.GetMilliSeconds (), 2);
 		if (NodeEntry::maxJitter < var)
 			NodeEntry::maxJitter = var;
 		if (NodeEntry::minJitter > var)
@@ -544,35 +544,35 @@ void NodeEntry::OnCoapPacketReceived(Ptr<const Packet> packet, Address from) {
 		auto timeDiff = (Simulator::Now() - seqTs.GetTs());
 		//cout << "=========================CLIENT SEQ " << seqTs.GetSeq() << endl;
 		//if (seqTs.GetSeq() >= 0) //allways true
-		stats->get(this->id).NumberOfSuccessfulRoundtripPacketsWithSeqHeader++;
+		stats->NumberOfSuccessfulRoundtripPacketsWithSeqHeader[this->id]++;
 
-		stats->get(this->id).NumberOfSuccessfulRoundtripPackets++;
-		stats->get(this->id).TotalPacketRoundtripTime += timeDiff; //time from S to C is accumulated here and later added to the time from C to S
+		stats->NumberOfSuccessfulRoundtripPackets[this->id]++;
+		stats->TotalPacketRoundtripTime[this->id] += timeDiff; //time from S to C is accumulated here and later added to the time from C to S
 		this->UpdateJitter(Simulator::Now() - this->timeSent);
 		uint32_t currentSequenceNumber = seqTs.GetSeq();
 		//cout << "============================================================================ Client " << this->id << " received seq" << currentSequenceNumber << endl;
 
 		Time newNow = Simulator::Now();
-		if (currentSequenceNumber == stats->get(this->id).m_prevPacketSeqClient + 1)
+		if (currentSequenceNumber == stats->m_prevPacketSeqClient[this->id] + 1)
 		{
-			stats->get(this->id).m_interPacketDelayClient.push_back(newNow - stats->get(this->id).m_prevPacketTimeClient);
-			stats->get(this->id).interPacketDelayAtClient = newNow - stats->get(this->id).m_prevPacketTimeClient;
-			//cout << "============================================================================ interPacketDelayAtClient " << this->id << " is" << newNow - stats->get(this->id).m_prevPacketTimeClient << endl;
+			stats->m_interPacketDelayClient[this->id].push_back(newNow - stats->m_prevPacketTimeClient[this->id]);
+			stats->interPacketDelayAtClient[this->id] = newNow - stats->m_prevPacketTimeClient[this->id];
+			//cout << "============================================================================ interPacketDelayAtClient " << this->id << " is" << newNow - stats->m_prevPacketTimeClient[this->id] << endl;
 
 		}
-		else if (currentSequenceNumber > stats->get(this->id).m_prevPacketSeqClient + 1)
+		else if (currentSequenceNumber > stats->m_prevPacketSeqClient[this->id] + 1)
 		{
 			NS_LOG_INFO ("Packet(s) with seq number(s) ");
-			for (uint32_t i = stats->get(this->id).m_prevPacketSeqClient + 1; i < currentSequenceNumber; i++)
+			for (uint32_t i = stats->m_prevPacketSeqClient[this->id] + 1; i < currentSequenceNumber; i++)
 				NS_LOG_INFO (std::to_string(i) << " ");
 			NS_LOG_INFO ("is(are) lost in path Server -> Client");
 
-			stats->get(this->id).m_interPacketDelayClient.push_back(newNow - stats->get(this->id).m_prevPacketTimeClient);
-			stats->get(this->id).interPacketDelayAtClient = newNow - stats->get(this->id).m_prevPacketTimeClient;
+			stats->m_interPacketDelayClient[this->id].push_back(newNow - stats->m_prevPacketTimeClient[this->id]);
+			stats->interPacketDelayAtClient[this->id] = newNow - stats->m_prevPacketTimeClient[this->id];
 
 		}
-		stats->get(this->id).m_prevPacketSeqClient = currentSequenceNumber;
-		stats->get(this->id).m_prevPacketTimeClient = newNow;
+		stats->m_prevPacketSeqClient[this->id] = currentSequenceNumber;
+		stats->m_prevPacketTimeClient[this->id] = newNow;
 
 	} catch (std::runtime_error e) {
 		// packet fragmentation, unable to get the header from fragements
@@ -592,11 +592,11 @@ void NodeEntry::OnUdpPacketReceivedAtAP(Ptr<const Packet> packet) {
 		//	<< std::to_string(timeDiff.GetMicroSeconds()) << "µs" << endl;
 		if (this->id == 90)
 			cout << "++++++++++++++++++++++++++++++++++++++++++++++ RX at " << Simulator::Now() << "seq " << seqTs.GetSeq() << endl;
-		stats->get(this->id).NumberOfSuccessfulPackets++;
-		stats->get(this->id).TotalPacketSentReceiveTime += timeDiff;
-		stats->get(this->id).latency = timeDiff;
+		stats->NumberOfSuccessfulPackets[this->id]++;
+		stats->TotalPacketSentReceiveTime[this->id] += timeDiff;
+		stats->latency[this->id] = timeDiff;
 		//cout << "id = " << this->id << " ; latency = " << timeDiff << " ; seq =  " << seqTs.GetSeq() << endl;
-		stats->get(this->id).TotalPacketPayloadSize += packet->GetSize();
+		stats->TotalPacketPayloadSize[this->id] += packet->GetSize();
 
 	} catch (std::runtime_error e) {
 		// packet fragmentation, unable to get header
@@ -619,41 +619,41 @@ void NodeEntry::OnCoapPacketReceivedAtServer(Ptr<const Packet> packet) {
 			NodeEntry::minLatency = timeDiff;
 
 		//if (seqTs.GetSeq() >= 0) allways true
-		stats->get(this->id).NumberOfSuccessfulPacketsWithSeqHeader++;
-		stats->get(this->id).NumberOfSuccessfulPackets++;
-		stats->get(this->id).TotalPacketSentReceiveTime += timeDiff;
+		stats->NumberOfSuccessfulPacketsWithSeqHeader[this->id]++;
+		stats->NumberOfSuccessfulPackets[this->id]++;
+		stats->TotalPacketSentReceiveTime[this->id] += timeDiff;
 
 		uint32_t currentSequenceNumber = seqTs.GetSeq();
 		if (currentSequenceNumber == 0)
 		{
-			stats->get(this->id).m_prevPacketSeqServer = currentSequenceNumber;
-			stats->get(this->id).m_prevPacketTimeServer = Simulator::Now();
+			stats->m_prevPacketSeqServer[this->id] = currentSequenceNumber;
+			stats->m_prevPacketTimeServer[this->id] = Simulator::Now();
 		}
-		else if (currentSequenceNumber == stats->get(this->id).m_prevPacketSeqServer + 1)
+		else if (currentSequenceNumber == stats->m_prevPacketSeqServer[this->id] + 1)
 		{
 			Time newNow = Simulator::Now();
-			stats->get(this->id).m_interPacketDelayServer.push_back(newNow - stats->get(this->id).m_prevPacketTimeServer);
-			stats->get(this->id).interPacketDelayAtServer = newNow - stats->get(this->id).m_prevPacketTimeServer;
-			stats->get(this->id).m_time.push_back(newNow);
-			stats->get(this->id).m_prevPacketSeqServer = currentSequenceNumber;
-			stats->get(this->id).m_prevPacketTimeServer = newNow;
+			stats->m_interPacketDelayServer[this->id].push_back(newNow - stats->m_prevPacketTimeServer[this->id]);
+			stats->interPacketDelayAtServer[this->id] = newNow - stats->m_prevPacketTimeServer[this->id];
+			stats->m_time[this->id].push_back(newNow);
+			stats->m_prevPacketSeqServer[this->id] = currentSequenceNumber;
+			stats->m_prevPacketTimeServer[this->id] = newNow;
 		}
-		else if (currentSequenceNumber > stats->get(this->id).m_prevPacketSeqServer + 1)
+		else if (currentSequenceNumber > stats->m_prevPacketSeqServer[this->id] + 1)
 		{
 			NS_LOG_INFO ("Packet(s) with seq number(s) ");
-			for (uint32_t i = stats->get(this->id).m_prevPacketSeqServer + 1; i < currentSequenceNumber; i++)
+			for (uint32_t i = stats->m_prevPacketSeqServer[this->id] + 1; i < currentSequenceNumber; i++)
 				NS_LOG_INFO (std::to_string(i) << " ");
 			NS_LOG_INFO ("is(are) lost in path Client->Server");
 
 			Time newNow = Simulator::Now();
-			stats->get(this->id).m_interPacketDelayServer.push_back(newNow - stats->get(this->id).m_prevPacketTimeServer);
-			stats->get(this->id).interPacketDelayAtServer = newNow - stats->get(this->id).m_prevPacketTimeServer;
-			stats->get(this->id).m_time.push_back(newNow);
-			stats->get(this->id).m_prevPacketSeqServer = currentSequenceNumber;
-			stats->get(this->id).m_prevPacketTimeServer = newNow;
+			stats->m_interPacketDelayServer[this->id].push_back(newNow - stats->m_prevPacketTimeServer[this->id]);
+			stats->interPacketDelayAtServer[this->id] = newNow - stats->m_prevPacketTimeServer[this->id];
+			stats->m_time[this->id].push_back(newNow);
+			stats->m_prevPacketSeqServer[this->id] = currentSequenceNumber;
+			stats->m_prevPacketTimeServer[this->id] = newNow;
 
 		}
-		stats->get(this->id).TotalPacketPayloadSize += packet->GetSize() - 4 - 7; //deduct coap hdr & opts, only payload here
+		stats->TotalPacketPayloadSize[this->id] += packet->GetSize() - 4 - 7; //deduct coap hdr & opts, only payload here
 		//std::cout << packet->GetSize() << std::endl;
 	} catch (std::runtime_error e) {
 		// packet fragmentation, unable to get header
@@ -662,75 +662,75 @@ void NodeEntry::OnCoapPacketReceivedAtServer(Ptr<const Packet> packet) {
 
 void NodeEntry::OnMacPacketDropped(std::string context, Ptr<const Packet> packet, DropReason reason) {
 	//cout << "============================Mac Packet Dropped!, reason:" << reason << endl;
-	stats->get(this->id).NumberOfDropsByReason[reason]++;
+	stats->NumberOfDropsByReason[this->id][reason]++;
 
 }
 
 void NodeEntry::OnTcpPacketDropped(Ptr<Packet> packet, DropReason reason) {
 	//cout << "Mac Packet Dropped!, reason:" << reason << endl;
-	stats->get(this->id).NumberOfDropsByReason[reason]++;
+	stats->NumberOfDropsByReason[this->id][reason]++;
 }
 
 
 void NodeEntry::OnTcpFirmwareUpdated(Time totalFirmwareTransferTime) {
-	stats->get(this->id).FirmwareTransferTime = totalFirmwareTransferTime;
+	stats->FirmwareTransferTime[this->id] = totalFirmwareTransferTime;
 }
 
 
 void NodeEntry::OnTcpIPCameraStreamStateChanged(bool newStateIsStreaming) {
 	if(newStateIsStreaming) {
-		stats->get(this->id).TimeStreamStarted = Simulator::Now();
-		stats->get(this->id).IPCameraTotalDataSent = 0;
-		stats->get(this->id).IPCameraTotalDataReceivedAtAP = 0;
-		stats->get(this->id).IPCameraTotalTimeSent = Time(0);
+		stats->TimeStreamStarted[this->id] = Simulator::Now();
+		stats->IPCameraTotalDataSent[this->id] = 0;
+		stats->IPCameraTotalDataReceivedAtAP[this->id] = 0;
+		stats->IPCameraTotalTimeSent[this->id] = Time(0);
 	}
 	else {
 		// stopped stream
-		stats->get(this->id).IPCameraTotalTimeSent = (Simulator::Now() - stats->get(this->id).TimeStreamStarted);
+		stats->IPCameraTotalTimeSent[this->id] = (Simulator::Now() - stats->TimeStreamStarted[this->id]);
 	}
 }
 
 void NodeEntry::OnTcpIPCameraDataSent(uint16_t nrOfBytes) {
-	stats->get(this->id).IPCameraTotalDataSent += nrOfBytes;
+	stats->IPCameraTotalDataSent[this->id] += nrOfBytes;
 }
 
 void NodeEntry::OnTcpIPCameraDataReceivedAtAP(uint16_t nrOfBytes) {
-	stats->get(this->id).IPCameraTotalDataReceivedAtAP += nrOfBytes;
+	stats->IPCameraTotalDataReceivedAtAP[this->id] += nrOfBytes;
 }
 
 void NodeEntry::OnCollision(std::string context, uint32_t nrOfBackoffSlots) {
 	if(showLog) cout << "Collision sensed" << endl;
-	stats->get(this->id).NumberOfCollisions++;
-	stats->get(this->id).TotalNumberOfBackedOffSlots += nrOfBackoffSlots;
+	stats->NumberOfCollisions[this->id]++;
+	stats->TotalNumberOfBackedOffSlots[this->id] += nrOfBackoffSlots;
 }
 
 void NodeEntry::OnTransmissionWillCrossRAWBoundary(std::string context, Time txDuration, Time remainingTimeInRawSlot) {
 	cout << "Transmission cancelled, tx duration " << txDuration << ", remaining time " << remainingTimeInRawSlot << endl;
 
-	stats->get(this->id).NumberOfTransmissionsCancelledDueToCrossingRAWBoundary++;
+	stats->NumberOfTransmissionsCancelledDueToCrossingRAWBoundary[this->id]++;
 }
 
 void NodeEntry::OnMacTxRtsFailed(std::string context, Mac48Address address) {
 	//cout  << Simulator::Now().GetMicroSeconds() << " [" << this->aId << "] "
 	//	<< " MAC Tx Rts Failed" << endl;
-	stats->get(this->id).NumberOfMACTxRTSFailed++;
+	stats->NumberOfMACTxRTSFailed[this->id]++;
 }
 
 void NodeEntry::OnMacTxDataFailed(std::string context, Mac48Address address) {
 	//cout  << Simulator::Now().GetMicroSeconds() << " [" << this->aId << "] "
 	//		<< " MAC Tx Data Failed" << endl;
-	stats->get(this->id).NumberOfMACTxMissedACK++;
+	stats->NumberOfMACTxMissedACK[this->id]++;
 }
 
 void NodeEntry::OnMacTxFinalRtsFailed(std::string context, Mac48Address address) {
 	//cout  << Simulator::Now().GetMicroSeconds() << " [" << this->aId << "] "
-	stats->get(this->id).NumberOfMACTxRTSFailed++;
+	stats->NumberOfMACTxRTSFailed[this->id]++;
 }
 
 void NodeEntry::OnMacTxFinalDataFailed(std::string context, Mac48Address address) {
 	//cout  << Simulator::Now().GetMicroSeconds() << " [" << this->aId << "] "
 	//		<< " MAC Tx Final data Failed" << endl;
-	stats->get(this->id).NumberOfMACTxMissedACKAndDroppedPacket++;
+	stats->NumberOfMACTxMissedACKAndDroppedPacket[this->id]++;
 }
 
 void NodeEntry::SetAssociatedCallback(std::function<void()> assocCallback) {
@@ -91,12 +91,12 @@ void SimulationEventManager::onNodeDeassociated(NodeEntry& node) {
 	send({"stanodedeassoc", std::to_string(node.id)});
 }
 
-string SimulationEventManager::SerializeDropReason(map<DropReason, long>& map) {
+string SimulationEventManager::SerializeDropReason(const DropCounts& drops) {
 
 	int lastItem = DropReason::TCPTxBufferExceeded;
 	std::stringstream s;
 	for(int i = 0; i <= lastItem;i++) {
-		s << map[(DropReason)i] << ((i == lastItem) ? "": ",");
+		s << drops[i] << ((i == lastItem) ? "": ",");
 	}
 	return s.str();
 }
@@ -123,56 +123,56 @@ void SimulationEventManager::onUpdateSlotStatistics(vector<long>& transmissionsP
 void SimulationEventManager::onUpdateStatistics(Statistics& stats) {
 	for(int i = 0; i < stats.getNumberOfNodes(); i++) {
 		send({"nodestats", std::to_string(i),
-			std::to_string(stats.get(i).TotalTxTime.GetMilliSeconds()),
-			std::to_string(stats.get(i).TotalRxTime.GetMilliSeconds()),
-			std::to_string(stats.get(i).TotalSleepTime.GetMilliSeconds()),
-			std::to_string(stats.get(i).TotalIdleTime.GetMilliSeconds()),
-			std::to_string(stats.get(i).NumberOfTransmissions),
-			std::to_string(stats.get(i).NumberOfTransmissionsDropped),
-			std::to_string(stats.get(i).NumberOfReceives),
-			std::to_string(stats.get(i).NumberOfReceivesDropped),
-			std::to_string(stats.get(i).NumberOfSentPackets),
-			std::to_string(stats.get(i).NumberOfSuccessfulPackets),
-			std::to_string(stats.get(i).getNumberOfDroppedPackets()),
-			std::to_string(stats.get(i).getAveragePacketSentReceiveTime()),
-			std::to_string(stats.get(i).getGoodputKbit(stats.TimeWhenEverySTAIsAssociated)),
-			std::to_string(stats.get(i).EDCAQueueLength),
-			std::to_string(stats.get(i).NumberOfSuccessfulRoundtripPackets),
-			std::to_string(stats.get(i).getAveragePacketRoundTripTime(m_config.trafficType)),
-			std::to_string(stats.get(i).TCPCongestionWindow),
-			std::to_string(stats.get(i).NumberOfTCPRetransmissions),
-			std::to_string(stats.get(i).NumberOfTCPRetransmissionsFromAP),
-			std::to_string(stats.get(i).NumberOfReceiveDroppedByDestination),
-			std::to_string(stats.get(i).NumberOfMACTxRTSFailed),
-			std::to_string(stats.get(i).NumberOfMACTxMissedACK),
-			this->SerializeDropReason(stats.get(i).NumberOfDropsByReason),
-			this->SerializeDropReason(stats.get(i).NumberOfDropsByReasonAtAP),
-			std::to_string(stats.get(i).TCPRTOValue.GetMicroSeconds() == 0 ? -1 : stats.get(i).TCPRTOValue.GetMicroSeconds()),
-			std::to_string(stats.get(i).NumberOfAPScheduledPacketForNodeInNextSlot),
-			std::to_string(stats.get(i).NumberOfAPSentPacketForNodeImmediately),
-			std::to_string(stats.get(i).getAverageRemainingWhenAPSendingPacketInSameSlot().GetMicroSeconds()),
-			std::to_string(stats.get(i).NumberOfCollisions),
-			std::to_string(stats.get(i).NumberOfMACTxMissedACKAndDroppedPacket),
-			(stats.get(i).TCPConnected ? "1" : "0"),
-			std::to_string(stats.get(i).TCPSlowStartThreshold),
-			std::to_string(stats.get(i).TCPEstimatedBandwidth),
-			std::to_string(stats.get(i).TCPRTTValue.GetMicroSeconds() == 0 ? -1 : stats.get(i).TCPRTTValue.GetMicroSeconds()),
-			std::to_string(stats.get(i).NumberOfBeaconsMissed),
-			std::to_string(stats.get(i).NumberOfTransmissionsDuringRAWSlot),
-			std::to_string(stats.get(i).getTotalDrops()),
-			std::to_string(stats.get(i).FirmwareTransferTime.GetMicroSeconds()),
-			std::to_string(stats.get(i).getIPCameraSendingRate()),
-			std::to_string(stats.get(i).getIPCameraAPReceivingRate()),
-			std::to_string(stats.get(i).NumberOfTransmissionsCancelledDueToCrossingRAWBoundary),
-			std::to_string(stats.get(i).GetAverageJitter()), // I have jitter in micros abs delay between subsequent packets
-			std::to_string(stats.get(i).GetPacketLoss(m_config.trafficType)),
-			std::to_string(stats.get(i).GetInterPacketDelayAtServer()),
-			std::to_string(stats.get(i).GetInterPacketDelayAtClient()),
-			std::to_string(stats.get(i).GetInterPacketDelayDeviationPercentage(stats.get(i).m_interPacketDelayServer)),
-			std::to_string(stats.get(i).GetInterPacketDelayDeviationPercentage(stats.get(i).m_interPacketDelayClient)),
-			std::to_string(stats.get(i).latency.GetMilliSeconds()),
-			std::to_string(stats.get(i).EnergyRxIdle),
-			std::to_string(stats.get(i).EnergyTx)
+			std::to_string(stats.TotalTxTime[i].GetMilliSeconds()),
+			std::to_string(stats.TotalRxTime[i].GetMilliSeconds()),
+			std::to_string(stats.TotalSleepTime[i].GetMilliSeconds()),
+			std::to_string(stats.TotalIdleTime[i].GetMilliSeconds()),
+			std::to_string(stats.NumberOfTransmissions[i]),
+			std::to_string(stats.NumberOfTransmissionsDropped[i]),
+			std::to_string(stats.NumberOfReceives[i]),
+			std::to_string(stats.NumberOfReceivesDropped[i]),
+			std::to_string(stats.NumberOfSentPackets[i]),
+			std::to_string(stats.NumberOfSuccessfulPackets[i]),
+			std::to_string(stats.getNumberOfDroppedPackets(i)),
+			std::to_string(stats.getAveragePacketSentReceiveTime(i)),
+			std::to_string(stats.getGoodputKbit(i, stats.TimeWhenEverySTAIsAssociated)),
+			std::to_string(stats.EDCAQueueLength[i]),
+			std::to_string(stats.NumberOfSuccessfulRoundtripPackets[i]),
+			std::to_string(stats.getAveragePacketRoundTripTime(i, m_config.trafficType)),
+			std::to_string(stats.TCPCongestionWindow[i]),
+			std::to_string(stats.NumberOfTCPRetransmissions[i]),
+			std::to_string(stats.NumberOfTCPRetransmissionsFromAP[i]),
+			std::to_string(stats.NumberOfReceiveDroppedByDestination[i]),
+			std::to_string(stats.NumberOfMACTxRTSFailed[i]),
+			std::to_string(stats.NumberOfMACTxMissedACK[i]),
+			this->SerializeDropReason(stats.NumberOfDropsByReason[i]),
+			this->SerializeDropReason(stats.NumberOfDropsByReasonAtAP[i]),
+			std::to_string(stats.TCPRTOValue[i].GetMicroSeconds() == 0 ? -1 : stats.TCPRTOValue[i].GetMicroSeconds()),
+			std::to_string(stats.NumberOfAPScheduledPacketForNodeInNextSlot[i]),
+			std::to_string(stats.NumberOfAPSentPacketForNodeImmediately[i]),
+			std::to_string(stats.getAverageRemainingWhenAPSendingPacketInSameSlot(i).GetMicroSeconds()),
+			std::to_string(stats.NumberOfCollisions[i]),
+			std::to_string(stats.NumberOfMACTxMissedACKAndDroppedPacket[i]),
+			(stats.TCPConnected[i] ? "1" : "0"),
+			std::to_string(stats.TCPSlowStartThreshold[i]),
+			std::to_string(stats.TCPEstimatedBandwidth[i]),
+			std::to_string(stats.TCPRTTValue[i].GetMicroSeconds() == 0 ? -1 : stats.TCPRTTValue[i].GetMicroSeconds()),
+			std::to_string(stats.NumberOfBeaconsMissed[i]),
+			std::to_string(stats.NumberOfTransmissionsDuringRAWSlot[i]),
+			std::to_string(stats.getTotalDrops(i)),
+			std::to_string(stats.FirmwareTransferTime[i].GetMicroSeconds()),
+			std::to_string(stats.getIPCameraSendingRate(i)),
+			std::to_string(stats.getIPCameraAPReceivingRate(i)),
+			std::to_string(stats.NumberOfTransmissionsCancelledDueToCrossingRAWBoundary[i]),
+			std::to_string(stats.GetAverageJitter(i)), // I have jitter in micros abs delay between subsequent packets
+			std::to_string(stats.GetPacketLoss(i, m_config.trafficType)),
+			std::to_string(stats.GetInterPacketDelayAtServer(i)),
+			std::to_string(stats.GetInterPacketDelayAtClient(i)),
+			std::to_string(stats.GetInterPacketDelayDeviationPercentage(stats.m_interPacketDelayServer[i])),
+			std::to_string(stats.GetInterPacketDelayDeviationPercentage(stats.m_interPacketDelayClient[i])),
+			std::to_string(stats.latency[i].GetMilliSeconds()),
+			std::to_string(stats.EnergyRxIdle[i]),
+			std::to_string(stats.EnergyTx[i])
 		});
 	}
 }
@@ -43,7 +43,7 @@ public:
 	void onNodeAssociated(NodeEntry& node);
 	void onNodeDeassociated(NodeEntry& node);
 
-	string SerializeDropReason(map<DropReason, long>& map);
+	string SerializeDropReason(const DropCounts& drops);
 
 	void onUpdateSlotStatistics(vector<long>& transmissionsPerSlotFromAP, vector<long>& transmissionsPerSlotFromSTA);
 
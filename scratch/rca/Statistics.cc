@@ -1,19 +1,241 @@
 #include "Statistics.h"
+#include "Configuration.h"
+#include <numeric>
+#include <cmath>
 
-Statistics::Statistics() {
+Statistics::Statistics() : nrOfNodes(0) {
 	this->TimeWhenEverySTAIsAssociated = Time();
 }
 
-Statistics::Statistics(int nrOfNodes) {
+Statistics::Statistics(int nrOfNodes) :
+		nrOfNodes(nrOfNodes),
+		TotalTransmitTime(nrOfNodes),
+		TotalTxTime(nrOfNodes),
+		TotalReceiveTime(nrOfNodes),
+		TotalRxTime(nrOfNodes),
+		TotalDozeTime(nrOfNodes),
+		TotalSleepTime(nrOfNodes),
+		TotalActiveTime(nrOfNodes),
+		TotalIdleTime(nrOfNodes),
+		EnergyRxIdle(nrOfNodes),
+		EnergyTx(nrOfNodes),
+		interPacketDelayAtServer(nrOfNodes),
+		interPacketDelayAtClient(nrOfNodes),
+		m_interPacketDelayServer(nrOfNodes),
+		m_interPacketDelayClient(nrOfNodes),
+		m_time(nrOfNodes),
+		m_prevPacketSeqServer(nrOfNodes),
+		m_prevPacketTimeServer(nrOfNodes),
+		m_prevPacketSeqClient(nrOfNodes),
+		m_prevPacketTimeClient(nrOfNodes),
+		NumberOfTransmissions(nrOfNodes),
+		NumberOfTransmissionsDropped(nrOfNodes),
+		NumberOfReceives(nrOfNodes),
+		NumberOfReceivesDropped(nrOfNodes),
+		NumberOfReceiveDroppedByDestination(nrOfNodes),
+		NumberOfDropsByReason(nrOfNodes),
+		NumberOfDropsByReasonAtAP(nrOfNodes),
+		NumberOfSuccessfulPackets(nrOfNodes),
+		NumberOfSuccessfulPacketsWithSeqHeader(nrOfNodes),
+		NumberOfSentPackets(nrOfNodes),
+		NumberOfSuccessfulRoundtripPackets(nrOfNodes),
+		NumberOfSuccessfulRoundtripPacketsWithSeqHeader(nrOfNodes),
+		TotalPacketSentReceiveTime(nrOfNodes),
+		latency(nrOfNodes),
+		jitterAcc(nrOfNodes),
+		jitter(nrOfNodes),
+		TotalPacketPayloadSize(nrOfNodes),
+		TotalPacketRoundtripTime(nrOfNodes),
+		EDCAQueueLength(nrOfNodes),
+		TCPCongestionWindow(nrOfNodes),
+		TCPRTOValue(nrOfNodes),
+		TCPConnected(nrOfNodes),
+		NumberOfTCPRetransmissions(nrOfNodes),
+		NumberOfTCPRetransmissionsFromAP(nrOfNodes),
+		NumberOfMACTxRTSFailed(nrOfNodes),
+		NumberOfMACTxMissedACK(nrOfNodes),
+		NumberOfMACTxMissedACKAndDroppedPacket(nrOfNodes),
+		NumberOfAPScheduledPacketForNodeInNextSlot(nrOfNodes),
+		NumberOfAPSentPacketForNodeImmediately(nrOfNodes),
+		APTotalTimeRemainingWhenSendingPacketInSameSlot(nrOfNodes),
+		NumberOfCollisions(nrOfNodes),
+		NumberOfTransmissionsCancelledDueToCrossingRAWBoundary(nrOfNodes),
+		TotalNumberOfBackedOffSlots(nrOfNodes),
+		TCPSlowStartThreshold(nrOfNodes, -1),
+		TCPEstimatedBandwidth(nrOfNodes, -1),
+		TCPRTTValue(nrOfNodes),
+		NumberOfBeaconsMissed(nrOfNodes),
+		NumberOfTransmissionsDuringRAWSlot(nrOfNodes),
+		FirmwareTransferTime(nrOfNodes),
+		TimeStreamStarted(nrOfNodes),
+		IPCameraTotalDataSent(nrOfNodes),
+		IPCameraTotalDataReceivedAtAP(nrOfNodes),
+		IPCameraTotalTimeSent(nrOfNodes) {
 	this->TimeWhenEverySTAIsAssociated = Time();
-    for(int i = 0; i < nrOfNodes; i++)
-        this->nodeStatistics.push_back(NodeStatistics());    
-}
-NodeStatistics& Statistics::get(int index) {
-    return this->nodeStatistics.at(index);
 }
 
 int Statistics::getNumberOfNodes() const {
-    return this->nodeStatistics.size();
+	return this->nrOfNodes;
+}
+
+long double Statistics::getAveragePacketSentReceiveTime(int node) { //milliseconds
+	if(NumberOfSuccessfulPackets[node] > 0)
+		return static_cast<long double>(TotalPacketSentReceiveTime[node].GetMilliSeconds()) / NumberOfSuccessfulPackets[node];
+	else
+		return -1;
+}
+
+// This is jitter in milliseconds
+long Statistics::GetAverageJitter(int node)
+{
+	if (NumberOfSuccessfulRoundtripPackets[node] > 1)
+		return sqrt(jitterAcc[node]/(NumberOfSuccessfulRoundtripPackets[node] - 1));
+	else
+		return -1;
+}
+
+double Statistics::GetTotalEnergyConsumption (int node)
+{
+	return EnergyRxIdle[node] + EnergyTx[node]; //mW
+}
+
+Time Statistics::GetAverageInterPacketDelay(std::vector<Time>& delayVector){
+	if (delayVector.size() != 0)
+	{
+		//cout << "inter packet delay vector size " << delayVector.size() << endl;
+		return std::accumulate(delayVector.begin(), delayVector.end(), Seconds(0.0))/delayVector.size();
+	}
+	else return Time();
+}
+
+long double Statistics::GetInterPacketDelayDeviation(std::vector<Time>& delayVector) // in microseconds
+{
+	long double meanInterPacketDelay (this->GetAverageInterPacketDelay(delayVector).GetMicroSeconds());
+	long double dev (0);
+	for (Time& delay : delayVector)
+	{
+		dev += (static_cast<long double>(delay.GetMicroSeconds()) - meanInterPacketDelay)*(static_cast<long double>(delay.GetMicroSeconds() - meanInterPacketDelay));
+	}
+	if (delayVector.size() > 0)
+		return sqrt(dev/delayVector.size());
+	else return -1; //implement exception handling for dummy nodes TODO
 }
 
+//reliability for one node or for all nodes in whole network? impossible with dummy nodes.
+//try whole net when testing max nr of control loops
+float Statistics::GetPacketLoss (int node, std::string trafficType)
+{
+	if (NumberOfSuccessfulRoundtripPackets[node] > 0)
+		return 100 - 100 * (float)NumberOfSuccessfulRoundtripPackets[node] / NumberOfSentPackets[node];
+	else if (NumberOfSuccessfulPackets[node] > 0)
+		return 100 - 100 * (float)NumberOfSuccessfulPackets[node] / NumberOfSentPackets[node];
+	else return -1;
+}
+
+long double Statistics::GetInterPacketDelayDeviationPercentage(std::vector<Time>& delayVector){
+	int64_t avg = GetAverageInterPacketDelay(delayVector).GetMicroSeconds();
+	if (avg != 0)
+		return (100*GetInterPacketDelayDeviation(delayVector)/avg);
+	else
+		return -1;
+}
+
+
+long double Statistics::getAveragePacketRoundTripTime (int node, std::string trafficType) {
+	if(NumberOfSuccessfulRoundtripPackets[node] > 0)
+	{
+		if (trafficType != "coap")
+			return static_cast<long double>(TotalPacketRoundtripTime[node].GetMilliSeconds()) / NumberOfSuccessfulRoundtripPacketsWithSeqHeader[node];
+		else
+			return static_cast<long double>((TotalPacketRoundtripTime[node].GetMilliSeconds() + TotalPacketSentReceiveTime[node].GetMilliSeconds())) / NumberOfSuccessfulRoundtripPacketsWithSeqHeader[node];
+		// In coap case TotalPacketRoundtripTime is not RTT but total time between the moment server sends a reply and a moment client receives it
+		// same like TotalPacketSentReceiveTime just in the opposite direction
+		// optimize the code and add new container for this value because the name is not representative
+		// basically, true Total RTT = TotalPacketRoundtripTime + TotalPacketSentReceiveTime
+	}
+	else
+		return -1;
+}
+
+long Statistics::getNumberOfDroppedPackets(int node) {
+	if(NumberOfSentPackets[node] == 0)
+		return -1;
+	else
+		return NumberOfSentPackets[node] - NumberOfSuccessfulPackets[node];
+}
+
+long double Statistics::GetInterPacketDelayAtClient (int node)
+{
+	if (interPacketDelayAtClient[node].GetMilliSeconds() > 0)
+	{
+		return interPacketDelayAtClient[node].GetMilliSeconds();
+	}
+	else return -1;
+}
+
+long double Statistics::GetInterPacketDelayAtServer (int node)
+{
+	if (interPacketDelayAtServer[node].GetMilliSeconds() > 0)
+	{
+		return interPacketDelayAtServer[node].GetMilliSeconds();
+	}
+	else return -1;
+}
+
+double Statistics::getGoodputKbit(int node, Time timeAllStationsAssociated) {
+	if (Simulator::Now () > 0)
+		return (TotalPacketPayloadSize[node] * 8.) / ((Simulator::Now ().GetSeconds () - timeAllStationsAssociated.GetSeconds ()) * 1000);
+	else return -1;
+}
+
+
+Time Statistics::getAverageRemainingWhenAPSendingPacketInSameSlot(int node) {
+	if(NumberOfAPSentPacketForNodeImmediately[node] == 0)
+		return Time();
+	else
+		return APTotalTimeRemainingWhenSendingPacketInSameSlot[node] / NumberOfAPSentPacketForNodeImmediately[node];
+}
+
+
+int Statistics::getTotalDrops(int node) {
+	int sum = 0;
+	for(long drops : NumberOfDropsByReason[node]) {
+		sum += drops;
+	}
+
+	for(long drops : NumberOfDropsByReasonAtAP[node]) {
+		sum += drops;
+	}
+	return sum;
+}
+
+double Statistics::getIPCameraSendingRate(int node) {
+	if(TimeStreamStarted[node] == Time(0))
+		return -1;
+	else {
+
+		double elapsedSeconds;
+		if(IPCameraTotalTimeSent[node] == Time(0))
+			elapsedSeconds = (Simulator::Now() -TimeStreamStarted[node]).GetSeconds();
+		else
+			elapsedSeconds = IPCameraTotalTimeSent[node].GetSeconds();
+		return (IPCameraTotalDataSent[node] / elapsedSeconds) / 1024 * 8;
+	}
+}
+
+double Statistics::getIPCameraAPReceivingRate(int node) {
+	if(TimeStreamStarted[node] == Time(0))
+			return -1;
+	else {
+
+		double elapsedSeconds;
+		if(IPCameraTotalTimeSent[node] == Time(0))
+			elapsedSeconds = (Simulator::Now() -TimeStreamStarted[node]).GetSeconds();
+		else
+			elapsedSeconds = IPCameraTotalTimeSent[node].GetSeconds();
+
+		return (IPCameraTotalDataReceivedAtAP[node] / elapsedSeconds) / 1024 * 8;
+	}
+}
+
+
@@ -1,26 +1,147 @@
 #ifndef STATISTICS_H
 #define STATISTICS_H
 
-#include "NodeStatistics.h"
+#include "ns3/core-module.h"
+#include "ns3/drop-reason.h"
+#include <array>
+#include <vector>
+#include <numeric>
 
 using namespace std;
 using namespace ns3;
 
+// number of drops of a node, indexed by DropReason
+typedef array<long, DropReason::TCPTxBufferExceeded + 1> DropCounts;
+
+// The statistics of the nodes are stored as an array per metric, indexed by
+// node id, so that the per-event updates and the sweeps over all the nodes
+// only touch the metrics involved instead of a large object per node.
 class Statistics {
 private:
-    vector<NodeStatistics> nodeStatistics;
-    
+    int nrOfNodes;
+
 public:
     Time TotalSimulationTime;
     Time TimeWhenEverySTAIsAssociated;
-    
+
+    vector<Time> TotalTransmitTime; // tx
+    vector<Time> TotalTxTime; // rx
+
+    vector<Time> TotalReceiveTime; // rx
+    vector<Time> TotalRxTime; // rx
+
+    vector<Time> TotalDozeTime; // sleep
+    vector<Time> TotalSleepTime; // sleep
+
+    vector<Time> TotalActiveTime; // switching
+
+    vector<Time> TotalIdleTime; //idle
+
+    vector<double> EnergyRxIdle;
+    vector<double> EnergyTx;
+
+    vector<Time> interPacketDelayAtServer; ///ami
+    vector<Time> interPacketDelayAtClient; ///ami
+    vector<vector<Time> > m_interPacketDelayServer;
+    vector<vector<Time> > m_interPacketDelayClient;
+    vector<vector<Time> > m_time;
+
+    vector<uint32_t> m_prevPacketSeqServer;
+    vector<Time> m_prevPacketTimeServer;
+    vector<uint32_t> m_prevPacketSeqClient;
+    vector<Time> m_prevPacketTimeClient;
+
+    vector<long> NumberOfTransmissions;
+    vector<long> NumberOfTransmissionsDropped;
+    vector<long> NumberOfReceives;
+    vector<long> NumberOfReceivesDropped;
+    // the number of Rx that is dropped while STA was the destination
+    vector<long> NumberOfReceiveDroppedByDestination;
+
+    // number of drops for any packets for between STA and AP by reason
+    vector<DropCounts> NumberOfDropsByReason;
+    // number of drops for any packets for between STA and AP by reason that occurred at AP
+    vector<DropCounts> NumberOfDropsByReasonAtAP;
+
+    vector<long> NumberOfSuccessfulPackets;
+    vector<long> NumberOfSuccessfulPacketsWithSeqHeader;
+    vector<long> NumberOfSentPackets;
+
+    vector<long> NumberOfSuccessfulRoundtripPackets;
+    vector<long> NumberOfSuccessfulRoundtripPacketsWithSeqHeader;
+
+    vector<Time> TotalPacketSentReceiveTime;
+    vector<Time> latency;
+
+    // for jitter RMS - cumulative sum of abs differences
+    vector<uint64_t> jitterAcc;
+    vector<Time> jitter;
+
+    vector<long> TotalPacketPayloadSize;
+
+    vector<Time> TotalPacketRoundtripTime;
+
+    vector<int> EDCAQueueLength;
+
+    vector<long> TCPCongestionWindow;
+    vector<Time> TCPRTOValue;
+    vector<bool> TCPConnected;
+
+    vector<long> NumberOfTCPRetransmissions;
+    vector<long> NumberOfTCPRetransmissionsFromAP;
+
+    vector<long> NumberOfMACTxRTSFailed;
+    vector<long> NumberOfMACTxMissedACK;
+    vector<long> NumberOfMACTxMissedACKAndDroppedPacket;
+
+    vector<long> NumberOfAPScheduledPacketForNodeInNextSlot;
+    vector<long> NumberOfAPSentPacketForNodeImmediately;
+    vector<Time> APTotalTimeRemainingWhenSendingPacketInSameSlot;
+
+    vector<long> NumberOfCollisions;
+    vector<long> NumberOfTransmissionsCancelledDueToCrossingRAWBoundary;
+
+    vector<long> TotalNumberOfBackedOffSlots;
+
+    vector<uint32_t> TCPSlowStartThreshold;
+
+    vector<double> TCPEstimatedBandwidth;
+
+    vector<Time> TCPRTTValue;
+
+    vector<long> NumberOfBeaconsMissed;
+
+    vector<uint16_t> NumberOfTransmissionsDuringRAWSlot;
+
+    vector<Time> FirmwareTransferTime;
+
+    vector<Time> TimeStreamStarted;
+    vector<double> IPCameraTotalDataSent;
+    vector<double> IPCameraTotalDataReceivedAtAP;
+    vector<Time> IPCameraTotalTimeSent;
+
     Statistics();
     Statistics(int nrOfNodes);
-    NodeStatistics& get(int index);
 
     int getNumberOfNodes() const;
 
+    double GetTotalEnergyConsumption (int node);
+    long double GetInterPacketDelayDeviation(std::vector<Time>& delayVector);
+    long double GetInterPacketDelayDeviationPercentage(std::vector<Time>& delayVector);
+    Time GetAverageInterPacketDelay(std::vector<Time>& delayVector);
+    float GetPacketLoss (int node, std::string trafficType);
+    long double GetInterPacketDelayAtServer (int node);
+    long double GetInterPacketDelayAtClient (int node);
+    long getNumberOfDroppedPackets(int node);
+    long GetAverageJitter(int node);
+    long double getAveragePacketSentReceiveTime(int node);
+    long double getAveragePacketRoundTripTime(int node, std::string trafficType);
+    double getGoodputKbit(int node, Time timeAllStationsAssociated);
+    Time getAverageRemainingWhenAPSendingPacketInSameSlot(int node);
+    int getTotalDrops(int node);
+    double getIPCameraSendingRate(int node);
+    double getIPCameraAPReceivingRate(int node);
+
 };
 
 #endif /* STATISTICS_H */
-
@@ -130,6 +130,88 @@ void PopulateArpCache() {
 	}
 }
 
+void AddNeighbor(Ptr<NdiscCache> cache, Ptr<Ipv6Interface> neighbor) {
+	Address mac = neighbor->GetDevice()->GetAddress();
+	for (uint32_t k = 0; k < neighbor->GetNAddresses(); k++) {
+		NdiscCache::Entry * entry = cache->Add(
+				neighbor->GetAddress(k).GetAddress());
+		entry->SetRouter(false);
+		entry->SetMacAddress(mac);
+		entry->MarkPermanent();
+	}
+}
+
+// Same as PopulateArpCache: stations that sleep most of the time can not be
+// reached by neighbor discovery, so the AP and the stations know each other.
+// The caches are replaced, otherwise they are flushed when the stations associate
+Ptr<NdiscCache> CreateNeighborCache(Ptr<Ipv6Interface> iface) {
+	Ptr<NdiscCache> cache = CreateObject<NdiscCache>();
+	cache->SetDevice(iface->GetDevice(), iface);
+	iface->SetNdiscCache(cache);
+	return cache;
+}
+
+void PopulateNeighborCache() {
+	Ptr<Ipv6Interface> apIface =
+			wifiApNode.Get(0)->GetObject<Ipv6L3Protocol>()->GetInterface(
+					apNodeInterface6.GetInterfaceIndex(0));
+	Ptr<NdiscCache> apCache = CreateNeighborCache(apIface);
+	for (uint32_t i = 0; i < staNodeInterface6.GetN(); i++) {
+		Ptr<Ipv6Interface> staIface =
+				wifiStaNode.Get(i)->GetObject<Ipv6L3Protocol>()->GetInterface(
+						staNodeInterface6.GetInterfaceIndex(i));
+		AddNeighbor(CreateNeighborCache(staIface), apIface);
+		AddNeighbor(apCache, staIface);
+	}
+}
+
+void onStaIpv6Tx(Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface) {
+	sixLowPanDatagrams++;
+	sixLowPanIpv6Bytes += packet->GetSize();
+}
+
+void onStaSixLowPanTx(Ptr<const Packet> packet,
+		Ptr<SixLowPanNetDevice> device, uint32_t interface) {
+	sixLowPanCompressedBytes += packet->GetSize();
+}
+
+// Ipv6Interface does not add the link-local address of 48-bit MAC devices,
+// and the udp traffic is sent to the link-local address of the AP
+void addLinkLocalAddresses(NetDeviceContainer& devices,
+		Ipv6InterfaceContainer& interfaces) {
+	for (uint32_t i = 0; i < devices.GetN(); i++) {
+		Ptr<Ipv6> ipv6 = devices.Get(i)->GetNode()->GetObject<Ipv6>();
+		Ipv6Address linkLocal = Ipv6Address::MakeAutoconfiguredLinkLocalAddress(
+				Mac48Address::ConvertFrom(devices.Get(i)->GetAddress()));
+		ipv6->AddAddress(interfaces.GetInterfaceIndex(i),
+				Ipv6InterfaceAddress(linkLocal, Ipv6Prefix(64)));
+	}
+}
+
+void configureSixLowPan(NetDeviceContainer& staDevice) {
+	SixLowPanHelper sixlowpan;
+	sixlowpan.SetDeviceAttribute("MaxFrameSize",
+			UintegerValue(config.sixLowPanMaxFrameSize));
+	// the EtherType of the LoWPAN encapsulation (RFC 7973), carried in the LLC/SNAP header
+	sixlowpan.SetDeviceAttribute("EtherType", UintegerValue(0xA0ED));
+	NetDeviceContainer staSixLowPanDevice = sixlowpan.Install(staDevice);
+	NetDeviceContainer apSixLowPanDevice = sixlowpan.Install(apDevice);
+
+	Ipv6AddressHelper address;
+	address.SetBase(Ipv6Address("2001:1::"), Ipv6Prefix(64));
+	staNodeInterface6 = address.Assign(staSixLowPanDevice);
+	apNodeInterface6 = address.Assign(apSixLowPanDevice);
+	addLinkLocalAddresses(staSixLowPanDevice, staNodeInterface6);
+	addLinkLocalAddresses(apSixLowPanDevice, apNodeInterface6);
+
+	for (uint32_t i = 0; i < staSixLowPanDevice.GetN(); i++) {
+		staSixLowPanDevice.Get(i)->TraceConnectWithoutContext("Tx",
+				MakeCallback(&onStaSixLowPanTx));
+		wifiStaNode.Get(i)->GetObject<Ipv6L3Protocol>()->TraceConnectWithoutContext(
+				"Tx", MakeCallback(&onStaIpv6Tx));
+	}
+}
+
 uint16_t ngroup;
 uint16_t nslot;
 RPSVector configureRAW(RPSVector rpslist, string RAWConfigFile) {
@@ -150,40 +232,39 @@ RPSVector configureRAW(RPSVector rpslist, string RAWConfigFile) {
 		int totalNumSta = 0;
 		for (uint16_t kk = 0; kk < NRPS; kk++) // number of beacons covering all raw groups
 		{
-			RPS *m_rps = new RPS;
+			RPS m_rps;
 			myfile >> NRAWPERBEACON;
 			ngroup = NRAWPERBEACON;
 			for (uint16_t i = 0; i < NRAWPERBEACON; i++) // raw groups in one beacon
 			{
 				//RPS *m_rps = new RPS;
-				RPS::RawAssignment *m_raw = new RPS::RawAssignment;
+				RPS::RawAssignment m_raw;
 
 				myfile >> Value;
-				m_raw->SetRawControl(Value);  //support paged STA or not
+				m_raw.SetRawControl(Value);  //support paged STA or not
 				myfile >> Value;
-				m_raw->SetSlotCrossBoundary(Value);
+				m_raw.SetSlotCrossBoundary(Value);
 				myfile >> Value;
-				m_raw->SetSlotFormat(Value);
+				m_raw.SetSlotFormat(Value);
 				myfile >> Value;
-				m_raw->SetSlotDurationCount(Value);
+				m_raw.SetSlotDurationCount(Value);
 				myfile >> Value;
 				nslot = Value;
-				m_raw->SetSlotNum(Value);
+				m_raw.SetSlotNum(Value);
 				myfile >> page;
 				myfile >> aid_start;
 				myfile >> aid_end;
 				rawinfo = (aid_end << 13) | (aid_start << 2) | page;
-				m_raw->SetRawGroup(rawinfo);
+				m_raw.SetRawGroup(rawinfo);
 				totalNumSta += aid_end - aid_start + 1;
-				m_rps->SetRawAssignment(*m_raw);
-				delete m_raw;
+				m_rps.SetRawAssignment(m_raw);
 			}
 			rpslist.rpsset.push_back(m_rps);
 			//config.nRawGroupsPerRpsList.push_back(NRAWPERBEACON);
 		}
 		myfile.close();
 		config.NRawSta = totalNumSta;
-				/*rpslist.rpsset[rpslist.rpsset.size() - 1]->GetRawAssigmentObj(
+				/*rpslist.rpsset[rpslist.rpsset.size() - 1].GetRawAssigmentObj(
 						NRAWPERBEACON - 1).GetRawGroupAIDEnd();*/
 	} else
 		cout << "Unable to open RAW configuration file \n";
@@ -191,6 +272,45 @@ RPSVector configureRAW(RPSVector rpslist, string RAWConfigFile) {
 	return rpslist;
 }
 
+// adds to every RPS a RAW group with one slot per relay, in which the relays
+// forward the packets of their stations to the AP
+RPSVector addRelayRawGroup(RPSVector rpslist, uint16_t aidStart, uint16_t aidEnd) {
+	RPSVector withRelays;
+	uint16_t nslot = aidEnd - aidStart + 1;
+	// slot format 0 has an 8 bit slot duration count and a 6 bit number of slots
+	uint8_t format = config.relaySlotDurationCount > 255 ? 1 : 0;
+	NS_ASSERT(nslot < (format ? 8 : 64));
+	for (uint32_t i = 0; i < rpslist.rpsset.size(); i++) {
+		RPS m_rps;
+		for (uint32_t j = 0; j < rpslist.rpsset[i].GetNumberOfRawGroups(); j++)
+			m_rps.SetRawAssignment(rpslist.rpsset[i].GetRawAssigmentObj(j));
+		RPS::RawAssignment m_raw;
+		m_raw.SetRawControl(0);
+		m_raw.SetSlotCrossBoundary(1);
+		m_raw.SetSlotFormat(format);
+		m_raw.SetSlotDurationCount(config.relaySlotDurationCount);
+		m_raw.SetSlotNum(nslot);
+		m_raw.SetRawGroup((aidEnd << 13) | (aidStart << 2) | 0);
+		m_rps.SetRawAssignment(m_raw);
+		withRelays.rpsset.push_back(m_rps);
+	}
+	return withRelays;
+}
+
+void startRelayBeacons(Ptr<ApWifiMac> mac) {
+	mac->SetAttribute("BeaconGeneration", BooleanValue(true));
+}
+
+Ssid getRelaySsid(uint32_t relay) {
+	return Ssid("ns380211ah-relay" + std::to_string(relay));
+}
+
+// the relays are evenly spread around the AP
+Vector getRelayPosition(uint32_t relay, double distance) {
+	double angle = 2 * M_PI * relay / config.NRelay;
+	return Vector(distance * cos(angle), distance * sin(angle), 0);
+}
+
 /*
 pageslice element and TIM(DTIM) together accomplish page slicing.
 
@@ -260,11 +380,11 @@ void checkRawAndTimConfiguration (void)
 	for (uint32_t j = 0; j < config.rps.rpsset.size(); j++)
 	{
 		uint32_t totalRawTime = 0;
-		for (uint32_t i = 0; i < config.rps.rpsset[j]->GetNumberOfRawGroups(); i++)
+		for (uint32_t i = 0; i < config.rps.rpsset[j].GetNumberOfRawGroups(); i++)
 		{
-			totalRawTime += (120 * config.rps.rpsset[j]->GetRawAssigmentObj(i).GetSlotDurationCount() + 500) * config.rps.rpsset[j]->GetRawAssigmentObj(i).GetSlotNum();
-			auto aidStart = config.rps.rpsset[j]->GetRawAssigmentObj(i).GetRawGroupAIDStart();
-			auto aidEnd = config.rps.rpsset[j]->GetRawAssigmentObj(i).GetRawGroupAIDEnd();
+			totalRawTime += (120 * config.rps.rpsset[j].GetRawAssigmentObj(i).GetSlotDurationCount() + 500) * config.rps.rpsset[j].GetRawAssigmentObj(i).GetSlotNum();
+			auto aidStart = config.rps.rpsset[j].GetRawAssigmentObj(i).GetRawGroupAIDStart();
+			auto aidEnd = config.rps.rpsset[j].GetRawAssigmentObj(i).GetRawGroupAIDEnd();
 			configIsCorrect = check (aidStart, j) && check (aidEnd, j);
 			// AIDs in each RPS must comply with TIM in the following way:
 			// TIM0: 1-63; TIM1: 64-127; TIM2: 128-191; ...; TIM32: 1983-2047
@@ -284,8 +404,69 @@ bool check (uint16_t aid, uint32_t index)
 }
 
 
+void openStatisticsDatabase() {
+#ifdef STATS_HAS_SQLITE3
+	statisticsDatabase = CreateObject<SqliteDataOutput>();
+	statisticsDatabase->SetFilePrefix(config.StatisticsDatabase);
+	statisticsDatabase->CreateWideTable("NodeStatistics", {"TotalTxTime",
+			"TotalRxTime", "TotalSleepTime", "TotalIdleTime",
+			"NumberOfTransmissions", "NumberOfTransmissionsDropped",
+			"NumberOfReceives", "NumberOfReceivesDropped",
+			"NumberOfSentPackets", "NumberOfSuccessfulPackets",
+			"NumberOfDroppedPackets", "AveragePacketSentReceiveTime",
+			"GoodputKbit", "EDCAQueueLength",
+			"NumberOfSuccessfulRoundtripPackets", "NumberOfTCPRetransmissions",
+			"NumberOfMACTxRTSFailed", "NumberOfMACTxMissedACK",
+			"NumberOfCollisions", "NumberOfBeaconsMissed",
+			"NumberOfTransmissionsDuringRAWSlot", "TotalDrops", "Jitter",
+			"PacketLoss", "Latency", "EnergyRxIdle", "EnergyTx"});
+#else
+	cout << "The stats module was built without SQLite, StatisticsDatabase is ignored" << endl;
+#endif
+}
+
+void writeStatisticsToDatabase() {
+#ifdef STATS_HAS_SQLITE3
+	if (!statisticsDatabase)
+		return;
+	// one row per node and snapshot, in the order of the columns of openStatisticsDatabase
+	vector<double> values;
+	for (int i = 0; i < stats.getNumberOfNodes(); i++) {
+		values = {(double) stats.TotalTxTime[i].GetMilliSeconds(),
+				(double) stats.TotalRxTime[i].GetMilliSeconds(),
+				(double) stats.TotalSleepTime[i].GetMilliSeconds(),
+				(double) stats.TotalIdleTime[i].GetMilliSeconds(),
+				(double) stats.NumberOfTransmissions[i],
+				(double) stats.NumberOfTransmissionsDropped[i],
+				(double) stats.NumberOfReceives[i],
+				(double) stats.NumberOfReceivesDropped[i],
+				(double) stats.NumberOfSentPackets[i],
+				(double) stats.NumberOfSuccessfulPackets[i],
+				(double) stats.getNumberOfDroppedPackets(i),
+				(double) stats.getAveragePacketSentReceiveTime(i),
+				stats.getGoodputKbit(i, stats.TimeWhenEverySTAIsAssociated),
+				(double) stats.EDCAQueueLength[i],
+				(double) stats.NumberOfSuccessfulRoundtripPackets[i],
+				(double) stats.NumberOfTCPRetransmissions[i],
+				(double) stats.NumberOfMACTxRTSFailed[i],
+				(double) stats.NumberOfMACTxMissedACK[i],
+				(double) stats.NumberOfCollisions[i],
+				(double) stats.NumberOfBeaconsMissed[i],
+				(double) stats.NumberOfTransmissionsDuringRAWSlot[i],
+				(double) stats.getTotalDrops(i),
+				(double) stats.GetAverageJitter(i),
+				stats.GetPacketLoss(i, config.trafficType),
+				(double) stats.latency[i].GetMilliSeconds(),
+				stats.EnergyRxIdle[i],
+				stats.EnergyTx[i]};
+		statisticsDatabase->AddWideRow("NodeStatistics", config.name, Simulator::Now(), i, values);
+	}
+#endif
+}
+
 void sendStatistics(bool schedule) {
 	eventManager.onUpdateStatistics(stats);
+	writeStatisticsToDatabase();
 	eventManager.onUpdateSlotStatistics(
 			transmissionsPerTIMGroupAndSlotFromAPSinceLastInterval,
 			transmissionsPerTIMGroupAndSlotFromSTASinceLastInterval);
@@ -306,7 +487,7 @@ void onSTADeassociated(int i) {
 void updateNodesQueueLength() {
 	for (uint32_t i = 0; i < config.Nsta; i++) {
 		nodes[i]->UpdateQueueLength();
-		stats.get(i).EDCAQueueLength = nodes[i]->queueLength;
+		stats.EDCAQueueLength[i] = nodes[i]->queueLength;
 	}
 	Simulator::Schedule(Seconds(0.5), &updateNodesQueueLength);
 }
@@ -316,16 +497,16 @@ void onSTAAssociated(int i) {
 			<< nodes[i]->aId << endl;
 
 	for (int k = 0; k < config.rps.rpsset.size(); k++) {
-		for (int j = 0; j < config.rps.rpsset[k]->GetNumberOfRawGroups(); j++) {
-			if (config.rps.rpsset[k]->GetRawAssigmentObj(j).GetRawGroupAIDStart()
+		for (int j = 0; j < config.rps.rpsset[k].GetNumberOfRawGroups(); j++) {
+			if (config.rps.rpsset[k].GetRawAssigmentObj(j).GetRawGroupAIDStart()
 					<= i + 1
 					&& i + 1
-							<= config.rps.rpsset[k]->GetRawAssigmentObj(j).GetRawGroupAIDEnd()) {
+							<= config.rps.rpsset[k].GetRawAssigmentObj(j).GetRawGroupAIDEnd()) {
 				nodes[i]->rpsIndex = k + 1;
 				nodes[i]->rawGroupNumber = j + 1;
 				nodes[i]->rawSlotIndex =
 						nodes[i]->aId
-								% config.rps.rpsset[k]->GetRawAssigmentObj(j).GetSlotNum()
+								% config.rps.rpsset[k].GetRawAssigmentObj(j).GetSlotNum()
 								+ 1;
 				/*cout << "Node " << i << " with AID " << (int)nodes[i]->aId << " belongs to " << (int)nodes[i]->rawSlotIndex << " slot of RAW group "
 				 << (int)nodes[i]->rawGroupNumber << " within the " << (int)nodes[i]->rpsIndex << " RPS." << endl;
@@ -585,7 +766,7 @@ void OnAPPhyRxDrop(std::string context, Ptr<const Packet> packet,
 				}
 			}
 			if (staId != -1) {
-				stats.get(staId).NumberOfDropsByReasonAtAP[reason]++;
+				stats.NumberOfDropsByReasonAtAP[staId][reason]++;
 			}
 			delete chunk;
 			break;
@@ -616,10 +797,10 @@ void OnAPPacketToTransmitReceived(string context, Ptr<const Packet> packet,
 	}
 	if (staId != -1) {
 		if (isScheduled)
-			stats.get(staId).NumberOfAPScheduledPacketForNodeInNextSlot++;
+			stats.NumberOfAPScheduledPacketForNodeInNextSlot[staId]++;
 		else {
-			stats.get(staId).NumberOfAPSentPacketForNodeImmediately++;
-			stats.get(staId).APTotalTimeRemainingWhenSendingPacketInSameSlot +=
+			stats.NumberOfAPSentPacketForNodeImmediately[staId]++;
+			stats.APTotalTimeRemainingWhenSendingPacketInSameSlot[staId] +=
 					timeLeftInSlot;
 		}
 	}
@@ -632,14 +813,19 @@ void onChannelTransmission(Ptr<NetDevice> senderDevice, Ptr<Packet> packet) {
 	//cout << rpsIndex << "		" << rawGroup << "		" << slotIndex << "		" << endl;
 
 	uint64_t iSlot = slotIndex;
+	// the slots are only counted for the RPS of the configuration, not
+	// for the ones the AP plans itself
+	if (rpsIndex < 0 || rpsIndex >= (int) config.rps.rpsset.size ()
+			|| rawGroup >= (int) config.rps.rpsset[rpsIndex].GetNumberOfRawGroups ())
+		return;
 	if (rpsIndex > 0)
 		for (int r = rpsIndex - 1; r >= 0; r--)
-			for (int g = 0; g < config.rps.rpsset[r]->GetNumberOfRawGroups(); g++)
-				iSlot += config.rps.rpsset[r]->GetRawAssigmentObj(g).GetSlotNum();
+			for (int g = 0; g < config.rps.rpsset[r].GetNumberOfRawGroups(); g++)
+				iSlot += config.rps.rpsset[r].GetRawAssigmentObj(g).GetSlotNum();
 
 	if (rawGroup > 0)
 		for (int i = rawGroup - 1; i >= 0; i--)
-			iSlot += config.rps.rpsset[rpsIndex]->GetRawAssigmentObj(i).GetSlotNum();
+			iSlot += config.rps.rpsset[rpsIndex].GetRawAssigmentObj(i).GetSlotNum();
 
 	if (rpsIndex >= 0 && rawGroup >= 0 && slotIndex >= 0)
 	{
@@ -672,10 +858,37 @@ int getSTAIdFromAddress(Ipv4Address from) {
 	return staId;
 }
 
+// IPHC elides the link-local addresses, which are derived from the MAC address
+Ipv6Address getLinkLocalAddress(Ptr<Node> node, uint32_t interface) {
+	return node->GetObject<Ipv6L3Protocol>()->GetInterface(interface)->GetLinkLocalAddress().GetAddress();
+}
+
+int getSTAIdFromAddress(Ipv6Address from) {
+	int staId = -1;
+	for (uint32_t i = 0; i < staNodeInterface6.GetN(); i++) {
+		if (getLinkLocalAddress(wifiStaNode.Get(i), staNodeInterface6.GetInterfaceIndex(i)) == from) {
+			staId = i;
+			break;
+		}
+	}
+	return staId;
+}
+
+Address getServerAddress() {
+	if (config.useV6)
+		return getLinkLocalAddress(wifiApNode.Get(0), apNodeInterface6.GetInterfaceIndex(0));
+	return apNodeInterface.GetAddress(0);
+}
+
 void udpPacketReceivedAtServer(Ptr<const Packet> packet, Address from) { //works
 	//cout << "+++++++++++udpPacketReceivedAtServer" << endl;
-	int staId = getSTAIdFromAddress(
-			InetSocketAddress::ConvertFrom(from).GetIpv4());
+	int staId;
+	if (Inet6SocketAddress::IsMatchingType(from))
+		staId = getSTAIdFromAddress(
+				Inet6SocketAddress::ConvertFrom(from).GetIpv6());
+	else
+		staId = getSTAIdFromAddress(
+				InetSocketAddress::ConvertFrom(from).GetIpv4());
 	if (staId != -1)
 		nodes[staId]->OnUdpPacketReceivedAtAP(packet);
 	else
@@ -706,7 +919,7 @@ void tcpPacketDroppedAtServer(Address to, Ptr<Packet> packet,
 		DropReason reason) {
 	int staId = getSTAIdFromAddress(Ipv4Address::ConvertFrom(to));
 	if (staId != -1) {
-		stats.get(staId).NumberOfDropsByReasonAtAP[reason]++;
+		stats.NumberOfDropsByReasonAtAP[staId][reason]++;
 	}
 }
 
@@ -1011,7 +1224,7 @@ void configureUDPClients() {
 	//Application start time
 	Ptr<UniformRandomVariable> m_rv = CreateObject<UniformRandomVariable>();
 
-	UdpClientHelper myClient(apNodeInterface.GetAddress(0), 9); //address of remote node
+	UdpClientHelper myClient(getServerAddress(), 9); //address of remote node
 	myClient.SetAttribute("MaxPackets", config.maxNumberOfPackets);
 	myClient.SetAttribute("PacketSize", UintegerValue(config.payloadSize));
 	traffic_sta.clear();
@@ -1053,7 +1266,7 @@ void configureUDPClients() {
 }
 
 void configureUDPEchoClients() {
-	UdpEchoClientHelper clientHelper(apNodeInterface.GetAddress(0), 9); //address of remote node
+	UdpEchoClientHelper clientHelper(getServerAddress(), 9); //address of remote node
 	clientHelper.SetAttribute("MaxPackets", UintegerValue(4294967295u));
 	clientHelper.SetAttribute("Interval", TimeValue(MilliSeconds(config.trafficInterval)));
 	//clientHelper.SetAttribute("IntervalDeviation", TimeValue(MilliSeconds(config.trafficIntervalDeviation)));
@@ -1155,6 +1368,41 @@ void PhyStateTrace(std::string context, Time start, Time duration,
 	}
 }
 
+void printSixLowPanSavings() {
+	if (sixLowPanDatagrams == 0)
+		return;
+	// the LLC/SNAP header is the same with or without 6LoWPAN, only the IPv6 and UDP headers are compressed
+	double ipv6Size = (double) sixLowPanIpv6Bytes / sixLowPanDatagrams;
+	double compressedSize = (double) sixLowPanCompressedBytes / sixLowPanDatagrams;
+	double savedBytes = ipv6Size - compressedSize;
+	WifiMode mode = WifiMode(getWifiMode(config.DataMode));
+	double airtimeSaved = savedBytes * 8 * 1e6 / mode.GetDataRate(); //us
+	// Tx consumption of 7.2 mW, as in NodeEntry
+	double energySaved = airtimeSaved * 7.2e-3; //uJ
+	cout << "6LoWPAN datagrams sent by stations " << sixLowPanDatagrams << endl;
+	cout << "6LoWPAN mean size per packet: IPv6 " << ipv6Size
+			<< " bytes, compressed " << compressedSize << " bytes" << endl;
+	cout << "6LoWPAN bytes saved per packet " << savedBytes << endl;
+	cout << "6LoWPAN airtime saved per packet " << airtimeSaved << " us at "
+			<< mode.GetUniqueName() << endl;
+	cout << "6LoWPAN Tx energy saved per packet " << energySaved << " uJ"
+			<< endl;
+}
+
+void printRelayStatistics() {
+	Time txTime;
+	for (uint32_t i = 0; i < config.Nsta; i++)
+		txTime += timeTxArray[i];
+	double meanTxTime = txTime.GetSeconds() * 1000 / config.Nsta; //ms
+	cout << "mean station Tx time " << meanTxTime << " ms" << endl;
+	// Tx consumption of 7.2 mW, as in NodeEntry
+	cout << "mean station Tx energy " << meanTxTime * 7.2 << " uJ" << endl;
+	for (uint32_t k = 0; k < relays.size(); k++)
+		cout << "relay " << k << " forwarded " << relays[k]->GetNUplinkPackets()
+				<< " packets to the AP and " << relays[k]->GetNDownlinkPackets()
+				<< " to its stations" << endl;
+}
+
 int main(int argc, char *argv[]) {
 	 LogComponentEnable ("UdpServer", LOG_INFO);
      //LogComponentEnable ("UdpClient", LOG_INFO);
@@ -1170,6 +1418,13 @@ int main(int argc, char *argv[]) {
 
 	config.rps = configureRAW(config.rps, config.RAWConfigFile);
 	config.Nsta = config.NRawSta;
+	// the stations of a relay keep the RAW configuration of the file, the
+	// AP adds a RAW group for the relays, which get the AIDs following
+	// those of the stations
+	RPSVector relayRps = config.rps;
+	bool deployRelays = config.NRelay > 0 && config.useRelays;
+	if (deployRelays)
+		config.rps = addRelayRawGroup(config.rps, config.Nsta + 1, config.Nsta + config.NRelay);
 
 	configurePageSlice ();
 	configureTIM ();
@@ -1187,11 +1442,11 @@ int main(int argc, char *argv[]) {
 			config.visualizerPort, config.NSSFile);
 	uint32_t totalRawGroups(0);
 	for (int i = 0; i < config.rps.rpsset.size(); i++) {
-		int nRaw = config.rps.rpsset[i]->GetNumberOfRawGroups();
+		int nRaw = config.rps.rpsset[i].GetNumberOfRawGroups();
 		totalRawGroups += nRaw;
 		//cout << "Total raw groups after rps " << i << " is " << totalRawGroups << endl;
 		for (int j = 0; j < nRaw; j++) {
-			config.totalRawSlots += config.rps.rpsset[i]->GetRawAssigmentObj(j).GetSlotNum();
+			config.totalRawSlots += config.rps.rpsset[i].GetRawAssigmentObj(j).GetSlotNum();
 			//cout << "Total slots after group " << j << " is " << totalRawSlots << endl;
 		}
 
@@ -1205,6 +1460,8 @@ int main(int argc, char *argv[]) {
 
 	wifiStaNode.Create(config.Nsta);
 	wifiApNode.Create(1);
+	if (deployRelays)
+		wifiRelayNode.Create(config.NRelay);
 
 	YansWifiChannelHelper channelBuilder = YansWifiChannelHelper();
 	channelBuilder.AddPropagationLoss("ns3::LogDistancePropagationLossModel",
@@ -1250,6 +1507,27 @@ int main(int argc, char *argv[]) {
 	NetDeviceContainer staDevice;
 	staDevice = wifi.Install(phy, mac, wifiStaNode);
 
+	NetDeviceContainer relayStaDevice;
+	if (deployRelays) {
+		for (uint32_t i = 0; i < config.Nsta; i++)
+			DynamicCast<WifiNetDevice>(staDevice.Get(i))->GetMac()->SetSsid(
+					getRelaySsid(i % config.NRelay));
+		// the relays are mains powered, their radios are set up as the AP's
+		YansWifiPhyHelper relayPhy = phy;
+		relayPhy.Set("TxGain", DoubleValue(3.0));
+		relayPhy.Set("RxGain", DoubleValue(3.0));
+		relayPhy.Set("TxPowerEnd", DoubleValue(30.0));
+		relayPhy.Set("TxPowerStart", DoubleValue(30.0));
+		relayStaDevice = wifi.Install(relayPhy, mac, wifiRelayNode);
+		for (uint32_t k = 0; k < config.NRelay; k++) {
+			Mac48Address address = Mac48Address::ConvertFrom(relayStaDevice.Get(k)->GetAddress());
+			uint8_t buffer[6];
+			address.CopyTo(buffer);
+			// the AP derives the AID from the MAC address
+			NS_ASSERT(((buffer[4] & 0x1f) << 8 | buffer[5]) == config.Nsta + 1 + k);
+		}
+	}
+
 	mac.SetType ("ns3::ApWifiMac",
 	                 "Ssid", SsidValue (ssid),
 	                 "BeaconInterval", TimeValue (MicroSeconds(config.BeaconInterval)),
@@ -1269,12 +1547,40 @@ int main(int argc, char *argv[]) {
 
 	apDevice = wifi.Install(phy, mac, wifiApNode);
 
+	for (uint32_t k = 0; k < wifiRelayNode.GetN(); k++) {
+		mac.SetType ("ns3::ApWifiMac",
+		                 "Ssid", SsidValue (getRelaySsid(k)),
+		                 "BeaconInterval", TimeValue (MicroSeconds(config.BeaconInterval)),
+		                 "NRawStations", UintegerValue (config.NRawSta),
+		                 "RPSsetup", RPSVectorValue (relayRps),
+		                 "PageSliceSet", pageSliceValue (config.pageS),
+		                 "TIMSet", TIMValue (config.tim),
+		                 "BeaconGeneration", BooleanValue (false)
+		               );
+		NetDeviceContainer relayApDevice = wifi.Install(phy, mac, wifiRelayNode.Get(k));
+		Ptr<S1gRelay> relay = CreateObject<S1gRelay>();
+		relay->Install(DynamicCast<WifiNetDevice>(relayStaDevice.Get(k)),
+				DynamicCast<WifiNetDevice>(relayApDevice.Get(0)));
+		wifiRelayNode.Get(k)->AggregateObject(relay);
+		relays.push_back(relay);
+		// the relay beacons follow the beacon of the AP, so that the RAW
+		// slots of the stations of the relays are about those of the AP
+		Ptr<ApWifiMac> relayMac = DynamicCast<ApWifiMac>(relay->GetApDevice()->GetMac());
+		Simulator::Schedule(MicroSeconds(100 * (k + 1)), &startRelayBeacons, relayMac);
+	}
+
 	Config::Set(
 			"/NodeList/*/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/BE_EdcaTxopN/Queue/MaxPacketNumber",
 			UintegerValue(10));
 	Config::Set(
 			"/NodeList/*/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/BE_EdcaTxopN/Queue/MaxDelay",
 			TimeValue(NanoSeconds(6000000000000)));
+	// a relay queues the packets of all its stations
+	for (uint32_t k = 0; k < wifiRelayNode.GetN(); k++)
+		Config::Set(
+				"/NodeList/" + std::to_string(wifiRelayNode.Get(k)->GetId())
+						+ "/DeviceList/*/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/BE_EdcaTxopN/Queue/MaxPacketNumber",
+				UintegerValue(10 * config.Nsta));
 
 	std::ostringstream oss;
 	oss << "/NodeList/" << wifiApNode.Get(0)->GetId()
@@ -1297,12 +1603,30 @@ int main(int argc, char *argv[]) {
     
     MobilityHelper mobility;
     Ptr<ListPositionAllocator> position = CreateObject<ListPositionAllocator> ();
-    position->Add (Vector (-500, 0, 0));
+    if (config.NRelay > 0)
+    {
+        // large area: the stations of each relay are twice as far from the AP as the relay
+        for (uint32_t i = 0; i < config.Nsta; i++)
+            position->Add (getRelayPosition (i % config.NRelay, 2 * config.relayDistance));
+    }
+    else
+        position->Add (Vector (-500, 0, 0));
     mobility.SetPositionAllocator (position);
     mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
     mobility.Install(wifiStaNode);
     PrintPositions (wifiStaNode);
 
+    if (deployRelays)
+    {
+        MobilityHelper mobilityRelay;
+        Ptr<ListPositionAllocator> relayPosition = CreateObject<ListPositionAllocator> ();
+        for (uint32_t k = 0; k < config.NRelay; k++)
+            relayPosition->Add (getRelayPosition (k, config.relayDistance));
+        mobilityRelay.SetPositionAllocator (relayPosition);
+        mobilityRelay.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobilityRelay.Install(wifiRelayNode);
+    }
+
 
    /*
 	MobilityHelper mobilityAp;
@@ -1357,16 +1681,26 @@ int main(int argc, char *argv[]) {
 	 */
 
 	/* Internet stack*/
+	if (config.sixLowPan) {
+		config.useV6 = true;
+		// the neighbor cache is populated below
+		Config::SetDefault("ns3::Icmpv6L4Protocol::DAD", BooleanValue(false));
+	}
 	InternetStackHelper stack;
 	stack.Install(wifiApNode);
 	stack.Install(wifiStaNode);
+	stack.Install(wifiRelayNode);
 
-	Ipv4AddressHelper address;
+	if (config.sixLowPan) {
+		configureSixLowPan(staDevice);
+	} else {
+		Ipv4AddressHelper address;
 
-	address.SetBase("192.168.0.0", "255.255.0.0");
+		address.SetBase("192.168.0.0", "255.255.0.0");
 
-	staNodeInterface = address.Assign(staDevice);
-	apNodeInterface = address.Assign(apDevice);
+		staNodeInterface = address.Assign(staDevice);
+		apNodeInterface = address.Assign(apDevice);
+	}
 
 	//trace association
 	for (uint16_t kk = 0; kk < config.Nsta; kk++) {
@@ -1387,10 +1721,15 @@ int main(int argc, char *argv[]) {
 		assoc_vector.push_back(m_assocrecord);
 	}
 
-	std::cout << "Populating routing tables..." << std::endl;
-	Ipv4GlobalRoutingHelper::PopulateRoutingTables();
-	std::cout << "Populating ARP cache..." << std::endl;
-	PopulateArpCache();
+	if (config.sixLowPan) {
+		std::cout << "Populating neighbor cache..." << std::endl;
+		PopulateNeighborCache();
+	} else {
+		std::cout << "Populating routing tables..." << std::endl;
+		Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+		std::cout << "Populating ARP cache..." << std::endl;
+		PopulateArpCache();
+	}
 
 	// configure tracing for associations & other metrics
 	std::cout << "Configuring trace sinks for nodes..." << std::endl;
@@ -1442,9 +1781,9 @@ int main(int argc, char *argv[]) {
 	if (config.rps.rpsset.size() > 0)
 		for (uint32_t i = 0; i < config.rps.rpsset.size(); i++)
 			for (uint32_t j = 0;
-					j < config.rps.rpsset[i]->GetNumberOfRawGroups(); j++)
+					j < config.rps.rpsset[i].GetNumberOfRawGroups(); j++)
 				eventManager.onRawConfig(i, j,
-						config.rps.rpsset[i]->GetRawAssigmentObj(j));
+						config.rps.rpsset[i].GetRawAssigmentObj(j));
 
 	for (uint32_t i = 0; i < config.Nsta; i++)
 		eventManager.onSTANodeCreated(*nodes[i]);
@@ -1452,6 +1791,8 @@ int main(int argc, char *argv[]) {
 	eventManager.onAPNodeCreated(apposition.x, apposition.y);
 	eventManager.onStatisticsHeader();
 
+	if (config.StatisticsDatabase != "")
+		openStatisticsDatabase();
 	sendStatistics(true);
 
 	Simulator::Stop(Seconds(config.simulationTime + config.CoolDownPeriod)); // allow up to a minute after the client & server apps are finished to process the queue
@@ -1461,21 +1802,22 @@ int main(int argc, char *argv[]) {
 	int pay = 0, totalSuccessfulPackets = 0, totalSentPackets = 0, totalPacketsEchoed = 0;
 	for (int i = 0; i < config.Nsta; i++)
 	{
-		totalSuccessfulPackets += stats.get(i).NumberOfSuccessfulPackets;
-		totalSentPackets += stats.get(i).NumberOfSentPackets;
-		totalPacketsEchoed += stats.get(i).NumberOfSuccessfulRoundtripPackets;
-		pay += stats.get(i).TotalPacketPayloadSize;
-		cout << i << " sent: " << stats.get(i).NumberOfSentPackets
-				<< " ; delivered: " << stats.get(i).NumberOfSuccessfulPackets
-				<< " ; echoed: " << stats.get(i).NumberOfSuccessfulRoundtripPackets
+		totalSuccessfulPackets += stats.NumberOfSuccessfulPackets[i];
+		totalSentPackets += stats.NumberOfSentPackets[i];
+		totalPacketsEchoed += stats.NumberOfSuccessfulRoundtripPackets[i];
+		pay += stats.TotalPacketPayloadSize[i];
+		cout << i << " sent: " << stats.NumberOfSentPackets[i]
+				<< " ; delivered: " << stats.NumberOfSuccessfulPackets[i]
+				<< " ; echoed: " << stats.NumberOfSuccessfulRoundtripPackets[i]
 				<< "; packetloss: "
-				<< stats.get(i).GetPacketLoss(config.trafficType) << endl;
+				<< stats.GetPacketLoss(i, config.trafficType) << endl;
 	}
 
 	if (config.trafficType == "udp")
 	{
 		double throughput = 0;
-		uint32_t totalPacketsThrough =
+		// the server is only set up once stations have associated
+		uint32_t totalPacketsThrough = serverApp.GetN() == 0 ? 0 :
 				DynamicCast<UdpServer>(serverApp.Get(0))->GetReceived();
 		throughput = totalPacketsThrough * config.payloadSize * 8
 				/ (config.simulationTime * 1000000.0);
@@ -1511,6 +1853,14 @@ int main(int argc, char *argv[]) {
 	}
 	cout << "total packet loss % "
 			<< 100 - 100. * totalPacketsEchoed / totalSentPackets << endl;
+	if (config.sixLowPan)
+		printSixLowPanSavings();
+	if (config.NRelay > 0)
+		printRelayStatistics();
+#ifdef STATS_HAS_SQLITE3
+	if (statisticsDatabase)
+		statisticsDatabase->Close();
+#endif
 	Simulator::Destroy();
 
     ofstream risultati;
@@ -1525,13 +1875,13 @@ int main(int argc, char *argv[]) {
         
         risultati << i << spazio << dist[i] << spazio << timeRxArray[i].GetSeconds() << ",(" << timeRxNotAssociated[i].GetSeconds() << ")," << timeIdleArray[i].GetSeconds() << ",(" << timeIdleNotAssociated[i].GetSeconds() << ")," << timeTxArray[i].GetSeconds() << ",(" << timeTxNotAssociated[i].GetSeconds() << ")," << timeSleepArray[i].GetSeconds() << ",(" << timeSleepNotAssociated[i].GetSeconds() << ")," << timeCollisionArray[i].GetSeconds() << ",(" << timeCollisionNotAssociated[i].GetSeconds() << ")" << std::endl;
         /*
-         cout << "================== Sleep " << stats.get(i).TotalSleepTime.GetSeconds() << endl;
-         cout << "================== Tx " << stats.get(i).TotalTxTime.GetSeconds() << endl;
-         cout << "================== Rx " << stats.get(i).TotalRxTime.GetSeconds() << endl;
-         cout << "+++++++++++++++++++IDLE " << stats.get(i).TotalIdleTime.GetSeconds() << endl;
-         cout << "ooooooooooooooooooo TOTENERGY " <<  stats.get(i).GetTotalEnergyConsumption() << " mW" << endl;
-         cout << "Rx+Idle ENERGY " <<  stats.get(i).EnergyRxIdle << " mW" << endl;
-         cout << "Tx ENERGY " <<  stats.get(i).EnergyTx << " mW" << endl;*/
+         cout << "================== Sleep " << stats.TotalSleepTime[i].GetSeconds() << endl;
+         cout << "================== Tx " << stats.TotalTxTime[i].GetSeconds() << endl;
+         cout << "================== Rx " << stats.TotalRxTime[i].GetSeconds() << endl;
+         cout << "+++++++++++++++++++IDLE " << stats.TotalIdleTime[i].GetSeconds() << endl;
+         cout << "ooooooooooooooooooo TOTENERGY " <<  stats.GetTotalEnergyConsumption(i) << " mW" << endl;
+         cout << "Rx+Idle ENERGY " <<  stats.EnergyRxIdle[i] << " mW" << endl;
+         cout << "Tx ENERGY " <<  stats.EnergyTx[i] << " mW" << endl;*/
         
         i++;
     }
@@ -7,6 +7,8 @@
 #include "ns3/mobility-module.h"
 #include "ns3/ipv4-global-routing-helper.h"
 #include "ns3/internet-module.h"
+#include "ns3/sixlowpan-module.h"
+#include "ns3/stats-module.h"
 #include <iostream>
 #include <fstream>
 #include <stdio.h>
@@ -38,6 +40,8 @@ using namespace ns3;
 
 NodeContainer wifiStaNode;
 NodeContainer wifiApNode;
+NodeContainer wifiRelayNode;
+vector<Ptr<S1gRelay> > relays;
 
 Ipv4InterfaceContainer staNodeInterface;
 Ipv6InterfaceContainer staNodeInterface6;
@@ -47,6 +51,11 @@ Ipv6InterfaceContainer apNodeInterface6;
 
 NetDeviceContainer apDevice;
 
+// IPv6 datagrams sent by the stations over 6LoWPAN, and their size before and after compression
+uint32_t sixLowPanDatagrams = 0;
+uint64_t sixLowPanIpv6Bytes = 0;
+uint64_t sixLowPanCompressedBytes = 0;
+
 uint16_t currentRps;
 uint16_t currentRawGroup;
 uint16_t currentRawSlot;
@@ -56,6 +65,11 @@ vector<NodeEntry*> nodes;
 vector<long> transmissionsPerTIMGroupAndSlotFromAPSinceLastInterval;
 vector<long> transmissionsPerTIMGroupAndSlotFromSTASinceLastInterval;
 
+#ifdef STATS_HAS_SQLITE3
+// SQLite file receiving the node statistics every sampling interval
+Ptr<SqliteDataOutput> statisticsDatabase;
+#endif
+
 ApplicationContainer serverApp;
 uint32_t AppStartTime = 0;
 uint32_t ApStopTime = 0;
@@ -102,6 +116,8 @@ int getSTAIdFromAddress(Ipv4Address from);
 int main(int argc, char** argv);
 
 void sendStatistics(bool schedule);
+void openStatisticsDatabase();
+void writeStatisticsToDatabase();
 
 void configurePageSlice (void);
 void configureTIM (void);
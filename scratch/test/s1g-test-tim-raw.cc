@@ -139,40 +139,39 @@ RPSVector configureRAW(RPSVector rpslist, string RAWConfigFile) {
 		int totalNumSta = 0;
 		for (uint16_t kk = 0; kk < NRPS; kk++) // number of beacons covering all raw groups
 		{
-			RPS *m_rps = new RPS;
+			RPS m_rps;
 			myfile >> NRAWPERBEACON;
 			ngroup = NRAWPERBEACON;
 			for (uint16_t i = 0; i < NRAWPERBEACON; i++) // raw groups in one beacon
 			{
 				//RPS *m_rps = new RPS;
-				RPS::RawAssignment *m_raw = new RPS::RawAssignment;
+				RPS::RawAssignment m_raw;
 
 				myfile >> Value;
-				m_raw->SetRawControl(Value);  //support paged STA or not
+				m_raw.SetRawControl(Value);  //support paged STA or not
 				myfile >> Value;
-				m_raw->SetSlotCrossBoundary(Value);
+				m_raw.SetSlotCrossBoundary(Value);
 				myfile >> Value;
-				m_raw->SetSlotFormat(Value);
+				m_raw.SetSlotFormat(Value);
 				myfile >> Value;
-				m_raw->SetSlotDurationCount(Value);
+				m_raw.SetSlotDurationCount(Value);
 				myfile >> Value;
 				nslot = Value;
-				m_raw->SetSlotNum(Value);
+				m_raw.SetSlotNum(Value);
 				myfile >> page;
 				myfile >> aid_start;
 				myfile >> aid_end;
 				rawinfo = (aid_end << 13) | (aid_start << 2) | page;
-				m_raw->SetRawGroup(rawinfo);
+				m_raw.SetRawGroup(rawinfo);
 				totalNumSta += aid_end - aid_start + 1;
-				m_rps->SetRawAssignment(*m_raw);
-				delete m_raw;
+				m_rps.SetRawAssignment(m_raw);
 			}
 			rpslist.rpsset.push_back(m_rps);
 			//config.nRawGroupsPerRpsList.push_back(NRAWPERBEACON);
 		}
 		myfile.close();
 		config.NRawSta = totalNumSta;
-				/*rpslist.rpsset[rpslist.rpsset.size() - 1]->GetRawAssigmentObj(
+				/*rpslist.rpsset[rpslist.rpsset.size() - 1].GetRawAssigmentObj(
 						NRAWPERBEACON - 1).GetRawGroupAIDEnd();*/
 	} else
 		cout << "Unable to open RAW configuration file \n";
@@ -249,11 +248,11 @@ void checkRawAndTimConfiguration (void)
 	for (uint32_t j = 0; j < config.rps.rpsset.size(); j++)
 	{
 		uint32_t totalRawTime = 0;
-		for (uint32_t i = 0; i < config.rps.rpsset[j]->GetNumberOfRawGroups(); i++)
+		for (uint32_t i = 0; i < config.rps.rpsset[j].GetNumberOfRawGroups(); i++)
 		{
-			totalRawTime += (120 * config.rps.rpsset[j]->GetRawAssigmentObj(i).GetSlotDurationCount() + 500) * config.rps.rpsset[j]->GetRawAssigmentObj(i).GetSlotNum();
-			auto aidStart = config.rps.rpsset[j]->GetRawAssigmentObj(i).GetRawGroupAIDStart();
-			auto aidEnd = config.rps.rpsset[j]->GetRawAssigmentObj(i).GetRawGroupAIDEnd();
+			totalRawTime += (120 * config.rps.rpsset[j].GetRawAssigmentObj(i).GetSlotDurationCount() + 500) * config.rps.rpsset[j].GetRawAssigmentObj(i).GetSlotNum();
+			auto aidStart = config.rps.rpsset[j].GetRawAssigmentObj(i).GetRawGroupAIDStart();
+			auto aidEnd = config.rps.rpsset[j].GetRawAssigmentObj(i).GetRawGroupAIDEnd();
 			configIsCorrect = check (aidStart, j) && check (aidEnd, j);
 			// AIDs in each RPS must comply with TIM in the following way:
 			// TIM0: 1-63; TIM1: 64-127; TIM2: 128-191; ...; TIM32: 1983-2047
@@ -313,16 +312,16 @@ void onSTAAssociated(int i) {
 			<< nodes[i]->aId << endl;
 
 	for (int k = 0; k < config.rps.rpsset.size(); k++) {
-		for (int j = 0; j < config.rps.rpsset[k]->GetNumberOfRawGroups(); j++) {
-			if (config.rps.rpsset[k]->GetRawAssigmentObj(j).GetRawGroupAIDStart()
+		for (int j = 0; j < config.rps.rpsset[k].GetNumberOfRawGroups(); j++) {
+			if (config.rps.rpsset[k].GetRawAssigmentObj(j).GetRawGroupAIDStart()
 					<= i + 1
 					&& i + 1
-							<= config.rps.rpsset[k]->GetRawAssigmentObj(j).GetRawGroupAIDEnd()) {
+							<= config.rps.rpsset[k].GetRawAssigmentObj(j).GetRawGroupAIDEnd()) {
 				nodes[i]->rpsIndex = k + 1;
 				nodes[i]->rawGroupNumber = j + 1;
 				nodes[i]->rawSlotIndex =
 						nodes[i]->aId
-								% config.rps.rpsset[k]->GetRawAssigmentObj(j).GetSlotNum()
+								% config.rps.rpsset[k].GetRawAssigmentObj(j).GetSlotNum()
 								+ 1;
 				/*cout << "Node " << i << " with AID " << (int)nodes[i]->aId << " belongs to " << (int)nodes[i]->rawSlotIndex << " slot of RAW group "
 				 << (int)nodes[i]->rawGroupNumber << " within the " << (int)nodes[i]->rpsIndex << " RPS." << endl;
@@ -632,12 +631,12 @@ void onChannelTransmission(Ptr<NetDevice> senderDevice, Ptr<Packet> packet) {
 	uint64_t iSlot = slotIndex;
 	if (rpsIndex > 0)
 		for (int r = rpsIndex - 1; r >= 0; r--)
-			for (int g = 0; g < config.rps.rpsset[r]->GetNumberOfRawGroups(); g++)
-				iSlot += config.rps.rpsset[r]->GetRawAssigmentObj(g).GetSlotNum();
+			for (int g = 0; g < config.rps.rpsset[r].GetNumberOfRawGroups(); g++)
+				iSlot += config.rps.rpsset[r].GetRawAssigmentObj(g).GetSlotNum();
 
 	if (rawGroup > 0)
 		for (int i = rawGroup - 1; i >= 0; i--)
-			iSlot += config.rps.rpsset[rpsIndex]->GetRawAssigmentObj(i).GetSlotNum();
+			iSlot += config.rps.rpsset[rpsIndex].GetRawAssigmentObj(i).GetSlotNum();
 
 	if (rpsIndex >= 0 && rawGroup >= 0 && slotIndex >= 0)
 	{
@@ -1184,11 +1183,11 @@ int main(int argc, char *argv[]) {
 			config.visualizerPort, config.NSSFile);
 	uint32_t totalRawGroups(0);
 	for (int i = 0; i < config.rps.rpsset.size(); i++) {
-		int nRaw = config.rps.rpsset[i]->GetNumberOfRawGroups();
+		int nRaw = config.rps.rpsset[i].GetNumberOfRawGroups();
 		totalRawGroups += nRaw;
 		//cout << "Total raw groups after rps " << i << " is " << totalRawGroups << endl;
 		for (int j = 0; j < nRaw; j++) {
-			config.totalRawSlots += config.rps.rpsset[i]->GetRawAssigmentObj(j).GetSlotNum();
+			config.totalRawSlots += config.rps.rpsset[i].GetRawAssigmentObj(j).GetSlotNum();
 			//cout << "Total slots after group " << j << " is " << totalRawSlots << endl;
 		}
 
@@ -1440,9 +1439,9 @@ int main(int argc, char *argv[]) {
 	if (config.rps.rpsset.size() > 0)
 		for (uint32_t i = 0; i < config.rps.rpsset.size(); i++)
 			for (uint32_t j = 0;
-					j < config.rps.rpsset[i]->GetNumberOfRawGroups(); j++)
+					j < config.rps.rpsset[i].GetNumberOfRawGroups(); j++)
 				eventManager.onRawConfig(i, j,
-						config.rps.rpsset[i]->GetRawAssigmentObj(j));
+						config.rps.rpsset[i].GetRawAssigmentObj(j));
 
 	for (uint32_t i = 0; i < config.Nsta; i++)
 		eventManager.onSTANodeCreated(*nodes[i]);
@@ -0,0 +1,166 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Scalability benchmark for the buildings module: places a large number of
+ * stations over a grid of buildings, then measures the time needed to
+ * locate every station (BuildingsHelper::MakeMobilityModelConsistent) and
+ * to evaluate the propagation loss (with shadowing) AP <-> every station
+ * and from a set of stations towards every other station, the way a
+ * shared wireless channel does.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <ns3/buildings-helper.h>
+#include <ns3/building-list.h>
+#include <ns3/hybrid-buildings-propagation-loss-model.h>
+#include <ns3/oh-buildings-propagation-loss-model.h>
+
+#include <iostream>
+
+using namespace ns3;
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nSta = 5000;
+  uint32_t nBuildingsX = 10;
+  uint32_t nBuildingsY = 10;
+  double buildingSize = 50.0;
+  double streetWidth = 10.0;
+  uint32_t rounds = 20;
+  uint32_t nSenders = 50;
+  std::string model = "hybrid";
+
+  CommandLine cmd;
+  cmd.AddValue ("nSta", "Number of stations", nSta);
+  cmd.AddValue ("nBuildingsX", "Number of buildings along x", nBuildingsX);
+  cmd.AddValue ("nBuildingsY", "Number of buildings along y", nBuildingsY);
+  cmd.AddValue ("buildingSize", "Side of each building [m]", buildingSize);
+  cmd.AddValue ("streetWidth", "Distance between buildings [m]", streetWidth);
+  cmd.AddValue ("rounds", "Number of AP <-> all stations evaluations", rounds);
+  cmd.AddValue ("nSenders", "Number of stations transmitting to all other stations", nSenders);
+  cmd.AddValue ("model", "Propagation loss model (hybrid or oh)", model);
+  cmd.Parse (argc, argv);
+
+  RngSeedManager::SetSeed (1);
+
+  double pitch = buildingSize + streetWidth;
+  for (uint32_t i = 0; i < nBuildingsX; i++)
+    {
+      for (uint32_t j = 0; j < nBuildingsY; j++)
+        {
+          Ptr<Building> b = CreateObject<Building> ();
+          b->SetBoundaries (Box (i * pitch, i * pitch + buildingSize,
+                                 j * pitch, j * pitch + buildingSize,
+                                 0.0, 9.0));
+          b->SetBuildingType (Building::Office);
+          b->SetExtWallsType (Building::ConcreteWithWindows);
+          b->SetNFloors (3);
+          b->SetNRoomsX (4);
+          b->SetNRoomsY (4);
+        }
+    }
+
+  NodeContainer ap;
+  ap.Create (1);
+  NodeContainer stas;
+  stas.Create (nSta);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  Ptr<ListPositionAllocator> apPosition = CreateObject<ListPositionAllocator> ();
+  apPosition->Add (Vector (nBuildingsX * pitch / 2, nBuildingsY * pitch / 2, 15.0));
+  mobility.SetPositionAllocator (apPosition);
+  mobility.Install (ap);
+  std::ostringstream xMax, yMax;
+  xMax << "ns3::UniformRandomVariable[Min=0.0|Max=" << nBuildingsX * pitch << "]";
+  yMax << "ns3::UniformRandomVariable[Min=0.0|Max=" << nBuildingsY * pitch << "]";
+  mobility.SetPositionAllocator ("ns3::RandomBoxPositionAllocator",
+                                 "X", StringValue (xMax.str ()),
+                                 "Y", StringValue (yMax.str ()),
+                                 "Z", StringValue ("ns3::UniformRandomVariable[Min=1.0|Max=8.0]"));
+  mobility.Install (stas);
+  BuildingsHelper::Install (ap);
+  BuildingsHelper::Install (stas);
+
+  Ptr<BuildingsPropagationLossModel> loss;
+  if (model == "oh")
+    {
+      loss = CreateObject<OhBuildingsPropagationLossModel> ();
+    }
+  else
+    {
+      loss = CreateObject<HybridBuildingsPropagationLossModel> ();
+    }
+  loss->AssignStreams (1);
+
+  SystemWallClockMs clock;
+
+  clock.Start ();
+  BuildingsHelper::MakeMobilityModelConsistent ();
+  int64_t consistentMs = clock.End ();
+
+  uint32_t indoor = 0;
+  for (uint32_t i = 0; i < nSta; i++)
+    {
+      if (stas.Get (i)->GetObject<MobilityBuildingInfo> ()->IsIndoor ())
+        {
+          indoor++;
+        }
+    }
+
+  Ptr<MobilityModel> apMm = ap.Get (0)->GetObject<MobilityModel> ();
+  double sum = 0.0;
+  clock.Start ();
+  for (uint32_t r = 0; r < rounds; r++)
+    {
+      for (uint32_t i = 0; i < nSta; i++)
+        {
+          Ptr<MobilityModel> staMm = stas.Get (i)->GetObject<MobilityModel> ();
+          sum += loss->CalcRxPower (0.0, apMm, staMm);
+          sum += loss->CalcRxPower (0.0, staMm, apMm);
+        }
+    }
+  int64_t apMs = clock.End ();
+
+  clock.Start ();
+  for (uint32_t s = 0; s < nSenders && s < nSta; s++)
+    {
+      Ptr<MobilityModel> txMm = stas.Get (s)->GetObject<MobilityModel> ();
+      for (uint32_t i = 0; i < nSta; i++)
+        {
+          if (i != s)
+            {
+              sum += loss->CalcRxPower (0.0, txMm, stas.Get (i)->GetObject<MobilityModel> ());
+            }
+        }
+    }
+  int64_t staMs = clock.End ();
+
+  std::cout << "stations " << nSta << " (" << indoor << " indoor)"
+            << " buildings " << BuildingList::GetNBuildings () << std::endl
+            << "MakeMobilityModelConsistent " << consistentMs << " ms" << std::endl
+            << "AP <-> stations (" << 2 * rounds * nSta << " evaluations) " << apMs << " ms" << std::endl
+            << "stations -> stations (" << nSenders * (nSta - 1) << " evaluations) " << staMs << " ms" << std::endl
+            << "checksum " << sum << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
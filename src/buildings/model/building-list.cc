@@ -27,6 +27,8 @@
 #include "ns3/assert.h"
 #include "building-list.h"
 #include "building.h"
+#include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
@@ -47,6 +49,8 @@ public:
   BuildingList::Iterator End (void) const;
   Ptr<Building> GetBuilding (uint32_t n);
   uint32_t GetNBuildings (void);
+  void GetBuildingsAt (const Vector &position, std::vector<Ptr<Building> > &buildings);
+  void NotifyBoundariesChanged (void);
 
   static Ptr<BuildingListPriv> Get (void);
 
@@ -54,7 +58,21 @@ private:
   virtual void DoDispose (void);
   static Ptr<BuildingListPriv> *DoGet (void);
   static void Delete (void);
+  void BuildGrid (void);
+  uint32_t GetCellX (double x) const;
+  uint32_t GetCellY (double y) const;
   std::vector<Ptr<Building> > m_buildings;
+
+  /// the spatial index is up to date
+  bool m_gridValid;
+  double m_gridXMin;
+  double m_gridYMin;
+  double m_cellWidth;
+  double m_cellHeight;
+  uint32_t m_nCellsX;
+  uint32_t m_nCellsY;
+  /// building indices overlapping each cell, row by row
+  std::vector<std::vector<uint32_t> > m_grid;
 };
 
 NS_OBJECT_ENSURE_REGISTERED (BuildingListPriv);
@@ -100,6 +118,7 @@ BuildingListPriv::Delete (void)
 
 
 BuildingListPriv::BuildingListPriv ()
+  : m_gridValid (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -118,6 +137,8 @@ BuildingListPriv::DoDispose (void)
       *i = 0;
     }
   m_buildings.erase (m_buildings.begin (), m_buildings.end ());
+  m_grid.clear ();
+  m_gridValid = false;
   Object::DoDispose ();
 }
 
@@ -127,6 +148,7 @@ BuildingListPriv::Add (Ptr<Building> building)
 {
   uint32_t index = m_buildings.size ();
   m_buildings.push_back (building);
+  m_gridValid = false;
   Simulator::ScheduleWithContext (index, TimeStep (0), &Building::Initialize, building);
   return index;
 
@@ -155,6 +177,94 @@ BuildingListPriv::GetBuilding (uint32_t n)
   return m_buildings.at (n);
 }
 
+void
+BuildingListPriv::NotifyBoundariesChanged (void)
+{
+  m_gridValid = false;
+}
+
+uint32_t
+BuildingListPriv::GetCellX (double x) const
+{
+  double cell = std::floor ((x - m_gridXMin) / m_cellWidth);
+  return static_cast<uint32_t> (std::min (std::max (cell, 0.0), m_nCellsX - 1.0));
+}
+
+uint32_t
+BuildingListPriv::GetCellY (double y) const
+{
+  double cell = std::floor ((y - m_gridYMin) / m_cellHeight);
+  return static_cast<uint32_t> (std::min (std::max (cell, 0.0), m_nCellsY - 1.0));
+}
+
+void
+BuildingListPriv::BuildGrid (void)
+{
+  NS_LOG_FUNCTION (this << m_buildings.size ());
+  m_grid.clear ();
+  m_gridValid = true;
+  if (m_buildings.empty ())
+    {
+      return;
+    }
+  Box bounds = m_buildings[0]->GetBoundaries ();
+  double xMax = bounds.xMax;
+  double yMax = bounds.yMax;
+  m_gridXMin = bounds.xMin;
+  m_gridYMin = bounds.yMin;
+  for (std::vector<Ptr<Building> >::const_iterator i = m_buildings.begin ();
+       i != m_buildings.end (); i++)
+    {
+      bounds = (*i)->GetBoundaries ();
+      m_gridXMin = std::min (m_gridXMin, bounds.xMin);
+      m_gridYMin = std::min (m_gridYMin, bounds.yMin);
+      xMax = std::max (xMax, bounds.xMax);
+      yMax = std::max (yMax, bounds.yMax);
+    }
+  // about one building per cell
+  uint32_t n = static_cast<uint32_t> (std::ceil (std::sqrt (static_cast<double> (m_buildings.size ()))));
+  m_nCellsX = n;
+  m_nCellsY = n;
+  m_cellWidth = std::max ((xMax - m_gridXMin) / n, 1e-9);
+  m_cellHeight = std::max ((yMax - m_gridYMin) / n, 1e-9);
+  m_grid.resize (m_nCellsX * m_nCellsY);
+  for (uint32_t index = 0; index < m_buildings.size (); index++)
+    {
+      bounds = m_buildings[index]->GetBoundaries ();
+      uint32_t xLast = GetCellX (bounds.xMax);
+      uint32_t yLast = GetCellY (bounds.yMax);
+      for (uint32_t y = GetCellY (bounds.yMin); y <= yLast; y++)
+        {
+          for (uint32_t x = GetCellX (bounds.xMin); x <= xLast; x++)
+            {
+              m_grid[y * m_nCellsX + x].push_back (index);
+            }
+        }
+    }
+}
+
+void
+BuildingListPriv::GetBuildingsAt (const Vector &position, std::vector<Ptr<Building> > &buildings)
+{
+  buildings.clear ();
+  if (!m_gridValid)
+    {
+      BuildGrid ();
+    }
+  if (m_grid.empty ())
+    {
+      return;
+    }
+  const std::vector<uint32_t> &cell = m_grid[GetCellY (position.y) * m_nCellsX + GetCellX (position.x)];
+  for (std::vector<uint32_t>::const_iterator i = cell.begin (); i != cell.end (); i++)
+    {
+      if (m_buildings[*i]->IsInside (position))
+        {
+          buildings.push_back (m_buildings[*i]);
+        }
+    }
+}
+
 }
 
 /**
@@ -189,5 +299,15 @@ BuildingList::GetNBuildings (void)
 {
   return BuildingListPriv::Get ()->GetNBuildings ();
 }
+void
+BuildingList::GetBuildingsAt (const Vector &position, std::vector<Ptr<Building> > &buildings)
+{
+  BuildingListPriv::Get ()->GetBuildingsAt (position, buildings);
+}
+void
+BuildingList::NotifyBoundariesChanged (void)
+{
+  BuildingListPriv::Get ()->NotifyBoundariesChanged ();
+}
 
 } // namespace ns3
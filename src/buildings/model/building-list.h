@@ -25,6 +25,7 @@
 
 #include <vector>
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
@@ -62,6 +63,21 @@ public:
    * \returns the number of buildings currently in the list.
    */
   static uint32_t GetNBuildings (void);
+  /**
+   * \param position the position to look up.
+   * \param buildings filled with the buildings which contain the
+   *        position, in index order.
+   *
+   * The lookup goes through a uniform grid over the ground plan of all
+   * buildings, which is rebuilt on demand whenever a building is added
+   * or its boundaries change.
+   */
+  static void GetBuildingsAt (const Vector &position, std::vector<Ptr<Building> > &buildings);
+  /**
+   * Invalidate the spatial index of the buildings. This method is called
+   * automatically from Building::SetBoundaries.
+   */
+  static void NotifyBoundariesChanged (void);
 };
 
 } // namespace ns3
@@ -26,6 +26,7 @@
 #include "ns3/double.h"
 #include "ns3/pointer.h"
 #include <cmath>
+#include <algorithm>
 #include "buildings-propagation-loss-model.h"
 #include <ns3/mobility-building-info.h>
 #include "ns3/enum.h"
@@ -37,28 +38,6 @@ NS_LOG_COMPONENT_DEFINE ("BuildingsPropagationLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED (BuildingsPropagationLossModel);
 
-BuildingsPropagationLossModel::ShadowingLoss::ShadowingLoss ()
-{
-}
-
-BuildingsPropagationLossModel::ShadowingLoss::ShadowingLoss (double shadowingValue, Ptr<MobilityModel> receiver)
-  : m_shadowingValue (shadowingValue), m_receiver (receiver)
-{
-  NS_LOG_INFO (this << " New Shadowing value " << m_shadowingValue);
-}
-
-double
-BuildingsPropagationLossModel::ShadowingLoss::GetLoss () const
-{
-  return (m_shadowingValue);
-}
-
-Ptr<MobilityModel>
-BuildingsPropagationLossModel::ShadowingLoss::GetReceiver () const
-{
-  return m_receiver;
-}
-
 TypeId
 BuildingsPropagationLossModel::GetTypeId (void)
 {
@@ -100,6 +79,16 @@ BuildingsPropagationLossModel::BuildingsPropagationLossModel ()
   m_randVariable = CreateObject<NormalRandomVariable> ();
 }
 
+void
+BuildingsPropagationLossModel::DoDispose (void)
+{
+  m_shadowingIndexes.clear ();
+  m_shadowingTable.clear ();
+  m_lastTx = 0;
+  m_lastTxInfo = 0;
+  PropagationLossModel::DoDispose ();
+}
+
 double
 BuildingsPropagationLossModel::ExternalWallLoss (Ptr<MobilityBuildingInfo> a) const
 {
@@ -149,39 +138,75 @@ double
 BuildingsPropagationLossModel::GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityModel> b)
 const
 {
-    Ptr<MobilityBuildingInfo> a1 = a->GetObject <MobilityBuildingInfo> ();
-    Ptr<MobilityBuildingInfo> b1 = b->GetObject <MobilityBuildingInfo> ();
-    NS_ASSERT_MSG ((a1 != 0) && (b1 != 0), "BuildingsPropagationLossModel only works with MobilityBuildingInfo");
-  
-  std::map<Ptr<MobilityModel>,  std::map<Ptr<MobilityModel>, ShadowingLoss> >::iterator ait = m_shadowingLossMap.find (a);
-  if (ait != m_shadowingLossMap.end ())
+  Ptr<MobilityBuildingInfo> a1 = a->GetObject <MobilityBuildingInfo> ();
+  Ptr<MobilityBuildingInfo> b1 = b->GetObject <MobilityBuildingInfo> ();
+  NS_ASSERT_MSG ((a1 != 0) && (b1 != 0), "BuildingsPropagationLossModel only works with MobilityBuildingInfo");
+  return GetShadowing (a1, b1);
+}
+
+double
+BuildingsPropagationLossModel::GetShadowing (Ptr<MobilityBuildingInfo> a, Ptr<MobilityBuildingInfo> b)
+const
+{
+  uint32_t aIndex = GetShadowingIndex (a);
+  uint32_t bIndex = GetShadowingIndex (b);
+  std::vector<ShadowingEntry> &row = m_shadowingTable[aIndex];
+
+  std::vector<ShadowingEntry>::iterator it = std::lower_bound (row.begin (), row.end (), bIndex,
+                                                               &BuildingsPropagationLossModel::ReceiverLess);
+  if (it != row.end () && it->receiver == bIndex)
     {
-      std::map<Ptr<MobilityModel>, ShadowingLoss>::iterator bit = ait->second.find (b);
-      if (bit != ait->second.end ())
-        {
-          return (bit->second.GetLoss ());
-        }
-      else
-        {
-          double sigma = EvaluateSigma (a1, b1);
-          // side effect: will create new entry          
-          // sigma is standard deviation, not variance
-          double shadowingValue = m_randVariable->GetValue (0.0, (sigma*sigma));
-          ait->second[b] = ShadowingLoss (shadowingValue, b);          
-          return (ait->second[b].GetLoss ());
-        }
+      return it->loss;
     }
-  else
+
+  double sigma = EvaluateSigma (a, b);
+  // side effect: will create new entry
+  // sigma is standard deviation, not variance
+  ShadowingEntry entry;
+  entry.receiver = bIndex;
+  entry.loss = m_randVariable->GetValue (0.0, (sigma*sigma));
+  NS_LOG_INFO (this << " New Shadowing value " << entry.loss);
+  row.insert (it, entry);
+  return entry.loss;
+}
+
+uint32_t
+BuildingsPropagationLossModel::GetShadowingIndex (Ptr<MobilityBuildingInfo> info) const
+{
+  std::map<Ptr<MobilityBuildingInfo>, uint32_t>::const_iterator it = m_shadowingIndexes.find (info);
+  if (it != m_shadowingIndexes.end ())
     {
-      double sigma = EvaluateSigma (a1, b1);
-      // side effect: will create new entries in both maps
-      // sigma is standard deviation, not variance
-      double shadowingValue = m_randVariable->GetValue (0.0, (sigma*sigma));
-      m_shadowingLossMap[a][b] = ShadowingLoss (shadowingValue, b);  
-      return (m_shadowingLossMap[a][b].GetLoss ());       
+      return it->second;
     }
+  uint32_t index = m_shadowingTable.size ();
+  m_shadowingIndexes[info] = index;
+  m_shadowingTable.resize (index + 1);
+  return index;
 }
 
+bool
+BuildingsPropagationLossModel::ReceiverLess (const ShadowingEntry &entry, uint32_t receiver)
+{
+  return entry.receiver < receiver;
+}
+
+Ptr<MobilityBuildingInfo>
+BuildingsPropagationLossModel::GetBuildingInfo (Ptr<MobilityModel> mm) const
+{
+  if (mm != m_lastTx)
+    {
+      m_lastTx = mm;
+      m_lastTxInfo = mm->GetObject<MobilityBuildingInfo> ();
+    }
+  return m_lastTxInfo;
+}
+
+double
+BuildingsPropagationLossModel::GetBuildingsLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b,
+                                                 Ptr<MobilityBuildingInfo> a1, Ptr<MobilityBuildingInfo> b1) const
+{
+  return GetLoss (a, b);
+}
 
 
 double
@@ -216,7 +241,10 @@ const
 double
 BuildingsPropagationLossModel::DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
-  return txPowerDbm - GetLoss (a, b) - GetShadowing (a, b);
+  Ptr<MobilityBuildingInfo> a1 = GetBuildingInfo (a);
+  Ptr<MobilityBuildingInfo> b1 = b->GetObject<MobilityBuildingInfo> ();
+  NS_ASSERT_MSG ((a1 != 0) && (b1 != 0), "BuildingsPropagationLossModel only works with MobilityBuildingInfo");
+  return txPowerDbm - GetBuildingsLoss (a, b, a1, b1) - GetShadowing (a1, b1);
 }
 
 int64_t
@@ -28,6 +28,8 @@
 #include "ns3/random-variable-stream.h"
 #include <ns3/building.h>
 #include <ns3/mobility-building-info.h>
+#include <vector>
+#include <map>
 
 
 
@@ -72,28 +74,62 @@ public:
   virtual double DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
 protected:
+  virtual void DoDispose (void);
+
   double ExternalWallLoss (Ptr<MobilityBuildingInfo> a) const;
   double HeightLoss (Ptr<MobilityBuildingInfo> n) const;
   double InternalWallsLoss (Ptr<MobilityBuildingInfo> a, Ptr<MobilityBuildingInfo> b) const;
   
   double GetShadowing (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  double GetShadowing (Ptr<MobilityBuildingInfo> a, Ptr<MobilityBuildingInfo> b) const;
+
+  /**
+   * \param a the mobility model of the source
+   * \param b the mobility model of the destination
+   * \param a1 the MobilityBuildingInfo aggregated to a
+   * \param b1 the MobilityBuildingInfo aggregated to b
+   * \returns the propagation loss (in dBm)
+   *
+   * Same as GetLoss, for callers which already looked up the building
+   * information of both nodes. The default implementation calls GetLoss.
+   */
+  virtual double GetBuildingsLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b,
+                                   Ptr<MobilityBuildingInfo> a1, Ptr<MobilityBuildingInfo> b1) const;
+
+  /**
+   * \param mm the mobility model
+   * \returns the MobilityBuildingInfo aggregated to mm. The result for the
+   * last transmitter is remembered, since a channel evaluates the loss from
+   * one transmitter towards all the receivers in a row.
+   */
+  Ptr<MobilityBuildingInfo> GetBuildingInfo (Ptr<MobilityModel> mm) const;
 
   double m_lossInternalWall; // in meters
 
-  
-  class ShadowingLoss
+  /**
+   * \param info the building information of a node
+   * \returns the index of the node in the shadowing table of this model,
+   * the nodes being indexed in the order this model first sees them
+   */
+  uint32_t GetShadowingIndex (Ptr<MobilityBuildingInfo> info) const;
+
+  /**
+   * Shadowing value towards one receiver. Each transmitter has a row of
+   * these, sorted by receiver index (GetShadowingIndex).
+   */
+  struct ShadowingEntry
   {
-  public:
-    ShadowingLoss ();
-    ShadowingLoss (double shadowingValue, Ptr<MobilityModel> receiver);
-    double GetLoss () const;
-    Ptr<MobilityModel> GetReceiver (void) const;
-  protected:
-    double m_shadowingValue;
-    Ptr<MobilityModel> m_receiver;
+    uint32_t receiver;
+    double loss;
   };
-
-  mutable std::map<Ptr<MobilityModel>,  std::map<Ptr<MobilityModel>, ShadowingLoss> > m_shadowingLossMap;
+  static bool ReceiverLess (const ShadowingEntry &entry, uint32_t receiver);
+
+  /// index of the nodes in the shadowing table
+  mutable std::map<Ptr<MobilityBuildingInfo>, uint32_t> m_shadowingIndexes;
+  /// shadowing rows, indexed by transmitter index
+  mutable std::vector<std::vector<ShadowingEntry> > m_shadowingTable;
+  mutable Ptr<MobilityModel> m_lastTx;
+  mutable Ptr<MobilityBuildingInfo> m_lastTxInfo;
   double EvaluateSigma (Ptr<MobilityBuildingInfo> a, Ptr<MobilityBuildingInfo> b) const;
 
 
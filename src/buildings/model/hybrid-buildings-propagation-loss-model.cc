@@ -142,15 +142,21 @@ HybridBuildingsPropagationLossModel::SetRooftopHeight (double rooftopHeight)
 double
 HybridBuildingsPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
-  NS_ASSERT_MSG ((a->GetPosition ().z >= 0) && (b->GetPosition ().z >= 0), "HybridBuildingsPropagationLossModel does not support underground nodes (placed at z < 0)");
-
-  
-  double distance = a->GetDistanceFrom (b);
-
   // get the MobilityBuildingInfo pointers
   Ptr<MobilityBuildingInfo> a1 = a->GetObject<MobilityBuildingInfo> ();
   Ptr<MobilityBuildingInfo> b1 = b->GetObject<MobilityBuildingInfo> ();
   NS_ASSERT_MSG ((a1 != 0) && (b1 != 0), "HybridBuildingsPropagationLossModel only works with MobilityBuildingInfo");
+  return GetBuildingsLoss (a, b, a1, b1);
+}
+
+double
+HybridBuildingsPropagationLossModel::GetBuildingsLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b,
+                                                       Ptr<MobilityBuildingInfo> a1, Ptr<MobilityBuildingInfo> b1) const
+{
+  NS_ASSERT_MSG ((a->GetPosition ().z >= 0) && (b->GetPosition ().z >= 0), "HybridBuildingsPropagationLossModel does not support underground nodes (placed at z < 0)");
+
+  
+  double distance = a->GetDistanceFrom (b);
 
   double loss = 0.0;
 
@@ -97,6 +97,11 @@ public:
    */
   virtual double GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+protected:
+  // inherited from BuildingsPropagationLossModel
+  virtual double GetBuildingsLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b,
+                                   Ptr<MobilityBuildingInfo> a1, Ptr<MobilityBuildingInfo> b1) const;
+
   
 private:
 
@@ -65,12 +65,19 @@ OhBuildingsPropagationLossModel::GetTypeId (void)
 double
 OhBuildingsPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
-  NS_LOG_FUNCTION (this << a << b);
-
   // get the MobilityBuildingInfo pointers
   Ptr<MobilityBuildingInfo> a1 = a->GetObject<MobilityBuildingInfo> ();
   Ptr<MobilityBuildingInfo> b1 = b->GetObject<MobilityBuildingInfo> ();
   NS_ASSERT_MSG ((a1 != 0) && (b1 != 0), "OhBuildingsPropagationLossModel only works with MobilityBuildingInfo");
+  return GetBuildingsLoss (a, b, a1, b1);
+}
+
+double
+OhBuildingsPropagationLossModel::GetBuildingsLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b,
+                                                   Ptr<MobilityBuildingInfo> a1, Ptr<MobilityBuildingInfo> b1) const
+{
+  NS_LOG_FUNCTION (this << a << b);
+
 
   double loss = 0.0;
 
@@ -50,6 +50,11 @@ public:
    * \returns the propagation loss (in dBm)
    */
   virtual double GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+protected:
+  // inherited from BuildingsPropagationLossModel
+  virtual double GetBuildingsLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b,
+                                   Ptr<MobilityBuildingInfo> a1, Ptr<MobilityBuildingInfo> b1) const;
   
 private:
 
@@ -25,6 +25,9 @@
 #include <ns3/mobility-building-info.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/building.h>
+#include <ns3/building-list.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/double.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/mobility-helper.h>
 #include <ns3/simulator.h>
@@ -169,7 +172,76 @@ BuildingsHelperOneTestCase::DoRun ()
 
 
 
+/**
+ * Check that the spatial index of BuildingList finds the same buildings
+ * as a linear scan, also after the boundaries of a building change.
+ */
+class BuildingsHelperGridTestCase : public TestCase
+{
+public:
+  BuildingsHelperGridTestCase ();
 
+private:
+  virtual void DoRun (void);
+  void CheckPositions (Ptr<UniformRandomVariable> x, Ptr<UniformRandomVariable> y);
+};
+
+BuildingsHelperGridTestCase::BuildingsHelperGridTestCase ()
+  : TestCase ("building lookup through the spatial index")
+{
+}
+
+void
+BuildingsHelperGridTestCase::CheckPositions (Ptr<UniformRandomVariable> x, Ptr<UniformRandomVariable> y)
+{
+  for (uint32_t n = 0; n < 2000; n++)
+    {
+      Vector pos (x->GetValue (), y->GetValue (), 5.0);
+      std::vector<Ptr<Building> > expected;
+      for (BuildingList::Iterator bit = BuildingList::Begin (); bit != BuildingList::End (); ++bit)
+        {
+          if ((*bit)->IsInside (pos))
+            {
+              expected.push_back (*bit);
+            }
+        }
+      std::vector<Ptr<Building> > found;
+      BuildingList::GetBuildingsAt (pos, found);
+      NS_TEST_ASSERT_MSG_EQ (found.size (), expected.size (), "wrong number of buildings at " << pos);
+      for (uint32_t i = 0; i < found.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (found[i], expected[i], "wrong building at " << pos);
+        }
+    }
+}
+
+void
+BuildingsHelperGridTestCase::DoRun ()
+{
+  // buildings of different sizes, some of them overlapping
+  for (uint32_t i = 0; i < 7; i++)
+    {
+      for (uint32_t j = 0; j < 5; j++)
+        {
+          Ptr<Building> b = CreateObject<Building> ();
+          b->SetBoundaries (Box (i * 30.0, i * 30.0 + 10.0 + 5 * j,
+                                 j * 40.0, j * 40.0 + 20.0 + 6 * i,
+                                 0.0, 10.0));
+        }
+    }
+  Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable> ();
+  x->SetAttribute ("Min", DoubleValue (-20.0));
+  x->SetAttribute ("Max", DoubleValue (250.0));
+  Ptr<UniformRandomVariable> y = CreateObject<UniformRandomVariable> ();
+  y->SetAttribute ("Min", DoubleValue (-20.0));
+  y->SetAttribute ("Max", DoubleValue (250.0));
+  CheckPositions (x, y);
+
+  BuildingList::GetBuilding (3)->SetBoundaries (Box (100.0, 240.0, 150.0, 240.0, 0.0, 10.0));
+  CheckPositions (x, y);
+
+  Simulator::Destroy ();
+}
 
 
 
@@ -321,6 +393,8 @@ BuildingsHelperTestSuite::BuildingsHelperTestSuite ()
   q7.pos = vq7;
   q7.indoor = false;
   AddTestCase (new BuildingsHelperOneTestCase (q7, b2), TestCase::QUICK);     
+
+  AddTestCase (new BuildingsHelperGridTestCase, TestCase::QUICK);
 }
 
 static BuildingsHelperTestSuite buildingsHelperAntennaTestSuiteInstance;
@@ -27,8 +27,15 @@
 #include "pointer.h"
 #include "assert.h"
 #include "log.h"
+#include "string.h"
+#include "rng-stream.h"
 
 #include <cmath>
+#include <cstdlib>
+#include <typeinfo>
+#if (__GNUC__ >= 3)
+#include <cxxabi.h>
+#endif
 
 
 /**
@@ -53,6 +60,13 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("EventTraceFile",
+                   "The file logging the executed events and the random numbers "
+                   "they draw, or an empty string to not log them.",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::SetEventTraceFile,
+                                       &DefaultSimulatorImpl::GetEventTraceFile),
+                   MakeStringChecker ())
   ;
   return tid;
 }
@@ -73,6 +87,7 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_unscheduledEvents = 0;
   m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self();
+  m_eventTrace = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
@@ -92,6 +107,7 @@ DefaultSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+  SetEventTraceFile ("");
   SimulatorImpl::DoDispose ();
 }
 void
@@ -127,6 +143,93 @@ DefaultSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
   m_events = scheduler;
 }
 
+/**
+ * Demangle the name of the type of an event.
+ * \param [in] mangled The name returned by std::type_info::name().
+ * \returns The demangled name, if the compiler supports it.
+ */
+static std::string
+DemangleEventType (const char *mangled)
+{
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled, 0, 0, &status);
+  if (status == 0)
+    {
+      std::string name = demangled;
+      std::free (demangled);
+      return name;
+    }
+#endif
+  return mangled;
+}
+
+void
+DefaultSimulatorImpl::SetEventTraceFile (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  if (m_eventTrace != 0)
+    {
+      RngStream::CountDraws (0);
+      m_eventTrace->close ();
+      delete m_eventTrace;
+      m_eventTrace = 0;
+    }
+  m_eventTraceFilename = filename;
+  m_eventTypes.clear ();
+  m_draws.clear ();
+  if (filename == "")
+    {
+      return;
+    }
+  m_eventTrace = new std::ofstream (filename.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_eventTrace->is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open the event trace file " << filename);
+    }
+  uint64_t stepsPerSecond = Seconds (1).GetTimeStep ();
+  m_eventTrace->write ("ns3evtr1", 8);
+  m_eventTrace->write (reinterpret_cast<const char *> (&stepsPerSecond), sizeof (stepsPerSecond));
+  RngStream::CountDraws (&m_draws);
+}
+
+std::string
+DefaultSimulatorImpl::GetEventTraceFile (void) const
+{
+  return m_eventTraceFilename;
+}
+
+void
+DefaultSimulatorImpl::WriteEventRecord (EventImpl *event)
+{
+  const char *typeName = typeid (*event).name ();
+  std::map<const char *, uint16_t>::const_iterator type = m_eventTypes.find (typeName);
+  if (type == m_eventTypes.end ())
+    {
+      std::string name = DemangleEventType (typeName);
+      uint16_t id = m_eventTypes.size ();
+      uint16_t length = name.size ();
+      m_eventTrace->put ('T');
+      m_eventTrace->write (reinterpret_cast<const char *> (&id), sizeof (id));
+      m_eventTrace->write (reinterpret_cast<const char *> (&length), sizeof (length));
+      m_eventTrace->write (name.data (), length);
+      type = m_eventTypes.insert (std::make_pair (typeName, id)).first;
+    }
+  int64_t ts = m_currentTs;
+  uint16_t streams = m_draws.size ();
+  m_eventTrace->put ('E');
+  m_eventTrace->write (reinterpret_cast<const char *> (&ts), sizeof (ts));
+  m_eventTrace->write (reinterpret_cast<const char *> (&m_currentContext), sizeof (m_currentContext));
+  m_eventTrace->write (reinterpret_cast<const char *> (&type->second), sizeof (type->second));
+  m_eventTrace->write (reinterpret_cast<const char *> (&streams), sizeof (streams));
+  for (std::map<uint64_t, uint32_t>::const_iterator i = m_draws.begin (); i != m_draws.end (); ++i)
+    {
+      m_eventTrace->write (reinterpret_cast<const char *> (&i->first), sizeof (i->first));
+      m_eventTrace->write (reinterpret_cast<const char *> (&i->second), sizeof (i->second));
+    }
+  m_draws.clear ();
+}
+
 // System ID for non-distributed simulation is always zero
 uint32_t 
 DefaultSimulatorImpl::GetSystemId (void) const
@@ -147,6 +250,10 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
   next.impl->Invoke ();
+  if (m_eventTrace != 0 && !next.impl->IsCancelled ())
+    {
+      WriteEventRecord (next.impl);
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
@@ -30,6 +30,8 @@
 #include "ptr.h"
 
 #include <list>
+#include <map>
+#include <fstream>
 
 /**
  * \file
@@ -43,6 +45,22 @@ namespace ns3 {
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the EventTraceFile attribute is set, the events executed are
+ * logged to a binary file which utils/event-trace.py can summarize
+ * over a time window or compare with the log of another run.  The
+ * file starts with the magic "ns3evtr1" and the number of time steps
+ * per second, as an uint64_t, followed by records in host byte order,
+ * each starting with an uint8_t tag:
+ *
+ *  - 'T', the definition of an event type: its uint16_t id, the
+ *    uint16_t length of its name and the name, that of the
+ *    EventImpl subclass created by MakeEvent();
+ *  - 'E', an executed event: its int64_t timestamp in time steps,
+ *    its uint32_t context, its uint16_t type id and the uint16_t
+ *    number of random number streams used since the previous event,
+ *    followed by the uint64_t stream number and the uint32_t count
+ *    of the numbers drawn from each of them.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -85,6 +103,21 @@ private:
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
+  /**
+   * Start logging the executed events to a file.
+   * \param [in] filename The file, or an empty string to stop logging.
+   */
+  void SetEventTraceFile (std::string filename);
+  /**
+   * Get the file of the executed events.
+   * \returns The file, or an empty string if the events are not logged.
+   */
+  std::string GetEventTraceFile (void) const;
+  /**
+   * Log an executed event.
+   * \param [in] event The event.
+   */
+  void WriteEventRecord (EventImpl *event);
  
   /** Wrap an event with its execution context. */
   struct EventWithContext {
@@ -132,6 +165,15 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+  /** The file of the executed events. */
+  std::string m_eventTraceFilename;
+  /** The log of the executed events, if enabled. */
+  std::ofstream *m_eventTrace;
+  /** The ids of the event types already defined in the log. */
+  std::map<const char *, uint16_t> m_eventTypes;
+  /** The numbers drawn from each random number stream since the last event. */
+  std::map<uint64_t, uint32_t> m_draws;
 };
 
 } // namespace ns3
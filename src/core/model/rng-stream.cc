@@ -363,10 +363,23 @@ double RngStream::RandU01 ()
   /* Combination */
   u = ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
 
+  if (m_draws != 0)
+    {
+      (*m_draws)[m_stream]++;
+    }
   return u;
 }
 
+std::map<uint64_t, uint32_t> *RngStream::m_draws = 0;
+
+void
+RngStream::CountDraws (std::map<uint64_t, uint32_t> *draws)
+{
+  m_draws = draws;
+}
+
 RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
+  : m_stream (stream)
 {
   if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
@@ -381,6 +394,7 @@ RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
 }
 
 RngStream::RngStream(const RngStream& r)
+  : m_stream (r.m_stream)
 {
   for (int i = 0; i < 6; ++i)
     {
@@ -20,6 +20,7 @@
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
 #include <string>
+#include <map>
 #include <stdint.h>
 
 /**
@@ -71,6 +72,15 @@ public:
    */
   double RandU01 (void);
 
+  /**
+   * Count the numbers generated by all the streams, per stream number,
+   * or stop counting them.
+   *
+   * \param [in] draws The counts of the numbers generated by each
+   *             stream, or 0 to stop counting.
+   */
+  static void CountDraws (std::map<uint64_t, uint32_t> *draws);
+
 private:
   /**
    * Advance \p state of the RNG by leaps and bounds.
@@ -83,6 +93,10 @@ private:
 
   /** The RNG state vector. */
   double m_currentState[6];
+  /** The stream number. */
+  uint64_t m_stream;
+  /** The counts of the numbers generated by each stream, if counted. */
+  static std::map<uint64_t, uint32_t> *m_draws;
 };
 
 } // namespace ns3
@@ -22,11 +22,21 @@
 #include "singleton.h"
 #include "system-path.h"
 #include "log.h"
+#include "system-wall-clock-ms.h"
 #include <cmath>
 #include <cstring>
+#include <cstdlib>
+#include <cerrno>
 #include <vector>
 #include <list>
 #include <map>
+#include <sstream>
+#include <fstream>
+#include <csignal>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 
 /**
@@ -238,6 +248,53 @@ private:
   std::list<TestCase *> FilterTests (std::string testName,
                                      enum TestSuite::Type testType,
                                      enum TestCase::TestDuration maximumTestDuration);
+  /**
+   * Clean up characters not allowed in JSON strings.
+   *
+   * \param [in] json The raw string.
+   * \returns The escaped string, without the enclosing quotes.
+   */
+  std::string ReplaceJsonSpecialCharacters (std::string json) const;
+  /**
+   * Describe the result of a test and of its children as a JSON object.
+   *
+   * \param [in] test The TestCase to describe.
+   * \returns The JSON object.
+   */
+  std::string GetJsonReport (TestCase *test) const;
+  /**
+   * Run the tests in a pool of worker processes.
+   *
+   * The workers are forked before any test is run and each of them
+   * runs one test suite after the other until there is none left, so
+   * that a crash only takes down the suite being run: the worker is
+   * then replaced.  As the suites run before in the same worker may
+   * have left some global state behind them, a suite which fails or
+   * crashes in a worker that has run other suites is run again in a
+   * fresh worker, whose result is the one reported, a crash being
+   * reported as \c CRASH.  The reports are printed in the order in
+   * which the suites complete.
+   *
+   * \param [in] tests The test suites to run.
+   * \param [in] jobs The number of worker processes.
+   * \param [in,out] os The output stream of the reports.
+   * \param [in] xml Generate XML output if \c true.
+   * \param [out] json The JSON report of each suite, in the order of \p tests.
+   * \returns \c true if a suite failed or crashed.
+   */
+  bool RunParallel (const std::vector<TestCase *> &tests, uint32_t jobs,
+                    std::ostream *os, bool xml, std::vector<std::string> &json);
+  /**
+   * Body of a worker process of RunParallel(): run the suites whose
+   * index is read from \p commandFd and write their reports to
+   * \p resultFd, until the index of the end of \p tests is read.
+   *
+   * \param [in] tests The test suites to run.
+   * \param [in] commandFd The pipe of the suites to run.
+   * \param [in] resultFd The pipe of the reports.
+   * \param [in] xml Generate XML output if \c true.
+   */
+  void RunWorker (const std::vector<TestCase *> &tests, int commandFd, int resultFd, bool xml);
 
 
   /** Container type for the test. */
@@ -728,6 +785,424 @@ TestRunnerImpl::PrintReport (TestCase *test, std::ostream *os, bool xml, int lev
   (*os).unsetf(std::ios_base::floatfield);
   (*os).precision (oldPrecision);
 }
+
+std::string
+TestRunnerImpl::ReplaceJsonSpecialCharacters (std::string json) const
+{
+  NS_LOG_FUNCTION (this << json);
+  std::ostringstream escaped;
+  for (std::string::const_iterator i = json.begin (); i != json.end (); ++i)
+    {
+      unsigned char c = *i;
+      if (c == '"' || c == '\\')
+        {
+          escaped << '\\' << c;
+        }
+      else if (c == '\n')
+        {
+          escaped << "\\n";
+        }
+      else if (c < 0x20)
+        {
+          char code[8];
+          snprintf (code, sizeof (code), "\\u%04x", c);
+          escaped << code;
+        }
+      else
+        {
+          escaped << c;
+        }
+    }
+  return escaped.str ();
+}
+
+std::string
+TestRunnerImpl::GetJsonReport (TestCase *test) const
+{
+  NS_LOG_FUNCTION (this << test);
+  std::ostringstream os;
+  os << "{\"name\": \"" << ReplaceJsonSpecialCharacters (test->GetName ()) << "\"";
+  if (test->m_result == 0)
+    {
+      os << ", \"result\": \"SKIP\"}";
+      return os.str ();
+    }
+  const double MS_PER_SEC = 1000.;
+  os.precision (3);
+  os << std::fixed
+     << ", \"result\": \"" << (test->IsFailed () ? "FAIL" : "PASS") << "\""
+     << ", \"time\": " << test->m_result->clock.GetElapsedReal () / MS_PER_SEC
+     << ", \"failures\": " << test->m_result->failure.size ();
+  if (!test->m_children.empty ())
+    {
+      os << ", \"cases\": [";
+      for (uint32_t i = 0; i < test->m_children.size (); i++)
+        {
+          os << (i == 0 ? "" : ", ") << GetJsonReport (test->m_children[i]);
+        }
+      os << "]";
+    }
+  os << "}";
+  return os.str ();
+}
+
+/**
+ * \ingroup testingimpl
+ * Write all of a buffer to a file descriptor.
+ * \param [in] fd The file descriptor.
+ * \param [in] buffer The data to write.
+ * \param [in] size The size of \p buffer.
+ * \returns \c false if the file descriptor was closed.
+ */
+static bool
+WriteAll (int fd, const void *buffer, size_t size)
+{
+  const char *data = static_cast<const char *> (buffer);
+  while (size > 0)
+    {
+      ssize_t written = write (fd, data, size);
+      if (written < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      if (written <= 0)
+        {
+          return false;
+        }
+      data += written;
+      size -= written;
+    }
+  return true;
+}
+
+/**
+ * \ingroup testingimpl
+ * Read a whole buffer from a file descriptor.
+ * \param [in] fd The file descriptor.
+ * \param [out] buffer The data read.
+ * \param [in] size The size of \p buffer.
+ * \returns \c false if the file descriptor was closed before \p size
+ * bytes were read.
+ */
+static bool
+ReadAll (int fd, void *buffer, size_t size)
+{
+  char *data = static_cast<char *> (buffer);
+  while (size > 0)
+    {
+      ssize_t got = read (fd, data, size);
+      if (got < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      if (got <= 0)
+        {
+          return false;
+        }
+      data += got;
+      size -= got;
+    }
+  return true;
+}
+
+/**
+ * \ingroup testingimpl
+ * Write a length-prefixed string to a file descriptor.
+ * \param [in] fd The file descriptor.
+ * \param [in] s The string.
+ * \returns \c false if the file descriptor was closed.
+ */
+static bool
+WriteString (int fd, const std::string &s)
+{
+  uint32_t size = s.size ();
+  return WriteAll (fd, &size, sizeof (size)) && WriteAll (fd, s.data (), size);
+}
+
+/**
+ * \ingroup testingimpl
+ * Read a length-prefixed string from a file descriptor.
+ * \param [in] fd The file descriptor.
+ * \param [out] s The string.
+ * \returns \c false if the file descriptor was closed.
+ */
+static bool
+ReadString (int fd, std::string &s)
+{
+  uint32_t size;
+  if (!ReadAll (fd, &size, sizeof (size)))
+    {
+      return false;
+    }
+  std::vector<char> data (size);
+  if (size > 0 && !ReadAll (fd, &data[0], size))
+    {
+      return false;
+    }
+  s.assign (data.begin (), data.end ());
+  return true;
+}
+
+/**
+ * \ingroup testingimpl
+ * Stop an idle worker process of TestRunnerImpl::RunParallel() and wait
+ * for it to exit.
+ * \param [in] pid The process.
+ * \param [in] commandFd The pipe of the suites to run.
+ * \param [in] resultFd The pipe of the reports.
+ * \param [in] end The index telling the worker to exit.
+ */
+static void
+StopWorker (pid_t pid, int commandFd, int resultFd, uint32_t end)
+{
+  WriteAll (commandFd, &end, sizeof (end));
+  close (commandFd);
+  close (resultFd);
+  waitpid (pid, 0, 0);
+}
+
+void
+TestRunnerImpl::RunWorker (const std::vector<TestCase *> &tests, int commandFd, int resultFd, bool xml)
+{
+  NS_LOG_FUNCTION (this << commandFd << resultFd << xml);
+  uint32_t index;
+  while (ReadAll (commandFd, &index, sizeof (index)) && index < tests.size ())
+    {
+      TestCase *test = tests[index];
+      test->Run (this);
+      std::ostringstream report;
+      PrintReport (test, &report, xml, 0);
+      uint32_t failed = test->IsFailed ();
+      std::cout.flush ();
+      if (!WriteAll (resultFd, &failed, sizeof (failed))
+          || !WriteString (resultFd, report.str ())
+          || !WriteString (resultFd, GetJsonReport (test)))
+        {
+          break;
+        }
+    }
+}
+
+bool
+TestRunnerImpl::RunParallel (const std::vector<TestCase *> &tests, uint32_t jobs,
+                             std::ostream *os, bool xml, std::vector<std::string> &json)
+{
+  NS_LOG_FUNCTION (this << jobs << os << xml);
+  /// A worker process and its pipes, seen from the parent.
+  struct Worker
+  {
+    pid_t pid;          //!< The process, or -1.
+    int commandFd;      //!< Write end of the pipe of the suites to run.
+    int resultFd;       //!< Read end of the pipe of the reports.
+    int32_t test;       //!< The suite being run, or -1.
+    int64_t startMs;    //!< When the suite was sent, in ms.
+    uint32_t suites;    //!< Number of suites sent to the process.
+  };
+  std::vector<Worker> workers (std::min<size_t> (jobs, tests.size ()));
+  for (uint32_t w = 0; w < workers.size (); w++)
+    {
+      workers[w].pid = -1;
+      workers[w].test = -1;
+    }
+  // a crashed worker must not kill us when we send it a suite
+  void (*oldSigPipe)(int) = signal (SIGPIPE, SIG_IGN);
+  std::cout.flush ();
+  os->flush ();
+
+  SystemWallClockMs wall;
+  wall.Start ();
+  uint32_t next = 0;
+  std::list<uint32_t> retry;
+  bool failed = false;
+  uint32_t running = 0;
+  while (true)
+    {
+      // hand a suite to every idle worker, starting it if needed
+      for (uint32_t w = 0; w < workers.size (); w++)
+        {
+          Worker &worker = workers[w];
+          if (worker.pid != -1 && worker.test != -1)
+            {
+              continue;
+            }
+          if ((next == tests.size () && retry.empty ())
+              || (failed && !m_continueOnFailure))
+            {
+              break;
+            }
+          if (worker.pid != -1 && !retry.empty ())
+            {
+              // a suite to run again needs a fresh worker
+              StopWorker (worker.pid, worker.commandFd, worker.resultFd, tests.size ());
+              worker.pid = -1;
+            }
+          if (worker.pid == -1)
+            {
+              int command[2], result[2];
+              if (pipe (command) != 0 || pipe (result) != 0)
+                {
+                  NS_FATAL_ERROR ("Cannot create the pipes of a test worker: " << strerror (errno));
+                }
+              pid_t pid = fork ();
+              if (pid < 0)
+                {
+                  NS_FATAL_ERROR ("Cannot start a test worker: " << strerror (errno));
+                }
+              if (pid == 0)
+                {
+                  // the worker must not keep the pipes of the others open,
+                  // or the parent would not see them exit
+                  for (uint32_t o = 0; o < workers.size (); o++)
+                    {
+                      if (workers[o].pid != -1)
+                        {
+                          close (workers[o].commandFd);
+                          close (workers[o].resultFd);
+                        }
+                    }
+                  close (command[1]);
+                  close (result[0]);
+                  signal (SIGPIPE, oldSigPipe);
+                  RunWorker (tests, command[0], result[1], xml);
+                  std::cout.flush ();
+                  _exit (0);
+                }
+              close (command[0]);
+              close (result[1]);
+              worker.pid = pid;
+              worker.commandFd = command[1];
+              worker.resultFd = result[0];
+              worker.suites = 0;
+            }
+          if (!retry.empty ())
+            {
+              worker.test = retry.front ();
+              retry.pop_front ();
+            }
+          else
+            {
+              worker.test = next++;
+            }
+          worker.suites++;
+          worker.startMs = wall.End ();
+          WriteAll (worker.commandFd, &worker.test, sizeof (worker.test));
+          running++;
+        }
+      if (running == 0)
+        {
+          break;
+        }
+
+      std::vector<struct pollfd> fds;
+      std::vector<uint32_t> polled;
+      for (uint32_t w = 0; w < workers.size (); w++)
+        {
+          if (workers[w].pid != -1 && workers[w].test != -1)
+            {
+              struct pollfd fd;
+              fd.fd = workers[w].resultFd;
+              fd.events = POLLIN;
+              fd.revents = 0;
+              fds.push_back (fd);
+              polled.push_back (w);
+            }
+        }
+      if (poll (&fds[0], fds.size (), -1) < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          NS_FATAL_ERROR ("Cannot wait for the test workers: " << strerror (errno));
+        }
+      for (uint32_t f = 0; f < fds.size (); f++)
+        {
+          if (fds[f].revents == 0)
+            {
+              continue;
+            }
+          Worker &worker = workers[polled[f]];
+          TestCase *test = tests[worker.test];
+          uint32_t testFailed = 0;
+          std::string report;
+          bool completed = ReadAll (worker.resultFd, &testFailed, sizeof (testFailed))
+            && ReadString (worker.resultFd, report)
+            && ReadString (worker.resultFd, json[worker.test]);
+          int status = 0;
+          if (!completed)
+            {
+              // the worker died while running the suite
+              waitpid (worker.pid, &status, 0);
+              close (worker.commandFd);
+              close (worker.resultFd);
+              worker.pid = -1;
+            }
+          if ((!completed || testFailed) && worker.suites > 1)
+            {
+              // the suites run before by the worker may have left some
+              // global state behind them: only trust a failure of the
+              // suite in a worker of its own
+              NS_LOG_INFO ("Running " << test->GetName () << " again in a fresh worker");
+              retry.push_back (worker.test);
+              json[worker.test] = "";
+            }
+          else if (completed)
+            {
+              failed |= (testFailed != 0);
+              *os << report;
+            }
+          else
+            {
+              failed = true;
+
+              double real = (wall.End () - worker.startMs) / 1000.;
+              std::ostringstream reason;
+              if (WIFSIGNALED (status))
+                {
+                  reason << "signal " << WTERMSIG (status);
+                }
+              else
+                {
+                  reason << "exit status " << WEXITSTATUS (status);
+                }
+              std::ostringstream time;
+              time.precision (3);
+              time << std::fixed << real;
+              if (xml)
+                {
+                  *os << "<Test>" << std::endl
+                      << "  <Name>" << ReplaceXmlSpecialCharacters (test->GetName ()) << "</Name>" << std::endl
+                      << "  <Result>CRASH</Result>" << std::endl
+                      << "  <Time real=\"" << time.str () << "\" user=\"0.000\" system=\"0.000\"/>" << std::endl
+                      << "  <Reason>" << reason.str () << "</Reason>" << std::endl
+                      << "</Test>" << std::endl;
+                }
+              else
+                {
+                  *os << "CRASH " << test->GetName () << " " << time.str () << " s ("
+                      << reason.str () << ")" << std::endl;
+                }
+              json[worker.test] = "{\"name\": \"" + ReplaceJsonSpecialCharacters (test->GetName ())
+                + "\", \"result\": \"CRASH\", \"time\": " + time.str ()
+                + ", \"reason\": \"" + reason.str () + "\"}";
+            }
+          os->flush ();
+          worker.test = -1;
+          running--;
+        }
+    }
+
+  // stop the workers
+  for (uint32_t w = 0; w < workers.size (); w++)
+    {
+      if (workers[w].pid != -1)
+        {
+          StopWorker (workers[w].pid, workers[w].commandFd, workers[w].resultFd, tests.size ());
+        }
+    }
+  signal (SIGPIPE, oldSigPipe);
+  return failed;
+}
   
 void
 TestRunnerImpl::PrintHelp (const char *program_name) const
@@ -763,6 +1238,11 @@ TestRunnerImpl::PrintHelp (const char *program_name) const
             << "output" << std::endl
             << "  --append=FILE          : append test result to FILE instead of standard "
             << "output" << std::endl
+            << "  --jobs=N               : run the test suites in N worker processes, each" << std::endl
+            << "                           of them running suites until none is left; a" << std::endl
+            << "                           crashing suite is reported as CRASH" << std::endl
+            << "  --json=FILE            : write a JSON summary of the run, with the result" << std::endl
+            << "                           and time of every test case, to FILE" << std::endl
     ;  
 }
 
@@ -866,6 +1346,8 @@ TestRunnerImpl::Run (int argc, char *argv[])
   std::string testTypeString = "";
   std::string out = "";
   std::string fullness = "";
+  std::string jsonFile = "";
+  uint32_t jobs = 0;
   bool xml = false;
   bool append = false;
   bool printTempDir = false;
@@ -947,6 +1429,14 @@ TestRunnerImpl::Run (int argc, char *argv[])
         {
           out = arg + strlen("--out=");
         }
+      else if (strncmp(arg, "--json=", strlen("--json=")) == 0)
+        {
+          jsonFile = arg + strlen("--json=");
+        }
+      else if (strncmp(arg, "--jobs=", strlen("--jobs=")) == 0)
+        {
+          jobs = atoi (arg + strlen("--jobs="));
+        }
       else if (strncmp(arg, "--fullness=", strlen("--fullness=")) == 0)
         {
           fullness = arg + strlen("--fullness=");
@@ -1060,22 +1550,78 @@ TestRunnerImpl::Run (int argc, char *argv[])
       std::cerr << "Error:  no tests match the requested string" << std::endl;
       return 1;
     }
-  for (std::list<TestCase *>::const_iterator i = tests.begin (); i != tests.end (); ++i)
+  std::vector<TestCase *> suites (tests.begin (), tests.end ());
+  std::vector<std::string> json (suites.size ());
+  SystemWallClockMs wall;
+  wall.Start ();
+  if (jobs > 0)
     {
-      TestCase *test = *i;
-
-      test->Run (this);
-      PrintReport (test, os, xml, 0);
-      if (test->IsFailed ())
+      failed = RunParallel (suites, jobs, os, xml, json);
+    }
+  else
+    {
+      for (uint32_t i = 0; i < suites.size (); i++)
         {
-          failed = true;
-          if (!m_continueOnFailure)
+          TestCase *test = suites[i];
+
+          test->Run (this);
+          PrintReport (test, os, xml, 0);
+          json[i] = GetJsonReport (test);
+          if (test->IsFailed ())
             {
-              return 1;
+              failed = true;
+              if (!m_continueOnFailure)
+                {
+                  break;
+                }
             }
         }
     }
+  wall.End ();
 
+  if (jsonFile != "")
+    {
+      std::ofstream summary (jsonFile.c_str (), std::ios_base::out | std::ios_base::trunc);
+      uint32_t passed = 0, crashed = 0, notRun = 0;
+      for (uint32_t i = 0; i < json.size (); i++)
+        {
+          if (json[i] == "")
+            {
+              notRun++;
+              continue;
+            }
+          // the first result of the report is the one of the suite
+          const std::string key = "\"result\": \"";
+          std::string result = json[i].substr (json[i].find (key) + key.size ());
+          if (result.compare (0, 5, "PASS\"") == 0)
+            {
+              passed++;
+            }
+          else if (result.compare (0, 6, "CRASH\"") == 0)
+            {
+              crashed++;
+            }
+        }
+      summary.precision (3);
+      summary << std::fixed << "{" << std::endl
+              << "  \"jobs\": " << std::max<uint32_t> (jobs, 1) << "," << std::endl
+              << "  \"time\": " << wall.GetElapsedReal () / 1000. << "," << std::endl
+              << "  \"passed\": " << passed << "," << std::endl
+              << "  \"failed\": " << json.size () - passed - crashed - notRun << "," << std::endl
+              << "  \"crashed\": " << crashed << "," << std::endl
+              << "  \"notRun\": " << notRun << "," << std::endl
+              << "  \"suites\": [";
+      bool first = true;
+      for (uint32_t i = 0; i < json.size (); i++)
+        {
+          if (json[i] != "")
+            {
+              summary << (first ? "" : ",") << std::endl << "    " << json[i];
+              first = false;
+            }
+        }
+      summary << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
   if (out != "")
     {
       delete os;
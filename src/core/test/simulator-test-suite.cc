@@ -23,6 +23,12 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/random-variable-stream.h"
+#include <fstream>
+#include <cstring>
+#include <unistd.h>
 
 using namespace ns3;
 
@@ -459,6 +465,112 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorEventTraceTestCase : public TestCase
+{
+public:
+  SimulatorEventTraceTestCase ();
+  virtual void DoRun (void);
+
+private:
+  void Draw (uint32_t n);
+  template <typename T>
+  T Read (std::istream &is);
+
+  Ptr<UniformRandomVariable> m_random;
+};
+
+SimulatorEventTraceTestCase::SimulatorEventTraceTestCase ()
+  : TestCase ("Log of the executed events and of their random numbers")
+{
+}
+
+void
+SimulatorEventTraceTestCase::Draw (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      m_random->GetValue ();
+    }
+}
+
+template <typename T>
+T
+SimulatorEventTraceTestCase::Read (std::istream &is)
+{
+  T value = 0;
+  is.read (reinterpret_cast<char *> (&value), sizeof (value));
+  return value;
+}
+
+void
+SimulatorEventTraceTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("simulator-events.evt");
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::EventTraceFile", StringValue (filename));
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (5);
+
+  Simulator::Schedule (Seconds (1), &SimulatorEventTraceTestCase::Draw, this, 2);
+  Simulator::ScheduleWithContext (7, Seconds (2), &SimulatorEventTraceTestCase::Draw, this, 0);
+  EventId cancelled = Simulator::Schedule (Seconds (3), &SimulatorEventTraceTestCase::Draw, this, 1);
+  cancelled.Cancel ();
+  Simulator::Run ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::EventTraceFile", StringValue (""));
+
+  // the test macros evaluate their arguments again on failure, so that
+  // each field is read before being checked
+  std::ifstream is (filename.c_str (), std::ios::binary);
+  char magic[8];
+  is.read (magic, 8);
+  NS_TEST_ASSERT_MSG_EQ (std::string (magic, 8), "ns3evtr1", "Wrong magic");
+  uint64_t stepsPerSecond = Read<uint64_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (stepsPerSecond, Seconds (1).GetTimeStep (), "Wrong time resolution");
+
+  // the type of both events is defined before the first one
+  uint8_t tag = Read<uint8_t> (is);
+  NS_TEST_ASSERT_MSG_EQ (tag, 'T', "The event type must be defined first");
+  uint16_t type = Read<uint16_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (type, 0, "Wrong type id");
+  std::string name (Read<uint16_t> (is), ' ');
+  is.read (&name[0], name.size ());
+  NS_TEST_EXPECT_MSG_NE (name.find ("SimulatorEventTraceTestCase"), std::string::npos, "Wrong type name");
+
+  tag = Read<uint8_t> (is);
+  NS_TEST_ASSERT_MSG_EQ (tag, 'E', "Wrong record");
+  int64_t ts = Read<int64_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (ts, Seconds (1).GetTimeStep (), "Wrong timestamp");
+  uint32_t context = Read<uint32_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (context, 0xffffffff, "Wrong context");
+  type = Read<uint16_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (type, 0, "Wrong type");
+  uint16_t streams = Read<uint16_t> (is);
+  NS_TEST_ASSERT_MSG_EQ (streams, 1, "One stream was used");
+  // streams set with SetStream () come after the automatically assigned ones
+  uint64_t stream = Read<uint64_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (stream, (UINT64_C (1) << 63) + 5, "Wrong stream");
+  uint32_t draws = Read<uint32_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (draws, 2, "Wrong number of draws");
+
+  tag = Read<uint8_t> (is);
+  NS_TEST_ASSERT_MSG_EQ (tag, 'E', "Wrong record");
+  ts = Read<int64_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (ts, Seconds (2).GetTimeStep (), "Wrong timestamp");
+  context = Read<uint32_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (context, 7, "Wrong context");
+  type = Read<uint16_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (type, 0, "Wrong type");
+  streams = Read<uint16_t> (is);
+  NS_TEST_EXPECT_MSG_EQ (streams, 0, "No stream was used");
+
+  // the cancelled event is not logged
+  is.peek ();
+  NS_TEST_EXPECT_MSG_EQ (is.eof (), true, "Unexpected record");
+  m_random = 0;
+  unlink (filename.c_str ());
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -475,5 +587,6 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorEventTraceTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
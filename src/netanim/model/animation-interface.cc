@@ -51,6 +51,10 @@
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/energy-source-container.h"
 
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("AnimationInterface");
@@ -65,6 +69,7 @@ static bool initialized = false;
 AnimationInterface::AnimationInterface (const std::string fn)
   : m_f (0),
     m_routingF (0),
+    m_gzF (0),
     m_mobilityPollInterval (Seconds (0.25)), 
     m_outputFileName (fn),
     gAnimUid (0), 
@@ -78,7 +83,10 @@ AnimationInterface::AnimationInterface (const std::string fn)
     m_routingStopTime (Seconds (0)), 
     m_routingFileName (""),
     m_routingPollInterval (Seconds (5)), 
-    m_trackPackets (true)
+    m_trackPackets (true),
+    m_wifiPacketSampling (1),
+    m_pendingTimeout (Seconds (PURGE_INTERVAL)),
+    m_maxPendingPackets (0)
 {
   initialized = true;
   StartAnimation ();
@@ -224,6 +232,35 @@ AnimationInterface::SetMaxPktsPerTraceFile (uint64_t maxPacketsPerFile)
   m_maxPktsPerFile = maxPacketsPerFile;
 }
 
+void
+AnimationInterface::SetWifiPacketSampling (uint32_t interval)
+{
+  NS_ASSERT (interval > 0);
+  m_wifiPacketSampling = interval;
+}
+
+void
+AnimationInterface::SetPendingPacketLimits (Time timeout, uint32_t maxPending)
+{
+  m_pendingTimeout = timeout;
+  m_maxPendingPackets = maxPending;
+}
+
+void
+AnimationInterface::SetNodeFilter (NodeContainer nc)
+{
+  m_nodeFilter.assign (NodeList::GetNNodes (), false);
+  for (NodeContainer::Iterator i = nc.Begin (); i != nc.End (); ++i)
+    {
+      uint32_t nodeId = (*i)->GetId ();
+      if (nodeId >= m_nodeFilter.size ())
+        {
+          m_nodeFilter.resize (nodeId + 1, false);
+        }
+      m_nodeFilter[nodeId] = true;
+    }
+}
+
 uint32_t 
 AnimationInterface::AddNodeCounter (std::string counterName, CounterType counterType)
 {
@@ -501,6 +538,12 @@ AnimationInterface::WriteN (const char* data, uint32_t count, FILE * f)
 { 
   if (!f)
     return 0;
+#ifdef HAVE_ZLIB
+  if (f == m_f && m_gzF)
+    {
+      return gzwrite ((gzFile) m_gzF, data, count);
+    }
+#endif
   // Write count bytes to h from data
   uint32_t    nLeft   = count;
   const char* p       = data;
@@ -750,6 +793,8 @@ AnimationInterface::DevTxTrace (std::string context,
   double lbTx = (now + txTime).GetSeconds ();
   double fbRx = (now + rxTime - txTime).GetSeconds ();
   double lbRx = (now + rxTime).GetSeconds ();
+  if (!IsNodeTraced (tx->GetNode ()->GetId ()) && !IsNodeTraced (rx->GetNode ()->GetId ()))
+    return;
   CheckMaxPktsPerTraceFile ();
   WriteXmlP ("p", 
              tx->GetNode ()->GetId (), 
@@ -807,6 +852,8 @@ AnimationInterface::WifiPhyTxBeginTrace (std::string context,
 {
   if (!m_started || !IsInTimeWindow () || !m_trackPackets)
     return;
+  if (p->GetUid () % m_wifiPacketSampling != 0)
+    return;
   Ptr <NetDevice> ndev = GetNetDeviceFromContext (context); 
   NS_ASSERT (ndev);
   Ptr <Node> n = ndev->GetNode ();
@@ -837,11 +884,13 @@ AnimationInterface::WifiPhyRxBeginTrace (std::string context,
   NS_ASSERT (ndev);
   Ptr <Node> n = ndev->GetNode ();
   NS_ASSERT (n);
+  if (p->GetUid () % m_wifiPacketSampling != 0)
+    return;
   uint64_t animUid = GetAnimUidFromPacket (p);
   NS_LOG_INFO ("Wifi RxBeginTrace for packet:" << animUid);
   if (!IsPacketPending (animUid, AnimationInterface::WIFI))
     {
-      NS_ASSERT (0);
+      NS_ASSERT (m_maxPendingPackets > 0 || m_pendingTimeout < Seconds (PURGE_INTERVAL));
       NS_LOG_WARN ("WifiPhyRxBeginTrace: unknown Uid");
       std::ostringstream oss;
       WifiMacHeader hdr;
@@ -883,7 +932,7 @@ AnimationInterface::WimaxTxTrace (std::string context, Ptr<const Packet> p, cons
   AnimPacketInfo pktInfo (ndev, Simulator::Now ());
   AddByteTag (gAnimUid, p);
   AddPendingPacket (AnimationInterface::WIMAX, gAnimUid, pktInfo);
-  OutputWirelessPacketTxInfo (p, pktInfo, gAnimUid);
+  OutputWirelessPacketTxInfo (p, m_pendingWimaxPackets[gAnimUid], gAnimUid);
 }
 
 
@@ -898,7 +947,11 @@ AnimationInterface::WimaxRxTrace (std::string context, Ptr<const Packet> p, cons
   NS_ASSERT (n);
   uint64_t animUid = GetAnimUidFromPacket (p);
   NS_LOG_INFO ("WimaxRxTrace for packet:" << animUid);
-  NS_ASSERT (IsPacketPending (animUid, AnimationInterface::WIMAX) == true);
+  if (!IsPacketPending (animUid, AnimationInterface::WIMAX))
+    {
+      NS_LOG_WARN ("WimaxRxTrace: unknown Uid");
+      return;
+    }
   AnimPacketInfo& pktInfo = m_pendingWimaxPackets[animUid];
   UpdatePosition (n);
   pktInfo.ProcessRxBegin (ndev, Simulator::Now ().GetSeconds ());
@@ -920,7 +973,7 @@ AnimationInterface::LteTxTrace (std::string context, Ptr<const Packet> p, const
   AnimPacketInfo pktInfo (ndev, Simulator::Now ());
   AddByteTag (gAnimUid, p);
   AddPendingPacket (AnimationInterface::LTE, gAnimUid, pktInfo);
-  OutputWirelessPacketTxInfo (p, pktInfo, gAnimUid);
+  OutputWirelessPacketTxInfo (p, m_pendingLtePackets[gAnimUid], gAnimUid);
 }
 
 
@@ -974,7 +1027,7 @@ AnimationInterface::LteSpectrumPhyTxStart (std::string context, Ptr<const Packet
       AnimPacketInfo pktInfo (ndev, Simulator::Now ());
       AddByteTag (gAnimUid, p);
       AddPendingPacket (AnimationInterface::LTE, gAnimUid, pktInfo);
-      OutputWirelessPacketTxInfo (p, pktInfo, gAnimUid);
+      OutputWirelessPacketTxInfo (p, m_pendingLtePackets[gAnimUid], gAnimUid);
     }
 }
 
@@ -1107,31 +1160,50 @@ AnimationInterface::CsmaMacRxTrace (std::string context,
 void
 AnimationInterface::OutputWirelessPacketTxInfo (Ptr<const Packet> p, AnimPacketInfo &pktInfo, uint64_t animUid)
 {
-  CheckMaxPktsPerTraceFile ();
   uint32_t nodeId = 0;
   if (pktInfo.m_txnd)
     nodeId = pktInfo.m_txnd->GetNode ()->GetId ();
   else
     nodeId = pktInfo.m_txNodeId;
+  if (!IsNodeTraced (nodeId))
+    {
+      // written with the first reception by a traced node, if any
+      return;
+    }
+  CheckMaxPktsPerTraceFile ();
   WriteXmlPRef (animUid, nodeId, pktInfo.m_fbTx, m_enablePacketMetadata? GetPacketMetadata (p):"");
-
+  pktInfo.m_refWritten = true;
 }
 
 void 
 AnimationInterface::OutputWirelessPacketRxInfo (Ptr<const Packet> p, AnimPacketInfo & pktInfo, uint64_t animUid)
 {
-  CheckMaxPktsPerTraceFile ();
   uint32_t rxId = pktInfo.m_rxnd->GetNode ()->GetId ();
+  if (!IsNodeTraced (rxId))
+    {
+      return;
+    }
+  if (!pktInfo.m_refWritten)
+    {
+      uint32_t nodeId = pktInfo.m_txnd ? pktInfo.m_txnd->GetNode ()->GetId () : pktInfo.m_txNodeId;
+      CheckMaxPktsPerTraceFile ();
+      WriteXmlPRef (animUid, nodeId, pktInfo.m_fbTx, m_enablePacketMetadata? GetPacketMetadata (p):"");
+      pktInfo.m_refWritten = true;
+    }
   WriteXmlP (animUid, "wpr", rxId, pktInfo.m_fbRx, pktInfo.m_lbRx);
 }
 
 void 
 AnimationInterface::OutputCsmaPacket (Ptr<const Packet> p, AnimPacketInfo &pktInfo)
 {
-  CheckMaxPktsPerTraceFile ();
   NS_ASSERT (pktInfo.m_txnd);
   uint32_t nodeId = pktInfo.m_txnd->GetNode ()->GetId ();
   uint32_t rxId = pktInfo.m_rxnd->GetNode ()->GetId ();
+  if (!IsNodeTraced (nodeId) && !IsNodeTraced (rxId))
+    {
+      return;
+    }
+  CheckMaxPktsPerTraceFile ();
 
   WriteXmlP ("p", 
              nodeId, 
@@ -1149,6 +1221,11 @@ AnimationInterface::AddPendingPacket (ProtocolType protocolType, uint64_t animUi
   AnimUidPacketInfoMap * pendingPackets = ProtocolTypeToPendingPackets (protocolType);
   NS_ASSERT (pendingPackets);
   pendingPackets->insert (AnimUidPacketInfoMap::value_type (animUid, pktInfo));
+  if (m_maxPendingPackets > 0 && pendingPackets->size () > m_maxPendingPackets)
+    {
+      // the Uids increase with time: forget the oldest packet
+      pendingPackets->erase (pendingPackets->begin ());
+    }
 }
 
 bool 
@@ -1164,26 +1241,13 @@ AnimationInterface::PurgePendingPackets (AnimationInterface::ProtocolType protoc
 {
   AnimUidPacketInfoMap * pendingPackets = ProtocolTypeToPendingPackets (protocolType);
   NS_ASSERT (pendingPackets);
-  if (pendingPackets->empty ())
-    return;
-  std::vector <uint64_t> purgeList;
-  for (AnimUidPacketInfoMap::iterator i = pendingPackets->begin ();
-       i != pendingPackets->end ();
-       ++i)
-    {
-     
-      AnimPacketInfo pktInfo = i->second; 
-      double delta = (Simulator::Now ().GetSeconds () - pktInfo.m_fbTx);
-      if (delta > PURGE_INTERVAL)
-        {
-          purgeList.push_back (i->first);
-        }
-    }
-  for (std::vector <uint64_t>::iterator i = purgeList.begin ();
-       i != purgeList.end ();
-       ++i)
+  // The Uids are allocated when the transmission starts, so the map is
+  // sorted by transmission time: stop at the first recent packet
+  double oldest = (Simulator::Now () - m_pendingTimeout).GetSeconds ();
+  AnimUidPacketInfoMap::iterator i = pendingPackets->begin ();
+  while (i != pendingPackets->end () && i->second.m_fbTx < oldest)
     {
-      pendingPackets->erase (*i);
+      pendingPackets->erase (i++);
     }
 }
 
@@ -1271,6 +1335,13 @@ AnimationInterface::StopAnimation (bool onlyAnimation)
     {
       // Terminate the anim element
       WriteXmlClose ("anim");
+#ifdef HAVE_ZLIB
+      if (m_gzF)
+        {
+          gzclose ((gzFile) m_gzF);
+          m_gzF = 0;
+        }
+#endif
       std::fclose (m_f);
       m_f = 0;
     }
@@ -1657,6 +1728,12 @@ AnimationInterface::WriteNodeEnergies ()
     }
 }
 
+bool
+AnimationInterface::IsNodeTraced (uint32_t nodeId) const
+{
+  return m_nodeFilter.empty () || (nodeId < m_nodeFilter.size () && m_nodeFilter[nodeId]);
+}
+
 bool 
 AnimationInterface::IsInTimeWindow ()
 {
@@ -1688,6 +1765,19 @@ AnimationInterface::SetOutputFile (const std::string& fn, bool routing)
       NS_FATAL_ERROR ("Unable to open output file:" << fn.c_str ());
       return; // Can't open output file
     }
+  if (!routing && fn.size () > 3 && fn.compare (fn.size () - 3, 3, ".gz") == 0)
+    {
+#ifdef HAVE_ZLIB
+      m_gzF = gzdopen (dup (fileno (f)), "wb");
+      if (!m_gzF)
+        {
+          NS_FATAL_ERROR ("Unable to compress output file:" << fn.c_str ());
+        }
+      gzbuffer ((gzFile) m_gzF, 1 << 18);
+#else
+      NS_FATAL_ERROR ("Compressed output file " << fn.c_str () << " requires zlib");
+#endif
+    }
   if (routing)
     {
       m_routingF = f;
@@ -1706,6 +1796,12 @@ AnimationInterface::CheckMaxPktsPerTraceFile ()
 {
   // Start a new trace file if the current packet count exceeded nax packets per file
   ++m_currentPktCount;
+#ifdef HAVE_ZLIB
+  if (m_gzF && m_currentPktCount % GZIP_CHUNK_PKTS == 0)
+    {
+      gzflush ((gzFile) m_gzF, Z_SYNC_FLUSH);
+    }
+#endif
   if (m_currentPktCount <= m_maxPktsPerFile)
     {
       return;
@@ -2254,6 +2350,10 @@ AnimationInterface::WriteXmlUpdateNodeSize (uint32_t nodeId, double width, doubl
 void 
 AnimationInterface::WriteXmlUpdateNodePosition (uint32_t nodeId, double x, double y)
 {
+  if (!IsNodeTraced (nodeId))
+    {
+      return;
+    }
   AnimXmlElement element ("nu");
   element.AddAttribute ("p", "p");
   element.AddAttribute ("t", Simulator::Now ().GetSeconds ());
@@ -2389,7 +2489,8 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo ()
     m_txNodeId (0),
     m_fbTx (0), 
     m_lbTx (0), 
-    m_lbRx (0)
+    m_lbRx (0),
+    m_refWritten (false)
 {
 }
 
@@ -2400,6 +2501,7 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo (const AnimPacketInfo & pInfo
   m_fbTx = pInfo.m_fbTx;
   m_lbTx = pInfo.m_lbTx;
   m_lbRx = pInfo.m_lbRx;
+  m_refWritten = pInfo.m_refWritten;
 }
 
 AnimationInterface::AnimPacketInfo::AnimPacketInfo (Ptr <const NetDevice> txnd, 
@@ -2409,7 +2511,8 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo (Ptr <const NetDevice> txnd,
     m_txNodeId (0),
     m_fbTx (fbTx.GetSeconds ()), 
     m_lbTx (0), 
-    m_lbRx (0)
+    m_lbRx (0),
+    m_refWritten (false)
 {
   if (!m_txnd)
     m_txNodeId = txNodeId;
@@ -48,6 +48,7 @@ namespace ns3 {
 
 #define MAX_PKTS_PER_TRACE_FILE 100000
 #define PURGE_INTERVAL 5
+#define GZIP_CHUNK_PKTS 10000
 #define NETANIM_VERSION "netanim-3.106"
 
 
@@ -73,7 +74,10 @@ public:
 
   /**
    * \brief Constructor
-   * \param filename The Filename for the trace file used by the Animator
+   * \param filename The Filename for the trace file used by the Animator.
+   *        If the name ends in ".gz", the trace file is written gzip compressed
+   *        (requires zlib), flushed every GZIP_CHUNK_PKTS packets so that a
+   *        partial trace can be read back
    *
    */
   AnimationInterface (const std::string filename);
@@ -208,6 +212,37 @@ public:
    */
   void SetMaxPktsPerTraceFile (uint64_t maxPktsPerFile);
 
+  /**
+   * \brief Trace only a sample of the wifi packets, to keep the trace file of
+   *        a large network manageable. The sampling is done per packet, so
+   *        that all the transmissions and receptions of a sampled packet are traced
+   * \param interval One out of interval wifi packets is traced
+   *        Default: 1 (every packet)
+   *
+   * \returns none
+   */
+  void SetWifiPacketSampling (uint32_t interval);
+
+  /**
+   * \brief Bound the memory used by the packets waiting for their reception
+   * \param timeout A packet is forgotten once its transmission started more than
+   *        timeout ago. Default: PURGE_INTERVAL seconds
+   * \param maxPending Maximum number of pending packets per protocol, the oldest
+   *        ones being forgotten first. Default: 0 (no limit)
+   *
+   * \returns none
+   */
+  void SetPendingPacketLimits (Time timeout, uint32_t maxPending = 0);
+
+  /**
+   * \brief Only trace the packets sent or received by the given nodes, and
+   *        the position updates of these nodes
+   * \param nc The nodes to trace, typically the AP and a few stations
+   *
+   * \returns none
+   */
+  void SetNodeFilter (NodeContainer nc);
+
   /**
    * \brief Set mobility poll interval:WARNING: setting a low interval can 
    * cause slowness
@@ -435,6 +470,7 @@ private:
     double m_fbRx;            
     double m_lbRx;
     Ptr <const NetDevice> m_rxnd;
+    bool m_refWritten; // true once the packet reference was written to the trace file
     void ProcessRxBegin (Ptr <const NetDevice> nd, const double fbRx);
   };
 
@@ -537,6 +573,7 @@ private:
 
   FILE * m_f; // File handle for output (0 if none)
   FILE * m_routingF; // File handle for routing table output (0 if None);
+  void * m_gzF; // gzFile writing compressed output to m_f (0 if none)
   Time m_mobilityPollInterval;
   std::string m_outputFileName;
   uint64_t gAnimUid ;    // Packet unique identifier used by AnimationInterface
@@ -561,6 +598,10 @@ private:
   Time m_wifiPhyCountersPollInterval;
   static Rectangle * userBoundary;
   bool m_trackPackets;
+  uint32_t m_wifiPacketSampling;
+  Time m_pendingTimeout;
+  uint32_t m_maxPendingPackets;
+  std::vector<bool> m_nodeFilter; // traced nodes, indexed by node Id (empty to trace all nodes)
 
   // Counter ID
   uint32_t m_remainingEnergyCounterId;
@@ -637,6 +678,7 @@ private:
   uint64_t GetAnimUidFromPacket (Ptr <const Packet>);
   void AddToIpv4AddressNodeIdTable (std::string, uint32_t);
   bool IsInTimeWindow ();
+  bool IsNodeTraced (uint32_t nodeId) const;
   void CheckMaxPktsPerTraceFile ();
 
   void TrackWifiPhyCounters ();
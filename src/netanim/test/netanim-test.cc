@@ -24,21 +24,59 @@
 #include "ns3/network-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/point-to-point-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/wifi-module.h"
 #include "ns3/netanim-module.h"
 #include "ns3/applications-module.h"
 #include "ns3/point-to-point-layout-module.h"
 #include "ns3/basic-energy-source.h"
 #include "ns3/simple-device-energy-model.h"
 
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
 using namespace ns3;
 
+/**
+ * Installs the internet stack on the nodes and addresses the devices, then
+ * makes the first node send up to 100 echo requests of 1024 bytes to the
+ * second one from 2 s to 10 s.
+ */
+static void
+InstallUdpEcho (NodeContainer nodes, NetDeviceContainer devices, Time interval)
+{
+  InternetStackHelper stack;
+  stack.Install (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+
+  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+
+  UdpEchoServerHelper echoServer (9);
+
+  ApplicationContainer serverApps = echoServer.Install (nodes.Get (1));
+  serverApps.Start (Seconds (1.0));
+  serverApps.Stop (Seconds (10.0));
+
+  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
+  echoClient.SetAttribute ("MaxPackets", UintegerValue (100));
+  echoClient.SetAttribute ("Interval", TimeValue (interval));
+  echoClient.SetAttribute ("PacketSize", UintegerValue (1024));
+
+  ApplicationContainer clientApps = echoClient.Install (nodes.Get (0));
+  clientApps.Start (Seconds (2.0));
+  clientApps.Stop (Seconds (10.0));
+}
+
 class AbstractAnimationInterfaceTestCase : public TestCase
 {
 public:
   /**
    * \brief Constructor.
    */
-  AbstractAnimationInterfaceTestCase (std::string name);
+  AbstractAnimationInterfaceTestCase (std::string name, const char* traceFileName = "netanim-test.xml");
   /**
    * \brief Destructor.
    */
@@ -53,8 +91,17 @@ public:
 
 protected:
 
+  /**
+   * \brief Create the nodes, connect the first two by a point-to-point
+   * link and install the echo applications between them.
+   * \param nNodes the number of nodes
+   */
+  void
+  PreparePointToPointNetwork (uint32_t nNodes);
+
   NodeContainer m_nodes;
   AnimationInterface* m_anim;
+  const char* m_traceFileName;
 
 private:
 
@@ -66,12 +113,10 @@ private:
 
   virtual void
   CheckFileExistence ();
-
-  const char* m_traceFileName;
 };
 
-AbstractAnimationInterfaceTestCase::AbstractAnimationInterfaceTestCase (std::string name) :
-  TestCase (name), m_anim (NULL), m_traceFileName ("netanim-test.xml")
+AbstractAnimationInterfaceTestCase::AbstractAnimationInterfaceTestCase (std::string name, const char* traceFileName) :
+  TestCase (name), m_anim (NULL), m_traceFileName (traceFileName)
 {
 }
 
@@ -93,6 +138,25 @@ AbstractAnimationInterfaceTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+void
+AbstractAnimationInterfaceTestCase::PreparePointToPointNetwork (uint32_t nNodes)
+{
+  m_nodes.Create (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      AnimationInterface::SetConstantPosition (m_nodes.Get (i), i , 10);
+    }
+
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+
+  NetDeviceContainer devices;
+  devices = pointToPoint.Install (m_nodes.Get (0), m_nodes.Get (1));
+
+  InstallUdpEcho (m_nodes, devices, Seconds (1.0));
+}
+
 void
 AbstractAnimationInterfaceTestCase::CheckFileExistence ()
 {
@@ -128,45 +192,283 @@ AnimationInterfaceTestCase::AnimationInterfaceTestCase () :
 void
 AnimationInterfaceTestCase::PrepareNetwork (void)
 {
-  m_nodes.Create (2);
-  AnimationInterface::SetConstantPosition (m_nodes.Get (0), 0 , 10);
-  AnimationInterface::SetConstantPosition (m_nodes.Get (1), 1 , 10);
+  PreparePointToPointNetwork (2);
+}
 
-  PointToPointHelper pointToPoint;
-  pointToPoint.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
-  pointToPoint.SetChannelAttribute ("Delay", StringValue ("2ms"));
+void
+AnimationInterfaceTestCase::CheckLogic (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_anim->GetTracePktCount (), 16, "Expected 16 packets traced");
+}
 
-  NetDeviceContainer devices;
-  devices = pointToPoint.Install (m_nodes);
+class AnimationNodeFilterTestCase : public AbstractAnimationInterfaceTestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationNodeFilterTestCase ();
 
-  InternetStackHelper stack;
-  stack.Install (m_nodes);
+private:
 
-  Ipv4AddressHelper address;
-  address.SetBase ("10.1.1.0", "255.255.255.0");
+  virtual void
+  PrepareNetwork ();
 
-  Ipv4InterfaceContainer interfaces = address.Assign (devices);
+  virtual void
+  CheckLogic ();
 
-  UdpEchoServerHelper echoServer (9);
+  void
+  SetNodeFilter ();
+};
 
-  ApplicationContainer serverApps = echoServer.Install (m_nodes.Get (1));
-  serverApps.Start (Seconds (1.0));
-  serverApps.Stop (Seconds (10.0));
+AnimationNodeFilterTestCase::AnimationNodeFilterTestCase () :
+  AbstractAnimationInterfaceTestCase ("Verify the node filter")
+{
+}
 
-  UdpEchoClientHelper echoClient (interfaces.GetAddress (1), 9);
-  echoClient.SetAttribute ("MaxPackets", UintegerValue (100));
-  echoClient.SetAttribute ("Interval", TimeValue (Seconds (1.0)));
-  echoClient.SetAttribute ("PacketSize", UintegerValue (1024));
+void
+AnimationNodeFilterTestCase::PrepareNetwork (void)
+{
+  // node 2 is not connected to the others
+  PreparePointToPointNetwork (3);
+  // the animation interface is created once the network is ready
+  Simulator::Schedule (Seconds (0.5), &AnimationNodeFilterTestCase::SetNodeFilter, this);
+}
 
-  ApplicationContainer clientApps = echoClient.Install (m_nodes.Get (0));
-  clientApps.Start (Seconds (2.0));
-  clientApps.Stop (Seconds (10.0));
+void
+AnimationNodeFilterTestCase::SetNodeFilter (void)
+{
+  m_anim->SetNodeFilter (NodeContainer (m_nodes.Get (2)));
 }
 
 void
-AnimationInterfaceTestCase::CheckLogic (void)
+AnimationNodeFilterTestCase::CheckLogic (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_anim->GetTracePktCount (), 0, "Expected no packet of the filtered out nodes");
+}
+
+#ifdef HAVE_ZLIB
+class AnimationGzipTestCase : public AbstractAnimationInterfaceTestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationGzipTestCase ();
+
+private:
+
+  virtual void
+  PrepareNetwork ();
+
+  virtual void
+  CheckLogic ();
+
+};
+
+AnimationGzipTestCase::AnimationGzipTestCase () :
+  AbstractAnimationInterfaceTestCase ("Verify the gzip compressed trace file", "netanim-test.xml.gz")
+{
+}
+
+void
+AnimationGzipTestCase::PrepareNetwork (void)
+{
+  PreparePointToPointNetwork (2);
+}
+
+void
+AnimationGzipTestCase::CheckLogic (void)
 {
   NS_TEST_ASSERT_MSG_EQ (m_anim->GetTracePktCount (), 16, "Expected 16 packets traced");
+  // the trace file is complete once the animation interface is deleted
+  delete m_anim;
+  m_anim = NULL;
+
+  FILE * fp = fopen (m_traceFileName, "rb");
+  NS_TEST_ASSERT_MSG_NE (fp, 0, "Trace file was not created");
+  int magic0 = fgetc (fp);
+  int magic1 = fgetc (fp);
+  fclose (fp);
+  NS_TEST_ASSERT_MSG_EQ ((magic0 == 0x1f && magic1 == 0x8b), true, "Trace file is not gzip compressed");
+
+  gzFile gz = gzopen (m_traceFileName, "rb");
+  NS_TEST_ASSERT_MSG_NE (gz, 0, "Trace file cannot be decompressed");
+  std::string trace;
+  char buffer[4096];
+  int n;
+  while ((n = gzread (gz, buffer, sizeof (buffer))) > 0)
+    {
+      trace.append (buffer, n);
+    }
+  gzclose (gz);
+  uint32_t records = 0;
+  for (std::string::size_type i = trace.find ("<p "); i != std::string::npos; i = trace.find ("<p ", i + 1))
+    {
+      records++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (records, 16, "Expected 16 packets in the decompressed trace file");
+  NS_TEST_ASSERT_MSG_NE (trace.find ("</anim>"), std::string::npos, "The decompressed trace file is truncated");
+}
+#endif
+
+/**
+ * Runs the same network twice, with the default trace options then with
+ * options reducing the trace, and compares the number of packets traced.
+ */
+class AbstractAnimationTraceReductionTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AbstractAnimationTraceReductionTestCase (std::string name);
+
+  virtual void
+  DoRun (void);
+
+private:
+
+  virtual void
+  PrepareNetwork (NodeContainer nodes) = 0;
+
+  virtual void
+  ReduceTrace (AnimationInterface* anim) = 0;
+
+  uint64_t
+  CountTracedPackets (bool reduce);
+};
+
+AbstractAnimationTraceReductionTestCase::AbstractAnimationTraceReductionTestCase (std::string name) :
+  TestCase (name)
+{
+}
+
+uint64_t
+AbstractAnimationTraceReductionTestCase::CountTracedPackets (bool reduce)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  PrepareNetwork (nodes);
+  AnimationInterface* anim = new AnimationInterface ("netanim-test.xml");
+  if (reduce)
+    {
+      ReduceTrace (anim);
+    }
+  Simulator::Stop (Seconds (10));
+  Simulator::Run ();
+  uint64_t count = anim->GetTracePktCount ();
+  Simulator::Destroy ();
+  delete anim;
+  unlink ("netanim-test.xml");
+  return count;
+}
+
+void
+AbstractAnimationTraceReductionTestCase::DoRun (void)
+{
+  uint64_t all = CountTracedPackets (false);
+  uint64_t reduced = CountTracedPackets (true);
+  NS_TEST_ASSERT_MSG_GT (all, 0, "Expected packets traced with the default options");
+  NS_TEST_ASSERT_MSG_LT (reduced, all, "Expected fewer packets traced with the reduced trace");
+}
+
+class AnimationWifiSamplingTestCase : public AbstractAnimationTraceReductionTestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationWifiSamplingTestCase ();
+
+private:
+
+  virtual void
+  PrepareNetwork (NodeContainer nodes);
+
+  virtual void
+  ReduceTrace (AnimationInterface* anim);
+};
+
+AnimationWifiSamplingTestCase::AnimationWifiSamplingTestCase () :
+  AbstractAnimationTraceReductionTestCase ("Verify the wifi packet sampling")
+{
+}
+
+void
+AnimationWifiSamplingTestCase::PrepareNetwork (NodeContainer nodes)
+{
+  AnimationInterface::SetConstantPosition (nodes.Get (0), 0 , 10);
+  AnimationInterface::SetConstantPosition (nodes.Get (1), 1 , 10);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  NqosWifiMacHelper mac = NqosWifiMacHelper::Default ();
+  mac.SetType ("ns3::AdhocWifiMac");
+
+  NetDeviceContainer devices;
+  devices = wifi.Install (phy, mac, nodes);
+
+  InstallUdpEcho (nodes, devices, Seconds (0.1));
+}
+
+void
+AnimationWifiSamplingTestCase::ReduceTrace (AnimationInterface* anim)
+{
+  anim->SetWifiPacketSampling (4);
+}
+
+class AnimationPendingPurgeTestCase : public AbstractAnimationTraceReductionTestCase
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  AnimationPendingPurgeTestCase ();
+
+private:
+
+  virtual void
+  PrepareNetwork (NodeContainer nodes);
+
+  virtual void
+  ReduceTrace (AnimationInterface* anim);
+};
+
+AnimationPendingPurgeTestCase::AnimationPendingPurgeTestCase () :
+  AbstractAnimationTraceReductionTestCase ("Verify the purge of the pending packets")
+{
+}
+
+void
+AnimationPendingPurgeTestCase::PrepareNetwork (NodeContainer nodes)
+{
+  AnimationInterface::SetConstantPosition (nodes.Get (0), 0 , 10);
+  AnimationInterface::SetConstantPosition (nodes.Get (1), 1 , 10);
+
+  CsmaHelper csma;
+  csma.SetChannelAttribute ("DataRate", StringValue ("5Mbps"));
+  csma.SetChannelAttribute ("Delay", StringValue ("2ms"));
+
+  NetDeviceContainer devices;
+  devices = csma.Install (nodes);
+
+  InstallUdpEcho (nodes, devices, Seconds (1.0));
+}
+
+void
+AnimationPendingPurgeTestCase::ReduceTrace (AnimationInterface* anim)
+{
+  // a frame ends its transmission within 2 ms but is received 2 ms later:
+  // the frames are forgotten before their reception
+  anim->SetMobilityPollInterval (MilliSeconds (1));
+  anim->SetPendingPacketLimits (MilliSeconds (2));
 }
 
 class AnimationRemainingEnergyTestCase : public AbstractAnimationInterfaceTestCase
@@ -235,6 +537,12 @@ public:
     TestSuite ("animation-interface", UNIT)
   {
     AddTestCase (new AnimationInterfaceTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationNodeFilterTestCase (), TestCase::QUICK);
+#ifdef HAVE_ZLIB
+    AddTestCase (new AnimationGzipTestCase (), TestCase::QUICK);
+#endif
+    AddTestCase (new AnimationWifiSamplingTestCase (), TestCase::QUICK);
+    AddTestCase (new AnimationPendingPurgeTestCase (), TestCase::QUICK);
     AddTestCase (new AnimationRemainingEnergyTestCase (), TestCase::QUICK);
   }
 } g_animationInterfaceTestSuite;
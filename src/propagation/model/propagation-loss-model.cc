@@ -28,7 +28,13 @@
 #include "ns3/double.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
+#include "ns3/node.h"
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <limits>
 
 namespace ns3 {
 
@@ -826,7 +832,9 @@ MatrixPropagationLossModel::GetTypeId (void)
 }
 
 MatrixPropagationLossModel::MatrixPropagationLossModel ()
-  : PropagationLossModel (), m_default (std::numeric_limits<double>::max ())
+  : PropagationLossModel (), m_default (std::numeric_limits<double>::max ()),
+    m_symmetricMatrix (true),
+    m_matrixNodes (0)
 {
 }
 
@@ -863,21 +871,295 @@ MatrixPropagationLossModel::SetLoss (Ptr<MobilityModel> ma, Ptr<MobilityModel> m
     }
 }
 
+void
+MatrixPropagationLossModel::SetLossMatrix (const std::vector<LossEntry> &entries, bool symmetric)
+{
+  NS_LOG_FUNCTION (this << entries.size () << symmetric);
+  m_symmetricMatrix = symmetric;
+  m_matrixNodes = 0;
+  std::vector<float> ().swap (m_dense);
+  std::vector<uint32_t> ().swap (m_rowStart);
+  std::vector<uint32_t> ().swap (m_columns);
+  std::vector<float> ().swap (m_values);
+  if (entries.empty ())
+    {
+      return;
+    }
+
+  // counting sort of the entries by row, in their order in each row so
+  // that the last of several entries of a pair can be kept
+  for (std::vector<LossEntry>::const_iterator i = entries.begin (); i != entries.end (); ++i)
+    {
+      m_matrixNodes = std::max (m_matrixNodes, std::max (i->tx, i->rx) + 1);
+    }
+  m_rowStart.assign (m_matrixNodes + 1, 0);
+  for (std::vector<LossEntry>::const_iterator i = entries.begin (); i != entries.end (); ++i)
+    {
+      uint32_t row = symmetric ? std::min (i->tx, i->rx) : i->tx;
+      m_rowStart[row + 1]++;
+    }
+  for (uint32_t row = 0; row < m_matrixNodes; row++)
+    {
+      m_rowStart[row + 1] += m_rowStart[row];
+    }
+  m_columns.resize (entries.size ());
+  m_values.resize (entries.size ());
+  std::vector<uint32_t> next (m_rowStart.begin (), m_rowStart.end () - 1);
+  for (std::vector<LossEntry>::const_iterator i = entries.begin (); i != entries.end (); ++i)
+    {
+      uint32_t row = i->tx;
+      uint32_t column = i->rx;
+      if (symmetric && row > column)
+        {
+          std::swap (row, column);
+        }
+      m_columns[next[row]] = column;
+      m_values[next[row]] = i->loss;
+      next[row]++;
+    }
+  std::vector<uint32_t> ().swap (next);
+
+  // sort the columns of each row, surveys usually are already sorted, and
+  // only keep the last loss of each pair
+  uint32_t size = 0;
+  std::vector<std::pair<uint32_t, float> > row;
+  for (uint32_t r = 0; r < m_matrixNodes; r++)
+    {
+      uint32_t begin = m_rowStart[r];
+      uint32_t end = m_rowStart[r + 1];
+      m_rowStart[r] = size;
+      bool sorted = true;
+      for (uint32_t i = begin + 1; i < end && sorted; i++)
+        {
+          sorted = m_columns[i - 1] < m_columns[i];
+        }
+      if (!sorted)
+        {
+          row.clear ();
+          for (uint32_t i = begin; i < end; i++)
+            {
+              row.push_back (std::make_pair (m_columns[i], m_values[i]));
+            }
+          std::stable_sort (row.begin (), row.end (), CompareColumns);
+          for (uint32_t i = 0; i < row.size (); i++)
+            {
+              m_columns[begin + i] = row[i].first;
+              m_values[begin + i] = row[i].second;
+            }
+        }
+      for (uint32_t i = begin; i < end; i++)
+        {
+          if (size > m_rowStart[r] && m_columns[size - 1] == m_columns[i])
+            {
+              size--;
+            }
+          m_columns[size] = m_columns[i];
+          m_values[size] = m_values[i];
+          size++;
+        }
+    }
+  m_rowStart[m_matrixNodes] = size;
+  m_columns.resize (size);
+  m_values.resize (size);
+
+  // a dense matrix takes less memory when more than half of its cells are known
+  uint64_t cells = symmetric ? (uint64_t)m_matrixNodes * (m_matrixNodes + 1) / 2
+    : (uint64_t)m_matrixNodes * m_matrixNodes;
+  if (2 * (uint64_t)size >= cells)
+    {
+      m_dense.assign (cells, std::numeric_limits<float>::quiet_NaN ());
+      for (uint32_t r = 0; r < m_matrixNodes; r++)
+        {
+          for (uint32_t i = m_rowStart[r]; i < m_rowStart[r + 1]; i++)
+            {
+              m_dense[GetDenseIndex (r, m_columns[i])] = m_values[i];
+            }
+        }
+      std::vector<uint32_t> ().swap (m_rowStart);
+      std::vector<uint32_t> ().swap (m_columns);
+      std::vector<float> ().swap (m_values);
+    }
+  NS_LOG_DEBUG ("node matrix of " << m_matrixNodes << " nodes, " << size << " pairs, "
+                << (m_dense.empty () ? "sparse" : "dense"));
+}
+
+void
+MatrixPropagationLossModel::LoadLossMatrix (std::string filename, bool symmetric)
+{
+  NS_LOG_FUNCTION (this << filename << symmetric);
+  FILE *file = std::fopen (filename.c_str (), "rb");
+  if (file == 0)
+    {
+      NS_FATAL_ERROR ("Cannot open the loss matrix file " << filename);
+    }
+  std::vector<LossEntry> entries;
+  // one more byte to terminate a last line without end of line
+  const size_t capacity = 1 << 20;
+  std::vector<char> buffer (capacity + 1);
+  size_t length = std::fread (&buffer[0], 1, capacity, file);
+  if (length >= 8 && std::memcmp (&buffer[0], "ns3loss1", 8) == 0)
+    {
+      const size_t recordSize = 2 * sizeof (uint32_t) + sizeof (float);
+      long position = std::ftell (file);
+      if (std::fseek (file, 0, SEEK_END) == 0)
+        {
+          entries.reserve ((std::ftell (file) - 8) / recordSize);
+        }
+      std::fseek (file, position, SEEK_SET);
+      size_t offset = 8;
+      while (true)
+        {
+          for (; offset + recordSize <= length; offset += recordSize)
+            {
+              LossEntry entry;
+              std::memcpy (&entry.tx, &buffer[offset], sizeof (uint32_t));
+              std::memcpy (&entry.rx, &buffer[offset + sizeof (uint32_t)], sizeof (uint32_t));
+              std::memcpy (&entry.loss, &buffer[offset + 2 * sizeof (uint32_t)], sizeof (float));
+              entries.push_back (entry);
+            }
+          length -= offset;
+          std::memmove (&buffer[0], &buffer[offset], length);
+          offset = 0;
+          size_t read = std::fread (&buffer[length], 1, capacity - length, file);
+          if (read == 0)
+            {
+              break;
+            }
+          length += read;
+        }
+      if (length != 0)
+        {
+          NS_FATAL_ERROR ("Truncated record at the end of the loss matrix file " << filename);
+        }
+    }
+  else
+    {
+      // the text is parsed line by line in place, a line which does not
+      // fit in the rest of the buffer is moved to its beginning
+      uint32_t lineNumber = 0;
+      bool header = true;
+      while (length != 0)
+        {
+          char *start = &buffer[0];
+          char *end = start + length;
+          char *eol;
+          while ((eol = static_cast<char *> (std::memchr (start, '\n', end - start))) != 0
+                 || (std::feof (file) && start != end && (eol = end)))
+            {
+              lineNumber++;
+              char saved = *eol;
+              *eol = 0;
+              char *p = start + std::strspn (start, " \t\r");
+              if (*p != 0 && *p != '#')
+                {
+                  LossEntry entry;
+                  char *q;
+                  bool ok = false;
+                  entry.tx = std::strtoul (p, &q, 10);
+                  if (q != p)
+                    {
+                      p = q + std::strspn (q, ",; \t");
+                      entry.rx = std::strtoul (p, &q, 10);
+                      if (q != p)
+                        {
+                          p = q + std::strspn (q, ",; \t");
+                          entry.loss = std::strtod (p, &q);
+                          ok = q != p && q[std::strspn (q, " \t\r")] == 0;
+                        }
+                    }
+                  if (ok)
+                    {
+                      entries.push_back (entry);
+                    }
+                  else if (!header)
+                    {
+                      NS_FATAL_ERROR ("Malformed line " << lineNumber << " of the loss matrix file " << filename);
+                    }
+                  header = false;
+                }
+              *eol = saved;
+              start = eol == end ? end : eol + 1;
+            }
+          length = end - start;
+          std::memmove (&buffer[0], start, length);
+          if (length == capacity)
+            {
+              NS_FATAL_ERROR ("Line " << lineNumber + 1 << " of the loss matrix file " << filename << " is too long");
+            }
+          length += std::fread (&buffer[length], 1, capacity - length, file);
+        }
+    }
+  std::fclose (file);
+  SetLossMatrix (entries, symmetric);
+}
+
+double
+MatrixPropagationLossModel::GetNodeLoss (uint32_t tx, uint32_t rx) const
+{
+  if (m_symmetricMatrix && tx > rx)
+    {
+      std::swap (tx, rx);
+    }
+  if (tx >= m_matrixNodes || rx >= m_matrixNodes)
+    {
+      return m_default;
+    }
+  if (!m_dense.empty ())
+    {
+      float loss = m_dense[GetDenseIndex (tx, rx)];
+      return loss == loss ? loss : m_default;
+    }
+  std::vector<uint32_t>::const_iterator begin = m_columns.begin () + m_rowStart[tx];
+  std::vector<uint32_t>::const_iterator end = m_columns.begin () + m_rowStart[tx + 1];
+  std::vector<uint32_t>::const_iterator i = std::lower_bound (begin, end, rx);
+  if (i != end && *i == rx)
+    {
+      return m_values[i - m_columns.begin ()];
+    }
+  return m_default;
+}
+
+uint64_t
+MatrixPropagationLossModel::GetDenseIndex (uint32_t row, uint32_t column) const
+{
+  if (m_symmetricMatrix)
+    {
+      // lower triangle of the transpose, row <= column
+      return (uint64_t)column * (column + 1) / 2 + row;
+    }
+  return (uint64_t)row * m_matrixNodes + column;
+}
+
+bool
+MatrixPropagationLossModel::CompareColumns (const std::pair<uint32_t, float> &a,
+                                            const std::pair<uint32_t, float> &b)
+{
+  return a.first < b.first;
+}
+
 double 
 MatrixPropagationLossModel::DoCalcRxPower (double txPowerDbm,
                                            Ptr<MobilityModel> a,
                                            Ptr<MobilityModel> b) const
 {
-  std::map<MobilityPair, double>::const_iterator i = m_loss.find (std::make_pair (a, b));
-
-  if (i != m_loss.end ())
+  if (!m_loss.empty ())
     {
-      return txPowerDbm - i->second;
+      std::map<MobilityPair, double>::const_iterator i = m_loss.find (std::make_pair (a, b));
+      if (i != m_loss.end ())
+        {
+          return txPowerDbm - i->second;
+        }
     }
-  else
+  if (m_matrixNodes != 0)
     {
-      return txPowerDbm - m_default;
+      Ptr<Node> tx = a->GetObject<Node> ();
+      Ptr<Node> rx = b->GetObject<Node> ();
+      if (tx != 0 && rx != 0)
+        {
+          return txPowerDbm - GetNodeLoss (tx->GetId (), rx->GetId ());
+        }
     }
+  return txPowerDbm - m_default;
 }
 
 int64_t
@@ -28,6 +28,7 @@
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -750,6 +751,13 @@ private:
  * \brief The propagation loss is fixed for each pair of nodes and doesn't depend on their actual positions.
  * 
  * This is supposed to be used by synthetic tests. Note that by default propagation loss is assumed to be symmetric.
+ *
+ * The losses can also be given per pair of node indices (Node::GetId), e.g.
+ * from a measured site survey, with SetLossMatrix or LoadLossMatrix. They
+ * are kept in a compressed sparse row matrix, or in a dense one when most
+ * of the pairs are known, with a single triangle for symmetric losses.
+ * The losses set with SetLoss take precedence over the matrix, and
+ * DefaultLoss is used for the pairs which are in neither of them.
  */
 class MatrixPropagationLossModel : public PropagationLossModel
 {
@@ -760,6 +768,14 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /// The loss between two nodes, for SetLossMatrix
+  struct LossEntry
+  {
+    uint32_t tx;   //!< index of the transmitter node
+    uint32_t rx;   //!< index of the receiver node
+    float loss;    //!< tx -> rx path loss, positive in dB
+  };
+
   MatrixPropagationLossModel ();
   virtual ~MatrixPropagationLossModel ();
 
@@ -780,6 +796,39 @@ public:
    */
   void SetDefaultLoss (double defaultLoss);
 
+  /**
+   * \brief Replace the losses between node indices
+   *
+   * When a pair appears more than once, the last loss is kept.
+   *
+   * \param entries     losses between pairs of node indices
+   * \param symmetric   If true (default), each loss is used for both
+   *                    directions and a single triangle is stored
+   */
+  void SetLossMatrix (const std::vector<LossEntry> &entries, bool symmetric = true);
+
+  /**
+   * \brief Replace the losses between node indices by those of a survey file
+   *
+   * The file is either a text file with one "tx,rx,loss" line per pair
+   * (commas, semicolons or blanks as separators, '#' comments, and an
+   * optional header line), or a binary file made of the 8 bytes
+   * "ns3loss1" followed by (uint32_t tx, uint32_t rx, float loss) records
+   * in the byte order of the host.
+   *
+   * \param filename    name of the survey file
+   * \param symmetric   see SetLossMatrix
+   */
+  void LoadLossMatrix (std::string filename, bool symmetric = true);
+
+  /**
+   * \param tx index of the transmitter node
+   * \param rx index of the receiver node
+   * \return the tx -> rx loss (in dB, positive) of the matrix, or the
+   * default loss if the pair is not in the matrix
+   */
+  double GetNodeLoss (uint32_t tx, uint32_t rx) const;
+
 private:
   /**
    * \brief Copy constructor
@@ -800,6 +849,20 @@ private:
                                 Ptr<MobilityModel> b) const;
 
   virtual int64_t DoAssignStreams (int64_t stream);
+
+  /**
+   * \param row row of the node matrix, not greater than column if it is symmetric
+   * \param column column of the node matrix
+   * \return the index of the cell in the dense node matrix
+   */
+  uint64_t GetDenseIndex (uint32_t row, uint32_t column) const;
+  /**
+   * \param a a (column, loss) pair
+   * \param b another (column, loss) pair
+   * \return true if the column of a is lower than the one of b
+   */
+  static bool CompareColumns (const std::pair<uint32_t, float> &a,
+                              const std::pair<uint32_t, float> &b);
 private:
   double m_default; //!< default loss
 
@@ -807,6 +870,13 @@ private:
   typedef std::pair< Ptr<MobilityModel>, Ptr<MobilityModel> > MobilityPair; 
 
   std::map<MobilityPair, double> m_loss; //!< Propagation loss between pair of nodes
+
+  bool m_symmetricMatrix;          //!< a single triangle of the node matrix is stored
+  uint32_t m_matrixNodes;          //!< number of rows and columns of the node matrix
+  std::vector<float> m_dense;      //!< dense node matrix, NaN for the unknown pairs
+  std::vector<uint32_t> m_rowStart; //!< first element of each row of the sparse node matrix, and end
+  std::vector<uint32_t> m_columns; //!< columns of the sparse node matrix, sorted in each row
+  std::vector<float> m_values;     //!< losses of the sparse node matrix
 };
 
 /**
@@ -24,6 +24,9 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simulator.h"
+#include "ns3/node.h"
+#include <fstream>
+#include <unistd.h>
 
 using namespace ns3;
 
@@ -396,6 +399,95 @@ MatrixPropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class MatrixPropagationLossModelSurveyTestCase : public TestCase
+{
+public:
+  MatrixPropagationLossModelSurveyTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MatrixPropagationLossModelSurveyTestCase::MatrixPropagationLossModelSurveyTestCase ()
+  : TestCase ("Test MatrixPropagationLossModel with losses between node indices")
+{
+}
+
+void
+MatrixPropagationLossModelSurveyTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> m[4];
+  for (int i = 0; i < 4; ++i)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      m[i] = CreateObject<ConstantPositionMobilityModel> ();
+      node->AggregateObject (m[i]);
+    }
+  uint32_t id[4];
+  for (int i = 0; i < 4; ++i)
+    {
+      id[i] = m[i]->GetObject<Node> ()->GetId ();
+    }
+
+  // sparse symmetric survey, with a header, unsorted rows, a pair given
+  // twice and no end of line at the end
+  std::string csv = CreateTempDirFilename ("survey.csv");
+  std::ofstream text (csv.c_str ());
+  text << "tx,rx,loss\n"
+       << "# measured on site\n"
+       << id[2] << "," << id[0] << ",70.5\n"
+       << id[0] << ";" << id[1] << ";60\r\n"
+       << id[0] << "\t" << id[2] << "\t75.5";
+  text.close ();
+
+  Ptr<MatrixPropagationLossModel> loss = CreateObject<MatrixPropagationLossModel> ();
+  loss->SetDefaultLoss (200);
+  loss->LoadLossMatrix (csv);
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (0, m[0], m[1]), -60, 1e-6, "Loss 0 -> 1 incorrect");
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (0, m[1], m[0]), -60, 1e-6, "Loss 1 -> 0 incorrect");
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (0, m[2], m[0]), -75.5, 1e-6, "The last loss of a pair is used");
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (0, m[1], m[2]), -200, 1e-6, "Default loss expected");
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (0, m[3], m[0]), -200, 1e-6, "Default loss expected");
+  loss->SetLoss (m[0], m[1], 10);
+  NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (0, m[1], m[0]), -10, 1e-6, "SetLoss takes precedence");
+  unlink (csv.c_str ());
+
+  // dense asymmetric binary survey
+  std::string bin = CreateTempDirFilename ("survey.bin");
+  std::ofstream binary (bin.c_str (), std::ios::binary);
+  binary.write ("ns3loss1", 8);
+  for (uint32_t tx = 0; tx < 4; tx++)
+    {
+      for (uint32_t rx = 0; rx < 4; rx++)
+        {
+          if (tx != rx)
+            {
+              float value = 10 * id[tx] + id[rx];
+              binary.write (reinterpret_cast<const char *> (&id[tx]), sizeof (uint32_t));
+              binary.write (reinterpret_cast<const char *> (&id[rx]), sizeof (uint32_t));
+              binary.write (reinterpret_cast<const char *> (&value), sizeof (float));
+            }
+        }
+    }
+  binary.close ();
+
+  loss = CreateObject<MatrixPropagationLossModel> ();
+  loss->SetDefaultLoss (200);
+  loss->LoadLossMatrix (bin, /*symmetric = */ false);
+  for (uint32_t tx = 0; tx < 4; tx++)
+    {
+      for (uint32_t rx = 0; rx < 4; rx++)
+        {
+          double expected = tx == rx ? 200 : 10 * id[tx] + id[rx];
+          NS_TEST_EXPECT_MSG_EQ_TOL (loss->CalcRxPower (0, m[tx], m[rx]), -expected, 1e-3, "Loss incorrect");
+          NS_TEST_EXPECT_MSG_EQ_TOL (loss->GetNodeLoss (id[tx], id[rx]), expected, 1e-3, "Loss incorrect");
+        }
+    }
+  unlink (bin.c_str ());
+
+  Simulator::Destroy ();
+}
+
 class RangePropagationLossModelTestCase : public TestCase
 {
 public:
@@ -449,6 +541,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new TwoRayGroundPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new MatrixPropagationLossModelSurveyTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
 }
 
@@ -75,6 +75,12 @@ TypeId SixLowPanNetDevice::GetTypeId (void)
                    UintegerValue (0x0),
                    MakeUintegerAccessor (&SixLowPanNetDevice::m_compressionThreshold),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("MaxFrameSize",
+                   "The maximum MAC layer payload size. Bigger packets are fragmented. "
+                   "Zero means the MTU of the underlying NetDevice.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&SixLowPanNetDevice::m_maxFrameSize),
+                   MakeUintegerChecker<uint16_t> ())
     .AddAttribute ("ForceEtherType",
                    "Force a specific EtherType in L2 frames.",
                    BooleanValue (false),
@@ -127,6 +133,14 @@ void SixLowPanNetDevice::SetNetDevice (Ptr<NetDevice> device)
 
   NS_LOG_DEBUG ("RegisterProtocolHandler for " << device->GetInstanceTypeId ().GetName ());
 
+  // 48-bit MAC devices (Ethernet, WiFi, etc.) demultiplex on the EtherType,
+  // and the 6LoWPAN addresses can be derived from their MAC address only in this mode.
+  if (!m_forceEtherType && Mac48Address::IsMatchingType (device->GetAddress ()))
+    {
+      NS_LOG_LOGIC ("48-bit MAC address, forcing EtherType " << m_etherType);
+      m_forceEtherType = true;
+    }
+
   uint16_t protocolType = 0;
   if ( m_forceEtherType )
     {
@@ -446,9 +460,9 @@ bool SixLowPanNetDevice::DoSend (Ptr<Packet> packet,
       origHdrSize += CompressLowPanHc1 (packet, m_netDevice->GetAddress (), dest);
     }
 
-  if ( packet->GetSize () > m_netDevice->GetMtu () )
+  if ( packet->GetSize () > GetMaxFrameSize () )
     {
-      NS_LOG_LOGIC ("Fragmentation: Packet size " << packet->GetSize () << " - Mtu " << m_netDevice->GetMtu () );
+      NS_LOG_LOGIC ("Fragmentation: Packet size " << packet->GetSize () << " - Mtu " << GetMaxFrameSize () );
       // fragment
       std::list<Ptr<Packet> > fragmentList;
       DoFragmentation (packet, origPacketSize, origHdrSize, fragmentList);
@@ -1733,7 +1747,7 @@ void SixLowPanNetDevice::DoFragmentation (Ptr<Packet> packet,
 
   uint16_t offsetData = 0;
   uint16_t offset = 0;
-  uint16_t l2Mtu = m_netDevice->GetMtu ();
+  uint16_t l2Mtu = GetMaxFrameSize ();
   uint32_t packetSize = packet->GetSize ();
   uint32_t compressedHeaderSize = packetSize - (origPacketSize - origHdrSize);
 
@@ -1794,6 +1808,16 @@ void SixLowPanNetDevice::DoFragmentation (Ptr<Packet> packet,
   return;
 }
 
+uint16_t SixLowPanNetDevice::GetMaxFrameSize (void) const
+{
+  uint16_t mtu = m_netDevice->GetMtu ();
+  if (m_maxFrameSize != 0 && m_maxFrameSize < mtu)
+    {
+      mtu = m_maxFrameSize;
+    }
+  return mtu;
+}
+
 bool SixLowPanNetDevice::ProcessFragment (Ptr<Packet>& packet, Address const &src, Address const &dst, bool isFirst)
 {
   NS_LOG_FUNCTION ( this << *packet );
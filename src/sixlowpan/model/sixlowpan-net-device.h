@@ -438,6 +438,16 @@ private:
   void DoFragmentation (Ptr<Packet> packet, uint32_t origPacketSize, uint32_t origHdrSize,
                         std::list<Ptr<Packet> >& listFragments);
 
+  /**
+   * \brief Get the largest 6LoWPAN frame that can be handed to the underlying NetDevice.
+   *
+   * This is the MTU of the underlying NetDevice, further limited by the
+   * MaxFrameSize attribute if set.
+   *
+   * \return the largest frame size in bytes
+   */
+  uint16_t GetMaxFrameSize (void) const;
+
   /**
    * \brief Process a packet fragment
    * \param packet the packet
@@ -503,6 +513,7 @@ private:
   bool m_omitUdpChecksum; /**< Omit UDP checksum in NC1 encoding */
 
   uint32_t m_compressionThreshold; /**< Minimum L2 payload size */
+  uint16_t m_maxFrameSize; /**< Maximum L2 payload size (zero: underlying NetDevice MTU) */
 
   Ptr<UniformRandomVariable> m_rng; //!< Rng for the fragments tag.
 };
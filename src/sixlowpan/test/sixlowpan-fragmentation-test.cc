@@ -39,6 +39,7 @@
 #include "ns3/ipv6-list-routing.h"
 #include "ns3/inet6-socket-address.h"
 #include "ns3/sixlowpan-net-device.h"
+#include "sixlowpan-test-stack.h"
 
 #include "ns3/udp-l4-protocol.h"
 
@@ -47,38 +48,13 @@
 
 #include <string>
 #include <limits>
+#include <algorithm>
 #include <netinet/in.h>
 
 using namespace ns3;
 
 class UdpSocketImpl;
 
-static void
-AddInternetStack (Ptr<Node> node)
-{
-  //IPV6
-  Ptr<Ipv6L3Protocol> ipv6 = CreateObject<Ipv6L3Protocol> ();
-
-  //Routing for Ipv6
-  Ptr<Ipv6ListRouting> ipv6Routing = CreateObject<Ipv6ListRouting> ();
-  ipv6->SetRoutingProtocol (ipv6Routing);
-  Ptr<Ipv6StaticRouting> ipv6staticRouting = CreateObject<Ipv6StaticRouting> ();
-  ipv6Routing->AddRoutingProtocol (ipv6staticRouting, 0);
-  node->AggregateObject (ipv6);
-
-  //ICMPv6
-  Ptr<Icmpv6L4Protocol> icmp6 = CreateObject<Icmpv6L4Protocol> ();
-  node->AggregateObject (icmp6);
-
-  //Ipv6 Extensions
-  ipv6->RegisterExtensions ();
-  ipv6->RegisterOptions ();
-
-  //UDP
-  Ptr<UdpL4Protocol> udp = CreateObject<UdpL4Protocol> ();
-  node->AggregateObject (udp);
-}
-
 
 class SixlowpanFragmentationTest : public TestCase
 {
@@ -94,6 +70,8 @@ class SixlowpanFragmentationTest : public TestCase
   uint32_t m_size;
   uint8_t m_icmpType;
   uint8_t m_icmpCode;
+  uint32_t m_clientFrames;
+  uint32_t m_clientMaxFrameSize;
 
 public:
   virtual void DoRun (void);
@@ -110,6 +88,8 @@ public:
   void HandleReadIcmpClient (Ipv6Address icmpSource, uint8_t icmpTtl, uint8_t icmpType,
                              uint8_t icmpCode,uint32_t icmpInfo);
 
+  void HandleTxClient (Ptr<const Packet> packet, Ptr<SixLowPanNetDevice> sixNetDevice, uint32_t ifIndex);
+
   void SetFill (uint8_t *fill, uint32_t fillSize, uint32_t dataSize);
   Ptr<Packet> SendClient (void);
 
@@ -122,6 +102,8 @@ SixlowpanFragmentationTest::SixlowpanFragmentationTest ()
   m_socketServer = 0;
   m_data = 0;
   m_dataSize = 0;
+  m_clientFrames = 0;
+  m_clientMaxFrameSize = 0;
 }
 
 SixlowpanFragmentationTest::~SixlowpanFragmentationTest ()
@@ -208,6 +190,14 @@ SixlowpanFragmentationTest::HandleReadIcmpClient (Ipv6Address icmpSource,
   m_icmpCode = icmpCode;
 }
 
+void
+SixlowpanFragmentationTest::HandleTxClient (Ptr<const Packet> packet,
+                                            Ptr<SixLowPanNetDevice> sixNetDevice, uint32_t ifIndex)
+{
+  m_clientFrames++;
+  m_clientMaxFrameSize = std::max (m_clientMaxFrameSize, packet->GetSize ());
+}
+
 void
 SixlowpanFragmentationTest::SetFill (uint8_t *fill, uint32_t fillSize, uint32_t dataSize)
 {
@@ -261,7 +251,7 @@ SixlowpanFragmentationTest::DoRun (void)
 
   // Receiver Node
   Ptr<Node> serverNode = CreateObject<Node> ();
-  AddInternetStack (serverNode);
+  SixLowPanTestAddInternetStack (serverNode);
   Ptr<SimpleNetDevice> serverDev;
   Ptr<BinaryErrorSixlowModel> serverDevErrorModel = CreateObject<BinaryErrorSixlowModel> ();
   {
@@ -282,18 +272,15 @@ SixlowpanFragmentationTest::DoRun (void)
 
     Ptr<Ipv6> ipv6 = serverNode->GetObject<Ipv6> ();
     ipv6->AddInterface (serverDev);
-    uint32_t netdev_idx = ipv6->AddInterface (serverSix);
-    Ipv6InterfaceAddress ipv6Addr = Ipv6InterfaceAddress (Ipv6Address ("2001:0100::1"), Ipv6Prefix (64));
-    ipv6->AddAddress (netdev_idx, ipv6Addr);
-    ipv6->SetUp (netdev_idx);
-
+    SixLowPanTestAddInterface (serverNode, serverSix, Ipv6Address ("2001:0100::1"));
   }
   StartServer (serverNode);
 
   // Sender Node
   Ptr<Node> clientNode = CreateObject<Node> ();
-  AddInternetStack (clientNode);
+  SixLowPanTestAddInternetStack (clientNode);
   Ptr<SimpleNetDevice> clientDev;
+  Ptr<SixLowPanNetDevice> clientSix;
   Ptr<BinaryErrorSixlowModel> clientDevErrorModel = CreateObject<BinaryErrorSixlowModel> ();
   {
     Ptr<Icmpv6L4Protocol> icmpv6l4 = clientNode->GetObject<Icmpv6L4Protocol> ();
@@ -306,17 +293,14 @@ SixlowpanFragmentationTest::DoRun (void)
     clientDevErrorModel->Disable ();
     clientNode->AddDevice (clientDev);
 
-    Ptr<SixLowPanNetDevice> clientSix = CreateObject<SixLowPanNetDevice> ();
+    clientSix = CreateObject<SixLowPanNetDevice> ();
     clientSix->SetAttribute ("ForceEtherType", BooleanValue (true) );
     clientNode->AddDevice (clientSix);
     clientSix->SetNetDevice (clientDev);
 
     Ptr<Ipv6> ipv6 = clientNode->GetObject<Ipv6> ();
     ipv6->AddInterface (clientDev);
-    uint32_t netdev_idx = ipv6->AddInterface (clientSix);
-    Ipv6InterfaceAddress ipv6Addr = Ipv6InterfaceAddress (Ipv6Address ("2001:0100::2"), Ipv6Prefix (64));
-    ipv6->AddAddress (netdev_idx, ipv6Addr);
-    ipv6->SetUp (netdev_idx);
+    SixLowPanTestAddInterface (clientNode, clientSix, Ipv6Address ("2001:0100::2"));
   }
   StartClient (clientNode);
 
@@ -449,6 +433,39 @@ SixlowpanFragmentationTest::DoRun (void)
       // Note that a 6LoWPAN fragment timeout does NOT send any ICMPv6.
     }
 
+  // Fifth test: the L2 MTU is big enough, but the frames are limited by MaxFrameSize.
+  // The packets are fragmented as if the L2 MTU was MaxFrameSize.
+  serverDevErrorModel->Disable ();
+  clientDev->SetMtu (1500);
+  clientSix->SetAttribute ("MaxFrameSize", UintegerValue (150));
+  clientSix->TraceConnectWithoutContext ("Tx", MakeCallback (&SixlowpanFragmentationTest::HandleTxClient, this));
+  for ( int i = 0; i < 5; i++)
+    {
+      uint32_t packetSize = packetSizes[i];
+
+      SetFill (fillData, 78, packetSize);
+
+      m_receivedPacketServer = Create<Packet> ();
+      m_clientFrames = 0;
+      m_clientMaxFrameSize = 0;
+      Simulator::ScheduleWithContext (m_socketClient->GetNode ()->GetId (), Seconds (0),
+                                      &SixlowpanFragmentationTest::SendClient, this);
+      Simulator::Run ();
+
+      uint8_t recvBuffer[65000];
+
+      uint16_t recvSize = m_receivedPacketServer->GetSize ();
+
+      NS_TEST_EXPECT_MSG_EQ (recvSize, packetSizes[i],
+                             "Packet size not correct: recvSize: " << recvSize << " packetSizes[" << i << "]: " << packetSizes[i] );
+      NS_TEST_EXPECT_MSG_GT (m_clientFrames, 1, "Packet not fragmented");
+      NS_TEST_EXPECT_MSG_LT_OR_EQ (m_clientMaxFrameSize, 150, "Frame bigger than MaxFrameSize");
+
+      m_receivedPacketServer->CopyData (recvBuffer, 65000);
+      NS_TEST_EXPECT_MSG_EQ (memcmp (m_data, recvBuffer, m_receivedPacketServer->GetSize ()),
+                             0, "Packet content differs");
+    }
+
 
 
   Simulator::Destroy ();
@@ -39,34 +39,13 @@
 #include "ns3/ipv6-static-routing.h"
 
 #include "ns3/sixlowpan-net-device.h"
+#include "sixlowpan-test-stack.h"
 
 #include <string>
 #include <limits>
 
 using namespace ns3;
 
-static void
-AddInternetStack6 (Ptr<Node> node)
-{
-  //IPV6
-  Ptr<Ipv6L3Protocol> ipv6 = CreateObject<Ipv6L3Protocol> ();
-  //Routing for Ipv6
-  Ptr<Ipv6ListRouting> ipv6Routing = CreateObject<Ipv6ListRouting> ();
-  ipv6->SetRoutingProtocol (ipv6Routing);
-  Ptr<Ipv6StaticRouting> ipv6staticRouting = CreateObject<Ipv6StaticRouting> ();
-  ipv6Routing->AddRoutingProtocol (ipv6staticRouting, 0);
-  node->AggregateObject (ipv6);
-  //ICMP
-  Ptr<Icmpv6L4Protocol> icmp = CreateObject<Icmpv6L4Protocol> ();
-  node->AggregateObject (icmp);
-  //Ipv6 Extensions
-  ipv6->RegisterExtensions ();
-  ipv6->RegisterOptions ();
-  //UDP
-  Ptr<UdpL4Protocol> udp = CreateObject<UdpL4Protocol> ();
-  node->AggregateObject (udp);
-}
-
 
 class SixlowpanIphcImplTest : public TestCase
 {
@@ -130,7 +109,7 @@ SixlowpanIphcImplTest::DoRun (void)
 
   // Receiver Node
   Ptr<Node> rxNode = CreateObject<Node> ();
-  AddInternetStack6 (rxNode);
+  SixLowPanTestAddInternetStack (rxNode);
   Ptr<SimpleNetDevice> rxDev;
   { // first interface
     rxDev = CreateObject<SimpleNetDevice> ();
@@ -144,15 +123,12 @@ SixlowpanIphcImplTest::DoRun (void)
 
     Ptr<Ipv6> ipv6 = rxNode->GetObject<Ipv6> ();
     ipv6->AddInterface (rxDev);
-    uint32_t netdev_idx = ipv6->AddInterface (rxSix);
-    Ipv6InterfaceAddress ipv6Addr = Ipv6InterfaceAddress (Ipv6Address ("2001:0100::1"), Ipv6Prefix (64));
-    ipv6->AddAddress (netdev_idx, ipv6Addr);
-    ipv6->SetUp (netdev_idx);
+    SixLowPanTestAddInterface (rxNode, rxSix, Ipv6Address ("2001:0100::1"));
   }
 
   // Sender Node
   Ptr<Node> txNode = CreateObject<Node> ();
-  AddInternetStack6 (txNode);
+  SixLowPanTestAddInternetStack (txNode);
   Ptr<SimpleNetDevice> txDev;
   {
     txDev = CreateObject<SimpleNetDevice> ();
@@ -166,10 +142,7 @@ SixlowpanIphcImplTest::DoRun (void)
 
     Ptr<Ipv6> ipv6 = txNode->GetObject<Ipv6> ();
     ipv6->AddInterface (txDev);
-    uint32_t netdev_idx = ipv6->AddInterface (txSix);
-    Ipv6InterfaceAddress ipv6Addr = Ipv6InterfaceAddress (Ipv6Address ("2001:0100::2"), Ipv6Prefix (64));
-    ipv6->AddAddress (netdev_idx, ipv6Addr);
-    ipv6->SetUp (netdev_idx);
+    SixLowPanTestAddInterface (txNode, txSix, Ipv6Address ("2001:0100::2"));
   }
 
   // link the two nodes
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "sixlowpan-test-stack.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/icmpv6-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/ipv6-list-routing.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/traffic-control-layer.h"
+
+namespace ns3 {
+
+void
+SixLowPanTestAddInternetStack (Ptr<Node> node)
+{
+  //IPV6
+  Ptr<Ipv6L3Protocol> ipv6 = CreateObject<Ipv6L3Protocol> ();
+  //Routing for Ipv6
+  Ptr<Ipv6ListRouting> ipv6Routing = CreateObject<Ipv6ListRouting> ();
+  ipv6->SetRoutingProtocol (ipv6Routing);
+  Ptr<Ipv6StaticRouting> ipv6staticRouting = CreateObject<Ipv6StaticRouting> ();
+  ipv6Routing->AddRoutingProtocol (ipv6staticRouting, 0);
+  node->AggregateObject (ipv6);
+  //ICMP
+  Ptr<Icmpv6L4Protocol> icmp = CreateObject<Icmpv6L4Protocol> ();
+  node->AggregateObject (icmp);
+  //Ipv6 Extensions
+  ipv6->RegisterExtensions ();
+  ipv6->RegisterOptions ();
+  //UDP
+  Ptr<UdpL4Protocol> udp = CreateObject<UdpL4Protocol> ();
+  node->AggregateObject (udp);
+  //Traffic Control
+  Ptr<TrafficControlLayer> tc = CreateObject<TrafficControlLayer> ();
+  node->AggregateObject (tc);
+}
+
+uint32_t
+SixLowPanTestAddInterface (Ptr<Node> node, Ptr<NetDevice> device, Ipv6Address address)
+{
+  Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+  uint32_t netdev_idx = ipv6->AddInterface (device);
+  ipv6->AddAddress (netdev_idx, Ipv6InterfaceAddress (address, Ipv6Prefix (64)));
+  Mac48Address mac = Mac48Address::ConvertFrom (device->GetAddress ());
+  ipv6->AddAddress (netdev_idx, Ipv6InterfaceAddress (Ipv6Address::MakeAutoconfiguredLinkLocalAddress (mac), Ipv6Prefix (64)));
+  ipv6->SetUp (netdev_idx);
+  return netdev_idx;
+}
+
+} // namespace ns3
@@ -0,0 +1,49 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SIXLOWPAN_TEST_STACK_H
+#define SIXLOWPAN_TEST_STACK_H
+
+#include "ns3/ptr.h"
+#include "ns3/ipv6-address.h"
+
+namespace ns3 {
+
+class Node;
+class NetDevice;
+
+/**
+ * \brief Install IPv6, ICMPv6, UDP and the traffic control layer on a node
+ * \param node the node
+ */
+void SixLowPanTestAddInternetStack (Ptr<Node> node);
+
+/**
+ * \brief Add an IPv6 interface for a 6LoWPAN device and bring it up
+ *
+ * Besides the given global address, the interface gets the link-local
+ * address derived from the 48-bit MAC of the device, which the IPv6
+ * interface does not configure by itself for such devices.
+ *
+ * \param node the node, with the stack of SixLowPanTestAddInternetStack
+ * \param device the 6LoWPAN device
+ * \param address the global address of the interface
+ * \returns the interface index
+ */
+uint32_t SixLowPanTestAddInterface (Ptr<Node> node, Ptr<NetDevice> device, Ipv6Address address);
+
+} // namespace ns3
+
+#endif /* SIXLOWPAN_TEST_STACK_H */
@@ -18,12 +18,12 @@
  * Author: Joe Kopena (tjkopena@cs.drexel.edu)
  */
 
-#include <sstream>
 
 #include <sqlite3.h>
 
 #include "ns3/log.h"
 #include "ns3/nstime.h"
+#include "ns3/uinteger.h"
 
 #include "data-collector.h"
 #include "data-calculator.h"
@@ -36,6 +36,10 @@ NS_LOG_COMPONENT_DEFINE ("SqliteDataOutput");
 //--------------------------------------------------------------
 //----------------------------------------------
 SqliteDataOutput::SqliteDataOutput()
+  : m_db (0),
+    m_batchSize (10000),
+    m_pendingRows (0),
+    m_singletonStmt (0)
 {
   NS_LOG_FUNCTION (this);
 
@@ -44,6 +48,7 @@ SqliteDataOutput::SqliteDataOutput()
 SqliteDataOutput::~SqliteDataOutput()
 {
   NS_LOG_FUNCTION (this);
+  Close ();
 }
 /* static */
 TypeId
@@ -52,7 +57,12 @@ SqliteDataOutput::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::SqliteDataOutput")
     .SetParent<DataOutputInterface> ()
     .SetGroupName ("Stats")
-    .AddConstructor<SqliteDataOutput> ();
+    .AddConstructor<SqliteDataOutput> ()
+    .AddAttribute ("BatchSize",
+                   "The number of rows inserted per transaction, 0 for a single transaction.",
+                   UintegerValue (10000),
+                   MakeUintegerAccessor (&SqliteDataOutput::m_batchSize),
+                   MakeUintegerChecker<uint32_t> ());
   return tid;
 }
   
@@ -61,6 +71,7 @@ SqliteDataOutput::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
 
+  Close ();
   DataOutputInterface::DoDispose ();
   // end SqliteDataOutput::DoDispose
 }
@@ -110,11 +121,57 @@ SqliteDataOutput::Exec (std::string exe) {
   // end SqliteDataOutput::Exec
 }
 
-//----------------------------------------------
+sqlite3_stmt *
+SqliteDataOutput::Prepare (std::string sql)
+{
+  NS_LOG_FUNCTION (this << sql);
+
+  sqlite3_stmt *stmt = 0;
+  if (sqlite3_prepare_v2 (m_db, sql.c_str (), -1, &stmt, 0) != SQLITE_OK) {
+      NS_LOG_ERROR ("sqlite3 error: \"" << sqlite3_errmsg (m_db) << "\"");
+      sqlite3_finalize (stmt);
+      return 0;
+    }
+  return stmt;
+}
+
 void
-SqliteDataOutput::Output (DataCollector &dc)
+SqliteDataOutput::Insert (sqlite3_stmt *stmt)
 {
-  NS_LOG_FUNCTION (this << &dc);
+  if (sqlite3_step (stmt) != SQLITE_DONE) {
+      NS_LOG_ERROR ("sqlite3 error: \"" << sqlite3_errmsg (m_db) << "\"");
+    }
+  sqlite3_reset (stmt);
+  sqlite3_clear_bindings (stmt);
+
+  if (m_batchSize > 0 && ++m_pendingRows >= m_batchSize) {
+      Exec ("COMMIT");
+      Exec ("BEGIN");
+      m_pendingRows = 0;
+    }
+}
+
+std::string
+SqliteDataOutput::QuoteIdentifier (std::string name)
+{
+  std::string quoted = "\"";
+  for (std::string::const_iterator i = name.begin (); i != name.end (); i++) {
+      if (*i == '"') {
+          quoted += '"';
+        }
+      quoted += *i;
+    }
+  return quoted + "\"";
+}
+
+bool
+SqliteDataOutput::Open (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_db) {
+      return true;
+    }
 
   std::string m_dbFile = m_filePrefix + ".db";
 
@@ -122,40 +179,131 @@ SqliteDataOutput::Output (DataCollector &dc)
       NS_LOG_ERROR ("Could not open sqlite3 database \"" << m_dbFile << "\"");
       NS_LOG_ERROR ("sqlite3 error \"" << sqlite3_errmsg (m_db) << "\"");
       sqlite3_close (m_db);
+      m_db = 0;
       /// \todo Better error reporting, management!
+      return false;
+    }
+
+  Exec ("BEGIN");
+  m_pendingRows = 0;
+  return true;
+}
+
+void
+SqliteDataOutput::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_db) {
+      return;
+    }
+
+  Exec ("COMMIT");
+  sqlite3_finalize (m_singletonStmt);
+  m_singletonStmt = 0;
+  for (std::map<std::string, std::pair<sqlite3_stmt *, uint32_t> >::iterator i = m_wideTables.begin ();
+       i != m_wideTables.end (); i++) {
+      sqlite3_finalize (i->second.first);
+    }
+  m_wideTables.clear ();
+  sqlite3_close (m_db);
+  m_db = 0;
+}
+
+void
+SqliteDataOutput::CreateWideTable (std::string table, const std::vector<std::string> &columns)
+{
+  NS_LOG_FUNCTION (this << table);
+
+  if (!Open () || m_wideTables.find (table) != m_wideTables.end ()) {
+      return;
+    }
+
+  std::string create = "create table if not exists " + QuoteIdentifier (table) +
+    " (run text, time integer, id integer";
+  std::string insert = "insert into " + QuoteIdentifier (table) + " values (?, ?, ?";
+  for (std::vector<std::string>::const_iterator i = columns.begin (); i != columns.end (); i++) {
+      create += ", " + QuoteIdentifier (*i) + " real";
+      insert += ", ?";
+    }
+  Exec (create + ")");
+
+  sqlite3_stmt *stmt = Prepare (insert + ")");
+  if (stmt) {
+      m_wideTables[table] = std::make_pair (stmt, columns.size ());
+    }
+}
+
+void
+SqliteDataOutput::AddWideRow (std::string table, std::string run, Time time, uint32_t id,
+                              const std::vector<double> &values)
+{
+  NS_LOG_FUNCTION (this << table << run << time << id);
+
+  std::map<std::string, std::pair<sqlite3_stmt *, uint32_t> >::iterator it = m_wideTables.find (table);
+  if (it == m_wideTables.end ()) {
+      NS_LOG_ERROR ("Unknown wide table \"" << table << "\", use CreateWideTable first");
+      return;
+    }
+  NS_ASSERT_MSG (values.size () == it->second.second,
+                 "Expected " << it->second.second << " values for table " << table);
+
+  sqlite3_stmt *stmt = it->second.first;
+  sqlite3_bind_text (stmt, 1, run.c_str (), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64 (stmt, 2, time.GetTimeStep ());
+  sqlite3_bind_int64 (stmt, 3, id);
+  for (uint32_t i = 0; i < values.size (); i++) {
+      sqlite3_bind_double (stmt, i + 4, values[i]);
+    }
+  Insert (stmt);
+}
+
+//----------------------------------------------
+void
+SqliteDataOutput::Output (DataCollector &dc)
+{
+  NS_LOG_FUNCTION (this << &dc);
+
+  bool wasOpen = (m_db != 0);
+  if (!Open ()) {
       return;
     }
 
   std::string run = dc.GetRunLabel ();
 
   Exec ("create table if not exists Experiments (run, experiment, strategy, input, description text)");
-  Exec ("insert into Experiments (run,experiment,strategy,input,description) values ('" +
-        run + "', '" +
-        dc.GetExperimentLabel () + "', '" +
-        dc.GetStrategyLabel () + "', '" +
-        dc.GetInputLabel () + "', '" +
-        dc.GetDescription () + "')");
+  sqlite3_stmt *stmt = Prepare ("insert into Experiments (run,experiment,strategy,input,description) values (?, ?, ?, ?, ?)");
+  if (stmt) {
+      sqlite3_bind_text (stmt, 1, run.c_str (), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text (stmt, 2, dc.GetExperimentLabel ().c_str (), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text (stmt, 3, dc.GetStrategyLabel ().c_str (), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text (stmt, 4, dc.GetInputLabel ().c_str (), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text (stmt, 5, dc.GetDescription ().c_str (), -1, SQLITE_TRANSIENT);
+      Insert (stmt);
+      sqlite3_finalize (stmt);
+    }
 
   Exec ("create table if not exists Metadata ( run text, key text, value)");
-
+  stmt = Prepare ("insert into Metadata (run,key,value) values (?, ?, ?)");
   for (MetadataList::iterator i = dc.MetadataBegin ();
-       i != dc.MetadataEnd (); i++) {
+       stmt && i != dc.MetadataEnd (); i++) {
       std::pair<std::string, std::string> blob = (*i);
-      Exec ("insert into Metadata (run,key,value) values ('" +
-            run + "', '" +
-            blob.first + "', '" +
-            blob.second + "')");
+      sqlite3_bind_text (stmt, 1, run.c_str (), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text (stmt, 2, blob.first.c_str (), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text (stmt, 3, blob.second.c_str (), -1, SQLITE_TRANSIENT);
+      Insert (stmt);
     }
+  sqlite3_finalize (stmt);
 
-  Exec ("BEGIN");
   SqliteOutputCallback callback (this, run);
   for (DataCalculatorList::iterator i = dc.DataCalculatorBegin ();
        i != dc.DataCalculatorEnd (); i++) {
       (*i)->Output (callback);
     }
-  Exec ("COMMIT");
 
-  sqlite3_close (m_db);
+  if (!wasOpen) {
+      Close ();
+    }
 
   // end SqliteDataOutput::Output
 }
@@ -168,10 +316,26 @@ SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback
   NS_LOG_FUNCTION (this << owner << run);
 
   m_owner->Exec ("create table if not exists Singletons ( run text, name text, variable text, value )");
+  if (!m_owner->m_singletonStmt) {
+      m_owner->m_singletonStmt = m_owner->Prepare ("insert into Singletons (run,name,variable,value) values (?, ?, ?, ?)");
+    }
 
   // end SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback
 }
 
+sqlite3_stmt *
+SqliteDataOutput::SqliteOutputCallback::BindSingleton (std::string key,
+                                                       std::string variable)
+{
+  sqlite3_stmt *stmt = m_owner->m_singletonStmt;
+  if (stmt) {
+      sqlite3_bind_text (stmt, 1, m_runLabel.c_str (), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text (stmt, 2, key.c_str (), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text (stmt, 3, variable.c_str (), -1, SQLITE_TRANSIENT);
+    }
+  return stmt;
+}
+
 void
 SqliteDataOutput::SqliteOutputCallback::OutputStatistic (std::string key,
                                                          std::string variable,
@@ -200,13 +364,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', " <<
-  val << ")";
-  m_owner->Exec (sstr.str ());
+  sqlite3_stmt *stmt = BindSingleton (key, variable);
+  if (!stmt)
+    return;
+  sqlite3_bind_int (stmt, 4, val);
+  m_owner->Insert (stmt);
 
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
@@ -217,13 +379,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', " <<
-  val << ")";
-  m_owner->Exec (sstr.str ());
+  sqlite3_stmt *stmt = BindSingleton (key, variable);
+  if (!stmt)
+    return;
+  sqlite3_bind_int64 (stmt, 4, val);
+  m_owner->Insert (stmt);
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
 void
@@ -233,13 +393,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', " <<
-  val << ")";
-  m_owner->Exec (sstr.str ());
+  sqlite3_stmt *stmt = BindSingleton (key, variable);
+  if (!stmt)
+    return;
+  sqlite3_bind_double (stmt, 4, val);
+  m_owner->Insert (stmt);
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
 void
@@ -249,13 +407,11 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', '" <<
-  val << "')";
-  m_owner->Exec (sstr.str ());
+  sqlite3_stmt *stmt = BindSingleton (key, variable);
+  if (!stmt)
+    return;
+  sqlite3_bind_text (stmt, 4, val.c_str (), -1, SQLITE_TRANSIENT);
+  m_owner->Insert (stmt);
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
 void
@@ -265,12 +421,10 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton (std::string key,
 {
   NS_LOG_FUNCTION (this << key << variable << val);
 
-  std::stringstream sstr;
-  sstr << "insert into Singletons (run,name,variable,value) values ('" <<
-  m_runLabel << "', '" <<
-  key << "', '" <<
-  variable << "', " <<
-  val.GetTimeStep () << ")";
-  m_owner->Exec (sstr.str ());
+  sqlite3_stmt *stmt = BindSingleton (key, variable);
+  if (!stmt)
+    return;
+  sqlite3_bind_int64 (stmt, 4, val.GetTimeStep ());
+  m_owner->Insert (stmt);
   // end SqliteDataOutput::SqliteOutputCallback::OutputSingleton
 }
@@ -21,6 +21,9 @@
 #ifndef SQLITE_DATA_OUTPUT_H
 #define SQLITE_DATA_OUTPUT_H
 
+#include <map>
+#include <vector>
+
 #include "ns3/nstime.h"
 
 #include "data-output-interface.h"
@@ -28,6 +31,7 @@
 #define STATS_HAS_SQLITE3
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace ns3 {
 
@@ -37,6 +41,11 @@ namespace ns3 {
  * \ingroup dataoutput
  * \class SqliteDataOutput
  * \brief Outputs data in a format compatible with SQLite
+ *
+ * All the rows are inserted through prepared statements, and committed
+ * in transactions of BatchSize rows.  Besides the DataCollector output,
+ * per-node metrics can be written to "wide" tables holding one row per
+ * snapshot of a node and one column per metric, see CreateWideTable.
  */
 class SqliteDataOutput : public DataOutputInterface {
 public:
@@ -51,6 +60,37 @@ public:
   
   virtual void Output (DataCollector &dc);
 
+  /**
+   * \brief Open the database, named after the file prefix, and keep it
+   * open until Close.  Output writes to the opened database as well.
+   * \return true if the database could be opened
+   */
+  bool Open (void);
+  /**
+   * \brief Commit the pending rows and close the database
+   */
+  void Close (void);
+
+  /**
+   * \brief Create a wide table, if it does not exist yet
+   *
+   * Each row of the table holds the run label, the time of the snapshot,
+   * the id of the entity (e.g. the node) measured, and one column per metric.
+   * \param table the name of the table
+   * \param columns the names of the metrics
+   */
+  void CreateWideTable (std::string table, const std::vector<std::string> &columns);
+  /**
+   * \brief Add a row to a wide table
+   * \param table the name of the table, as given to CreateWideTable
+   * \param run the run label
+   * \param time the time of the snapshot
+   * \param id the id of the entity measured
+   * \param values the metrics, in the order of the columns of the table
+   */
+  void AddWideRow (std::string table, std::string run, Time time, uint32_t id,
+                   const std::vector<double> &values);
+
 protected:
   virtual void DoDispose ();
 
@@ -130,6 +170,14 @@ public:
                           Time val);
 
 private:
+    /**
+     * \brief Bind the run, key and variable of a Singletons row
+     * \param key the SQL key to use
+     * \param variable the variable name
+     * \return the statement, whose value is left to bind
+     */
+    sqlite3_stmt * BindSingleton (std::string key, std::string variable);
+
     Ptr<SqliteDataOutput> m_owner; //!< the instance this object belongs to
     std::string m_runLabel; //!< Run label
 
@@ -138,6 +186,10 @@ private:
 
 
   sqlite3 *m_db; //!< pointer to the SQL database
+  uint32_t m_batchSize; //!< rows per transaction (0 for a single transaction)
+  uint32_t m_pendingRows; //!< rows inserted in the current transaction
+  sqlite3_stmt *m_singletonStmt; //!< insertion into the Singletons table
+  std::map<std::string, std::pair<sqlite3_stmt *, uint32_t> > m_wideTables; //!< insertion statement and number of metrics of the wide tables
 
   /**
    * \brief Execute a sqlite3 query
@@ -146,6 +198,26 @@ private:
    */
   int Exec (std::string exe);
 
+  /**
+   * \brief Compile a sqlite3 statement
+   * \param sql the statement, with ? for the parameters
+   * \return the compiled statement, 0 on error
+   */
+  sqlite3_stmt * Prepare (std::string sql);
+
+  /**
+   * \brief Run an insertion whose parameters are bound, and commit the
+   * transaction once BatchSize rows were inserted
+   * \param stmt the statement
+   */
+  void Insert (sqlite3_stmt *stmt);
+
+  /**
+   * \param name a table or column name
+   * \return the name quoted as a SQL identifier
+   */
+  static std::string QuoteIdentifier (std::string name);
+
   // end class SqliteDataOutput
 };
 
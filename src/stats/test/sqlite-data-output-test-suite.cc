@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sqlite3.h>
+#include <unistd.h>
+
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/data-collector.h"
+#include "ns3/basic-data-calculators.h"
+#include "ns3/sqlite-data-output.h"
+
+using namespace ns3;
+
+/**
+ * \return the text of the first column of the first row of the query, or
+ * "" if there is no row
+ */
+static std::string
+QueryText (std::string dbFile, std::string query)
+{
+  sqlite3 *db;
+  std::string text;
+  if (sqlite3_open (dbFile.c_str (), &db) == SQLITE_OK)
+    {
+      sqlite3_stmt *stmt;
+      if (sqlite3_prepare_v2 (db, query.c_str (), -1, &stmt, 0) == SQLITE_OK
+          && sqlite3_step (stmt) == SQLITE_ROW
+          && sqlite3_column_text (stmt, 0))
+        {
+          text = reinterpret_cast<const char *> (sqlite3_column_text (stmt, 0));
+        }
+      sqlite3_finalize (stmt);
+    }
+  sqlite3_close (db);
+  return text;
+}
+
+// ===========================================================================
+// Rows of the wide tables, committed in several transactions.
+// ===========================================================================
+
+class SqliteWideTableTestCase : public TestCase
+{
+public:
+  SqliteWideTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SqliteWideTableTestCase::SqliteWideTableTestCase ()
+  : TestCase ("Per-node metrics in a wide table")
+{
+}
+
+void
+SqliteWideTableTestCase::DoRun (void)
+{
+  std::string prefix = CreateTempDirFilename ("sqlite-wide");
+  Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+  output->SetFilePrefix (prefix);
+  output->SetAttribute ("BatchSize", UintegerValue (2));
+
+  std::vector<std::string> columns;
+  columns.push_back ("tx");
+  columns.push_back ("it's \"quoted\"");
+  output->CreateWideTable ("Node Statistics", columns);
+  for (uint32_t id = 0; id < 5; id++)
+    {
+      std::vector<double> values;
+      values.push_back (id);
+      values.push_back (0.5);
+      output->AddWideRow ("Node Statistics", "run'1", Seconds (1), id, values);
+    }
+  output->Close ();
+
+  std::string dbFile = prefix + ".db";
+  NS_TEST_EXPECT_MSG_EQ (QueryText (dbFile, "select count(*) from \"Node Statistics\""), "5",
+                         "Wrong number of rows");
+  NS_TEST_EXPECT_MSG_EQ (QueryText (dbFile, "select sum(tx) from \"Node Statistics\" where run = 'run''1'"), "10.0",
+                         "Wrong metrics");
+  NS_TEST_EXPECT_MSG_EQ (QueryText (dbFile, "select \"it's \"\"quoted\"\"\" from \"Node Statistics\" where id = 4"), "0.5",
+                         "Wrong metrics");
+  unlink (dbFile.c_str ());
+}
+
+// ===========================================================================
+// DataCollector output, with labels that are not valid SQL literals.
+// ===========================================================================
+
+class SqliteDataCollectorTestCase : public TestCase
+{
+public:
+  SqliteDataCollectorTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+SqliteDataCollectorTestCase::SqliteDataCollectorTestCase ()
+  : TestCase ("DataCollector output with prepared statements")
+{
+}
+
+void
+SqliteDataCollectorTestCase::DoRun (void)
+{
+  DataCollector data;
+  data.DescribeRun ("experiment", "strategy", "input", "run'); drop table Singletons; --");
+  data.AddMetadata ("author", "O'Brien");
+
+  Ptr<CounterCalculator<> > counter = CreateObject<CounterCalculator<> > ();
+  counter->SetKey ("packets");
+  counter->SetContext ("node[0]");
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      counter->Update ();
+    }
+  data.AddDataCalculator (counter);
+
+  std::string prefix = CreateTempDirFilename ("sqlite-collector");
+  Ptr<SqliteDataOutput> output = CreateObject<SqliteDataOutput> ();
+  output->SetFilePrefix (prefix);
+  output->Output (data);
+
+  std::string dbFile = prefix + ".db";
+  NS_TEST_EXPECT_MSG_EQ (QueryText (dbFile, "select value from Metadata where key = 'author'"), "O'Brien",
+                         "Wrong metadata");
+  NS_TEST_EXPECT_MSG_EQ (QueryText (dbFile, "select value from Singletons where name = 'node[0]'"), "3",
+                         "Wrong counter");
+  NS_TEST_EXPECT_MSG_EQ (QueryText (dbFile, "select run from Singletons"), "run'); drop table Singletons; --",
+                         "Wrong run label");
+  unlink (dbFile.c_str ());
+}
+
+
+class SqliteDataOutputTestSuite : public TestSuite
+{
+public:
+  SqliteDataOutputTestSuite ();
+};
+
+SqliteDataOutputTestSuite::SqliteDataOutputTestSuite ()
+  : TestSuite ("sqlite-data-output", UNIT)
+{
+  AddTestCase (new SqliteWideTableTestCase, TestCase::QUICK);
+  AddTestCase (new SqliteDataCollectorTestCase, TestCase::QUICK);
+}
+
+static SqliteDataOutputTestSuite sqliteDataOutputTestSuite;
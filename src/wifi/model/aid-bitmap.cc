@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "aid-bitmap.h"
+#include "ns3/assert.h"
+#include <cstring>
+
+namespace ns3 {
+
+AidBitmap::AidBitmap ()
+  : m_pages (0)
+{
+  std::memset (m_blocks, 0, sizeof (m_blocks));
+  std::memset (m_subblocks, 0, sizeof (m_subblocks));
+  std::memset (m_aids, 0, sizeof (m_aids));
+}
+
+void
+AidBitmap::Set (uint16_t aid)
+{
+  NS_ASSERT (aid < 8192);
+  uint16_t subblock = aid >> 3;
+  uint16_t block = aid >> 6;
+  uint16_t page = aid >> 11;
+  m_aids[subblock] |= 1 << (aid & 0x07);
+  m_subblocks[block] |= 1 << (subblock & 0x07);
+  m_blocks[page] |= 1u << (block & 0x1f);
+  m_pages |= 1 << page;
+}
+
+void
+AidBitmap::Clear (uint16_t aid)
+{
+  NS_ASSERT (aid < 8192);
+  uint16_t subblock = aid >> 3;
+  uint16_t block = aid >> 6;
+  uint16_t page = aid >> 11;
+  m_aids[subblock] &= ~(1 << (aid & 0x07));
+  if (m_aids[subblock] != 0)
+    {
+      return;
+    }
+  m_subblocks[block] &= ~(1 << (subblock & 0x07));
+  if (m_subblocks[block] != 0)
+    {
+      return;
+    }
+  m_blocks[page] &= ~(1u << (block & 0x1f));
+  if (m_blocks[page] != 0)
+    {
+      return;
+    }
+  m_pages &= ~(1 << page);
+}
+
+bool
+AidBitmap::IsSet (uint16_t aid) const
+{
+  NS_ASSERT (aid < 8192);
+  return (m_aids[aid >> 3] & (1 << (aid & 0x07))) != 0;
+}
+
+bool
+AidBitmap::IsEmpty (void) const
+{
+  return m_pages == 0;
+}
+
+uint8_t
+AidBitmap::GetPageBitmap (void) const
+{
+  return m_pages;
+}
+
+uint32_t
+AidBitmap::GetBlockBitmap (uint8_t page) const
+{
+  NS_ASSERT (page < 4);
+  return m_blocks[page];
+}
+
+uint8_t
+AidBitmap::GetSubblockBitmap (uint8_t page, uint8_t block) const
+{
+  NS_ASSERT (page < 4 && block < 32);
+  return m_subblocks[(page << 5) | block];
+}
+
+uint8_t
+AidBitmap::GetAidBitmap (uint8_t page, uint8_t block, uint8_t subblock) const
+{
+  NS_ASSERT (page < 4 && block < 32 && subblock < 8);
+  return m_aids[(page << 8) | (block << 3) | subblock];
+}
+
+uint16_t
+AidBitmap::GetAid (uint8_t page, uint8_t block, uint8_t subblock, uint8_t index)
+{
+  return (page << 11) | (block << 6) | (subblock << 3) | index;
+}
+
+} //namespace ns3
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef AID_BITMAP_H
+#define AID_BITMAP_H
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * A set of the AIDs of an S1G BSS, organized as the hierarchy of the TIM:
+ * 4 pages of 32 blocks of 8 subblocks of 8 AIDs. Every level keeps a
+ * bitmap of its non-empty children, updated when an AID is added or
+ * removed, so that the encoded blocks of a TIM are built by visiting the
+ * non-empty blocks and subblocks only.
+ */
+class AidBitmap
+{
+public:
+  AidBitmap ();
+
+  /**
+   * \param aid the AID to add
+   */
+  void Set (uint16_t aid);
+  /**
+   * \param aid the AID to remove
+   */
+  void Clear (uint16_t aid);
+  /**
+   * \param aid an AID
+   * \return true if the AID is in the set
+   */
+  bool IsSet (uint16_t aid) const;
+  /**
+   * \return true if no AID is in the set
+   */
+  bool IsEmpty (void) const;
+
+  /**
+   * \return the bitmap of the non-empty pages, page p being bit p
+   */
+  uint8_t GetPageBitmap (void) const;
+  /**
+   * \param page the page index (0 to 3)
+   * \return the bitmap of the non-empty blocks of the page
+   */
+  uint32_t GetBlockBitmap (uint8_t page) const;
+  /**
+   * \param page the page index (0 to 3)
+   * \param block the block index in the page (0 to 31)
+   * \return the bitmap of the non-empty subblocks of the block
+   */
+  uint8_t GetSubblockBitmap (uint8_t page, uint8_t block) const;
+  /**
+   * \param page the page index (0 to 3)
+   * \param block the block index in the page (0 to 31)
+   * \param subblock the subblock index in the block (0 to 7)
+   * \return the bitmap of the AIDs of the subblock
+   */
+  uint8_t GetAidBitmap (uint8_t page, uint8_t block, uint8_t subblock) const;
+
+  /**
+   * \param page the page index (0 to 3)
+   * \param block the block index in the page (0 to 31)
+   * \param subblock the subblock index in the block (0 to 7)
+   * \param index the index of the AID in the subblock (0 to 7)
+   * \return the AID
+   */
+  static uint16_t GetAid (uint8_t page, uint8_t block, uint8_t subblock, uint8_t index);
+
+private:
+  uint8_t m_pages;          //!< non-empty pages
+  uint32_t m_blocks[4];     //!< non-empty blocks of each page
+  uint8_t m_subblocks[128]; //!< non-empty subblocks of each block
+  uint8_t m_aids[1024];     //!< AIDs of each subblock
+};
+
+} //namespace ns3
+
+#endif /* AID_BITMAP_H */
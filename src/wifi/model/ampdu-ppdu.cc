@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ampdu-ppdu.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+AmpduPpdu::AmpduPpdu ()
+  : m_duration (Seconds (0)),
+    m_size (0)
+{
+}
+
+void
+AmpduPpdu::AddMpdu (Ptr<const Packet> mpdu, Time duration)
+{
+  m_mpdus.push_back (mpdu);
+  m_starts.push_back (m_duration);
+  m_duration += duration;
+  m_size += mpdu->GetSize ();
+}
+
+uint32_t
+AmpduPpdu::GetNMpdus (void) const
+{
+  return m_mpdus.size ();
+}
+
+Ptr<const Packet>
+AmpduPpdu::GetMpdu (uint32_t i) const
+{
+  NS_ASSERT (i < m_mpdus.size ());
+  return m_mpdus[i];
+}
+
+Time
+AmpduPpdu::GetMpduStart (uint32_t i) const
+{
+  NS_ASSERT (i < m_starts.size ());
+  return m_starts[i];
+}
+
+Time
+AmpduPpdu::GetMpduDuration (uint32_t i) const
+{
+  NS_ASSERT (i < m_starts.size ());
+  return (i + 1 < m_starts.size () ? m_starts[i + 1] : m_duration) - m_starts[i];
+}
+
+Time
+AmpduPpdu::GetDuration (void) const
+{
+  return m_duration;
+}
+
+uint32_t
+AmpduPpdu::GetSize (void) const
+{
+  return m_size;
+}
+
+} //namespace ns3
@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef AMPDU_PPDU_H
+#define AMPDU_PPDU_H
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/packet.h"
+#include "ns3/nstime.h"
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * The MPDUs of an A-MPDU sent as a single PPDU. Each MPDU keeps the
+ * duration it has when the MPDUs are sent one after the other: the
+ * preamble and the PLCP header are part of the first one, and the
+ * padding symbols of the A-MPDU are part of the last one. The PPDU is
+ * shared by all the receivers, which copy the MPDUs they deliver.
+ */
+class AmpduPpdu : public SimpleRefCount<AmpduPpdu>
+{
+public:
+  AmpduPpdu ();
+
+  /**
+   * Append an MPDU to the PPDU.
+   *
+   * \param mpdu the MPDU, with its A-MPDU subframe header and padding
+   * \param duration the duration of the MPDU
+   */
+  void AddMpdu (Ptr<const Packet> mpdu, Time duration);
+
+  /**
+   * \return the number of MPDUs
+   */
+  uint32_t GetNMpdus (void) const;
+  /**
+   * \param i the index of the MPDU
+   * \return the MPDU
+   */
+  Ptr<const Packet> GetMpdu (uint32_t i) const;
+  /**
+   * \param i the index of the MPDU
+   * \return the time between the start of the PPDU and the start of the MPDU
+   */
+  Time GetMpduStart (uint32_t i) const;
+  /**
+   * \param i the index of the MPDU
+   * \return the duration of the MPDU
+   */
+  Time GetMpduDuration (uint32_t i) const;
+  /**
+   * \return the duration of the PPDU
+   */
+  Time GetDuration (void) const;
+  /**
+   * \return the size of the MPDUs, in bytes
+   */
+  uint32_t GetSize (void) const;
+
+private:
+  std::vector<Ptr<const Packet> > m_mpdus; //!< the MPDUs
+  std::vector<Time> m_starts;              //!< start of each MPDU from the start of the PPDU
+  Time m_duration;                         //!< duration of the PPDU
+  uint32_t m_size;                         //!< size of the MPDUs
+};
+
+} //namespace ns3
+
+#endif /* AMPDU_PPDU_H */
@@ -27,6 +27,7 @@
 #include "ns3/string.h"
 #include "ns3/pointer.h"
 #include "ns3/boolean.h"
+#include "ns3/enum.h"
 #include "qos-tag.h"
 #include "wifi-phy.h"
 #include "dcf-manager.h"
@@ -40,6 +41,7 @@
 #include "ns3/uinteger.h"
 #include "wifi-mac-queue.h"
 #include <map>
+#include <algorithm>
 
 
 
@@ -120,6 +122,79 @@ ApWifiMac::GetTypeId (void)
                    RPSVectorValue (),
                    MakeRPSVectorAccessor (&ApWifiMac::m_rpsset),
                    MakeRPSVectorChecker ())
+    .AddAttribute ("AuthenThresholdStep", "Step by which the centralized authentication control threshold "
+                   "of the beacons moves, out of 1000, depending on the load of the management queue.",
+                   UintegerValue (50),
+                   MakeUintegerAccessor (&ApWifiMac::m_authenThresholdStep),
+                   MakeUintegerChecker<uint16_t> (1, 1000))
+    .AddAttribute ("GroupAssocResponse", "Whether successful association requests are answered "
+                   "by group addressed association responses covering several stations. The responses "
+                   "wait for more requests, which delays the association of the first stations.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ApWifiMac::m_groupAssocResp),
+                   MakeBooleanChecker ())
+    .AddAttribute ("GroupAssocResponseInterval", "Time during which association requests are collected "
+                   "before a group addressed association response is sent, unless the response is full.",
+                   TimeValue (MilliSeconds (10)),
+                   MakeTimeAccessor (&ApWifiMac::m_groupAssocRespInterval),
+                   MakeTimeChecker ())
+    .AddAttribute ("GroupAssocResponseMaxStations", "Maximum number of stations answered by one "
+                   "group addressed association response.",
+                   UintegerValue (32),
+                   MakeUintegerAccessor (&ApWifiMac::m_groupAssocRespMaxStas),
+                   MakeUintegerChecker<uint32_t> (1, 255))
+    .AddAttribute ("StationFairQueue", "Whether the downlink EDCA queues are served station by station "
+                   "in deficit round robin, so that frames buffered for dozing stations do not block the others.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ApWifiMac::SetStationFairQueue,
+                                        &ApWifiMac::GetStationFairQueue),
+                   MakeBooleanChecker ())
+    .AddAttribute ("UplinkMuEnabled", "Whether the AP solicits simultaneous uplink transmissions "
+                   "from the stations of a RAW slot by sending trigger frames.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&ApWifiMac::m_uplinkMuEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("UplinkMuRus", "Number of resource units the channel is split into for triggered uplink transmissions.",
+                   UintegerValue (2),
+                   MakeUintegerAccessor (&ApWifiMac::m_uplinkMuRus),
+                   MakeUintegerChecker<uint8_t> (2, 16))
+    .AddAttribute ("UplinkMuMcs", "MCS the stations use for triggered uplink transmissions.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ApWifiMac::m_uplinkMuMcs),
+                   MakeUintegerChecker<uint8_t> ())
+    .AddAttribute ("UplinkMuPpduDuration", "Maximum duration of a triggered uplink PPDU.",
+                   TimeValue (MicroSeconds (5000)),
+                   MakeTimeAccessor (&ApWifiMac::m_uplinkMuPpduDuration),
+                   MakeTimeChecker (MicroSeconds (0), MicroSeconds (65535)))
+    .AddAttribute ("UplinkMuTriggerDelay", "Delay between the start of a RAW slot and the first trigger frame.",
+                   TimeValue (MicroSeconds (0)),
+                   MakeTimeAccessor (&ApWifiMac::m_uplinkMuTriggerDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("RawSlotDurationStrategy", "How the RAW slots are sized. With Planned, the AP groups its sensor "
+                   "and offload stations at every beacon and sizes their slots from the airtime of their "
+                   "exchanges, instead of sending the RPS of RPSsetup in turn.",
+                   EnumValue (S1gRawCtr::FIXED_SLOT_DURATION),
+                   MakeEnumAccessor (&ApWifiMac::m_rawSlotDurationStrategy),
+                   MakeEnumChecker (S1gRawCtr::FIXED_SLOT_DURATION, "Fixed",
+                                    S1gRawCtr::PLANNED_SLOT_DURATION, "Planned"))
+    .AddAttribute ("RawPlannedDataMode", "Mode of the data frames the planned RAW slots are sized for, "
+                   "the first mode of the PHY if empty.",
+                   StringValue (""),
+                   MakeStringAccessor (&ApWifiMac::m_rawPlannedDataMode),
+                   MakeStringChecker ())
+    .AddAttribute ("RawPlannedSensorPayloadSize", "Size of the packets of the sensors the planned RAW slots are sized for.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&ApWifiMac::m_rawPlannedSensorPayloadSize),
+                   MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("RawPlannedOffloadPayloadSize", "Size of the packets of the offload stations the planned RAW slots are sized for.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&ApWifiMac::m_rawPlannedOffloadPayloadSize),
+                   MakeUintegerChecker<uint16_t> ())
+    .AddAttribute ("RawPlannedSuccessProbability", "Percentage of the exchanges that succeed, the planned RAW slots "
+                   "allowing for the others to be retried.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&ApWifiMac::m_rawPlannedSuccessProb),
+                   MakeUintegerChecker<uint16_t> (1, 100))
 	.AddTraceSource ("S1gBeaconBroadcasted", "Fired when a beacon is transmitted",
 	                 MakeTraceSourceAccessor(&ApWifiMac::m_transmitBeaconTrace),
 	                 "ns3::ApWifiMac::S1gBeaconTracedCallback")
@@ -153,7 +228,14 @@ ApWifiMac::GetTypeId (void)
      .AddAttribute ("TIMSet", "configuration of TIM",
                    TIMValue (),
                    MakeTIMAccessor (&ApWifiMac::m_TIM),
-                   MakeTIMChecker ());
+                   MakeTIMChecker ())
+     .AddAttribute ("NumberOfPages", "Number of pages whose stations are paged in turn, one page per "
+                    "DTIM interval, starting from the page of the page slice element. The stations "
+                    "of the other pages are never paged.",
+                    UintegerValue (1),
+                    MakeUintegerAccessor (&ApWifiMac::SetNumberOfPages,
+                                          &ApWifiMac::GetNumberOfPages),
+                    MakeUintegerChecker<uint32_t> (1, 4));
      /*
        .AddAttribute ("DTIMPeriod", "TIM number in one of DTIM",
                    UintegerValue (4),
@@ -175,12 +257,15 @@ ApWifiMac::ApWifiMac ()
   m_beaconDca->SetManager (m_dcfManager);
   m_beaconDca->SetTxMiddle (m_txMiddle);
 
+  m_low->SetMuUplinkEndCallback (MakeCallback (&ApWifiMac::SendUplinkTrigger, this));
+
   //Let the lower layers know that we are acting as an AP.
   SetTypeOfStation (AP);
 
   m_enableBeaconGeneration = false;
   AuthenThreshold = 0;
   currentRawGroup = 0;
+  RpsIndex = 0;
   //m_SlotFormat = 0;
   m_AidToMacAddr.clear ();
   m_accessList.clear ();
@@ -188,6 +273,16 @@ ApWifiMac::ApWifiMac ()
   m_sleepList.clear ();
   m_DTIMCount = 0;
   //m_DTIMOffset = 0;
+  m_uplinkMuPending = false;
+  m_nPages = 1;
+  m_firstPage = 0;
+  m_pageTurn = 0;
+  for (EdcaQueues::iterator i = m_edca.begin (); i != m_edca.end (); ++i)
+    {
+      i->second->GetEdcaQueue ()->SetBufferedCallback (MakeCallback (&ApWifiMac::NotifyBuffered, this));
+    }
+  m_supportedRatesGeneration = 0;
+  m_supportedRatesBasicModesGeneration = 0;
 }
 
 ApWifiMac::~ApWifiMac ()
@@ -202,6 +297,10 @@ ApWifiMac::DoDispose ()
   m_beaconDca = 0;
   m_enableBeaconGeneration = false;
   m_beaconEvent.Cancel ();
+  m_uplinkMuEndEvent.Cancel ();
+  m_uplinkMuAids.clear ();
+  m_groupAssocRespEvent.Cancel ();
+  m_pendingAssocResp.clear ();
   RegularWifiMac::DoDispose ();
 }
 
@@ -227,6 +326,32 @@ ApWifiMac::GetPageSlicingActivated (void) const
 	return m_pageSlicingActivated;
 }
 
+void
+ApWifiMac::SetNumberOfPages (uint32_t pages)
+{
+  NS_LOG_FUNCTION (this << pages);
+  NS_ASSERT (pages >= 1 && pages <= 4);
+  m_nPages = pages;
+  m_pageTurn = 0;
+}
+
+uint32_t
+ApWifiMac::GetNumberOfPages (void) const
+{
+  return m_nPages;
+}
+
+uint8_t
+ApWifiMac::GetDtimsUntilPage (uint8_t page) const
+{
+  uint8_t turn = (page + 4 - m_firstPage) % 4;
+  if (m_nPages <= 1 || turn >= m_nPages)
+    {
+      return 0;
+    }
+  return (turn + m_nPages - m_pageTurn) % m_nPages;
+}
+
 void
 ApWifiMac::SetBeaconGeneration (bool enable)
 {
@@ -473,26 +598,35 @@ ApWifiMac::ForwardDown (Ptr<const Packet> packet, Mac48Address from,
     {
       hdr.SetNoOrder ();
     }
-  hdr.SetAddr1 (to);
-  hdr.SetAddr2 (GetAddress ());
-  hdr.SetAddr3 (from);
-  hdr.SetDsFrom ();
-  hdr.SetDsNotTo ();
+  //Stations associated with a relay are reached through the relay,
+  //in a four address frame
+  Mac48Address receiver = to;
+  std::map<Mac48Address, Mac48Address>::const_iterator relay = m_relayedStations.find (to);
+  if (relay != m_relayedStations.end ())
+    {
+      receiver = relay->second;
+      hdr.SetAddr1 (receiver);
+      hdr.SetAddr2 (GetAddress ());
+      hdr.SetAddr3 (to);
+      hdr.SetAddr4 (from);
+      hdr.SetDsFrom ();
+      hdr.SetDsTo ();
+    }
+  else
+    {
+      hdr.SetAddr1 (to);
+      hdr.SetAddr2 (GetAddress ());
+      hdr.SetAddr3 (from);
+      hdr.SetDsFrom ();
+      hdr.SetDsNotTo ();
+    }
 
   int aid = 0;
-  if (!to.IsBroadcast ())
+  if (!receiver.IsBroadcast ())
   {
-	  /*for (auto it=m_AidToMacAddr.begin(); it != m_AidToMacAddr.end(); ++it){
-		  if (m_AidToMacAddr.find(aid)->second == to)
-			  break;
-		  else if (it == m_AidToMacAddr.end())
-			  aid = -1;
-	  }
-	  if (aid == -1)
-		  NS_LOG_INFO (Simulator::Now().GetMicroSeconds() << " ms: AP cannot forward down data because There is no RAW for this MAC address.");
-	  */
-	  do {aid++;}
-	  while (m_AidToMacAddr.find(aid)->second != to); //TODO optimize search
+	  std::map<Mac48Address, uint16_t>::const_iterator registered = m_macAddrToAid.find (receiver);
+	  NS_ASSERT_MSG (registered != m_macAddrToAid.end (), "AP cannot forward down data to " << receiver << ", which has no AID");
+	  aid = registered->second;
 
 	  NS_LOG_INFO (Simulator::Now().GetMicroSeconds() << " ms: AP to forward data for [aid=" << aid << "]");
 
@@ -529,6 +663,9 @@ ApWifiMac::ForwardDown (Ptr<const Packet> packet, Mac48Address from,
 	  else
 		 wait = (m_TIM.GetDTIMPeriod() - m_TIM.GetDTIMCount () + toTim) * this->GetBeaconInterval();
 
+	  // and the DTIM beacons of the other pages before the one of the station
+	  wait += GetDtimsUntilPage (page) * m_TIM.GetDTIMPeriod () * this->GetBeaconInterval ();
+
 	  // deduce the offset from the last beacon until now
 	  wait -= Simulator::Now() - this->m_lastBeaconTime;
 	  // downlink data needs to be scheduled in corresponding RAW slot for the station
@@ -584,7 +721,8 @@ ApWifiMac::GetSlotStartTimeFromAid (uint16_t aid) const
 	}
 
 	//std::cout << "aid=" << (int)aid << ", toTim=" << (int)toTim << std::endl;
-	uint16_t raw_len = (*m_rpsset.rpsset.at(toTim)).GetInformationFieldSize();
+	const RPS &rps = m_rawSlotDurationStrategy == S1gRawCtr::PLANNED_SLOT_DURATION ? m_plannedRps : m_rpsset.rpsset.at(toTim);
+	uint16_t raw_len = rps.GetInformationFieldSize();
 
 	uint16_t rawAssignment_len = 6;
 	if (raw_len % rawAssignment_len !=0)
@@ -600,7 +738,7 @@ ApWifiMac::GetSlotStartTimeFromAid (uint16_t aid) const
     int x = 0;
 	for (uint8_t raw_index=0; raw_index < RAW_number; raw_index++)
 	{
-		RPS::RawAssignment ass = m_rpsset.rpsset.at(toTim)->GetRawAssigmentObj(raw_index);
+		RPS::RawAssignment ass = rps.GetRawAssigmentObj(raw_index);
 		currentRAW_start += (500 + slotDurationCount * 120) * slotNum;
 		slotDurationCount = ass.GetSlotDurationCount();
 		slotNum = ass.GetSlotNum();
@@ -626,7 +764,8 @@ void
 ApWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to, Mac48Address from)
 {
   NS_LOG_FUNCTION (this << packet << to << from);
-  if (to.IsBroadcast () || m_stationManager->IsAssociated (to))
+  if (to.IsBroadcast () || m_stationManager->IsAssociated (to)
+      || m_relayedStations.find (to) != m_relayedStations.end ())
     {
 	  ForwardDown (packet, from, to);
     }
@@ -653,26 +792,23 @@ SupportedRates
 ApWifiMac::GetSupportedRates (void) const
 {
   NS_LOG_FUNCTION (this);
-  SupportedRates rates;
-  //If it is an HT-AP then add the BSSMembershipSelectorSet
-  //which only includes 127 for HT now. The standard says that the BSSMembershipSelectorSet
-  //must have its MSB set to 1 (must be treated as a Basic Rate)
-  //Also the standard mentioned that at leat 1 element should be included in the SupportedRates the rest can be in the ExtendedSupportedRates
-  if (m_htSupported)
+  const SupportedRates &phyRates = GetPhySupportedRates ();
+  if (m_supportedRatesGeneration == GetPhyElementsGeneration ()
+      && m_supportedRatesBasicModesGeneration == m_stationManager->GetBasicModesGeneration ())
     {
-      for (uint32_t i = 0; i < m_phy->GetNBssMembershipSelectors (); i++)
-        {
-          NS_LOG_UNCOND (GetAddress () << " GetSupportedRates ");
-          rates.SetBasicRate (m_phy->GetBssMembershipSelector (i)); //not sure it's needed
-        }
+      return m_supportedRates;
     }
+  //If it is an HT-AP then the BSSMembershipSelectorSet, which only includes
+  //127 for HT now, is already part of the rates of the PHY. The standard
+  //says that the BSSMembershipSelectorSet must have its MSB set to 1
+  //(must be treated as a Basic Rate)
+  //Also the standard mentioned that at leat 1 element should be included in the SupportedRates the rest can be in the ExtendedSupportedRates
+  SupportedRates rates = phyRates;
   //Send the set of supported rates and make sure that we indicate
   //the Basic Rate set in this set of supported rates.
- // NS_LOG_LOGIC ("ApWifiMac::GetSupportedRates  1 " ); //for test
   for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
     {
       WifiMode mode = m_phy->GetMode (i);
-      rates.AddSupportedRate (mode.GetDataRate ());
       //Add rates that are part of the BSSBasicRateSet (manufacturer dependent!)
       //here we choose to add the mandatory rates to the BSSBasicRateSet,
       //exept for 802.11b where we assume that only the two lowest mandatory rates are part of the BSSBasicRateSet
@@ -682,30 +818,22 @@ ApWifiMac::GetSupportedRates (void) const
           m_stationManager->AddBasicMode (mode);
         }
     }
-  // NS_LOG_LOGIC ("ApWifiMac::GetSupportedRates  2 " ); //for test
   //set the basic rates
   for (uint32_t j = 0; j < m_stationManager->GetNBasicModes (); j++)
     {
       WifiMode mode = m_stationManager->GetBasicMode (j);
       rates.SetBasicRate (mode.GetDataRate ());
     }
-  //NS_LOG_LOGIC ("ApWifiMac::GetSupportedRates   " ); //for test
-  return rates;
+  m_supportedRates = rates;
+  m_supportedRatesGeneration = GetPhyElementsGeneration ();
+  m_supportedRatesBasicModesGeneration = m_stationManager->GetBasicModesGeneration ();
+  return m_supportedRates;
 }
 
 HtCapabilities
 ApWifiMac::GetHtCapabilities (void) const
 {
-  HtCapabilities capabilities;
-  capabilities.SetHtSupported (1);
-  capabilities.SetLdpc (m_phy->GetLdpc ());
-  capabilities.SetShortGuardInterval20 (m_phy->GetGuardInterval ());
-  capabilities.SetGreenfield (m_phy->GetGreenfield ());
-  for (uint8_t i = 0; i < m_phy->GetNMcs (); i++)
-    {
-      capabilities.SetRxMcsBitmask (m_phy->GetMcs (i));
-    }
-  return capabilities;
+  return GetPhyHtCapabilities ();
 }
 
 S1gCapabilities
@@ -749,6 +877,54 @@ ApWifiMac::SendProbeResp (Mac48Address to)
   m_dca->Queue (packet, hdr);
 }
 
+uint16_t
+ApWifiMac::RegisterStation (Mac48Address to, bool success, uint8_t staType)
+{
+  uint8_t mac[6];
+  to.CopyTo (mac);
+  uint8_t aid_l = mac[5];
+  uint8_t aid_h = mac[4] & 0x1f;
+  uint16_t aid = (aid_h << 8) | (aid_l << 0); //assign mac address as AID
+  m_AidToMacAddr[aid]=to;
+  m_macAddrToAid[to] = aid;
+  if (((aid >> 11) + 4 - m_firstPage) % 4 >= m_nPages)
+    {
+      NS_LOG_WARN ("[aid=" << aid << "] is outside the " << m_nPages << " pages paged from page "
+                   << (int) m_firstPage << ", its buffered frames are never announced");
+    }
+  if (m_bufferedQueues.find (to) != m_bufferedQueues.end ())
+    {
+      m_bufferedAids.Set (aid);
+    }
+  if (success)
+    {
+      //the station is no longer behind a relay
+      m_relayedStations.erase (to);
+    }
+
+  if (m_s1gSupported && success)
+    {
+      //assign AID based on station type, to do.
+       if (staType == 1)
+        {
+          if (std::find (m_sensorList.begin (), m_sensorList.end (), aid) == m_sensorList.end ())
+            {
+              m_sensorList.push_back (aid);
+              NS_LOG_INFO ("m_sensorList =" << m_sensorList.size ());
+            }
+        }
+       else if (staType == 2)
+        {
+          if (std::find (m_OffloadList.begin (), m_OffloadList.end (), aid) == m_OffloadList.end ())
+            {
+              m_OffloadList.push_back (aid);
+              NS_LOG_INFO ("m_OffloadList =" << m_OffloadList.size ());
+            }
+        }
+    }
+  return aid;
+}
+
 void
 ApWifiMac::SendAssocResp (Mac48Address to, bool success, uint8_t staType)
 {
@@ -763,13 +939,7 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, uint8_t staType)
   Ptr<Packet> packet = Create<Packet> ();
   MgtAssocResponseHeader assoc;
   
-  uint8_t mac[6];
-  to.CopyTo (mac);
-  uint8_t aid_l = mac[5];
-  uint8_t aid_h = mac[4] & 0x1f;
-  uint16_t aid = (aid_h << 8) | (aid_l << 0); //assign mac address as AID
-  assoc.SetAID(aid); //
-  m_AidToMacAddr[aid]=to;
+  assoc.SetAID (RegisterStation (to, success, staType));
 
   StatusCode code;
   if (success)
@@ -794,30 +964,7 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, uint8_t staType)
   if (m_s1gSupported && success)
     {
       assoc.SetS1gCapabilities (GetS1gCapabilities ());
-      //assign AID based on station type, to do.
-       if (staType == 1)
-        {
-          for (std::vector<uint16_t>::iterator it = m_sensorList.begin(); it != m_sensorList.end(); it++)
-            {
-              if (*it == aid)
-                 goto Addheader;
-            }
-          m_sensorList.push_back (aid);
-          NS_LOG_INFO ("m_sensorList =" << m_sensorList.size ());
-  
-        }
-       else if (staType == 2)
-        {
-           for (std::vector<uint16_t>::iterator it = m_OffloadList.begin(); it != m_OffloadList.end(); it++)
-            {
-                if (*it == aid)
-                  goto Addheader;
-            }
-          m_OffloadList.push_back (aid);
-          NS_LOG_INFO ("m_OffloadList =" << m_OffloadList.size ());
-        }
     }
-Addheader:
   packet->AddHeader (assoc);
 
   //The standard is not clear on the correct queue for management
@@ -827,11 +974,85 @@ Addheader:
   m_dca->Queue (packet, hdr);
 }
 
+void
+ApWifiMac::QueueGroupAssocResp (Mac48Address to, uint8_t staType)
+{
+  NS_LOG_FUNCTION (this << to);
+  for (std::vector<std::pair<Mac48Address, uint8_t> >::iterator it = m_pendingAssocResp.begin ();
+       it != m_pendingAssocResp.end (); it++)
+    {
+      if (it->first == to)
+        {
+          //retransmitted association request
+          return;
+        }
+    }
+  m_pendingAssocResp.push_back (std::make_pair (to, staType));
+  if (m_pendingAssocResp.size () >= m_groupAssocRespMaxStas)
+    {
+      //a full response does not wait for more requests
+      m_groupAssocRespEvent.Cancel ();
+      SendGroupAssocResp ();
+    }
+  else if (!m_groupAssocRespEvent.IsRunning ())
+    {
+      m_groupAssocRespEvent = Simulator::Schedule (m_groupAssocRespInterval,
+                                                   &ApWifiMac::SendGroupAssocResp, this);
+    }
+}
+
+void
+ApWifiMac::SendGroupAssocResp (void)
+{
+  NS_LOG_FUNCTION (this);
+  WifiMacHeader hdr;
+  hdr.SetAssocResp ();
+  hdr.SetAddr1 (Mac48Address::GetBroadcast ());
+  hdr.SetAddr2 (GetAddress ());
+  hdr.SetAddr3 (GetAddress ());
+  hdr.SetDsNotFrom ();
+  hdr.SetDsNotTo ();
+  Ptr<Packet> packet = Create<Packet> ();
+  MgtGroupAssocResponseHeader assoc;
+  assoc.SetSupportedRates (GetSupportedRates ());
+  if (m_htSupported)
+    {
+      assoc.SetHtCapabilities (GetHtCapabilities ());
+      hdr.SetNoOrder ();
+    }
+  if (m_s1gSupported)
+    {
+      assoc.SetS1gCapabilities (GetS1gCapabilities ());
+    }
+
+  uint32_t n = std::min<uint32_t> (m_pendingAssocResp.size (), m_groupAssocRespMaxStas);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Mac48Address to = m_pendingAssocResp[i].first;
+      assoc.AddStation (to, RegisterStation (to, true, m_pendingAssocResp[i].second));
+      //group addressed frames are not acknowledged: a station which
+      //misses the response sends its association request again
+      if (m_stationManager->IsWaitAssocTxOk (to))
+        {
+          m_stationManager->RecordGotAssocTxOk (to);
+        }
+    }
+  m_pendingAssocResp.erase (m_pendingAssocResp.begin (), m_pendingAssocResp.begin () + n);
+  NS_LOG_DEBUG ("group association response for " << n << " stations");
+  packet->AddHeader (assoc);
+  m_dca->Queue (packet, hdr);
+
+  if (!m_pendingAssocResp.empty ())
+    {
+      m_groupAssocRespEvent = Simulator::Schedule (m_groupAssocRespInterval,
+                                                   &ApWifiMac::SendGroupAssocResp, this);
+    }
+}
+
 //For now, to avoid adjust pageslicecount and pageslicecount dynamicly,   page bitmap is always 4 bytes
 uint32_t
 ApWifiMac::HasPacketsToPage (uint8_t blockstart , uint8_t Page)
 {
-	uint8_t blockBitmap;
 	uint32_t PageBitmap;
 	PageBitmap = 0;
 	uint32_t numBlocks;
@@ -839,44 +1060,41 @@ ApWifiMac::HasPacketsToPage (uint8_t blockstart , uint8_t Page)
 		numBlocks = 31;
 	else
 		numBlocks = m_pageslice.GetPageSliceLen();
-	//printf("		ApWifiMac::HasPacketsToPage --- Page Bitmap includes blocks from %d to %d\n", blockstart, blockstart + numBlocks - 1);
-	for (uint32_t i=blockstart; i< blockstart + numBlocks ; i++ )
+	// only the blocks with buffered packets are visited
+	uint32_t blocks = m_bufferedAids.GetBlockBitmap (Page) >> blockstart;
+	for (uint32_t i = 0; i < numBlocks && blocks != 0; i++, blocks >>= 1)
 	{
-		blockBitmap = HasPacketsToBlock (i,  Page);
-		if (blockBitmap != 0)
+		if ((blocks & 1) && HasPacketsToBlock (blockstart + i, Page) != 0)
 		{
 			PageBitmap = PageBitmap | (1 << i);
 		}
-		//printf("		ApWifiMac::HasPacketsToPage --- Block Bitmap = %x\n", blockBitmap);
 	}
-	//printf("		ApWifiMac::HasPacketsToPage --- Page Bitmap before >> blockstart = %x\n", PageBitmap);
-	PageBitmap = PageBitmap >> blockstart;
-	//printf("		ApWifiMac::HasPacketsToPage --- Page Bitmap after >> blockstart = %x\n", PageBitmap);
 	return PageBitmap;
 }
 
 uint8_t
 ApWifiMac::HasPacketsToBlock (uint16_t blockInd , uint16_t PageInd)
 {
-    uint16_t sta_aid, subblock, block;
-    uint8_t blockBitmap;
+    uint16_t sta_aid;
+    uint8_t blockBitmap, subblocks, aids;
     
     blockBitmap = 0;
-    block = (PageInd << 11) | (blockInd << 6); // TODO check
+    subblocks = m_bufferedAids.GetSubblockBitmap (PageInd, blockInd);
    
     for (uint16_t i = 0; i <= 7; i++) //8 subblock in each block.
      {
-       subblock = block | (i << 3);
+       if ((subblocks & (1 << i)) == 0)
+         {
+           continue;
+         }
+       aids = m_bufferedAids.GetAidBitmap (PageInd, blockInd, i);
        for (uint16_t j = 0; j <= 7; j++) //8 stations in each subblock
         {
-           sta_aid = subblock | j;
-           if (m_stationManager->IsAssociated (m_AidToMacAddr.find(sta_aid)->second) && HasPacketsInQueueTo(m_AidToMacAddr.find(sta_aid)->second) )
+           sta_aid = AidBitmap::GetAid (PageInd, blockInd, i, j);
+           if ((aids & (1 << j)) && m_stationManager->IsAssociated (m_AidToMacAddr.find(sta_aid)->second))
             {
         	   blockBitmap = blockBitmap | (1 << i);
         	   NS_LOG_DEBUG ("[aid=" << sta_aid << "] " << "paged");
-        	   // if there is at least one station associated with AP that has FALSE for PageSlicingImplemented within this page then m_PageSliceNum = 31
-        	   if (!m_supportPageSlicingList.at(m_AidToMacAddr[sta_aid]))
-        		   m_PageSliceNum = 31;
         	   break;
             }
         }
@@ -885,51 +1103,88 @@ ApWifiMac::HasPacketsToBlock (uint16_t blockInd , uint16_t PageInd)
     return blockBitmap;
 }
 
-uint8_t
-ApWifiMac::HasPacketsToSubBlock (uint16_t subblockInd, uint16_t blockInd , uint16_t PageInd)
+AidBitmap
+ApWifiMac::GetPagedAids (uint8_t blockOffset, uint8_t numBlocks, uint8_t page)
 {
-    uint16_t sta_aid, subblock;
-    uint8_t subblockBitmap;
-    subblockBitmap = 0;
-  
-    subblock = (PageInd << 11) | (blockInd << 6) | (subblockInd << 3);
-    for (uint16_t j = 0; j <= 7; j++) //8 stations in each subblock
+  // the associated stations with buffered packets in the blocks, which
+  // stay awake to receive them
+  AidBitmap paged;
+  for (uint8_t i = 0; i < numBlocks; i++)
+    {
+      uint8_t block = (blockOffset + i) & 0x1f;
+      uint8_t subblocks = m_bufferedAids.GetSubblockBitmap (page, block);
+      for (uint8_t j = 0; j <= 7 && subblocks != 0; j++, subblocks >>= 1)
         {
-           sta_aid = subblock | j;
-           if (m_stationManager->IsAssociated (m_AidToMacAddr.find(sta_aid)->second) && HasPacketsInQueueTo(m_AidToMacAddr.find(sta_aid)->second) )
-             {
-               subblockBitmap = subblockBitmap | (1 << j); 
-               m_sleepList[m_AidToMacAddr.find(sta_aid)->second]=false;
-             } 
+          if ((subblocks & 1) == 0)
+            {
+              continue;
+            }
+          uint8_t aids = m_bufferedAids.GetAidBitmap (page, block, j);
+          for (uint8_t k = 0; k <= 7; k++)
+            {
+              uint16_t aid = AidBitmap::GetAid (page, block, j, k);
+              if (aids & (1 << k))
+                {
+                  Mac48Address address = m_AidToMacAddr.find (aid)->second;
+                  if (m_stationManager->IsAssociated (address))
+                    {
+                      paged.Set (aid);
+                      m_sleepList[address] = false;
+                    }
+                }
+            }
         }
-    return subblockBitmap;
+    }
+  return paged;
 }
-    
 
 bool 
 ApWifiMac::HasPacketsInQueueTo(Mac48Address dest) 
 {           
     //check also if ack received
-    Ptr<const Packet> peekedPacket_VO, peekedPacket_VI, peekedPacket_BE, peekedPacket_BK;
-    WifiMacHeader peekedHdr;
-    Time tstamp;
-        
-    peekedPacket_VO = m_edca.find(AC_VO)->second->GetEdcaQueue()->PeekByAddress (WifiMacHeader::ADDR1, dest);
-    peekedPacket_VI = m_edca.find(AC_VI)->second->GetEdcaQueue()->PeekByAddress (WifiMacHeader::ADDR1, dest);
-    peekedPacket_BE = m_edca.find(AC_BE)->second->GetEdcaQueue()->PeekByAddress (WifiMacHeader::ADDR1, dest);
-    peekedPacket_BK = m_edca.find(AC_BK)->second->GetEdcaQueue()->PeekByAddress (WifiMacHeader::ADDR1, dest);
-        
-    if (peekedPacket_VO != 0 || peekedPacket_VI != 0 || peekedPacket_BE != 0 || peekedPacket_BK != 0 )
-       {
-         return true;
-       }
-    else
-      {
-         return false;
-      }
+    return m_bufferedQueues.find (dest) != m_bufferedQueues.end ();
+}
+
+void
+ApWifiMac::NotifyBuffered (Mac48Address address, bool buffered)
+{
+  NS_LOG_FUNCTION (this << address << buffered);
+  std::map<Mac48Address, uint16_t>::const_iterator aid = m_macAddrToAid.find (address);
+  if (buffered)
+    {
+      if (m_bufferedQueues[address]++ == 0 && aid != m_macAddrToAid.end ())
+        {
+          m_bufferedAids.Set (aid->second);
+        }
+      return;
+    }
+  std::map<Mac48Address, uint8_t>::iterator it = m_bufferedQueues.find (address);
+  NS_ASSERT (it != m_bufferedQueues.end () && it->second > 0);
+  if (--it->second == 0)
+    {
+      m_bufferedQueues.erase (it);
+      if (aid != m_macAddrToAid.end ())
+        {
+          m_bufferedAids.Clear (aid->second);
+        }
+    }
+}
+
+void
+ApWifiMac::SetStationFairQueue (bool enable)
+{
+  for (EdcaQueues::iterator i = m_edca.begin (); i != m_edca.end (); ++i)
+    {
+      i->second->GetEdcaQueue ()->SetStationFairQueueing (enable);
+    }
+}
+
+bool
+ApWifiMac::GetStationFairQueue (void) const
+{
+  return m_edca.find (AC_BE)->second->GetEdcaQueue ()->GetStationFairQueueing ();
 }
  
-uint16_t ApWifiMac::RpsIndex = 0;
 void
 ApWifiMac::SetaccessList (std::map<Mac48Address, bool> list)
 {
@@ -971,19 +1226,31 @@ ApWifiMac::SendOneBeacon (void)
       Ptr<Packet> packet = Create<Packet> ();
       S1gBeaconHeader beacon;
       S1gBeaconCompatibility compatibility;
+      //the TIM only pages stations whose packets have not expired
+      m_edca.find (AC_VO)->second->GetEdcaQueue ()->RemoveExpired ();
+      m_edca.find (AC_VI)->second->GetEdcaQueue ()->RemoveExpired ();
+      m_edca.find (AC_BE)->second->GetEdcaQueue ()->RemoveExpired ();
+      m_edca.find (AC_BK)->second->GetEdcaQueue ()->RemoveExpired ();
       compatibility.SetBeaconInterval (m_beaconInterval.GetMicroSeconds ());
       beacon.SetBeaconCompatibility (compatibility);
+      beacon.SetCompressedSSID (GetSsid ().GetCompressed ());
      
-      RPS *m_rps;
-      if (RpsIndex < m_rpsset.rpsset.size())
+      const RPS *m_rps;
+      if (m_rawSlotDurationStrategy == S1gRawCtr::PLANNED_SLOT_DURATION)
          {
-            m_rps = m_rpsset.rpsset.at(RpsIndex);
+            m_plannedRps = m_S1gRawCtr.UpdateRAWGroupping (m_sensorList, m_OffloadList, m_receivedAid, m_beaconInterval.GetMicroSeconds (), m_outputpath);
+            m_receivedAid.clear (); //release storage
+            m_rps = &m_plannedRps;
+          }
+      else if (RpsIndex < m_rpsset.rpsset.size())
+         {
+            m_rps = &m_rpsset.rpsset.at(RpsIndex);
             NS_LOG_INFO ("< RpsIndex =" << RpsIndex);
             RpsIndex++;
           }
       else
          {
-            m_rps = m_rpsset.rpsset.at(0);
+            m_rps = &m_rpsset.rpsset.at(0);
             NS_LOG_INFO ("RpsIndex =" << RpsIndex);
             RpsIndex = 1;
           }
@@ -1005,6 +1272,13 @@ ApWifiMac::SendOneBeacon (void)
     if (m_DTIMCount == 0 && GetPageSlicingActivated ()) // TODO filter when GetPageSlicingActivated() is false
       {
     	NS_LOG_DEBUG ("***DTIM*** starts at " << Simulator::Now().GetSeconds() << " s");
+        if (m_nPages > 1)
+          {
+            //every DTIM interval pages the stations of the next page
+            m_pageslice.SetPageindex ((m_firstPage + m_pageTurn) % 4);
+            m_pageTurn = (m_pageTurn + 1) % m_nPages;
+            NS_LOG_DEBUG ("	Paging page " << (int)m_pageslice.GetPageindex ());
+          }
         m_pagebitmap = HasPacketsToPage (m_pageslice.GetBlockOffset (), m_pageslice.GetPageindex()); //TODO check set m_PageSliceNum = 31
         if (m_pagebitmap)//for now, only configure Page Bit map based on real-time traffic, other parameters configured beforehand.
         	NS_LOG_DEBUG("	Page bitmap (0-4 bytes): " << m_pagebitmap);
@@ -1032,6 +1306,8 @@ ApWifiMac::SendOneBeacon (void)
     m_TIM.SetDTIMCount (m_DTIMCount);
     NS_ASSERT (m_pageslice.GetTIMOffset () +  m_pageslice.GetPageSliceCount() <= m_DTIMPeriod);
     m_TrafficIndicator = 0; //for group addressed MSDU/MMPDU, not supported.
+    //the bitmap control field only carries the page index, stations get their page slice from the page slice element
+    m_TIM.SetBitmapControl (m_pageslice.GetPageindex () << 6);
     m_TIM.SetTafficIndicator (m_TrafficIndicator); //from page slice
     m_PageSliceNum = 0;
     if (m_pageslice.GetPageSliceCount() == 0)
@@ -1054,14 +1330,6 @@ ApWifiMac::SendOneBeacon (void)
 
     
     m_PageIndex = m_pageslice.GetPageindex();
-    //m_TIM.SetPageIndex (m_PageIndex);
-    uint64_t numPagedStas (0);
-    for (auto it = m_supportPageSlicingList.begin(); it != m_supportPageSlicingList.end(); ++it){
-    	if (m_stationManager->IsAssociated (it->first) && HasPacketsInQueueTo(it->first) )
-    	{
-    		numPagedStas++;
-    	}
-    }
     //if (!m_DTIMCount && numPagedStas) NS_LOG_DEBUG ("Paged stations: " << (int)numPagedStas);
 	/*if (m_pageslice.GetPageSliceCount() == 0 && numPagedStas > 0)// special case
 	{
@@ -1083,7 +1351,7 @@ ApWifiMac::SendOneBeacon (void)
       m_PageSliceNum = 0;
    }*/
 
-    uint8_t NumEncodedBlock;
+    uint8_t NumEncodedBlock = 0;
     if (m_PageSliceNum != (m_pageslice.GetPageSliceCount() - 1) && m_PageSliceNum != 31) // convenient overflow if count==0
       {
     		NumEncodedBlock = m_pageslice.GetPageSliceLen();
@@ -1106,40 +1374,15 @@ ApWifiMac::SendOneBeacon (void)
         m_blockoffset = m_pageslice.GetBlockOffset ();
       }
 
-   m_TIM.m_length = 0; // every beacon can have up to NumEncodedBlock encoded blocks
+   m_TIM.ClearPartialVBitmap (); // every beacon can have up to NumEncodedBlock encoded blocks
     if (m_pageslice.GetPageBitmapLength()){
     	//uint8_t numBlocksToEncode = m_pageslice.GetPageBitmapLength();
 
-    for (uint8_t i = 0; i< NumEncodedBlock; i++)
-      {
-        TIM::EncodedBlock * m_encodedBlock = new TIM::EncodedBlock;
-        m_encodedBlock->SetBlockOffset (m_blockoffset & 0x1f); //TODO check
-        uint8_t m_blockbitmap = HasPacketsToBlock (m_blockoffset & 0x1f, m_PageIndex);
-        m_encodedBlock->SetBlockBitmap (m_blockbitmap);
-
-        uint8_t subblocklength = 0;
-        uint8_t *  m_subblock; 
-        m_subblock = new uint8_t [8]; //can be released after SetPartialVBitmap
-        for (uint16_t j = 0; j <= 7; j++ ) // at most 8 subblock
-          {
-             if (m_blockbitmap & (1 << j))
-             {
-                *m_subblock = HasPacketsToSubBlock (j, m_blockoffset & 0x1f, m_PageIndex);
-                subblocklength++; 
-                m_subblock++;
-             }
-          }
-        for (uint32_t j = 0; j < subblocklength; j++)
-        	m_subblock--;
-        m_encodedBlock->SetEncodedInfo(m_subblock, subblocklength);
-             
-        m_blockoffset++; //actually block id
-        NS_ASSERT (m_blockoffset <= m_pageslice.GetBlockOffset () + m_pageslice.GetInformationFieldSize () * 8);
-        //block id cannot exceeds the max defined in the page slice  element
-        m_TIM.SetPartialVBitmap (*m_encodedBlock);
-        if (m_encodedBlock)
-        	delete m_encodedBlock;
-      }
+    AidBitmap paged = GetPagedAids (m_blockoffset & 0x1f, NumEncodedBlock, m_PageIndex);
+    m_TIM.AddEncodedBlocks (paged, m_PageIndex, m_blockoffset & 0x1f, NumEncodedBlock);
+    m_blockoffset += NumEncodedBlock; //actually block id
+    NS_ASSERT (m_blockoffset <= m_pageslice.GetBlockOffset () + m_pageslice.GetInformationFieldSize () * 8);
+    //block id cannot exceeds the max defined in the page slice  element
 
     }
 
@@ -1179,16 +1422,16 @@ ApWifiMac::SendOneBeacon (void)
       uint32_t MgtQueueSize= MgtQueue->GetSize ();
       if  (MgtQueueSize < 10 )
         {
-          if (AuthenThreshold <= 950)
+          if (AuthenThreshold + m_authenThresholdStep <= 1000)
            {
-             AuthenThreshold += 50;
+             AuthenThreshold += m_authenThresholdStep;
            }
         }
       else
         {
-          if (AuthenThreshold > 50)
+          if (AuthenThreshold > m_authenThresholdStep)
            {
-               AuthenThreshold -=50;
+               AuthenThreshold -= m_authenThresholdStep;
            }
         }
       AuthenCtrl.SetThreshold (AuthenThreshold); //centralized
@@ -1259,6 +1502,7 @@ ApWifiMac::SendOneBeacon (void)
 
     	  for (uint32_t i = 0; i < m_rps->GetRawAssigmentObj(g).GetSlotNum(); i++)
     	  {
+    		  std::vector<uint16_t> slotAids;
     		  for (uint32_t k = startaid; k <= endaid; k++)
     		  {
 
@@ -1270,6 +1514,7 @@ ApWifiMac::SendOneBeacon (void)
     				  if (m_stationManager->IsAssociated (stasAddr))
     				  {
     					  m_accessList[stasAddr]=true;
+    					  slotAids.push_back (k);
     				  }
     			  }
 
@@ -1280,7 +1525,14 @@ ApWifiMac::SendOneBeacon (void)
     		  Simulator::Schedule(
     				  bufferTimeToAllowBeaconToBeReceived + timeToSlotStart,
     				  &ApWifiMac::OnRAWSlotStart, this, RpsIndex, g + 1, i + 1);
-    		  timeToSlotStart += MicroSeconds(500 + m_rps->GetRawAssigmentObj(g).GetSlotDurationCount() * 120);
+    		  Time slotDuration = MicroSeconds(500 + m_rps->GetRawAssigmentObj(g).GetSlotDurationCount() * 120);
+    		  if (m_uplinkMuEnabled && !slotAids.empty () && m_uplinkMuTriggerDelay < slotDuration)
+    		  {
+    			  Simulator::Schedule (bufferTimeToAllowBeaconToBeReceived + timeToSlotStart + m_uplinkMuTriggerDelay,
+    					  &ApWifiMac::StartUplinkMu, this, slotAids,
+    					  slotDuration - m_uplinkMuTriggerDelay);
+    		  }
+    		  timeToSlotStart += slotDuration;
 
     		  for (uint16_t i=1; i<= m_totalStaNum;i++)
     		  {
@@ -1333,6 +1585,79 @@ void ApWifiMac::OnRAWSlotStart(uint16_t rps, uint8_t rawGroup, uint8_t slot)
 
 
 
+void
+ApWifiMac::StartUplinkMu (std::vector<uint16_t> aids, Time remaining)
+{
+  NS_LOG_FUNCTION (this << aids.size () << remaining);
+  m_uplinkMuAids = aids;
+  m_uplinkMuSlotEnd = Simulator::Now () + remaining;
+  m_uplinkMuEndEvent.Cancel ();
+  m_uplinkMuEndEvent = Simulator::Schedule (remaining, &ApWifiMac::EndUplinkMu, this);
+  if (!m_uplinkMuPending)
+    {
+      SendUplinkTrigger ();
+    }
+}
+
+void
+ApWifiMac::EndUplinkMu (void)
+{
+  NS_LOG_FUNCTION (this);
+  //a trigger frame dropped or flushed from the queue, or an uplink cut
+  //short by a channel switch, never reports its end
+  m_uplinkMuPending = false;
+  m_uplinkMuAids.clear ();
+}
+
+void
+ApWifiMac::SendUplinkTrigger (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_uplinkMuPending = false;
+  if (m_uplinkMuAids.empty ())
+    {
+      return;
+    }
+  CtrlTriggerHeader trigger;
+  trigger.SetType (TRIGGER_BASIC);
+  trigger.SetUlLength (m_uplinkMuPpduDuration.GetMicroSeconds ());
+  trigger.SetNRus (m_uplinkMuRus);
+  trigger.SetUlMcs (m_uplinkMuMcs);
+  std::vector<uint16_t>::iterator it = m_uplinkMuAids.begin ();
+  for (uint8_t ru = 0; ru < m_uplinkMuRus && it != m_uplinkMuAids.end (); ru++, it++)
+    {
+      trigger.AddUserInfo (*it, ru);
+    }
+
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_CTL_TRIGGER);
+  hdr.SetAddr1 (Mac48Address::GetBroadcast ());
+  hdr.SetAddr2 (GetAddress ());
+  hdr.SetDsNotFrom ();
+  hdr.SetDsNotTo ();
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (trigger);
+
+  //trigger frame, uplink PPDUs and multi-STA ack must fit in the slot
+  MacLowTransmissionParameters params;
+  params.DisableRts ();
+  params.DisableAck ();
+  params.DisableNextData ();
+  Time triggerTxTime = m_low->CalculateOverallTxTime (packet, &hdr, params);
+  Time needed = triggerTxTime + m_low->GetSifs () + m_uplinkMuPpduDuration
+    + m_low->GetSifs () + triggerTxTime;
+  if (Simulator::Now () + needed > m_uplinkMuSlotEnd)
+    {
+      NS_LOG_DEBUG ("not enough time left in the RAW slot for a triggered uplink");
+      m_uplinkMuAids.clear ();
+      return;
+    }
+  m_uplinkMuAids.erase (m_uplinkMuAids.begin (), it);
+  NS_LOG_DEBUG ("send trigger frame " << trigger);
+  m_uplinkMuPending = true;
+  m_beaconDca->Queue (packet, hdr);
+}
+
 void
 ApWifiMac::TxOk (const WifiMacHeader &hdr)
 {
@@ -1406,7 +1731,8 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
                 m_receivedAid.push_back(aid); //to change
             }
           else if (to.IsGroup ()
-                   || m_stationManager->IsAssociated (to))
+                   || m_stationManager->IsAssociated (to)
+                   || m_relayedStations.find (to) != m_relayedStations.end ())
             {
               NS_LOG_DEBUG ("forwarding frame from=" << from << ", to=" << to);
               Ptr<Packet> copy = packet->Copy ();
@@ -1429,6 +1755,47 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
               ForwardUp (packet, from, to);
             }
         }
+      else if (hdr->IsFromDs ()
+               && hdr->IsToDs ()
+               && bssid == GetAddress ()
+               && m_stationManager->IsAssociated (from))
+        {
+          //this is a frame relayed by one of our stations on behalf
+          //of a station associated with it. The source is remembered
+          //so that the frames to it are sent through the relay.
+          Mac48Address source = hdr->GetAddr4 ();
+          Mac48Address to = hdr->GetAddr3 ();
+          if (m_relayedStations[source] != from)
+            {
+              NS_LOG_DEBUG ("station " << source << " is reached through relay " << from);
+              m_relayedStations[source] = from;
+            }
+          if (to == GetAddress ())
+            {
+              NS_LOG_DEBUG ("relayed frame for me from=" << source << " via " << from);
+              ForwardUp (packet, source, to);
+            }
+          else if (to.IsGroup ()
+                   || m_stationManager->IsAssociated (to)
+                   || m_relayedStations.find (to) != m_relayedStations.end ())
+            {
+              NS_LOG_DEBUG ("forwarding relayed frame from=" << source << ", to=" << to);
+              Ptr<Packet> copy = packet->Copy ();
+              if (hdr->IsQosData ())
+                {
+                  ForwardDown (packet, source, to, hdr->GetQosTid ());
+                }
+              else
+                {
+                  ForwardDown (packet, source, to);
+                }
+              ForwardUp (copy, source, to);
+            }
+          else
+            {
+              ForwardUp (packet, source, to);
+            }
+        }
       else if (hdr->IsFromDs ()
                && hdr->IsToDs ())
         {
@@ -1459,6 +1826,12 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
             {
               if (m_stationManager->IsAssociated (from))
                 {
+                  if (m_groupAssocResp)
+                    {
+                      //the station missed the group addressed response
+                      //which admitted it
+                      QueueGroupAssocResp (from, 0);
+                    }
                   return;  //test, avoid repeate assoc
                  }
                //NS_LOG_LOGIC ("Received AssocReq "); // for test
@@ -1468,17 +1841,13 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
 
               packet->RemoveHeader (assocReq);
 
-              SupportedRates rates = assocReq.GetSupportedRates ();
-              bool problem = false;
+              SupportedRates::RateSet rates = assocReq.GetSupportedRates ().GetSupportedRateSet ();
+              SupportedRates::RateSet basicRates;
               for (uint32_t i = 0; i < m_stationManager->GetNBasicModes (); i++)
                 {
-                  WifiMode mode = m_stationManager->GetBasicMode (i);
-                  if (!rates.IsSupportedRate (mode.GetDataRate ()))
-                    {
-                      problem = true;
-                      break;
-                    }
+                  basicRates.set (SupportedRates::GetRateIndex (m_stationManager->GetBasicMode (i).GetDataRate ()));
                 }
+              bool problem = (basicRates & ~rates).any ();
 
               if (m_htSupported)
                 {
@@ -1508,12 +1877,12 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
                 {
                   //station supports all rates in Basic Rate Set.
                   //record all its supported modes in its associated WifiRemoteStation
-                  for (uint32_t j = 0; j < m_phy->GetNModes (); j++)
+                  const std::vector<uint8_t> &modeRates = GetPhyModeRateIndexes ();
+                  for (uint32_t j = 0; j < modeRates.size (); j++)
                     {
-                      WifiMode mode = m_phy->GetMode (j);
-                      if (rates.IsSupportedRate (mode.GetDataRate ()))
+                      if (rates.test (modeRates[j]))
                         {
-                          m_stationManager->AddSupportedMode (from, mode);
+                          m_stationManager->AddSupportedMode (from, m_phy->GetMode (j));
                         }
                     }
                   if (m_htSupported)
@@ -1539,7 +1908,18 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
                       uint8_t sta_type = s1gcapabilities.GetStaType ();
                       bool pageSlicingSupported = s1gcapabilities.GetPageSlicingSupport() != 0;
                       m_supportPageSlicingList[hdr->GetAddr2 ()] = pageSlicingSupported;
-                      SendAssocResp (hdr->GetAddr2 (), true, sta_type);
+                      if (m_groupAssocResp)
+                        {
+                          QueueGroupAssocResp (hdr->GetAddr2 (), sta_type);
+                        }
+                      else
+                        {
+                          SendAssocResp (hdr->GetAddr2 (), true, sta_type);
+                        }
+                    }
+                  else if (m_groupAssocResp)
+                    {
+                      QueueGroupAssocResp (hdr->GetAddr2 (), 0);
                     }
                   else
                     {
@@ -1611,6 +1991,16 @@ ApWifiMac::DoInitialize (void)
   NS_LOG_FUNCTION (this);
   m_beaconDca->Initialize ();
   m_beaconEvent.Cancel ();
+  m_firstPage = m_pageslice.GetPageindex ();
+  m_pageTurn = 0;
+  m_S1gRawCtr.SetSlotDurationStrategy (m_rawSlotDurationStrategy);
+  if (m_rawSlotDurationStrategy == S1gRawCtr::PLANNED_SLOT_DURATION)
+    {
+      m_S1gRawCtr.GetSlotPlanner ().SetPhy (m_phy);
+      WifiMode mode = m_rawPlannedDataMode.empty () ? m_phy->GetMode (0) : WifiMode (m_rawPlannedDataMode);
+      m_S1gRawCtr.SetPlannedTraffic (mode, m_rawPlannedSensorPayloadSize, m_rawPlannedOffloadPayloadSize,
+                                     m_rawPlannedSuccessProb);
+    }
   if (m_enableBeaconGeneration)
     {
       if (m_enableBeaconJitter)
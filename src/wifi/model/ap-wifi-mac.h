@@ -33,10 +33,12 @@
 #include "tim.h"
 #include "pageSlice.h"
 #include "s1g-raw-control.h"
+#include "aid-bitmap.h"
 #include "ns3/string.h"
 #include "extension-headers.h"
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
+#include <set>
 
 
 namespace ns3 {
@@ -137,10 +139,31 @@ public:
 
   uint8_t GetDTIMPeriod (void) const;
   void SetDTIMPeriod (uint8_t period);
+  /**
+   * \param dest the address of a station
+   * \return true if a packet for the station is buffered in one of the
+   *         EDCA queues. The buffered stations are tracked as packets are
+   *         queued and dequeued, and the expired packets are removed when
+   *         a beacon is built.
+   */
   bool HasPacketsInQueueTo(Mac48Address dest);
-  uint8_t HasPacketsToSubBlock (uint16_t subblockInd, uint16_t blockInd , uint16_t PageInd);
+  /**
+   * \param enable true to serve the downlink EDCA queues station by
+   *        station in deficit round robin, holding the frames of dozing
+   *        stations without blocking the others
+   */
+  void SetStationFairQueue (bool enable);
+  bool GetStationFairQueue (void) const;
   uint8_t HasPacketsToBlock (uint16_t blockInd , uint16_t PageInd);
   uint32_t HasPacketsToPage (uint8_t blockstart , uint8_t Page);
+  /**
+   * \param pages the number of pages paged in turn, one per DTIM
+   *        interval, from the page of the page slice element (1 to 4).
+   *        The stations of the other pages are never paged, which is
+   *        logged as they register.
+   */
+  void SetNumberOfPages (uint32_t pages);
+  uint32_t GetNumberOfPages (void) const;
 
 
 
@@ -149,6 +172,24 @@ private:
   virtual void Receive (Ptr<Packet> packet, const WifiMacHeader *hdr);
 
   void OnRAWSlotStart(uint16_t rps, uint8_t rawGroup, uint8_t slot);
+  /**
+   * Start soliciting triggered uplink transmissions from the stations
+   * of the RAW slot which just started.
+   *
+   * \param aids the AIDs of the associated stations of the slot
+   * \param remaining the time left until the end of the slot
+   */
+  void StartUplinkMu (std::vector<uint16_t> aids, Time remaining);
+  /**
+   * Stop soliciting triggered uplink transmissions at the end of the
+   * RAW slot, even if the last triggered uplink did not end.
+   */
+  void EndUplinkMu (void);
+  /**
+   * Send a trigger frame to the next stations of the current RAW slot,
+   * if the triggered uplink still fits in the slot.
+   */
+  void SendUplinkTrigger (void);
 
   /**
    * The packet we sent was successfully received by the receiver
@@ -196,6 +237,9 @@ private:
    * \param from the address to be used for Address 3 field in the header
    * \param to the address to be used for Address 1 field in the header
    * \param tid the traffic id for the packet
+   *
+   * If \p to is associated with one of our stations acting as a relay,
+   * the packet is sent to the relay in a four address frame.
    */
   void ForwardDown (Ptr<const Packet> packet, Mac48Address from, Mac48Address to, uint8_t tid);
   /**
@@ -213,10 +257,43 @@ private:
    * \param success indicates whether the association was successful or not
    */
   void SendAssocResp (Mac48Address to, bool success, uint8_t staType);
+  /**
+   * Assign the AID of a station and record it in the per type lists.
+   *
+   * \param to the address of the station
+   * \param success whether the association is accepted
+   * \param staType the S1G station type
+   * \return the AID of the station
+   */
+  uint16_t RegisterStation (Mac48Address to, bool success, uint8_t staType);
+  /**
+   * Answer a successful association request in the next group
+   * addressed association response.
+   *
+   * \param to the address of the station
+   * \param staType the S1G station type
+   */
+  void QueueGroupAssocResp (Mac48Address to, uint8_t staType);
+  /**
+   * Send a group addressed association response to the stations
+   * waiting for one.
+   */
+  void SendGroupAssocResp (void);
   /**
    * Forward a beacon packet to the beacon special DCF.
    */
   void SendOneBeacon (void);
+  /**
+   * Return the AIDs of the associated stations with buffered packets in
+   * the blocks of a page, and keep these stations awake.
+   *
+   * \param blockOffset the first block
+   * \param numBlocks the number of blocks, wrapping around the 32 blocks of the page
+   * \param page the page of the blocks
+   *
+   * \return the AIDs to page in the TIM
+   */
+  AidBitmap GetPagedAids (uint8_t blockOffset, uint8_t numBlocks, uint8_t page);
   /**
    * Return the HT capability of the current AP.
    *
@@ -226,7 +303,8 @@ private:
   S1gCapabilities GetS1gCapabilities (void) const;
   /**
    * Return an instance of SupportedRates that contains all rates that we support
-   * including HT rates.
+   * including HT rates. The element is only rebuilt when the PHY
+   * configuration or the basic modes of the station manager change.
    *
    * \return SupportedRates all rates that we support
    */
@@ -256,6 +334,20 @@ private:
   uint32_t GetSlotNum (void) const;
 
   Time GetSlotStartTimeFromAid (uint16_t aid) const;
+  /**
+   * \param page a page index
+   * \return the number of DTIM intervals from the next DTIM beacon until
+   *         the one of the page, 0 for a page which is not paged
+   */
+  uint8_t GetDtimsUntilPage (uint8_t page) const;
+  /**
+   * Called by the EDCA queues when they get their first packet for a
+   * station or lose their last one.
+   *
+   * \param address the receiver of the packets
+   * \param buffered true if a packet has been queued
+   */
+  void NotifyBuffered (Mac48Address address, bool buffered);
   void SetPageSlicingActivated (bool activate);
   bool GetPageSlicingActivated (void) const;
 
@@ -265,7 +357,7 @@ private:
   void SetTotalStaNum (uint32_t num);
   uint32_t GetTotalStaNum (void) const;
     
-  typedef std::vector<ns3::RPS *>::iterator RPSlistCI;
+  typedef std::vector<ns3::RPS>::iterator RPSlistCI;
     
   virtual void DoDispose (void);
   virtual void DoInitialize (void);
@@ -306,12 +398,19 @@ private:
   std::vector<uint16_t> m_OffloadList;
   std::vector<uint16_t> m_receivedAid;
   std::map<uint16_t, Mac48Address> m_AidToMacAddr;
+  std::map<Mac48Address, Mac48Address> m_relayedStations; //!< Stations associated with a relay, and that relay
   std::map<Mac48Address, bool> m_accessList;
     
   std::map<Mac48Address, bool> m_sleepList;
   std::map<Mac48Address, bool> m_supportPageSlicingList;
 
   S1gRawCtr m_S1gRawCtr;
+  S1gRawCtr::SlotDurationStrategy m_rawSlotDurationStrategy; //!< How the RAW slots are sized
+  std::string m_rawPlannedDataMode;          //!< Mode the planned RAW slots are sized for
+  uint16_t m_rawPlannedSensorPayloadSize;    //!< Packet size of the sensors the planned RAW slots are sized for
+  uint16_t m_rawPlannedOffloadPayloadSize;   //!< Packet size of the offload stations the planned RAW slots are sized for
+  uint16_t m_rawPlannedSuccessProb;          //!< Percentage of the planned exchanges that succeed
+  RPS m_plannedRps;                          //!< RPS of the current beacon with planned RAW slots
   Ptr<DcaTxop> m_beaconDca;                  //!< Dedicated DcaTxop for beacons
   Time m_beaconInterval;                     //!< Interval between beacons
   bool m_enableBeaconGeneration;             //!< Flag if beacons are being generated
@@ -321,7 +420,31 @@ private:
   std::string  m_outputpath;
   bool m_pageSlicingActivated;
   Time m_lastBeaconTime;
-  static uint16_t RpsIndex;
+  bool m_uplinkMuEnabled;                    //!< Flag if triggered uplink transmissions are solicited in RAW slots
+  uint8_t m_uplinkMuRus;                     //!< Number of resource units of a triggered uplink
+  uint8_t m_uplinkMuMcs;                     //!< MCS of the triggered uplink PPDUs
+  Time m_uplinkMuPpduDuration;               //!< Maximum duration of a triggered uplink PPDU
+  Time m_uplinkMuTriggerDelay;               //!< Delay between a RAW slot start and the first trigger frame
+  std::vector<uint16_t> m_uplinkMuAids;      //!< Stations of the current slot not triggered yet
+  Time m_uplinkMuSlotEnd;                    //!< End of the current RAW slot
+  bool m_uplinkMuPending;                    //!< Flag if a triggered uplink is in progress
+  EventId m_uplinkMuEndEvent;                //!< Event to stop the triggered uplinks at the end of the RAW slot
+  uint16_t m_authenThresholdStep;            //!< Step of the centralized authentication control threshold
+  bool m_groupAssocResp;                     //!< Flag if association responses are group addressed
+  Time m_groupAssocRespInterval;             //!< Collection time of a group addressed association response
+  uint32_t m_groupAssocRespMaxStas;          //!< Maximum number of stations per group addressed association response
+  std::vector<std::pair<Mac48Address, uint8_t> > m_pendingAssocResp; //!< Stations waiting for a group addressed association response
+  EventId m_groupAssocRespEvent;             //!< Event to send the next group addressed association response
+  std::map<Mac48Address, uint8_t> m_bufferedQueues; //!< Number of EDCA queues with packets for each station
+  std::map<Mac48Address, uint16_t> m_macAddrToAid;  //!< AID of each registered station
+  AidBitmap m_bufferedAids;                  //!< AIDs of the registered stations with buffered packets
+  uint32_t m_nPages;                         //!< Number of pages paged in turn
+  uint8_t m_firstPage;                       //!< Page of the first DTIM beacon
+  uint8_t m_pageTurn;                        //!< Turn of the page of the next DTIM beacon
+  mutable SupportedRates m_supportedRates;    //!< Supported rates element, with the basic rates
+  mutable uint32_t m_supportedRatesGeneration;  //!< Generation of the PHY elements m_supportedRates was built from
+  mutable uint32_t m_supportedRatesBasicModesGeneration; //!< Generation of the basic modes of the station manager in m_supportedRates
+  uint16_t RpsIndex;                         //!< Index of the RPS of the next beacon
 };
 
 } //namespace ns3
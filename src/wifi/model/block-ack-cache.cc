@@ -38,6 +38,7 @@ BlockAckCache::Init (uint16_t winStart, uint16_t winSize)
   m_winSize = winSize <= 64 ? winSize : 64;
   m_winEnd = (m_winStart + m_winSize - 1) % 4096;
   memset (m_bitmap, 0, sizeof (m_bitmap));
+  memset (m_scoreboard, 0, sizeof (m_scoreboard));
 }
 
 uint16_t
@@ -66,6 +67,7 @@ BlockAckCache::UpdateWithMpdu (const WifiMacHeader *hdr)
           WINSIZE_ASSERT;
         }
       m_bitmap[seqNumber] |= (0x0001 << hdr->GetFragmentNumber ());
+      UpdateScoreboard (seqNumber);
     }
 }
 
@@ -102,12 +104,60 @@ void
 BlockAckCache::ResetPortionOfBitmap (uint16_t start, uint16_t end)
 {
   NS_LOG_FUNCTION (this << start << end);
-  uint32_t i = start;
-  for (; i != end; i = (i + 1) % 4096)
+  if (end < start)
     {
-      m_bitmap[i] = 0;
+      ResetPortionOfBitmap (start, 4095);
+      ResetPortionOfBitmap (0, end);
+      return;
     }
-  m_bitmap[i] = 0;
+  memset (m_bitmap + start, 0, (end - start + 1) * sizeof (uint16_t));
+  uint16_t firstWord = start / 64;
+  uint16_t lastWord = end / 64;
+  uint64_t firstMask = ~uint64_t (0) << (start % 64);
+  uint64_t lastMask = ~uint64_t (0) >> (63 - end % 64);
+  if (firstWord == lastWord)
+    {
+      m_scoreboard[firstWord] &= ~(firstMask & lastMask);
+      return;
+    }
+  m_scoreboard[firstWord] &= ~firstMask;
+  for (uint16_t w = firstWord + 1; w < lastWord; w++)
+    {
+      m_scoreboard[w] = 0;
+    }
+  m_scoreboard[lastWord] &= ~lastMask;
+}
+
+void
+BlockAckCache::UpdateScoreboard (uint16_t seq)
+{
+  uint64_t bit = uint64_t (1) << (seq % 64);
+  if (m_bitmap[seq] == 1)
+    {
+      m_scoreboard[seq / 64] |= bit;
+    }
+  else
+    {
+      m_scoreboard[seq / 64] &= ~bit;
+    }
+}
+
+uint64_t
+BlockAckCache::GetScoreboardWindow (uint16_t start, uint16_t size) const
+{
+  NS_ASSERT (size <= 64);
+  uint16_t word = start / 64;
+  uint16_t offset = start % 64;
+  uint64_t bits = m_scoreboard[word] >> offset;
+  if (offset != 0)
+    {
+      bits |= m_scoreboard[(word + 1) % 64] << (64 - offset);
+    }
+  if (size < 64)
+    {
+      bits &= (uint64_t (1) << size) - 1;
+    }
+  return bits;
 }
 
 bool
@@ -127,19 +177,7 @@ BlockAckCache::FillBlockAckBitmap (CtrlBAckResponseHeader *blockAckHeader)
     }
   else if (blockAckHeader->IsCompressed ())
     {
-      uint32_t i = blockAckHeader->GetStartingSequence ();
-      uint32_t end = (i + m_winSize - 1) % 4096;
-      for (; i != end; i = (i + 1) % 4096)
-        {
-          if (m_bitmap[i] == 1)
-            {
-              blockAckHeader->SetReceivedPacket (i);
-            }
-        }
-      if (m_bitmap[i] == 1)
-        {
-          blockAckHeader->SetReceivedPacket (i);
-        }
+      blockAckHeader->SetCompressedBitmap (GetScoreboardWindow (blockAckHeader->GetStartingSequence (), m_winSize));
     }
   else if (blockAckHeader->IsMultiTid ())
     {
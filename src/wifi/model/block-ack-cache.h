@@ -53,12 +53,34 @@ public:
 private:
   void ResetPortionOfBitmap (uint16_t start, uint16_t end);
   bool IsInWindow (uint16_t seq);
+  /**
+   * Update the scoreboard bit of <i>seq</i> from its fragment bitmap.
+   *
+   * \param seq the sequence number
+   */
+  void UpdateScoreboard (uint16_t seq);
+  /**
+   * Return the scoreboard bits of <i>size</i> (at most 64) consecutive
+   * sequence numbers starting at <i>start</i>, wrapping around the
+   * sequence number space. Bit i refers to sequence number start + i.
+   *
+   * \param start the first sequence number
+   * \param size the number of sequence numbers
+   * \return the scoreboard bits
+   */
+  uint64_t GetScoreboardWindow (uint16_t start, uint16_t size) const;
 
   uint16_t m_winStart;
   uint8_t m_winSize;
   uint16_t m_winEnd;
 
   uint16_t m_bitmap[4096];
+  /**
+   * One bit per sequence number, set when the MPDU was received
+   * unfragmented. This mirrors m_bitmap[seq] == 1 and allows building
+   * a compressed block ack with a couple of word operations.
+   */
+  uint64_t m_scoreboard[64];
 };
 
 } //namespace ns3
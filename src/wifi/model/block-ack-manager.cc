@@ -564,9 +564,17 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
             }
           else if (blockAck->IsCompressed ())
             {
+              /* Work on a snapshot of the scoreboard: each queued MPDU is then
+                 checked with a single shift and mask. */
+              uint64_t ackedBitmap = blockAck->GetCompressedBitmap ();
+              uint16_t startingSeq = blockAck->GetStartingSequence ();
+              NS_LOG_DEBUG ("block ack from " << recipient << " acknowledges "
+                            << blockAck->GetNReceivedPackets () << " packets, first missing "
+                            << blockAck->GetFirstMissingSequence ());
               for (PacketQueueI queueIt = it->second.second.begin (); queueIt != queueEnd; )
                 {
-                  if (blockAck->IsPacketReceived ((*queueIt).hdr.GetSequenceNumber ()))
+                  uint16_t index = ((*queueIt).hdr.GetSequenceNumber () - startingSeq + 4096) % 4096;
+                  if (index < 64 && ((ackedBitmap >> index) & 0x1) == 1)
                     {
                       uint16_t currentSeq = (*queueIt).hdr.GetSequenceNumber ();
                       while (queueIt != queueEnd
@@ -26,6 +26,48 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("CtrlHeaders");
 
+namespace {
+
+/**
+ * \param word the word to inspect
+ * \return the number of bits set in <i>word</i>
+ */
+inline uint32_t
+PopCount (uint64_t word)
+{
+#if defined (__GNUC__)
+  return __builtin_popcountll (word);
+#else
+  uint32_t count = 0;
+  for (; word != 0; word &= word - 1)
+    {
+      count++;
+    }
+  return count;
+#endif
+}
+
+/**
+ * \param word the word to inspect, must not be zero
+ * \return the index of the lowest bit set in <i>word</i>
+ */
+inline uint32_t
+CountTrailingZeros (uint64_t word)
+{
+#if defined (__GNUC__)
+  return __builtin_ctzll (word);
+#else
+  uint32_t count = 0;
+  for (; (word & 0x1) == 0; word >>= 1)
+    {
+      count++;
+    }
+  return count;
+#endif
+}
+
+} //anonymous namespace
+
 /***********************************
  *       Block ack request
  ***********************************/
@@ -740,6 +782,24 @@ CtrlBAckResponseHeader::IsFragmentReceived (uint16_t seq, uint8_t frag) const
   return false;
 }
 
+uint32_t
+CtrlBAckResponseHeader::GetNReceivedPackets (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (IsCompressed (), "Only compressed block ack bitmaps can be counted");
+  return PopCount (bitmap.m_compressedBitmap);
+}
+
+uint16_t
+CtrlBAckResponseHeader::GetFirstMissingSequence (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (IsCompressed (), "Only compressed block ack bitmaps can be searched");
+  uint64_t missing = ~bitmap.m_compressedBitmap;
+  uint32_t index = (missing == 0) ? 64 : CountTrailingZeros (missing);
+  return (m_startingSeq + index) % 4096;
+}
+
 uint8_t
 CtrlBAckResponseHeader::IndexInBitmap (uint16_t seq) const
 {
@@ -778,6 +838,14 @@ CtrlBAckResponseHeader::GetCompressedBitmap (void) const
   return bitmap.m_compressedBitmap;
 }
 
+void
+CtrlBAckResponseHeader::SetCompressedBitmap (uint64_t bits)
+{
+  NS_LOG_FUNCTION (this << bits);
+  NS_ASSERT (IsCompressed ());
+  bitmap.m_compressedBitmap = bits;
+}
+
 void
 CtrlBAckResponseHeader::ResetBitmap (void)
 {
@@ -785,4 +853,228 @@ CtrlBAckResponseHeader::ResetBitmap (void)
   memset (&bitmap, 0, sizeof (bitmap));
 }
 
+
+/***********************************
+ *          Trigger
+ ***********************************/
+
+NS_OBJECT_ENSURE_REGISTERED (CtrlTriggerHeader);
+
+CtrlTriggerHeader::CtrlTriggerHeader ()
+  : m_type (TRIGGER_BASIC),
+    m_ulLength (0),
+    m_nRus (1),
+    m_ulMcs (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+CtrlTriggerHeader::~CtrlTriggerHeader ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+CtrlTriggerHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CtrlTriggerHeader")
+    .SetParent<Header> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<CtrlTriggerHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+CtrlTriggerHeader::GetInstanceTypeId (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return GetTypeId ();
+}
+
+void
+CtrlTriggerHeader::Print (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this << &os);
+  os << "Type=" << (uint16_t) m_type << ", UlLength=" << m_ulLength
+     << "us, NRus=" << (uint16_t) m_nRus << ", UlMcs=" << (uint16_t) m_ulMcs;
+  for (std::vector<UserInfo>::const_iterator it = m_userInfo.begin (); it != m_userInfo.end (); it++)
+    {
+      os << ", AID=" << it->aid << "/RU=" << (uint16_t) it->ruIndex;
+    }
+}
+
+uint32_t
+CtrlTriggerHeader::GetSerializedSize (void) const
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t size = 0;
+  size += 1; //Trigger type
+  size += 2; //UL length
+  size += 1; //Number of RUs
+  size += 1; //UL MCS
+  size += 1; //Number of user info fields
+  size += 3 * m_userInfo.size (); //AID and RU allocation
+  return size;
+}
+
+void
+CtrlTriggerHeader::Serialize (Buffer::Iterator start) const
+{
+  NS_LOG_FUNCTION (this << &start);
+  Buffer::Iterator i = start;
+  i.WriteU8 (m_type);
+  i.WriteHtolsbU16 (m_ulLength);
+  i.WriteU8 (m_nRus);
+  i.WriteU8 (m_ulMcs);
+  i.WriteU8 (m_userInfo.size ());
+  for (std::vector<UserInfo>::const_iterator it = m_userInfo.begin (); it != m_userInfo.end (); it++)
+    {
+      i.WriteHtolsbU16 (it->aid & 0x3fff);
+      i.WriteU8 (it->ruIndex);
+    }
+}
+
+uint32_t
+CtrlTriggerHeader::Deserialize (Buffer::Iterator start)
+{
+  NS_LOG_FUNCTION (this << &start);
+  Buffer::Iterator i = start;
+  m_type = i.ReadU8 ();
+  m_ulLength = i.ReadLsbtohU16 ();
+  m_nRus = i.ReadU8 ();
+  m_ulMcs = i.ReadU8 ();
+  uint8_t nUserInfo = i.ReadU8 ();
+  m_userInfo.clear ();
+  for (uint8_t j = 0; j < nUserInfo; j++)
+    {
+      UserInfo info;
+      info.aid = i.ReadLsbtohU16 () & 0x3fff;
+      info.ruIndex = i.ReadU8 ();
+      m_userInfo.push_back (info);
+    }
+  return i.GetDistanceFrom (start);
+}
+
+void
+CtrlTriggerHeader::SetType (enum TriggerFrameType type)
+{
+  NS_LOG_FUNCTION (this << type);
+  m_type = type;
+}
+
+void
+CtrlTriggerHeader::SetUlLength (uint16_t ulLength)
+{
+  NS_LOG_FUNCTION (this << ulLength);
+  m_ulLength = ulLength;
+}
+
+void
+CtrlTriggerHeader::SetNRus (uint8_t nRus)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) nRus);
+  NS_ASSERT (nRus > 0);
+  m_nRus = nRus;
+}
+
+void
+CtrlTriggerHeader::SetUlMcs (uint8_t mcs)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) mcs);
+  m_ulMcs = mcs;
+}
+
+void
+CtrlTriggerHeader::AddUserInfo (uint16_t aid, uint8_t ruIndex)
+{
+  NS_LOG_FUNCTION (this << aid << (uint16_t) ruIndex);
+  NS_ASSERT (ruIndex < m_nRus);
+  NS_ASSERT (m_userInfo.size () < 255);
+  UserInfo info;
+  info.aid = aid;
+  info.ruIndex = ruIndex;
+  m_userInfo.push_back (info);
+}
+
+enum TriggerFrameType
+CtrlTriggerHeader::GetType (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return static_cast<enum TriggerFrameType> (m_type);
+}
+
+bool
+CtrlTriggerHeader::IsBasic (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_type == TRIGGER_BASIC;
+}
+
+bool
+CtrlTriggerHeader::IsMultiStaAck (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_type == TRIGGER_MULTI_STA_ACK;
+}
+
+uint16_t
+CtrlTriggerHeader::GetUlLength (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_ulLength;
+}
+
+uint8_t
+CtrlTriggerHeader::GetNRus (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_nRus;
+}
+
+uint8_t
+CtrlTriggerHeader::GetUlMcs (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_ulMcs;
+}
+
+uint32_t
+CtrlTriggerHeader::GetNUserInfo (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_userInfo.size ();
+}
+
+uint16_t
+CtrlTriggerHeader::GetAid (uint32_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  NS_ASSERT (i < m_userInfo.size ());
+  return m_userInfo[i].aid;
+}
+
+uint8_t
+CtrlTriggerHeader::GetRuIndex (uint32_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  NS_ASSERT (i < m_userInfo.size ());
+  return m_userInfo[i].ruIndex;
+}
+
+bool
+CtrlTriggerHeader::FindRuIndex (uint16_t aid, uint8_t *ruIndex) const
+{
+  NS_LOG_FUNCTION (this << aid);
+  for (std::vector<UserInfo>::const_iterator it = m_userInfo.begin (); it != m_userInfo.end (); it++)
+    {
+      if (it->aid == aid)
+        {
+          *ruIndex = it->ruIndex;
+          return true;
+        }
+    }
+  return false;
+}
+
 }  //namespace ns3
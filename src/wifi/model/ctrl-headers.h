@@ -22,6 +22,7 @@
 #define CTRL_HEADERS_H
 
 #include "ns3/header.h"
+#include <vector>
 
 namespace ns3 {
 
@@ -299,6 +300,21 @@ public:
    *         false otherwise
    */
   bool IsFragmentReceived (uint16_t seq, uint8_t frag) const;
+  /**
+   * Return the number of packets ACKed in this compressed Block ACK
+   * response.
+   *
+   * \return the number of bits set in the compressed bitmap
+   */
+  uint32_t GetNReceivedPackets (void) const;
+  /**
+   * Return the sequence number of the first packet not ACKed in this
+   * compressed Block ACK response. If all 64 packets were ACKed, the
+   * sequence number following the bitmap is returned.
+   *
+   * \return the sequence number of the first missing packet
+   */
+  uint16_t GetFirstMissingSequence (void) const;
 
   /**
    * Return the starting sequence control.
@@ -325,6 +341,14 @@ public:
    * \return the compressed bitmap from the block ACK response header
    */
   uint64_t GetCompressedBitmap (void) const;
+  /**
+   * Set the compressed bitmap of the block ACK response header. Bit
+   * <i>i</i> acknowledges the packet with sequence number starting
+   * sequence + i.
+   *
+   * \param bits the compressed bitmap
+   */
+  void SetCompressedBitmap (uint64_t bits);
 
   /**
    * Reset the bitmap to 0.
@@ -405,6 +429,160 @@ private:
   } bitmap;
 };
 
+/**
+ * Enumeration for the variants of the trigger frame.
+ */
+enum TriggerFrameType
+{
+  TRIGGER_BASIC,
+  TRIGGER_MULTI_STA_ACK
+};
+
+/**
+ * \ingroup wifi
+ * \brief Headers for trigger frames.
+ *
+ *  A basic trigger frame is sent by the AP at the start of a RAW slot
+ *  to solicit a simultaneous uplink transmission from the listed
+ *  stations, each one on its own resource unit (RU), i.e. on an equal,
+ *  non overlapping sub-channel of the operating channel. The solicited
+ *  PPDUs must not last longer than the UL length.
+ *
+ *  The same format, with the multi-STA ack type, is used by the AP to
+ *  acknowledge the uplink PPDUs it has received: the user info list
+ *  then holds the stations and RUs whose frame was received correctly.
+ *  This takes the place of the multi-STA block ack.
+ */
+class CtrlTriggerHeader : public Header
+{
+public:
+  CtrlTriggerHeader ();
+  ~CtrlTriggerHeader ();
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+  /**
+   * Set the trigger frame type.
+   *
+   * \param type
+   */
+  void SetType (enum TriggerFrameType type);
+  /**
+   * Set the maximum duration of the solicited PPDUs.
+   *
+   * \param ulLength the duration in microseconds
+   */
+  void SetUlLength (uint16_t ulLength);
+  /**
+   * Set the number of RUs the channel is split into.
+   *
+   * \param nRus the number of RUs
+   */
+  void SetNRus (uint8_t nRus);
+  /**
+   * Set the MCS the stations use on their RU.
+   *
+   * \param mcs the MCS index
+   */
+  void SetUlMcs (uint8_t mcs);
+  /**
+   * Add a user info field assigning an RU to a station.
+   *
+   * \param aid the association ID of the station
+   * \param ruIndex the index of the RU
+   */
+  void AddUserInfo (uint16_t aid, uint8_t ruIndex);
+
+  /**
+   * Return the trigger frame type.
+   *
+   * \return the trigger frame type
+   */
+  enum TriggerFrameType GetType (void) const;
+  /**
+   * Check if this is a basic trigger frame.
+   *
+   * \return true if this is a basic trigger frame, false otherwise
+   */
+  bool IsBasic (void) const;
+  /**
+   * Check if this is a multi-STA acknowledgement.
+   *
+   * \return true if this is a multi-STA acknowledgement, false otherwise
+   */
+  bool IsMultiStaAck (void) const;
+  /**
+   * Return the maximum duration of the solicited PPDUs.
+   *
+   * \return the duration in microseconds
+   */
+  uint16_t GetUlLength (void) const;
+  /**
+   * Return the number of RUs the channel is split into.
+   *
+   * \return the number of RUs
+   */
+  uint8_t GetNRus (void) const;
+  /**
+   * Return the MCS the stations use on their RU.
+   *
+   * \return the MCS index
+   */
+  uint8_t GetUlMcs (void) const;
+  /**
+   * Return the number of user info fields.
+   *
+   * \return the number of user info fields
+   */
+  uint32_t GetNUserInfo (void) const;
+  /**
+   * Return the association ID of the i-th user info field.
+   *
+   * \param i the index of the user info field
+   *
+   * \return the association ID
+   */
+  uint16_t GetAid (uint32_t i) const;
+  /**
+   * Return the RU index of the i-th user info field.
+   *
+   * \param i the index of the user info field
+   *
+   * \return the RU index
+   */
+  uint8_t GetRuIndex (uint32_t i) const;
+  /**
+   * Look up the RU assigned to a station.
+   *
+   * \param aid the association ID of the station
+   * \param ruIndex set to the RU index if the station is listed
+   *
+   * \return true if the station is listed, false otherwise
+   */
+  bool FindRuIndex (uint16_t aid, uint8_t *ruIndex) const;
+
+
+private:
+  /**
+   * A user info field.
+   */
+  struct UserInfo
+  {
+    uint16_t aid;
+    uint8_t ruIndex;
+  };
+
+  uint8_t m_type;
+  uint16_t m_ulLength;
+  uint8_t m_nRus;
+  uint8_t m_ulMcs;
+  std::vector<UserInfo> m_userInfo;
+};
+
 } //namespace ns3
 
 #endif /* CTRL_HEADERS_H */
@@ -284,6 +284,7 @@ EdcaTxopN::EdcaTxopN ()
   m_rng = new RealRandomStream ();
   m_qosBlockedDestinations = new QosBlockedDestinations ();
   m_baManager = new BlockAckManager ();
+  m_queue->SetDozingCallback (MakeCallback (&EdcaTxopN::IsDozing, this));
   m_baManager->SetQueue (m_queue);
   m_baManager->SetBlockAckType (m_blockAckType);
   m_baManager->SetBlockDestinationCallback (MakeCallback (&QosBlockedDestinations::Block, m_qosBlockedDestinations));
@@ -508,6 +509,13 @@ EdcaTxopN::SetsleepList (std::map<Mac48Address, bool> list)
     m_sleepList = list;
 }
 
+bool
+EdcaTxopN::IsDozing (Mac48Address address) const
+{
+  std::map<Mac48Address, bool>::const_iterator it = m_sleepList.find (address);
+  return it != m_sleepList.end () && it->second;
+}
+
 void
 EdcaTxopN::NotifyAccessGranted (void)
 {
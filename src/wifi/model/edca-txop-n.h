@@ -496,6 +496,12 @@ public:
   
   void SetaccessList (std::map<Mac48Address, bool> list);
   void SetsleepList (std::map<Mac48Address, bool> list);
+  /**
+   * \param address the address of a station
+   * \return true if the station is in doze state according to the last
+   *         sleep list
+   */
+  bool IsDozing (Mac48Address address) const;
 
 
 private:
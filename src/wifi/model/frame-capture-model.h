@@ -0,0 +1,56 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FRAME_CAPTURE_MODEL_H
+#define FRAME_CAPTURE_MODEL_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ * \brief the interface for the models deciding whether a PHY receiving a
+ * frame switches to a new frame
+ *
+ * Without a frame capture model, a PHY drops the frames arriving while it
+ * receives another one.
+ */
+class FrameCaptureModel : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  /**
+   * \param timePreambleDetected the time the PHY synchronized to the
+   *        frame it receives
+   *
+   * \return true if the PHY may still switch to a new frame
+   */
+  virtual bool IsInCaptureWindow (Time timePreambleDetected) const = 0;
+  /**
+   * \param currentRxPowerW the receive power of the frame the PHY receives (W)
+   * \param newRxPowerW the receive power of the new frame (W)
+   *
+   * \return true if the PHY switches to the new frame
+   */
+  virtual bool CaptureNewFrame (double currentRxPowerW, double newRxPowerW) const = 0;
+};
+
+} //namespace ns3
+
+#endif /* FRAME_CAPTURE_MODEL_H */
@@ -25,6 +25,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include <algorithm>
+#include <new>
 
 namespace ns3 {
 
@@ -98,6 +99,73 @@ InterferenceHelper::Event::GetPreambleType (void) const
   return m_preamble;
 }
 
+void
+InterferenceHelper::EventDeleter::Delete (InterferenceHelper::Event *event)
+{
+  if (event->m_pool == 0)
+    {
+      delete event;
+      return;
+    }
+  //the event holds a reference to its pool: keep the pool alive
+  //while the event is destroyed
+  Ptr<EventPool> pool = event->m_pool;
+  pool->Release (event);
+}
+
+
+/****************************************************************
+ *       Storage of the events
+ ****************************************************************/
+
+InterferenceHelper::EventPool::EventPool ()
+  : m_nAllocated (0)
+{
+}
+
+InterferenceHelper::EventPool::~EventPool ()
+{
+  for (std::vector<void *>::iterator i = m_free.begin (); i != m_free.end (); i++)
+    {
+      ::operator delete (*i);
+    }
+}
+
+Ptr<InterferenceHelper::Event>
+InterferenceHelper::EventPool::Allocate (uint32_t size, WifiTxVector txVector,
+                                         enum WifiPreamble preamble,
+                                         Time duration, double rxPower)
+{
+  void *storage;
+  if (m_free.empty ())
+    {
+      storage = ::operator new (sizeof (Event));
+      m_nAllocated++;
+    }
+  else
+    {
+      storage = m_free.back ();
+      m_free.pop_back ();
+    }
+  Event *event = new (storage) Event (size, txVector, preamble, duration, rxPower);
+  event->m_pool = this;
+  //the event starts with a reference count of one
+  return Ptr<Event> (event, false);
+}
+
+void
+InterferenceHelper::EventPool::Release (InterferenceHelper::Event *event)
+{
+  event->~Event ();
+  m_free.push_back (event);
+}
+
+uint32_t
+InterferenceHelper::EventPool::GetNAllocated (void) const
+{
+  return m_nAllocated;
+}
+
 
 /****************************************************************
  *       Class which records SNIR change events for a
@@ -136,7 +204,11 @@ InterferenceHelper::NiChange::operator < (const InterferenceHelper::NiChange& o)
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_firstPower (0.0),
-    m_rxing (false)
+    m_rxing (false),
+    m_nMuRx (0),
+    m_eventPool (Create<EventPool> ()),
+    m_energyThresholdW (0.0),
+    m_energyEndValid (false)
 {
 }
 
@@ -153,15 +225,54 @@ InterferenceHelper::Add (uint32_t size, WifiTxVector txVector,
 {
   Ptr<InterferenceHelper::Event> event;
 
-  event = Create<InterferenceHelper::Event> (size,
-                                             txVector,
-                                             preamble,
-                                             duration,
-                                             rxPowerW);
-  AppendEvent (event);
+  event = m_eventPool->Allocate (size,
+                                 txVector,
+                                 preamble,
+                                 duration,
+                                 rxPowerW);
+  AppendNiChanges (event->GetStartTime (), event->GetEndTime (), rxPowerW);
+  if (txVector.GetNRus () > 1)
+    {
+      if (!m_rxing && m_nMuRx == 0)
+        {
+          Time now = Simulator::Now ();
+          Events::iterator i = m_ruEvents.begin ();
+          while (i != m_ruEvents.end ())
+            {
+              if ((*i)->GetEndTime () <= now)
+                {
+                  i = m_ruEvents.erase (i);
+                }
+              else
+                {
+                  i++;
+                }
+            }
+        }
+      m_ruEvents.push_back (event);
+    }
   return event;
 }
 
+void
+InterferenceHelper::AddForeignSignal (WifiTxVector txVector, Time duration, double rxPowerW)
+{
+  if (txVector.GetNRus () > 1)
+    {
+      //the RU signals are kept to leave out the orthogonal ones
+      Add (0, txVector, WIFI_PREAMBLE_NONE, duration, rxPowerW);
+      return;
+    }
+  Time now = Simulator::Now ();
+  AppendNiChanges (now, now + duration, rxPowerW);
+}
+
+Ptr<const InterferenceHelper::EventPool>
+InterferenceHelper::GetEventPool (void) const
+{
+  return m_eventPool;
+}
+
 
 void
 InterferenceHelper::SetNoiseFigure (double value)
@@ -191,6 +302,10 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW)
 {
   Time now = Simulator::Now ();
+  if (m_energyEndValid && energyW == m_energyThresholdW && now <= m_energyEnd)
+    {
+      return m_energyEnd - now;
+    }
   double noiseInterferenceW = 0.0;
   Time end = now;
   noiseInterferenceW = m_firstPower;
@@ -207,14 +322,23 @@ InterferenceHelper::GetEnergyDuration (double energyW)
           break;
         }
     }
-  return end > now ? end - now : MicroSeconds (0);
+  m_energyThresholdW = energyW;
+  m_energyEnd = end > now ? end : now;
+  m_energyEndValid = true;
+  return m_energyEnd - now;
 }
 
 void
-InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
+InterferenceHelper::AppendNiChanges (Time start, Time end, double rxPowerW)
 {
   Time now = Simulator::Now ();
-  if (!m_rxing)
+  //a signal ending within the energy horizon only raises the energy
+  //before it, so the horizon does not move
+  if (m_energyEndValid && (now >= m_energyEnd || end > m_energyEnd))
+    {
+      m_energyEndValid = false;
+    }
+  if (!m_rxing && m_nMuRx == 0)
     {
       NiChanges::iterator nowIterator = GetPosition (now);
       for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
@@ -222,13 +346,13 @@ InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
           m_firstPower += i->GetDelta ();
         }
       m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      m_niChanges.insert (m_niChanges.begin (), NiChange (start, rxPowerW));
     }
   else
     {
-      AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW ()));
+      AddNiChangeEvent (NiChange (start, rxPowerW));
     }
-  AddNiChangeEvent (NiChange (event->GetEndTime (), -event->GetRxPowerW ()));
+  AddNiChangeEvent (NiChange (end, -rxPowerW));
 
 }
 
@@ -266,6 +390,58 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event>
   return noiseInterference;
 }
 
+double
+InterferenceHelper::CalculateRuNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges *ni) const
+{
+  NS_ASSERT (m_rxing || m_nMuRx > 0);
+  Time start = event->GetStartTime ();
+  Time end = event->GetEndTime ();
+  double noiseInterference = m_firstPower - event->GetRxPowerW ();
+  NiChanges::const_iterator i = m_niChanges.begin ();
+  for (; i != m_niChanges.end () && i->GetTime () <= start; i++)
+    {
+      noiseInterference += i->GetDelta ();
+    }
+  for (; i != m_niChanges.end () && i->GetTime () < end; i++)
+    {
+      ni->push_back (*i);
+    }
+  uint8_t nRus = event->GetTxVector ().GetNRus ();
+  if (nRus > 1)
+    {
+      for (Events::const_iterator j = m_ruEvents.begin (); j != m_ruEvents.end (); j++)
+        {
+          Ptr<Event> other = *j;
+          if (other == event
+              || other->GetEndTime () <= start
+              || other->GetStartTime () >= end
+              || other->GetTxVector ().GetNRus () != nRus
+              || other->GetTxVector ().GetRuIndex () == event->GetTxVector ().GetRuIndex ())
+            {
+              continue;
+            }
+          //cancel the NI changes of a signal sent on another RU
+          if (other->GetStartTime () <= start)
+            {
+              noiseInterference -= other->GetRxPowerW ();
+            }
+          else
+            {
+              ni->push_back (NiChange (other->GetStartTime (), -other->GetRxPowerW ()));
+            }
+          if (other->GetEndTime () < end)
+            {
+              ni->push_back (NiChange (other->GetEndTime (), other->GetRxPowerW ()));
+            }
+        }
+      std::stable_sort (ni->begin (), ni->end ());
+    }
+  noiseInterference = std::max (noiseInterference, 0.0);
+  ni->insert (ni->begin (), NiChange (start, noiseInterference));
+  ni->push_back (NiChange (end, 0));
+  return noiseInterference;
+}
+
 double
 InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiMode mode) const
 {
@@ -280,14 +456,13 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
 }
 
 double
-InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event> event, enum WifiPreamble preamble, NiChanges *ni) const
 {
   NS_LOG_FUNCTION (this);
   double psr = 1.0; /* Packet Success Rate */
   NiChanges::iterator j = ni->begin ();
   Time previous = (*j).GetTime ();
   WifiMode payloadMode = event->GetPayloadMode ();
-  WifiPreamble preamble = event->GetPreambleType ();
   Time plcpHeaderStart;
   Time plcpHsigHeaderStart;
   Time plcpHtTrainingSymbolsStart;
@@ -690,7 +865,15 @@ struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event)
 {
   NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW;
+  if (event->GetTxVector ().GetNRus () > 1 || m_nMuRx > 0)
+    {
+      noiseInterferenceW = CalculateRuNoiseInterferenceW (event, &ni);
+    }
+  else
+    {
+      noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+    }
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetPayloadMode ());
@@ -698,7 +881,53 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> e
   /* calculate the SNIR at the start of the packet and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpPayloadPer (event, &ni);
+  double per = CalculatePlcpPayloadPer (event, event->GetPreambleType (), &ni);
+
+  struct SnrPer snrPer;
+  snrPer.snr = snr;
+  snrPer.per = per;
+  return snrPer;
+}
+
+struct InterferenceHelper::SnrPer
+InterferenceHelper::CalculateAmpduSubframeSnrPer (Ptr<InterferenceHelper::Event> event, Time start, Time duration)
+{
+  NiChanges ni;
+  double noiseInterferenceW;
+  if (event->GetTxVector ().GetNRus () > 1 || m_nMuRx > 0)
+    {
+      noiseInterferenceW = CalculateRuNoiseInterferenceW (event, &ni);
+    }
+  else
+    {
+      noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+    }
+
+  /* keep the NI changes of the MPDU. Except for the first MPDU, the
+   * changes at its start are part of the NI at its start, as they are
+   * when the MPDU is an event of its own.
+   */
+  bool first = start.IsZero ();
+  start += event->GetStartTime ();
+  Time end = start + duration;
+  NiChanges::const_iterator i = ni.begin () + 1;
+  for (; !first && i != ni.end () && i->GetTime () <= start; i++)
+    {
+      noiseInterferenceW += i->GetDelta ();
+    }
+  NiChanges subframe;
+  subframe.push_back (NiChange (start, noiseInterferenceW));
+  for (; i != ni.end () && i->GetTime () < end; i++)
+    {
+      subframe.push_back (*i);
+    }
+  subframe.push_back (NiChange (end, 0));
+
+  double snr = CalculateSnr (event->GetRxPowerW (),
+                             noiseInterferenceW,
+                             event->GetPayloadMode ());
+  WifiPreamble preamble = first ? event->GetPreambleType () : WIFI_PREAMBLE_NONE;
+  double per = CalculatePlcpPayloadPer (event, preamble, &subframe);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -710,7 +939,15 @@ struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event)
 {
   NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  double noiseInterferenceW;
+  if (event->GetTxVector ().GetNRus () > 1 || m_nMuRx > 0)
+    {
+      noiseInterferenceW = CalculateRuNoiseInterferenceW (event, &ni);
+    }
+  else
+    {
+      noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+    }
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              WifiPhy::GetPlcpHeaderMode (event->GetPayloadMode (), event->GetPreambleType ()));
@@ -730,8 +967,11 @@ void
 InterferenceHelper::EraseEvents (void)
 {
   m_niChanges.clear ();
+  m_ruEvents.clear ();
   m_rxing = false;
+  m_nMuRx = 0;
   m_firstPower = 0.0;
+  m_energyEndValid = false;
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -760,4 +1000,19 @@ InterferenceHelper::NotifyRxEnd ()
   m_rxing = false;
 }
 
+void
+InterferenceHelper::NotifyMuRxStart ()
+{
+  NS_LOG_FUNCTION (this);
+  m_nMuRx++;
+}
+
+void
+InterferenceHelper::NotifyMuRxEnd ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_nMuRx > 0);
+  m_nMuRx--;
+}
+
 } //namespace ns3
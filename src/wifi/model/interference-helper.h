@@ -42,10 +42,25 @@ class ErrorRateModel;
 class InterferenceHelper
 {
 public:
+  class Event;
+  class EventPool;
+
+  /**
+   * Give the events allocated by an EventPool back to it when their last
+   * reference goes away, and delete the others.
+   */
+  struct EventDeleter
+  {
+    /**
+     * \param event the event without references
+     */
+    static void Delete (Event *event);
+  };
+
   /**
    * Signal event for a packet.
    */
-  class Event : public SimpleRefCount<InterferenceHelper::Event>
+  class Event : public SimpleRefCount<InterferenceHelper::Event, empty, InterferenceHelper::EventDeleter>
   {
 public:
     /**
@@ -114,12 +129,61 @@ public:
 
 
 private:
+    friend class EventPool;
+    friend struct EventDeleter;
+
     uint32_t m_size;
     WifiTxVector m_txVector;
     enum WifiPreamble m_preamble;
     Time m_startTime;
     Time m_endTime;
     double m_rxPowerW;
+    Ptr<EventPool> m_pool; //!< the pool the event is given back to, if any
+  };
+
+  /**
+   * The storage of the events of an InterferenceHelper. The storage of
+   * the events without references is kept and reused for the next
+   * events, so that a PHY stops allocating events once it has seen as
+   * many overlapping signals as it will ever see. The pool lives as long
+   * as the InterferenceHelper or any of its events.
+   */
+  class EventPool : public SimpleRefCount<InterferenceHelper::EventPool>
+  {
+public:
+    EventPool ();
+    ~EventPool ();
+
+    /**
+     * Create an Event with the given parameters, in the storage of a
+     * released event if there is one.
+     *
+     * \param size packet size
+     * \param txVector TXVECTOR of the packet
+     * \param preamble preamble type
+     * \param duration duration of the signal
+     * \param rxPower the receive power (w)
+     *
+     * \return the event
+     */
+    Ptr<Event> Allocate (uint32_t size, WifiTxVector txVector,
+                         enum WifiPreamble preamble,
+                         Time duration, double rxPower);
+    /**
+     * Destroy an event of the pool and keep its storage.
+     *
+     * \param event the event without references
+     */
+    void Release (Event *event);
+    /**
+     * \return the number of events allocated from the heap since the
+     *         creation of the pool
+     */
+    uint32_t GetNAllocated (void) const;
+
+private:
+    std::vector<void *> m_free; //!< storage of the released events
+    uint32_t m_nAllocated;      //!< number of events allocated from the heap
   };
 
   /**
@@ -166,6 +230,9 @@ private:
    * \returns the expected amount of time the observed
    *          energy on the medium will be higher than
    *          the requested threshold.
+   *
+   * The end of this energy is kept until a signal extends it, so that
+   * the signals ending before it do not rescan the NI changes.
    */
   Time GetEnergyDuration (double energyW);
 
@@ -183,6 +250,21 @@ private:
   Ptr<InterferenceHelper::Event> Add (uint32_t size, WifiTxVector txvector,
                                       enum WifiPreamble preamble,
                                       Time duration, double rxPower);
+  /**
+   * Add a signal the PHY does not synchronize to: only its contribution
+   * to the noise and interference is recorded, without an event, unless
+   * it is sent on a resource unit and may thus be orthogonal to a
+   * reception.
+   *
+   * \param txvector TXVECTOR of the signal
+   * \param duration the duration of the signal
+   * \param rxPower receive power (W)
+   */
+  void AddForeignSignal (WifiTxVector txvector, Time duration, double rxPower);
+  /**
+   * \return the pool of the events of this interference helper
+   */
+  Ptr<const EventPool> GetEventPool (void) const;
 
   /**
    * Calculate the SNIR at the start of the plcp payload and accumulate
@@ -202,6 +284,20 @@ private:
    * \return struct of SNR and PER
    */
   struct InterferenceHelper::SnrPer CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event);
+  /**
+   * Calculate the SNIR at the start of an MPDU of an A-MPDU received as a
+   * single event, and the error rate of its payload, as if the MPDUs had
+   * been received one after the other.
+   *
+   * \param event the event of the whole A-MPDU
+   * \param start the time between the start of the event and the start of the MPDU
+   * \param duration the duration of the MPDU, with the preamble and the
+   *        PLCP header for the first one
+   *
+   * \return struct of SNR and PER
+   */
+  struct InterferenceHelper::SnrPer CalculateAmpduSubframeSnrPer (Ptr<InterferenceHelper::Event> event,
+                                                                  Time start, Time duration);
 
   /**
    * Notify that RX has started.
@@ -211,6 +307,15 @@ private:
    * Notify that RX has ended.
    */
   void NotifyRxEnd ();
+  /**
+   * Notify that the reception of a PPDU sent on a resource unit has
+   * started in parallel with the reception the PHY is synchronized to.
+   */
+  void NotifyMuRxStart ();
+  /**
+   * Notify that the reception of a PPDU sent on a resource unit has ended.
+   */
+  void NotifyMuRxEnd ();
   /**
    * Erase all events.
    */
@@ -266,11 +371,13 @@ private:
   typedef std::list<Ptr<Event> > Events;
 
   /**
-   * Append the given Event.
+   * Append the NI changes of a signal starting now.
    *
-   * \param event
+   * \param start the start of the signal
+   * \param end the end of the signal
+   * \param rxPowerW the receive power of the signal (W)
    */
-  void AppendEvent (Ptr<Event> event);
+  void AppendNiChanges (Time start, Time end, double rxPowerW);
   /**
    * Calculate noise and interference power in W.
    *
@@ -280,6 +387,18 @@ private:
    * \return noise and interference power
    */
   double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  /**
+   * Calculate noise and interference power in W for an event that is
+   * not necessarily the first one of the NI change list. Signals sent
+   * on another resource unit than the one of the event are orthogonal
+   * to it and thus left out.
+   *
+   * \param event
+   * \param ni
+   *
+   * \return noise and interference power
+   */
+  double CalculateRuNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
   /**
    * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
    * (Mode is not currently used)
@@ -307,11 +426,13 @@ private:
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
+   * \param preamble the preamble at the start of the NI changes, the one of
+   *        the event or WIFI_PREAMBLE_NONE for an MPDU of an A-MPDU but the first
    * \param ni
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpPayloadPer (Ptr<const Event> event, enum WifiPreamble preamble, NiChanges *ni) const;
   /**
    * Calculate the error rate of the plcp header. The plcp header can be divided into
    * multiple chunks (e.g. due to interference from other transmissions).
@@ -329,6 +450,12 @@ private:
   NiChanges m_niChanges;
   double m_firstPower;
   bool m_rxing;
+  uint32_t m_nMuRx;   //!< number of RU receptions in progress
+  Events m_ruEvents;  //!< signals sent on a resource unit
+  Ptr<EventPool> m_eventPool; //!< storage of the events
+  double m_energyThresholdW;   //!< threshold of the cached energy horizon (W)
+  Time m_energyEnd;            //!< end of the energy above m_energyThresholdW
+  bool m_energyEndValid;       //!< whether m_energyEnd is up to date
   /// Returns an iterator to the first nichange, which is later than moment
   NiChanges::iterator GetPosition (Time moment);
   /**
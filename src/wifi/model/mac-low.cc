@@ -312,54 +312,42 @@ public:
    * Create a PhyMacLowListener for the given MacLow.
    *
    * \param macLow
-   */      
-    Mac48Address listeneraddress;
+   */
   PhyMacLowListener (ns3::MacLow *macLow)
     : m_macLow (macLow)
   {
-     listeneraddress = m_macLow->GetAddress();
   }
+  virtual uint32_t GetNotificationMask (void) const
+  {
+    //MacLow only reacts to channel switching and sleep
+    return NOTIFY_SWITCHING_START | NOTIFY_SLEEP;
+  }
+  //the other notifications are masked out
   virtual void NotifyRxStart (Time duration)
   {
-      NS_LOG_DEBUG(listeneraddress << ",state RX," << Simulator::Now().GetSeconds());
-      //NS_LOG_UNCOND(listeneraddress << ",state RX," << Simulator::Now().GetSeconds());
   }
   virtual void NotifyRxEndOk (void)
   {
-      NS_LOG_DEBUG(listeneraddress << ",state RXENDOK," << Simulator::Now().GetSeconds());
-      //NS_LOG_UNCOND(listeneraddress << ",state RXENDOK," << Simulator::Now().GetSeconds());
   }
   virtual void NotifyRxEndError (void)
   {
-      NS_LOG_DEBUG(listeneraddress << ",state RXERROR," << Simulator::Now().GetSeconds());
-      //NS_LOG_UNCOND(listeneraddress << ",state RXERROR," << Simulator::Now().GetSeconds());
   }
   virtual void NotifyTxStart (Time duration, double txPowerDbm)
   {
-     NS_LOG_DEBUG (listeneraddress << ",state TX," << Simulator::Now().GetSeconds());
-      //NS_LOG_UNCOND (listeneraddress << ",state TX," << Simulator::Now().GetSeconds());
   }
   virtual void NotifyMaybeCcaBusyStart (Time duration)
   {
-      NS_LOG_DEBUG(listeneraddress << ",state CCAABUSY," << Simulator::Now().GetSeconds());
-      //NS_LOG_UNCOND(listeneraddress << ",state CCAABUSY," << Simulator::Now().GetSeconds());
   }
   virtual void NotifySwitchingStart (Time duration)
   {
-      NS_LOG_DEBUG(listeneraddress << ",state SWITCHING," << Simulator::Now().GetSeconds());
-      //NS_LOG_UNCOND(listeneraddress << ",state SWITCHING," << Simulator::Now().GetSeconds());
     m_macLow->NotifySwitchingStartNow (duration);
   }
   virtual void NotifySleep (void)
   {
-      NS_LOG_DEBUG(listeneraddress << ",state SLEEP," << Simulator::Now().GetSeconds());
-      //NS_LOG_UNCOND(listeneraddress << ",state SLEEP," << Simulator::Now().GetSeconds());
     m_macLow->NotifySleepNow ();
   }
   virtual void NotifyWakeup (void)
   {
-      NS_LOG_DEBUG(listeneraddress << ",state WAKEUP," << Simulator::Now().GetSeconds());
-     // NS_LOG_UNCOND(listeneraddress << ",state WAKEUP," << Simulator::Now().GetSeconds());
   }
 private:
   ns3::MacLow *m_macLow;
@@ -383,7 +371,10 @@ MacLow::MacLow ()
     m_listener (0),
     m_phyMacLowListener (0),
     m_ctsToSelfSupported (false),
-    m_receivedAtLeastOneMpdu (false)
+    m_receivedAtLeastOneMpdu (false),
+    m_nReceivedFrames (0),
+    m_nOverheardFrames (0),
+    m_muTriggerPreamble (WIFI_PREAMBLE_LONG)
 {
   NS_LOG_FUNCTION (this);
   m_lastNavDuration = Seconds (0);
@@ -445,6 +436,7 @@ MacLow::DoDispose (void)
   m_waitSifsEvent.Cancel ();
   m_endTxNoAckEvent.Cancel ();
   m_waitRifsEvent.Cancel ();
+  m_sendMuAckEvent.Cancel ();
   m_phy = 0;
   m_stationManager = 0;
   if (m_phyMacLowListener != 0)
@@ -710,6 +702,18 @@ MacLow::SetRxCallback (Callback<void, Ptr<Packet>, const WifiMacHeader *> callba
   m_rxCallback = callback;
 }
 
+void
+MacLow::SetTriggerCallback (Callback<void, const CtrlTriggerHeader &> callback)
+{
+  m_triggerCallback = callback;
+}
+
+void
+MacLow::SetMuUplinkEndCallback (Callback<void> callback)
+{
+  m_muUplinkEndCallback = callback;
+}
+
 void
 MacLow::RegisterDcfListener (MacLowDcfListener *listener)
 {
@@ -810,6 +814,10 @@ MacLow::StartTransmission (Ptr<const Packet> packet,
   CancelAllEvents ();
   m_listener = listener;
   m_txParams = params;
+  if (m_currentHdr.IsTrigger ())
+    {
+      packet->PeekHeader (m_muTrigger);
+    }
   if (m_currentHdr.IsPsPoll ())
     {
       SendPspoll ();   // no change on m_currentPacket
@@ -911,6 +919,8 @@ MacLow::NotifySwitchingStartNow (Time duration)
   NS_LOG_DEBUG ("switching channel. Cancelling MAC pending events");
   m_stationManager->Reset ();
   CancelAllEvents ();
+  //the triggered uplink in progress is not acknowledged
+  m_sendMuAckEvent.Cancel ();
   if (m_navCounterResetCtsMissed.IsRunning ())
     {
       m_navCounterResetCtsMissed.Cancel ();
@@ -926,6 +936,8 @@ MacLow::NotifySleepNow (void)
 {
   NS_LOG_DEBUG ("Device in sleep mode. Cancelling MAC pending events");
   CancelAllEvents ();
+  //the triggered uplink in progress is not acknowledged
+  m_sendMuAckEvent.Cancel ();
   if (m_navCounterResetCtsMissed.IsRunning ())
     {
       m_navCounterResetCtsMissed.Cancel ();
@@ -953,175 +965,302 @@ MacLow::ReceiveOk (Ptr<Packet> packet, double rxSnr, WifiTxVector txVector, Wifi
   NS_LOG_DEBUG ("duration/id=" << hdr.GetDuration ());
 
   NotifyNav (packet, hdr, preamble);
-  if (hdr.IsRts ())
-    {
-      //NS_LOG_DEBUG ("MacLow::ReceiveOk hdr.IsRts"); //for test
-      /* see section 9.2.5.7 802.11-1999
-       * A STA that is addressed by an RTS frame shall transmit a CTS frame after a SIFS
-       * period if the NAV at the STA receiving the RTS frame indicates that the medium is
-       * idle. If the NAV at the STA receiving the RTS indicates the medium is not idle,
-       * that STA shall not respond to the RTS frame.
+  m_nReceivedFrames++;
+  if (hdr.GetAddr1 () != m_self
+      && !m_promisc
+      && !hdr.GetAddr1 ().IsGroup ())
+    {
+      /* Frame not addressed to us: in a dense BSS this is most of the
+       * received frames and only the NAV update above is relevant.
+       * A control frame other than an RTS still ends any A-MPDU
+       * reception in progress.
        */
-      if (ampduSubframe)
+      m_nOverheardFrames++;
+      if (hdr.IsCtl () && !hdr.IsRts ())
         {
-          NS_FATAL_ERROR ("Received RTS as part of an A-MPDU");
-        }
-      else
-        {
-          if (isPrevNavZero
-              && hdr.GetAddr1 () == m_self)
-            {
-              NS_LOG_DEBUG ("rx RTS from=" << hdr.GetAddr2 () << ", schedule CTS");
-              NS_ASSERT (m_sendCtsEvent.IsExpired ());
-              m_stationManager->ReportRxOk (hdr.GetAddr2 (), &hdr,
-                                            rxSnr, txVector.GetMode ());
-              m_sendCtsEvent = Simulator::Schedule (GetSifs (),
-                                                    &MacLow::SendCtsAfterRts, this,
-                                                    hdr.GetAddr2 (),
-                                                    hdr.GetDuration (),
-                                                    txVector,
-                                                    rxSnr);
-            }
-          else
-            {
-              NS_LOG_DEBUG ("rx RTS from=" << hdr.GetAddr2 () << ", cannot schedule CTS");
-            }
+          m_receivedAtLeastOneMpdu = false;
         }
+      return;
     }
-  else if (hdr.IsCts ()
-           && hdr.GetAddr1 () == m_self
-           && m_ctsTimeoutEvent.IsRunning ()
-           && m_currentPacket != 0)
+  RxHandler handler = &MacLow::ReceiveDataOrMgt;
+  if (hdr.IsTrigger ())
     {
-      if (ampduSubframe)
-        {
-          NS_FATAL_ERROR ("Received CTS as part of an A-MPDU");
-        }
-
-      NS_LOG_DEBUG ("receive cts from=" << m_currentHdr.GetAddr1 ());
+      handler = &MacLow::ReceiveTrigger;
+    }
+  else if (hdr.IsCtl ())
+    {
+      handler = m_ctlRxHandlers[hdr.GetType ()];
+    }
+  (this->*handler)(packet, hdr, rxSnr, txVector, ampduSubframe, isPrevNavZero);
+}
 
-      SnrTag tag;
-      packet->RemovePacketTag (tag);
-      m_stationManager->ReportRxOk (m_currentHdr.GetAddr1 (), &m_currentHdr,
-                                    rxSnr, txVector.GetMode ());
-      m_stationManager->ReportRtsOk (m_currentHdr.GetAddr1 (), &m_currentHdr,
-                                     rxSnr, txVector.GetMode (), tag.Get ());
+const MacLow::RxHandler MacLow::m_ctlRxHandlers[WIFI_MAC_CTL_CTLWRAPPER + 1] =
+{
+  &MacLow::ReceiveRts,         // WIFI_MAC_CTL_RTS
+  &MacLow::ReceiveCts,         // WIFI_MAC_CTL_CTS
+  &MacLow::ReceiveAck,         // WIFI_MAC_CTL_ACK
+  &MacLow::ReceiveOtherCtl,    // WIFI_MAC_CTL_PSPOLL
+  &MacLow::ReceiveBlockAckReq, // WIFI_MAC_CTL_BACKREQ
+  &MacLow::ReceiveBlockAck,    // WIFI_MAC_CTL_BACKRESP
+  &MacLow::ReceiveOtherCtl     // WIFI_MAC_CTL_CTLWRAPPER
+};
 
-      m_ctsTimeoutEvent.Cancel ();
-      NotifyCtsTimeoutResetNow ();
-      m_listener->GotCts (rxSnr, txVector.GetMode ());
-      NS_ASSERT (m_sendDataEvent.IsExpired ());
-      m_sendDataEvent = Simulator::Schedule (GetSifs (),
-                                             &MacLow::SendDataAfterCts, this,
-                                             hdr.GetAddr1 (),
-                                             hdr.GetDuration ());
-    }
-  else if (hdr.IsAck ()
-           && hdr.GetAddr1 () == m_self
-           && (m_normalAckTimeoutEvent.IsRunning ()
-               || m_fastAckTimeoutEvent.IsRunning ()
-               || m_superFastAckTimeoutEvent.IsRunning ())
-           && m_txParams.MustWaitAck ())
-    {
-      NS_LOG_DEBUG ("receive ack from=" << m_currentHdr.GetAddr1 ());
-      SnrTag tag;
-      packet->RemovePacketTag (tag);
-      m_stationManager->ReportRxOk (m_currentHdr.GetAddr1 (), &m_currentHdr,
-                                    rxSnr, txVector.GetMode ());
-      m_stationManager->ReportDataOk (m_currentHdr.GetAddr1 (), &m_currentHdr,
-                                      rxSnr, txVector.GetMode (), tag.Get ());
+uint64_t
+MacLow::GetNReceivedFrames (void) const
+{
+  return m_nReceivedFrames;
+}
 
-      FlushAggregateQueue ();
-      bool gotAck = false;
+uint64_t
+MacLow::GetNOverheardFrames (void) const
+{
+  return m_nOverheardFrames;
+}
 
-      if (m_txParams.MustWaitNormalAck ()
-          && m_normalAckTimeoutEvent.IsRunning ())
-        {
-          m_normalAckTimeoutEvent.Cancel ();
-          NotifyAckTimeoutResetNow ();
-          gotAck = true;
-        }
-      if (m_txParams.MustWaitFastAck ()
-          && m_fastAckTimeoutEvent.IsRunning ())
-        {
-          m_fastAckTimeoutEvent.Cancel ();
-          NotifyAckTimeoutResetNow ();
-          gotAck = true;
-        }
-      if (gotAck)
+void
+MacLow::ReceiveRts (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr, WifiTxVector txVector,
+                    bool ampduSubframe, bool isPrevNavZero)
+{
+  /* see section 9.2.5.7 802.11-1999
+   * A STA that is addressed by an RTS frame shall transmit a CTS frame after a SIFS
+   * period if the NAV at the STA receiving the RTS frame indicates that the medium is
+   * idle. If the NAV at the STA receiving the RTS indicates the medium is not idle,
+   * that STA shall not respond to the RTS frame.
+   */
+  if (ampduSubframe)
+    {
+      NS_FATAL_ERROR ("Received RTS as part of an A-MPDU");
+    }
+  else
+    {
+      if (isPrevNavZero
+          && hdr.GetAddr1 () == m_self)
         {
-          m_listener->GotAck (rxSnr, txVector.GetMode ());
+          NS_LOG_DEBUG ("rx RTS from=" << hdr.GetAddr2 () << ", schedule CTS");
+          NS_ASSERT (m_sendCtsEvent.IsExpired ());
+          m_stationManager->ReportRxOk (hdr.GetAddr2 (), &hdr,
+                                        rxSnr, txVector.GetMode ());
+          m_sendCtsEvent = Simulator::Schedule (GetSifs (),
+                                                &MacLow::SendCtsAfterRts, this,
+                                                hdr.GetAddr2 (),
+                                                hdr.GetDuration (),
+                                                txVector,
+                                                rxSnr);
         }
-      if (m_txParams.HasNextPacket ())
+      else
         {
-          m_waitSifsEvent = Simulator::Schedule (GetSifs (),
-                                                 &MacLow::WaitSifsAfterEndTx, this);
+          NS_LOG_DEBUG ("rx RTS from=" << hdr.GetAddr2 () << ", cannot schedule CTS");
         }
     }
-  else if (hdr.IsBlockAck () && hdr.GetAddr1 () == m_self
-           && (m_txParams.MustWaitBasicBlockAck () || m_txParams.MustWaitCompressedBlockAck ())
-           && m_blockAckTimeoutEvent.IsRunning ())
+}
+
+void
+MacLow::ReceiveCts (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr, WifiTxVector txVector,
+                    bool ampduSubframe, bool isPrevNavZero)
+{
+  if (hdr.GetAddr1 () != m_self
+      || !m_ctsTimeoutEvent.IsRunning ()
+      || m_currentPacket == 0)
+    {
+      ReceiveOtherCtl (packet, hdr, rxSnr, txVector, ampduSubframe, isPrevNavZero);
+      return;
+    }
+  if (ampduSubframe)
     {
-      NS_LOG_DEBUG ("got block ack from " << hdr.GetAddr2 ());
-      CtrlBAckResponseHeader blockAck;
-      packet->RemoveHeader (blockAck);
-      m_blockAckTimeoutEvent.Cancel ();
+      NS_FATAL_ERROR ("Received CTS as part of an A-MPDU");
+    }
+
+  NS_LOG_DEBUG ("receive cts from=" << m_currentHdr.GetAddr1 ());
+
+  SnrTag tag;
+  packet->RemovePacketTag (tag);
+  m_stationManager->ReportRxOk (m_currentHdr.GetAddr1 (), &m_currentHdr,
+                                rxSnr, txVector.GetMode ());
+  m_stationManager->ReportRtsOk (m_currentHdr.GetAddr1 (), &m_currentHdr,
+                                 rxSnr, txVector.GetMode (), tag.Get ());
+
+  m_ctsTimeoutEvent.Cancel ();
+  NotifyCtsTimeoutResetNow ();
+  m_listener->GotCts (rxSnr, txVector.GetMode ());
+  NS_ASSERT (m_sendDataEvent.IsExpired ());
+  m_sendDataEvent = Simulator::Schedule (GetSifs (),
+                                         &MacLow::SendDataAfterCts, this,
+                                         hdr.GetAddr1 (),
+                                         hdr.GetDuration ());
+}
+
+void
+MacLow::ReceiveAck (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr, WifiTxVector txVector,
+                    bool ampduSubframe, bool isPrevNavZero)
+{
+  if (hdr.GetAddr1 () != m_self
+      || !(m_normalAckTimeoutEvent.IsRunning ()
+           || m_fastAckTimeoutEvent.IsRunning ()
+           || m_superFastAckTimeoutEvent.IsRunning ())
+      || !m_txParams.MustWaitAck ())
+    {
+      ReceiveOtherCtl (packet, hdr, rxSnr, txVector, ampduSubframe, isPrevNavZero);
+      return;
+    }
+  NS_LOG_DEBUG ("receive ack from=" << m_currentHdr.GetAddr1 ());
+  SnrTag tag;
+  packet->RemovePacketTag (tag);
+  m_stationManager->ReportRxOk (m_currentHdr.GetAddr1 (), &m_currentHdr,
+                                rxSnr, txVector.GetMode ());
+  m_stationManager->ReportDataOk (m_currentHdr.GetAddr1 (), &m_currentHdr,
+                                  rxSnr, txVector.GetMode (), tag.Get ());
+
+  FlushAggregateQueue ();
+  bool gotAck = false;
+
+  if (m_txParams.MustWaitNormalAck ()
+      && m_normalAckTimeoutEvent.IsRunning ())
+    {
+      m_normalAckTimeoutEvent.Cancel ();
+      NotifyAckTimeoutResetNow ();
+      gotAck = true;
+    }
+  if (m_txParams.MustWaitFastAck ()
+      && m_fastAckTimeoutEvent.IsRunning ())
+    {
+      m_fastAckTimeoutEvent.Cancel ();
       NotifyAckTimeoutResetNow ();
-      m_listener->GotBlockAck (&blockAck, hdr.GetAddr2 (), txVector.GetMode ());
-      m_sentMpdus = 0;
-      m_ampdu = false;
-      FlushAggregateQueue ();
+      gotAck = true;
     }
-  else if (hdr.IsBlockAckReq () && hdr.GetAddr1 () == m_self)
+  if (gotAck)
     {
-      CtrlBAckRequestHeader blockAckReq;
-      packet->RemoveHeader (blockAckReq);
-      if (!blockAckReq.IsMultiTid ())
+      m_listener->GotAck (rxSnr, txVector.GetMode ());
+    }
+  if (m_txParams.HasNextPacket ())
+    {
+      m_waitSifsEvent = Simulator::Schedule (GetSifs (),
+                                             &MacLow::WaitSifsAfterEndTx, this);
+    }
+}
+
+void
+MacLow::ReceiveBlockAck (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr, WifiTxVector txVector,
+                         bool ampduSubframe, bool isPrevNavZero)
+{
+  if (hdr.GetAddr1 () != m_self
+      || !(m_txParams.MustWaitBasicBlockAck () || m_txParams.MustWaitCompressedBlockAck ())
+      || !m_blockAckTimeoutEvent.IsRunning ())
+    {
+      ReceiveOtherCtl (packet, hdr, rxSnr, txVector, ampduSubframe, isPrevNavZero);
+      return;
+    }
+  NS_LOG_DEBUG ("got block ack from " << hdr.GetAddr2 ());
+  CtrlBAckResponseHeader blockAck;
+  packet->RemoveHeader (blockAck);
+  m_blockAckTimeoutEvent.Cancel ();
+  NotifyAckTimeoutResetNow ();
+  m_listener->GotBlockAck (&blockAck, hdr.GetAddr2 (), txVector.GetMode ());
+  m_sentMpdus = 0;
+  m_ampdu = false;
+  FlushAggregateQueue ();
+}
+
+void
+MacLow::ReceiveBlockAckReq (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr, WifiTxVector txVector,
+                            bool ampduSubframe, bool isPrevNavZero)
+{
+  if (hdr.GetAddr1 () != m_self)
+    {
+      ReceiveOtherCtl (packet, hdr, rxSnr, txVector, ampduSubframe, isPrevNavZero);
+      return;
+    }
+  CtrlBAckRequestHeader blockAckReq;
+  packet->RemoveHeader (blockAckReq);
+  if (!blockAckReq.IsMultiTid ())
+    {
+      uint8_t tid = blockAckReq.GetTidInfo ();
+      AgreementsI it = m_bAckAgreements.find (std::make_pair (hdr.GetAddr2 (), tid));
+      if (it != m_bAckAgreements.end ())
         {
-          uint8_t tid = blockAckReq.GetTidInfo ();
-          AgreementsI it = m_bAckAgreements.find (std::make_pair (hdr.GetAddr2 (), tid));
-          if (it != m_bAckAgreements.end ())
-            {
-              //Update block ack cache
-              BlockAckCachesI i = m_bAckCaches.find (std::make_pair (hdr.GetAddr2 (), tid));
-              NS_ASSERT (i != m_bAckCaches.end ());
-              (*i).second.UpdateWithBlockAckReq (blockAckReq.GetStartingSequence ());
+          //Update block ack cache
+          BlockAckCachesI i = m_bAckCaches.find (std::make_pair (hdr.GetAddr2 (), tid));
+          NS_ASSERT (i != m_bAckCaches.end ());
+          (*i).second.UpdateWithBlockAckReq (blockAckReq.GetStartingSequence ());
 
-              NS_ASSERT (m_sendAckEvent.IsExpired ());
-              /* See section 11.5.3 in IEEE 802.11 for mean of this timer */
-              ResetBlockAckInactivityTimerIfNeeded (it->second.first);
-              if ((*it).second.first.IsImmediateBlockAck ())
-                {
-                  NS_LOG_DEBUG ("rx blockAckRequest/sendImmediateBlockAck from=" << hdr.GetAddr2 ());
-                  m_sendAckEvent = Simulator::Schedule (GetSifs (),
-                                                        &MacLow::SendBlockAckAfterBlockAckRequest, this,
-                                                        blockAckReq,
-                                                        hdr.GetAddr2 (),
-                                                        hdr.GetDuration (),
-                                                        txVector.GetMode ());
-                }
-              else
-                {
-                  NS_FATAL_ERROR ("Delayed block ack not supported.");
-                }
-              m_receivedAtLeastOneMpdu = false;
+          NS_ASSERT (m_sendAckEvent.IsExpired ());
+          /* See section 11.5.3 in IEEE 802.11 for mean of this timer */
+          ResetBlockAckInactivityTimerIfNeeded (it->second.first);
+          if ((*it).second.first.IsImmediateBlockAck ())
+            {
+              NS_LOG_DEBUG ("rx blockAckRequest/sendImmediateBlockAck from=" << hdr.GetAddr2 ());
+              m_sendAckEvent = Simulator::Schedule (GetSifs (),
+                                                    &MacLow::SendBlockAckAfterBlockAckRequest, this,
+                                                    blockAckReq,
+                                                    hdr.GetAddr2 (),
+                                                    hdr.GetDuration (),
+                                                    txVector.GetMode ());
             }
           else
             {
-              NS_LOG_DEBUG ("There's not a valid agreement for this block ack request.");
+              NS_FATAL_ERROR ("Delayed block ack not supported.");
             }
+          m_receivedAtLeastOneMpdu = false;
         }
       else
         {
-          NS_FATAL_ERROR ("Multi-tid block ack is not supported.");
+          NS_LOG_DEBUG ("There's not a valid agreement for this block ack request.");
         }
     }
-  else if (hdr.IsCtl ())
+  else
+    {
+      NS_FATAL_ERROR ("Multi-tid block ack is not supported.");
+    }
+}
+
+void
+MacLow::ReceiveOtherCtl (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr, WifiTxVector txVector,
+                         bool ampduSubframe, bool isPrevNavZero)
+{
+  NS_LOG_DEBUG ("rx drop " << hdr.GetTypeString ());
+  m_receivedAtLeastOneMpdu = false;
+}
+
+void
+MacLow::ReceiveTrigger (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr, WifiTxVector txVector,
+                        bool ampduSubframe, bool isPrevNavZero)
+{
+  m_receivedAtLeastOneMpdu = false;
+  if (m_triggerCallback.IsNull ())
     {
       NS_LOG_DEBUG ("rx drop " << hdr.GetTypeString ());
-      m_receivedAtLeastOneMpdu = false;
+      return;
     }
-  else if (hdr.GetAddr1 () == m_self)
+  CtrlTriggerHeader trigger;
+  packet->RemoveHeader (trigger);
+  NS_LOG_DEBUG ("rx trigger from=" << hdr.GetAddr2 () << ", " << trigger);
+  m_triggerCallback (trigger);
+}
+
+void
+MacLow::ReceiveDataOrMgt (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr, WifiTxVector txVector,
+                          bool ampduSubframe, bool isPrevNavZero)
+{
+  if (hdr.GetAddr1 () == m_self && txVector.GetNRus () > 1)
+    {
+      /* PPDU solicited by our trigger frame: it is acknowledged by the
+       * multi-STA ack sent at the end of the uplink.
+       */
+      m_stationManager->ReportRxOk (hdr.GetAddr2 (), &hdr,
+                                    rxSnr, txVector.GetMode ());
+      uint8_t ruIndex = txVector.GetRuIndex ();
+      for (uint32_t i = 0; i < m_muTrigger.GetNUserInfo (); i++)
+        {
+          if (m_sendMuAckEvent.IsRunning () && m_muTrigger.GetRuIndex (i) == ruIndex)
+            {
+              NS_LOG_DEBUG ("rx trigger based PPDU from=" << hdr.GetAddr2 () << " on RU " << (uint32_t)ruIndex);
+              m_muAck.AddUserInfo (m_muTrigger.GetAid (i), ruIndex);
+              break;
+            }
+        }
+      ForwardUp (packet, hdr);
+      return;
+    }
+  if (hdr.GetAddr1 () == m_self)
     {
       m_stationManager->ReportRxOk (hdr.GetAddr2 (), &hdr,
                                     rxSnr, txVector.GetMode ());
@@ -1200,7 +1339,7 @@ MacLow::ReceiveOk (Ptr<Packet> packet, double rxSnr, WifiTxVector txVector, Wifi
                                                     rxSnr);
             }
         }
-      goto rxPacket;
+      ForwardUp (packet, hdr);
     }
   else if (hdr.GetAddr1 ().IsGroup ())
     {
@@ -1214,7 +1353,7 @@ MacLow::ReceiveOk (Ptr<Packet> packet, double rxSnr, WifiTxVector txVector, Wifi
             {
               NS_LOG_DEBUG ("rx group from=" << hdr.GetAddr2 ());
               m_receivedAtLeastOneMpdu = false;
-              goto rxPacket;
+              ForwardUp (packet, hdr);
             }
           else
             {
@@ -1227,19 +1366,17 @@ MacLow::ReceiveOk (Ptr<Packet> packet, double rxSnr, WifiTxVector txVector, Wifi
       NS_ASSERT (hdr.GetAddr1 () != m_self);
       if (hdr.IsData ())
         {
-          goto rxPacket;
+          ForwardUp (packet, hdr);
         }
     }
-  else
-    {
-      //NS_LOG_DEBUG_VERBOSE ("rx not-for-me from %d", GetSource (packet));
-    }
-  return;
-rxPacket:
+}
+
+void
+MacLow::ForwardUp (Ptr<Packet> packet, const WifiMacHeader &hdr)
+{
   WifiMacTrailer fcs;
   packet->RemoveTrailer (fcs);
   m_rxCallback (packet, &hdr);
-  return;
 }
 
 uint8_t
@@ -1715,11 +1852,10 @@ MacLow::ForwardDown (Ptr<const Packet> packet, const WifiMacHeader* hdr,
       WifiMacTrailer fcs;
       uint32_t queueSize = m_aggregateQueue->GetSize ();
       bool last = false;
-      uint8_t packetType = 0;
+      std::vector<Ptr<const Packet> > mpdus;
       //Add packet tag
       AmpduTag ampdutag;
       ampdutag.SetAmpdu (true);
-      Time delay = Seconds (0);
       for (; queueSize > 0; queueSize--)
         {
           dequeuedPacket = m_aggregateQueue->Dequeue (&newHdr);
@@ -1730,38 +1866,17 @@ MacLow::ForwardDown (Ptr<const Packet> packet, const WifiMacHeader* hdr,
           if (queueSize == 1)
             {
               last = true;
-              packetType = 2;
             }
           m_mpduAggregator->AddHeaderAndPad (newPacket, last);
 
           ampdutag.SetNoOfMpdus (queueSize);
           newPacket->AddPacketTag (ampdutag);
-          if (delay == Seconds (0))
-            {
-              NS_LOG_DEBUG ("Sending MPDU as part of A-MPDU");
-              packetType = 1;
-              m_phy->SendPacket (newPacket, txVector, preamble, packetType);
-            }
-          else
-            {
-              Simulator::Schedule (delay, &MacLow::SendPacket, this, newPacket, txVector, preamble, packetType);
-            }
-          if (queueSize > 1)
-            {
-              delay = delay + m_phy->CalculateTxDuration (GetSize (newPacket, &newHdr), txVector, preamble, m_phy->GetFrequency (), packetType, 0);
-            }
-          preamble = WIFI_PREAMBLE_NONE;  //need to check 802.11ah
+          mpdus.push_back (newPacket);
         }
+      m_phy->SendAmpdu (mpdus, txVector, preamble);
     }
 }
 
-void
-MacLow::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector, WifiPreamble preamble, uint8_t packetType)
-{
-  NS_LOG_DEBUG ("Sending MPDU as part of A-MPDU");
-  m_phy->SendPacket (packet, txVector, preamble, packetType);
-}
-
 void
 MacLow::CtsTimeout (void)
 {
@@ -2107,6 +2222,20 @@ MacLow::SendDataPacket (void)
               duration += GetAckDuration (m_currentHdr.GetAddr1 (), dataTxVector);
             }
         }
+      if (m_currentHdr.IsTrigger ())
+        {
+          //protect the solicited uplink PPDUs and the multi-STA ack
+          duration += GetSifs ();
+          duration += MicroSeconds (m_muTrigger.GetUlLength ());
+          duration += GetSifs ();
+          duration += m_phy->CalculateTxDuration (GetSize (m_currentPacket, &m_currentHdr),
+                                                  dataTxVector, preamble, m_phy->GetFrequency (), 0, 0);
+        }
+    }
+  if (m_currentHdr.IsTrigger ())
+    {
+      m_muTriggerTxVector = dataTxVector;
+      m_muTriggerPreamble = preamble;
     }
   m_currentHdr.SetDuration (duration);
 
@@ -2272,6 +2401,71 @@ MacLow::SendCtsAfterRts (Mac48Address source, Time duration, WifiTxVector rtsTxV
   ForwardDown (packet, &cts, ctsTxVector, preamble);
 }
 
+void
+MacLow::StartTriggerBasedTransmission (Ptr<const Packet> packet, const WifiMacHeader &hdr,
+                                       WifiTxVector txVector, WifiPreamble preamble)
+{
+  NS_LOG_FUNCTION (this << packet << &hdr << txVector << preamble);
+  Simulator::Schedule (GetSifs (), &MacLow::SendTriggerBasedPpdu, this,
+                       packet, hdr, txVector, preamble);
+}
+
+void
+MacLow::SendTriggerBasedPpdu (Ptr<const Packet> packet, WifiMacHeader hdr,
+                              WifiTxVector txVector, WifiPreamble preamble)
+{
+  NS_LOG_FUNCTION (this << packet << &hdr << txVector << preamble);
+  if (m_phy->IsStateTx () || m_phy->IsStateRx () || m_phy->IsStateSwitching () || m_phy->IsStateSleep ())
+    {
+      NS_LOG_DEBUG ("cannot respond to trigger frame");
+      return;
+    }
+  Ptr<Packet> ppdu = packet->Copy ();
+  ppdu->AddHeader (hdr);
+  WifiMacTrailer fcs;
+  ppdu->AddTrailer (fcs);
+  NS_LOG_DEBUG ("send trigger based PPDU, to=" << hdr.GetAddr1 () <<
+                ", size=" << ppdu->GetSize () <<
+                ", mode=" << txVector.GetMode () <<
+                ", RU=" << (uint32_t)txVector.GetRuIndex ());
+  m_phy->SendPacket (ppdu, txVector, preamble, 0);
+}
+
+void
+MacLow::SendMultiStaAck (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_muAck.GetNUserInfo () > 0
+      && !m_phy->IsStateTx () && !m_phy->IsStateRx () && !m_phy->IsStateSwitching ())
+    {
+      WifiMacHeader ack;
+      ack.SetType (WIFI_MAC_CTL_TRIGGER);
+      ack.SetDsNotFrom ();
+      ack.SetDsNotTo ();
+      ack.SetNoMoreFragments ();
+      ack.SetNoRetry ();
+      ack.SetAddr1 (Mac48Address::GetBroadcast ());
+      ack.SetAddr2 (m_self);
+      ack.SetDuration (Seconds (0));
+
+      Ptr<Packet> packet = Create<Packet> ();
+      packet->AddHeader (m_muAck);
+      packet->AddHeader (ack);
+      WifiMacTrailer fcs;
+      packet->AddTrailer (fcs);
+      NS_LOG_DEBUG ("send multi-STA ack, " << m_muAck);
+      m_phy->SendPacket (packet, m_muTriggerTxVector, m_muTriggerPreamble, 0);
+    }
+  else
+    {
+      NS_LOG_DEBUG ("no multi-STA ack sent, " << m_muAck.GetNUserInfo () << " uplink PPDUs received");
+    }
+  if (!m_muUplinkEndCallback.IsNull ())
+    {
+      m_muUplinkEndCallback ();
+    }
+}
+
 void
 MacLow::SendDataAfterCts (Mac48Address source, Time duration)
 {
@@ -2388,6 +2582,16 @@ MacLow::WaitSifsAfterEndTx (void)
 void
 MacLow::EndTxNoAck (void)
 {
+  if (m_currentHdr.IsTrigger () && m_muTrigger.IsBasic ())
+    {
+      m_muAck = CtrlTriggerHeader ();
+      m_muAck.SetType (TRIGGER_MULTI_STA_ACK);
+      m_muAck.SetNRus (m_muTrigger.GetNRus ());
+      m_muAck.SetUlMcs (m_muTrigger.GetUlMcs ());
+      NS_ASSERT (m_sendMuAckEvent.IsExpired ());
+      m_sendMuAckEvent = Simulator::Schedule (GetSifs () + MicroSeconds (m_muTrigger.GetUlLength ()) + GetSifs (),
+                                              &MacLow::SendMultiStaAck, this);
+    }
   MacLowTransmissionListener *listener = m_listener;
   m_listener = 0;
   listener->EndTxNoAck ();
@@ -680,6 +680,18 @@ public:
    * an instance of ns3::MacRxMiddle.
    */
   void SetRxCallback (Callback<void,Ptr<Packet>,const WifiMacHeader *> callback);
+  /**
+   * \param callback the callback which receives the trigger frames and
+   *        multi-STA acks sent by the AP.
+   *
+   * Without this callback, trigger frames are dropped.
+   */
+  void SetTriggerCallback (Callback<void,const CtrlTriggerHeader &> callback);
+  /**
+   * \param callback the callback invoked when the uplink PPDUs solicited
+   *        by a trigger frame we sent have been received and acknowledged.
+   */
+  void SetMuUplinkEndCallback (Callback<void> callback);
   /**
    * \param listener listen to NAV events for every incoming
    *        and outgoing packet.
@@ -712,6 +724,18 @@ public:
                                   const WifiMacHeader* hdr,
                                   MacLowTransmissionParameters parameters,
                                   MacLowTransmissionListener *listener);
+  /**
+   * \param packet packet to send (does not include the 802.11 MAC header and checksum)
+   * \param hdr 802.11 header for packet to send
+   * \param txVector TXVECTOR restricting the transmission to the assigned resource unit
+   * \param preamble the preamble to use
+   *
+   * Send the packet a SIFS from now, in response to the trigger frame
+   * that was just received. The transmission bypasses the channel access
+   * and is not acknowledged by a normal ACK.
+   */
+  void StartTriggerBasedTransmission (Ptr<const Packet> packet, const WifiMacHeader &hdr,
+                                      WifiTxVector txVector, WifiPreamble preamble);
 
   /**
    * \param packet packet received
@@ -724,6 +748,15 @@ public:
    * the MAC layer that a packet was successfully received.
    */
   void ReceiveOk (Ptr<Packet> packet, double rxSnr, WifiTxVector txVector, WifiPreamble preamble, bool ampduSubframe);
+  /**
+   * \return the number of frames successfully received from the PHY
+   */
+  uint64_t GetNReceivedFrames (void) const;
+  /**
+   * \return the number of received frames that were neither addressed to
+   *         us nor group addressed, and were only used to update the NAV
+   */
+  uint64_t GetNOverheardFrames (void) const;
   /**
    * \param packet packet received.
    * \param rxSnr snr of packet received.
@@ -884,15 +917,6 @@ private:
    */
   void ForwardDown (Ptr<const Packet> packet, const WifiMacHeader *hdr,
                     WifiTxVector txVector, WifiPreamble preamble);
-  /**
-   * Forward the packet down to WifiPhy for transmission. This is called for each MPDU when MPDU aggregation is used.
-   *
-   * \param packet
-   * \param hdr
-   * \param txVector
-   * \param preamble
-   */
-  void SendPacket (Ptr<const Packet> packet, WifiTxVector txVector, WifiPreamble preamble, uint8_t packetType);
   /**
    * Return a TXVECTOR for the RTS frame given the destination.
    * The function consults WifiRemoteStationManager, which controls the rate
@@ -1020,6 +1044,67 @@ private:
 
 
   void NotifyNav (Ptr<const Packet> packet,const WifiMacHeader &hdr, WifiPreamble preamble);
+
+  /**
+   * Handler for a received frame, selected by frame type in ReceiveOk.
+   * The arguments are the packet (without MAC header), the MAC header,
+   * the SNR, the TXVECTOR, whether the MPDU is part of an A-MPDU and
+   * whether the NAV was zero before the frame was received.
+   */
+  typedef void (MacLow::*RxHandler)(Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                                    WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Receive handlers for control frames, indexed by WifiMacType,
+   * except the trigger frames.
+   */
+  static const RxHandler m_ctlRxHandlers[WIFI_MAC_CTL_CTLWRAPPER + 1];
+  /**
+   * Handle a received RTS.
+   */
+  void ReceiveRts (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                   WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Handle a received CTS.
+   */
+  void ReceiveCts (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                   WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Handle a received ACK.
+   */
+  void ReceiveAck (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                   WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Handle a received Block ACK.
+   */
+  void ReceiveBlockAck (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                        WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Handle a received Block ACK request.
+   */
+  void ReceiveBlockAckReq (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                           WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Drop a control frame that is not expected in the current state.
+   */
+  void ReceiveOtherCtl (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                        WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Handle a received trigger frame or multi-STA ack.
+   */
+  void ReceiveTrigger (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                       WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Handle a received data or management frame.
+   */
+  void ReceiveDataOrMgt (Ptr<Packet> packet, const WifiMacHeader &hdr, double rxSnr,
+                         WifiTxVector txVector, bool ampduSubframe, bool isPrevNavZero);
+  /**
+   * Strip the FCS and forward the packet to the upper MAC.
+   *
+   * \param packet the packet without MAC header
+   * \param hdr the MAC header of the packet
+   */
+  void ForwardUp (Ptr<Packet> packet, const WifiMacHeader &hdr);
   /**
    * Reset NAV with the given duration.
    *
@@ -1111,6 +1196,20 @@ private:
    * \param rtsSnr
    */
   void SendCtsAfterRts (Mac48Address source, Time duration, WifiTxVector rtsTxVector, double rtsSnr);
+  /**
+   * Send a PPDU solicited by a trigger frame.
+   *
+   * \param packet
+   * \param hdr
+   * \param txVector
+   * \param preamble
+   */
+  void SendTriggerBasedPpdu (Ptr<const Packet> packet, WifiMacHeader hdr,
+                             WifiTxVector txVector, WifiPreamble preamble);
+  /**
+   * Acknowledge the uplink PPDUs received after our trigger frame.
+   */
+  void SendMultiStaAck (void);
   /**
    * Send ACK after receiving DATA.
    *
@@ -1285,6 +1384,8 @@ private:
   Ptr<WifiPhy> m_phy; //!< Pointer to WifiPhy (actually send/receives frames)
   Ptr<WifiRemoteStationManager> m_stationManager; //!< Pointer to WifiRemoteStationManager (rate control)
   MacLowRxCallback m_rxCallback; //!< Callback to pass packet up
+  Callback<void,const CtrlTriggerHeader &> m_triggerCallback; //!< Callback to pass trigger frames up
+  Callback<void> m_muUplinkEndCallback; //!< Callback invoked at the end of a triggered uplink
 
   /**
    * A struct for packet, Wifi header, and timestamp.
@@ -1370,6 +1471,13 @@ private:
   Ptr<WifiMacQueue> m_aggregateQueue; //!< Queue used for MPDU aggregation
   WifiTxVector m_currentTxVector;     //!< TXVECTOR used for the current packet transmission
   bool m_receivedAtLeastOneMpdu;      //!< Flag whether an MPDU has already been successfully received while receiving an A-MPDU
+  uint64_t m_nReceivedFrames;         //!< Number of frames received from the PHY
+  uint64_t m_nOverheardFrames;        //!< Number of received frames only used to update the NAV
+  CtrlTriggerHeader m_muTrigger;      //!< Last trigger frame sent
+  CtrlTriggerHeader m_muAck;          //!< Multi-STA ack for the uplink PPDUs solicited by the last trigger frame
+  WifiTxVector m_muTriggerTxVector;   //!< TXVECTOR used for the last trigger frame
+  WifiPreamble m_muTriggerPreamble;   //!< Preamble used for the last trigger frame
+  EventId m_sendMuAckEvent;           //!< Event to send the multi-STA ack
   std::vector<Item> m_txPackets;      //!< Contain temporary items to be sent with the next A-MPDU transmission, once RTS/CTS exchange has succeeded. It is not used in other cases.
 };
 
@@ -23,6 +23,7 @@
 #include "mgt-headers.h"
 #include "ns3/simulator.h"
 #include "ns3/assert.h"
+#include "ns3/address-utils.h"
 #include "ns3/log.h" //for test
 
 namespace ns3 {
@@ -727,6 +728,162 @@ MgtAssocResponseHeader::Deserialize (Buffer::Iterator start)
 }
 
 
+/***********************************************************
+ *          Group Assoc Response
+ ***********************************************************/
+
+NS_OBJECT_ENSURE_REGISTERED (MgtGroupAssocResponseHeader);
+
+MgtGroupAssocResponseHeader::MgtGroupAssocResponseHeader ()
+{
+}
+
+MgtGroupAssocResponseHeader::~MgtGroupAssocResponseHeader ()
+{
+}
+
+SupportedRates
+MgtGroupAssocResponseHeader::GetSupportedRates (void) const
+{
+  return m_rates;
+}
+
+void
+MgtGroupAssocResponseHeader::SetSupportedRates (SupportedRates rates)
+{
+  m_rates = rates;
+}
+
+void
+MgtGroupAssocResponseHeader::SetHtCapabilities (HtCapabilities htcapabilities)
+{
+  m_htCapability = htcapabilities;
+}
+
+HtCapabilities
+MgtGroupAssocResponseHeader::GetHtCapabilities (void) const
+{
+  return m_htCapability;
+}
+
+void
+MgtGroupAssocResponseHeader::SetS1gCapabilities (S1gCapabilities s1gcapabilities)
+{
+  m_s1gCapability = s1gcapabilities;
+}
+
+S1gCapabilities
+MgtGroupAssocResponseHeader::GetS1gCapabilities (void) const
+{
+  return m_s1gCapability;
+}
+
+void
+MgtGroupAssocResponseHeader::AddStation (Mac48Address address, uint16_t aid)
+{
+  NS_ASSERT (m_stations.size () < 255);
+  m_stations.push_back (std::make_pair (address, aid));
+}
+
+uint32_t
+MgtGroupAssocResponseHeader::GetNStations (void) const
+{
+  return m_stations.size ();
+}
+
+bool
+MgtGroupAssocResponseHeader::FindAid (Mac48Address address, uint16_t *aid) const
+{
+  for (std::vector<std::pair<Mac48Address, uint16_t> >::const_iterator it = m_stations.begin ();
+       it != m_stations.end (); it++)
+    {
+      if (it->first == address)
+        {
+          *aid = it->second;
+          return true;
+        }
+    }
+  return false;
+}
+
+TypeId
+MgtGroupAssocResponseHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MgtGroupAssocResponseHeader")
+    .SetParent<Header> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<MgtGroupAssocResponseHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+MgtGroupAssocResponseHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+uint32_t
+MgtGroupAssocResponseHeader::GetSerializedSize (void) const
+{
+  uint32_t size = 0;
+  size += m_capability.GetSerializedSize ();
+  size += 1; //number of stations
+  size += m_stations.size () * 8; //address and aid
+  size += m_rates.GetSerializedSize ();
+  size += m_rates.extended.GetSerializedSize ();
+  size += m_htCapability.GetSerializedSize ();
+  size += m_s1gCapability.GetSerializedSize ();
+  return size;
+}
+
+void
+MgtGroupAssocResponseHeader::Print (std::ostream &os) const
+{
+  os << "stations=" << m_stations.size () << ", "
+     << "rates=" << m_rates << ", "
+     << "HT Capabilities=" << m_htCapability;
+}
+
+void
+MgtGroupAssocResponseHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  i = m_capability.Serialize (i);
+  i.WriteU8 (m_stations.size ());
+  for (std::vector<std::pair<Mac48Address, uint16_t> >::const_iterator it = m_stations.begin ();
+       it != m_stations.end (); it++)
+    {
+      WriteTo (i, it->first);
+      i.WriteHtolsbU16 (it->second);
+    }
+  i = m_rates.Serialize (i);
+  i = m_rates.extended.Serialize (i);
+  i = m_htCapability.Serialize (i);
+  i = m_s1gCapability.Serialize (i);
+}
+
+uint32_t
+MgtGroupAssocResponseHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  i = m_capability.Deserialize (i);
+  uint8_t nStations = i.ReadU8 ();
+  m_stations.clear ();
+  for (uint8_t j = 0; j < nStations; j++)
+    {
+      Mac48Address address;
+      ReadFrom (i, address);
+      uint16_t aid = i.ReadLsbtohU16 ();
+      m_stations.push_back (std::make_pair (address, aid));
+    }
+  i = m_rates.Deserialize (i);
+  i = m_rates.extended.DeserializeIfPresent (i);
+  i = m_htCapability.DeserializeIfPresent (i);
+  i = m_s1gCapability.DeserializeIfPresent (i);
+  return i.GetDistanceFrom (start);
+}
+
 /**********************************************************
  *   ActionFrame
  **********************************************************/
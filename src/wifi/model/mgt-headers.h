@@ -24,8 +24,10 @@
 #define MGT_HEADERS_H
 
 #include <stdint.h>
+#include <vector>
 
 #include "ns3/header.h"
+#include "ns3/mac48-address.h"
 #include "status-code.h"
 #include "capability-information.h"
 #include "supported-rates.h"
@@ -291,6 +293,97 @@ private:
 };
 
 
+/**
+ * \ingroup wifi
+ * Implement the header for group addressed association responses.
+ *
+ * One frame answers the association requests of several stations: it
+ * carries the capabilities of the AP once, followed by the address and
+ * the AID of each admitted station.
+ */
+class MgtGroupAssocResponseHeader : public Header
+{
+public:
+  MgtGroupAssocResponseHeader ();
+  ~MgtGroupAssocResponseHeader ();
+
+  /**
+   * Return the supported rates.
+   *
+   * \return the supported rates
+   */
+  SupportedRates GetSupportedRates (void) const;
+  /**
+   * Return the HT capabilities.
+   *
+   * \return HT capabilities
+   */
+  HtCapabilities GetHtCapabilities (void) const;
+  /**
+   * Set the HT capabilities.
+   *
+   * \param htcapabilities HT capabilities
+   */
+  void SetHtCapabilities (HtCapabilities htcapabilities);
+  /**
+   * Set the supported rates.
+   *
+   * \param rates the supported rates
+   */
+  void SetSupportedRates (SupportedRates rates);
+  /**
+   * Set the S1G capabilities.
+   *
+   * \param s1gcapabilities S1G capabilities
+   */
+  void SetS1gCapabilities (S1gCapabilities s1gcapabilities);
+  /**
+   * Return the S1G capabilities.
+   *
+   * \return S1G capabilities
+   */
+  S1gCapabilities GetS1gCapabilities (void) const;
+  /**
+   * Add an admitted station.
+   *
+   * \param address the address of the station
+   * \param aid the AID assigned to the station
+   */
+  void AddStation (Mac48Address address, uint16_t aid);
+  /**
+   * \return the number of admitted stations
+   */
+  uint32_t GetNStations (void) const;
+  /**
+   * Look up the AID assigned to a station.
+   *
+   * \param address the address of the station
+   * \param aid where the AID is stored if the station is listed
+   * \return true if the station is listed in this response
+   */
+  bool FindAid (Mac48Address address, uint16_t *aid) const;
+
+  /**
+   * Register this type.
+   * \return The TypeId.
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+
+private:
+  SupportedRates m_rates;             //!< List of supported rates
+  CapabilityInformation m_capability; //!< Capability information
+  HtCapabilities m_htCapability;      //!< HT capabilities
+  S1gCapabilities m_s1gCapability;    //!< S1G capabilities
+  std::vector<std::pair<Mac48Address, uint16_t> > m_stations; //!< Admitted stations and their AID
+};
+
+
 /**
  * \ingroup wifi
  * Implement the header for management frames of type probe request.
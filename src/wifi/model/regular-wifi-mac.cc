@@ -39,6 +39,11 @@ NS_LOG_COMPONENT_DEFINE ("RegularWifiMac");
 NS_OBJECT_ENSURE_REGISTERED (RegularWifiMac);
 
 RegularWifiMac::RegularWifiMac ()
+  : m_phyElementsPhy (0),
+    m_phyElementsNMcs (0),
+    m_phyElementsFlags (0),
+    m_phyElementsBasicModesGeneration (0),
+    m_phyElementsGeneration (0)
 {
   NS_LOG_FUNCTION (this);
   m_rxMiddle = new MacRxMiddle ();
@@ -307,6 +312,81 @@ RegularWifiMac::GetS1gSupported () const
 {
   return m_s1gSupported;
 }
+
+void
+RegularWifiMac::UpdatePhyElements (void) const
+{
+  uint8_t flags = (m_htSupported ? 1 : 0) | (m_phy->GetLdpc () ? 2 : 0)
+    | (m_phy->GetGuardInterval () ? 4 : 0) | (m_phy->GetGreenfield () ? 8 : 0);
+  if (m_phyElementsGeneration > 0
+      && m_phyElementsPhy == PeekPointer (m_phy)
+      && m_phyElementsBasicModesGeneration == m_stationManager->GetBasicModesGeneration ()
+      && m_phyElementsNMcs == m_phy->GetNMcs ()
+      && m_phyElementsFlags == flags)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  m_phyElementsPhy = PeekPointer (m_phy);
+  m_phyElementsBasicModesGeneration = m_stationManager->GetBasicModesGeneration ();
+  m_phyElementsNMcs = m_phy->GetNMcs ();
+  m_phyElementsFlags = flags;
+  m_phyElementsGeneration++;
+
+  m_phySupportedRates = SupportedRates ();
+  if (m_htSupported)
+    {
+      for (uint32_t i = 0; i < m_phy->GetNBssMembershipSelectors (); i++)
+        {
+          m_phySupportedRates.SetBasicRate (m_phy->GetBssMembershipSelector (i));
+        }
+    }
+  m_phyModeRates.clear ();
+  for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
+    {
+      WifiMode mode = m_phy->GetMode (i);
+      m_phySupportedRates.AddSupportedRate (mode.GetDataRate ());
+      m_phyModeRates.push_back (SupportedRates::GetRateIndex (mode.GetDataRate ()));
+    }
+
+  m_phyHtCapabilities = HtCapabilities ();
+  m_phyHtCapabilities.SetHtSupported (1);
+  m_phyHtCapabilities.SetLdpc (m_phy->GetLdpc ());
+  m_phyHtCapabilities.SetShortGuardInterval20 (m_phy->GetGuardInterval ());
+  m_phyHtCapabilities.SetGreenfield (m_phy->GetGreenfield ());
+  for (uint8_t i = 0; i < m_phy->GetNMcs (); i++)
+    {
+      m_phyHtCapabilities.SetRxMcsBitmask (m_phy->GetMcs (i));
+    }
+}
+
+const SupportedRates &
+RegularWifiMac::GetPhySupportedRates (void) const
+{
+  UpdatePhyElements ();
+  return m_phySupportedRates;
+}
+
+const HtCapabilities &
+RegularWifiMac::GetPhyHtCapabilities (void) const
+{
+  UpdatePhyElements ();
+  return m_phyHtCapabilities;
+}
+
+const std::vector<uint8_t> &
+RegularWifiMac::GetPhyModeRateIndexes (void) const
+{
+  UpdatePhyElements ();
+  return m_phyModeRates;
+}
+
+uint32_t
+RegularWifiMac::GetPhyElementsGeneration (void) const
+{
+  UpdatePhyElements ();
+  return m_phyElementsGeneration;
+}
     
 void
 RegularWifiMac::SetS1gStaType (uint8_t type)
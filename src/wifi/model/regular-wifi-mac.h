@@ -27,6 +27,8 @@
 #include "wifi-remote-station-manager.h"
 #include "ssid.h"
 #include "qos-utils.h"
+#include "supported-rates.h"
+#include "ht-capabilities.h"
 #include <map>
 #include "drop-reason.h"
 #include "ns3/traced-callback.h"
@@ -469,6 +471,31 @@ protected:
   void SetS1gStaType (uint8_t type);
   uint8_t GetS1gStaType (void) const;
 
+  /**
+   * Return the supported rates element of the PHY modes, with the BSS
+   * membership selectors of an HT device. The element is only rebuilt
+   * when the configuration of the PHY changes.
+   *
+   * \return the supported rates element of the PHY
+   */
+  const SupportedRates & GetPhySupportedRates (void) const;
+  /**
+   * Return the HT capabilities element of the PHY, only rebuilt when the
+   * configuration of the PHY changes.
+   *
+   * \return the HT capabilities element of the PHY
+   */
+  const HtCapabilities & GetPhyHtCapabilities (void) const;
+  /**
+   * \return the index in a SupportedRates::RateSet of the rate of each
+   *         mode of the PHY
+   */
+  const std::vector<uint8_t> & GetPhyModeRateIndexes (void) const;
+  /**
+   * \return a number changed each time the elements of the PHY are rebuilt
+   */
+  uint32_t GetPhyElementsGeneration (void) const;
+
   TracedCallback<Ptr<const Packet>, DropReason> m_packetdropped;
   TracedCallback<uint32_t> m_collisionTrace;
   TracedCallback<Time,Time> m_transmissionWillCrossRAWBoundary;
@@ -484,6 +511,20 @@ private:
    * \param ac the Access Category index of the queue to initialise.
    */
   void SetupEdcaQueue (enum AcIndex ac);
+  /**
+   * Rebuild the elements of the PHY if its configuration changed since
+   * they were built.
+   */
+  void UpdatePhyElements (void) const;
+
+  mutable SupportedRates m_phySupportedRates;  //!< supported rates element of the PHY
+  mutable HtCapabilities m_phyHtCapabilities;  //!< HT capabilities element of the PHY
+  mutable std::vector<uint8_t> m_phyModeRates; //!< RateSet index of the rate of each PHY mode
+  mutable const WifiPhy *m_phyElementsPhy;     //!< PHY of the elements
+  mutable uint32_t m_phyElementsNMcs;          //!< number of MCSs of the PHY of the elements
+  mutable uint8_t m_phyElementsFlags;          //!< HT support, LDPC, short GI and greenfield of the elements
+  mutable uint32_t m_phyElementsBasicModesGeneration; //!< generation of the basic modes of the station manager when the elements were built
+  mutable uint32_t m_phyElementsGeneration;    //!< number of times the elements were built
 
   TracedCallback<const WifiMacHeader &> m_txOkCallback;
   TracedCallback<const WifiMacHeader &> m_txErrCallback;
@@ -21,6 +21,7 @@
 #include "rps.h"
 #include "ns3/assert.h"
 #include "ns3/log.h" //for test
+#include <cstring>
 #include <sstream>
 
 namespace ns3 {
@@ -247,64 +248,34 @@ RPS::~RPS ()
 void
 RPS::SetRawAssignment (RPS::RawAssignment raw)
 {
-	//m_length = 0;
-	//uint8_t m_rpsarry[12]; //! Support up to 10 RAW Assignment subfield
-	//uint8_t len = assignment.GetSize ();
-	assignment = raw; ///ami
-	m_rpsarry.push_back(raw.GetRawControl ());
+	NS_ASSERT (m_length + raw.GetSize () <= sizeof (m_rpsarry));
+	m_rpsarry[m_length] = raw.GetRawControl ();
 	m_length++;
-	m_rpsarry.push_back((uint8_t)raw.GetRawSlot ());
+	m_rpsarry[m_length] = (uint8_t)raw.GetRawSlot ();
 	m_length++;
-	m_rpsarry.push_back((uint8_t)(raw.GetRawSlot () >> 8));
+	m_rpsarry[m_length] = (uint8_t)(raw.GetRawSlot () >> 8);
 	m_length++;
-	//m_rpsarry.push_back(raw.GetRawStart ());
+	//m_rpsarry[m_length] = raw.GetRawStart ();
 	//m_length++;
-	m_rpsarry.push_back((uint8_t)(raw.GetRawGroup ()));//(7-0)
+	m_rpsarry[m_length] = (uint8_t)(raw.GetRawGroup ());//(7-0)
 	m_length++;
-	m_rpsarry.push_back((uint8_t)(raw.GetRawGroup () >> 8));//(15-8)
+	m_rpsarry[m_length] = (uint8_t)(raw.GetRawGroup () >> 8);//(15-8)
 	m_length++;
-	m_rpsarry.push_back( (uint8_t)(raw.GetRawGroup () >> 16));//(23-16)
+	m_rpsarry[m_length] = (uint8_t)(raw.GetRawGroup () >> 16);//(23-16)
 	m_length++;
-	//m_rpsarry.push_back((uint8_t)raw.GetChannelInd ());
-	//m_length++;
-	//m_rpsarry.push_back((uint8_t)(raw.GetChannelInd () >> 16));
-	//m_length++;
-	//m_rpsarry.push_back((uint8_t)raw.GetPRAW ());
-	//m_length++;
-	//m_rpsarry.push_back((uint8_t)(raw.GetPRAW () >> 8));
-	//m_length++;
-	//m_rpsarry.push_back( (uint8_t)(raw.GetPRAW () >> 16));
-	//m_length++;
-
-	m_rps = &m_rpsarry[0];
-	//printf (" set m_rps %x\n" , m_rps[6]);
-
-	/*std::cout << "GetRawControl-----" << (unsigned int)assignment.GetRawControl() << std::endl;
-	std::cout << "SetSlotCrossBoundary--" << (unsigned int)assignment.GetSlotCrossBoundary() << std::endl;
-	std::cout << "SetSlotFormat--" << (unsigned int)assignment.GetSlotFormat() << std::endl;
-	std::cout << "SetSlotDurationCount--" << assignment.GetSlotDurationCount() << std::endl;
-	std::cout << "SetSlotNum--" << assignment.GetSlotNum() << std::endl;
-
-	std::cout << "GetRawGroupAIDStart--" << assignment.GetRawGroupAIDStart()<< std::endl;
-	std::cout << "GetRawGroupAIDEnd--" << assignment.GetRawGroupAIDEnd()<< std::endl;
-	std::cout << "GetRawGroup--" << assignment.GetRawGroup()<< std::endl;
-	std::cout << "GetRawSlot--" << assignment.GetRawSlot()<< std::endl;
-	std::cout << "+++++++++++++++++++++++++++++++++++++++++++++++++" << std::endl << std::endl;*/
-
+	//channel indication and PRAW parameters are not supported
 }
 
-uint8_t *
+const uint8_t *
 RPS::GetRawAssignment (void) const
 {
-    //printf (" get m_rps addressx\n" , m_rps);
-    //printf (" get m_rps %x\n" , m_rps[6]);
-    return m_rps;
+    return m_rpsarry;
 }
 
 RPS::RawAssignment
 RPS::GetRawAssigmentObj(uint32_t raw_index) const {
 	RPS::RawAssignment ass;
-	uint8_t* rawassign = this->GetRawAssignment();
+	const uint8_t* rawassign = this->GetRawAssignment();
 
 	uint16_t raw_len = this->GetInformationFieldSize();
 	uint16_t rawAssignment_len = 6;
@@ -347,15 +318,14 @@ RPS::GetInformationFieldSize () const
 void
 RPS::SerializeInformationField (Buffer::Iterator start) const
 {
-  start.Write (m_rps, m_length);
+  start.Write (m_rpsarry, m_length);
 }
 
 uint8_t
 RPS::DeserializeInformationField (Buffer::Iterator start, uint8_t length)
 {
-  //static uint8_t m_rpsarry[12];
-  start.Read (m_rpsarry_temp, length);
-  m_rps = m_rpsarry_temp;
+  NS_ASSERT (length <= sizeof (m_rpsarry));
+  start.Read (m_rpsarry, length);
   m_length = length;
   return length;
 }
@@ -110,11 +110,11 @@ public:
    */
   void SetRawAssignment (RPS::RawAssignment raw);
   /**
-   * Return the Partial Virtual Bitmap.
+   * Return the RAW Assignment subfields.
    *
-   * \Return the Partial Virtual Bitmap
+   * \Return the RAW Assignment subfields, GetInformationFieldSize () bytes
    */
-  uint8_t * GetRawAssignment (void) const;  //to do, use std::vector
+  const uint8_t * GetRawAssignment (void) const;
   RPS::RawAssignment GetRawAssigmentObj(uint32_t index = 0) const;
 
   WifiInformationElementId ElementId () const;
@@ -124,15 +124,9 @@ public:
   uint8_t DeserializeInformationField (Buffer::Iterator start, uint8_t length);
   uint8_t GetNumberOfRawGroups (void) const;
 
-  uint8_t m_length;
+  uint8_t m_length; //!< Total length of all RAW Assignments
 private:
-  RPS::RawAssignment assignment; //!< RawAssignment subfield
-  uint8_t * m_rps; //! Support up to 10 RAW Assignment subfield
-  //uint8_t m_rpsarry[12];
-    uint8_t m_rpsarry_temp[1200];
-  std::vector<uint8_t> m_rpsarry;
-  
-  //uint8_t m_length; //!< Total length of all RAW Assignments
+  uint8_t m_rpsarry[255]; //!< RAW Assignment subfields, up to 42 of 6 octets
 };
 
 std::ostream &operator << (std::ostream &os, const RPS &rps);
@@ -144,10 +138,16 @@ ATTRIBUTE_HELPER_HEADER (RPS);
 
 
     
+/**
+ * \ingroup wifi
+ *
+ * The RPS elements of the beacons, in turn. The elements are stored by
+ * value, so that the list owns them and copying it copies them.
+ */
 class RPSVector
 {
 public:
-    typedef std::vector<ns3::RPS *> RPSlist;
+    typedef std::vector<ns3::RPS> RPSlist;
     RPSlist rpsset;
     
     uint32_t getlen();
@@ -219,7 +219,11 @@ S1gRawCtr::S1gRawCtr ()
     m_beaconOverhead = 0; // us
 
     MaxSlotForSensor = 40; //In order to guarantee channel for offload stations.
-    m_rps = new RPS;
+
+    m_slotDurationStrategy = FIXED_SLOT_DURATION;
+    m_sensorPayloadSize = 100;
+    m_offloadPayloadSize = 100;
+    m_successProb = 100;
 
 }
 
@@ -942,7 +946,7 @@ void
 S1gRawCtr::SetOffloadAllowedToSend ()
 {
     m_aidOffloadList.clear (); //Re assign slot to stations
-    m_offloadRawslotDuration = (m_slotDurationCount*120)+500;
+    calculateRawSlotDuration (1, m_successProb);
     uint16_t numAllowed = ((m_beaconInterval-m_beaconOverhead) - m_numSendSensorAllowed * m_rawslotDuration)/m_offloadRawslotDuration;
     //NS_LOG_UNCOND ("SetOffloadAllowedToSend,  numAllowed= " << numAllowed << ", m_numOffloadStaActive = " << m_numOffloadStaActive);
     if (numAllowed == 0)
@@ -979,17 +983,16 @@ S1gRawCtr::GetRPS ()
 {
  if (RpsIndex < rpslist.rpsset.size())
     {
-        m_rps = rpslist.rpsset.at(RpsIndex);
         NS_LOG_DEBUG ("< RpsIndex =" << RpsIndex);
         RpsIndex++;
+        return rpslist.rpsset.at(RpsIndex - 1);
     }
   else
     {
-        m_rps = rpslist.rpsset.at(0);
         NS_LOG_DEBUG ("RpsIndex =" << RpsIndex);
         RpsIndex = 1;
+        return rpslist.rpsset.at(0);
     }
-  return *m_rps;
 }
 
 // Beacon duration), before that use NGroup=1 and initialize by ap-wifi-mac
@@ -999,6 +1002,7 @@ S1gRawCtr::UpdateRAWGroupping (std::vector<uint16_t> m_sensorlist, std::vector<u
      NS_ASSERT ("S1gRawCtr should not be called");
      
      m_beaconInterval = BeaconInterval;
+     calculateRawSlotDuration (1, m_successProb);
      //currentId++; //beaconInterval counter
      //work here
      UdpateSensorStaInfo (m_sensorlist,  m_receivedAid, outputpath);
@@ -1017,7 +1021,7 @@ S1gRawCtr::UpdateRAWGroupping (std::vector<uint16_t> m_sensorlist, std::vector<u
      SetOffloadAllowedToSend ();
 
      //NS_LOG_UNCOND ("S1gRawCtr::UpdateRAWGrouppingcc =");
-     m_rps = new RPS;
+     m_rps = RPS ();
      configureRAW ();
      RPS m_rpsAP =  GetRPS ();
      return m_rpsAP;
@@ -1026,7 +1030,7 @@ S1gRawCtr::UpdateRAWGroupping (std::vector<uint16_t> m_sensorlist, std::vector<u
 void
 S1gRawCtr::deleteRps ()
 {
-    delete m_rps;
+    m_rps = RPS ();
 }
 
     /*
@@ -1103,21 +1107,20 @@ S1gRawCtr::configureRAW ( )
     if (NGroups == 0)
       {
         SlotDurationCount = m_slotDurationCount;
-        RPS::RawAssignment *m_raw = new RPS::RawAssignment;
+        RPS::RawAssignment m_raw;
 
-        m_raw->SetRawControl (RawControl);
-        m_raw->SetSlotCrossBoundary (SlotCrossBoundary);
-        m_raw->SetSlotFormat (SlotFormat);
-        m_raw->SetSlotDurationCount (SlotDurationCount);
-        m_raw->SetSlotNum (SlotNum);
+        m_raw.SetRawControl (RawControl);
+        m_raw.SetSlotCrossBoundary (SlotCrossBoundary);
+        m_raw.SetSlotFormat (SlotFormat);
+        m_raw.SetSlotDurationCount (SlotDurationCount);
+        m_raw.SetSlotNum (SlotNum);
 
         aid_start = 1;
         aid_end = 1;
         rawinfo = (aid_end << 13) | (aid_start << 2) | page;
-        m_raw->SetRawGroup (rawinfo);
+        m_raw.SetRawGroup (rawinfo);
 
-        m_rps->SetRawAssignment(*m_raw);
-        delete m_raw;
+        m_rps.SetRawAssignment(m_raw);
         rpslist.rpsset.push_back (m_rps);
         return;
       }
@@ -1135,24 +1138,40 @@ S1gRawCtr::configureRAW ( )
     for (std::vector<uint16_t>::iterator it = m_aidList.begin(); it != m_aidList.end(); it++)
       {
 
-          RPS::RawAssignment *m_raw = new RPS::RawAssignment;
+          RPS::RawAssignment m_raw;
           Sensor * stationTransmit = LookupSensorSta (*it);
           uint16_t num = stationTransmit->GetTransInOneBeacon ();
           //SlotDurationCount = (num * m_rawslotDuration - 500)/120;
-          uint64_t revisedslotduration = std::ceil(num * (m_beaconInterval-m_beaconOverhead) * 1.0 / m_numSendSensorAllowed);
-          SlotDurationCount = std::ceil((revisedslotduration - 500.0)/120.0);
+          if (m_slotDurationStrategy == PLANNED_SLOT_DURATION)
+            {
+              //only the airtime of the transmissions, the rest of the beacon interval goes to the offload stations
+              RawSlotPlan plan = m_slotPlanner.PlanSlots (num, m_successProb, m_plannedMode, m_sensorPayloadSize);
+              if (plan.slotNum > 1)
+                {
+                  //the sensor is alone in its RAW, so it only ever gets one slot
+                  NS_LOG_WARN ("The " << num << " transmissions of sensor " << *it << " need " << plan.slotNum
+                               << " slots, the slot is cut to the largest count, " << S1gRawSlotPlanner::MAX_SLOT_DURATION_COUNT);
+                  plan.slotDurationCount = S1gRawSlotPlanner::MAX_SLOT_DURATION_COUNT;
+                }
+              SlotDurationCount = plan.slotDurationCount;
+            }
+          else
+            {
+              uint64_t revisedslotduration = std::ceil(num * (m_beaconInterval-m_beaconOverhead) * 1.0 / m_numSendSensorAllowed);
+              SlotDurationCount = std::ceil((revisedslotduration - 500.0)/120.0);
+            }
 
-          NS_ASSERT (SlotDurationCount <= 2037);
+          NS_ASSERT (SlotDurationCount <= S1gRawSlotPlanner::MAX_SLOT_DURATION_COUNT);
 
 
-          m_raw->SetRawControl (RawControl);//support paged STA or not
-          m_raw->SetSlotCrossBoundary (SlotCrossBoundary);
-          m_raw->SetSlotFormat (SlotFormat);
-          m_raw->SetSlotDurationCount (SlotDurationCount);//to change
-          //m_raw->SetSlotDurationCount (725);//to change
+          m_raw.SetRawControl (RawControl);//support paged STA or not
+          m_raw.SetSlotCrossBoundary (SlotCrossBoundary);
+          m_raw.SetSlotFormat (SlotFormat);
+          m_raw.SetSlotDurationCount (SlotDurationCount);//to change
+          //m_raw.SetSlotDurationCount (725);//to change
 
 
-          m_raw->SetSlotNum (SlotNum);
+          m_raw.SetSlotNum (SlotNum);
 
 
           aid_start = *it;
@@ -1162,32 +1181,30 @@ S1gRawCtr::configureRAW ( )
           NS_LOG_UNCOND ("sensor, aid_start =" << aid_start << ", aid_end=" << aid_end << ", SlotDurationCount = " << SlotDurationCount << ", transmit num one beacon = " << num);
 
           rawinfo = (aid_end << 13) | (aid_start << 2) | page;
-          m_raw->SetRawGroup (rawinfo);
+          m_raw.SetRawGroup (rawinfo);
 
-          m_rps->SetRawAssignment(*m_raw);
-          delete m_raw;
+          m_rps.SetRawAssignment(m_raw);
       }
     
     //set remaining channel to another raw
     /*
-    RPS::RawAssignment *m_rawAll = new RPS::RawAssignment;
+    RPS::RawAssignment m_rawAll;
     SlotDurationCount = (m_offloadRawslotDuration - 500)/120;
     NS_ASSERT (SlotDurationCount <= 2037);
     
-    m_rawAll->SetRawControl (RawControl);//support paged STA or not
-    m_rawAll->SetSlotCrossBoundary (SlotCrossBoundary);
-    m_rawAll->SetSlotFormat (SlotFormat);
-    m_rawAll->SetSlotDurationCount (SlotDurationCount);//to change
-    m_rawAll->SetSlotNum (SlotNum);
+    m_rawAll.SetRawControl (RawControl);//support paged STA or not
+    m_rawAll.SetSlotCrossBoundary (SlotCrossBoundary);
+    m_rawAll.SetSlotFormat (SlotFormat);
+    m_rawAll.SetSlotDurationCount (SlotDurationCount);//to change
+    m_rawAll.SetSlotNum (SlotNum);
     aid_start = 1;
     aid_end = m_stations.size();
     NS_LOG_UNCOND ("sensor, aid_start =" << aid_start << ", aid_end=" << aid_end << ", SlotDurationCount = " << SlotDurationCount);
     
     rawinfo = (aid_end << 13) | (aid_start << 2) | page;
-    m_rawAll->SetRawGroup (rawinfo);
+    m_rawAll.SetRawGroup (rawinfo);
     
-    m_rps->SetRawAssignment(*m_rawAll);
-    delete m_rawAll;
+    m_rps.SetRawAssignment(m_rawAll);
     //finished
     */
 
@@ -1199,14 +1216,14 @@ S1gRawCtr::configureRAW ( )
 
     for (std::vector<uint16_t>::iterator it = m_aidOffloadList.begin(); it != m_aidOffloadList.end(); it++)
      {
-        RPS::RawAssignment *m_raw2 = new RPS::RawAssignment;
+        RPS::RawAssignment m_raw2;
 
-        m_raw2->SetRawControl (RawControl);//support paged STA or not
-        m_raw2->SetSlotCrossBoundary (SlotCrossBoundary);
-        m_raw2->SetSlotFormat (SlotFormat);
-        m_raw2->SetSlotDurationCount (offloadcount); //to change
-         //m_raw2->SetSlotDurationCount (99); //to change
-        m_raw2->SetSlotNum (SlotNum);
+        m_raw2.SetRawControl (RawControl);//support paged STA or not
+        m_raw2.SetSlotCrossBoundary (SlotCrossBoundary);
+        m_raw2.SetSlotFormat (SlotFormat);
+        m_raw2.SetSlotDurationCount (offloadcount); //to change
+         //m_raw2.SetSlotDurationCount (99); //to change
+        m_raw2.SetSlotNum (SlotNum);
 
         aid_start = *it;
         aid_end = *it;
@@ -1215,16 +1232,14 @@ S1gRawCtr::configureRAW ( )
         rawinfo = (aid_end << 13) | (aid_start << 2) | page;
         NS_LOG_UNCOND ("offload, aid_start =" << aid_start << ", aid_end=" << aid_end << ", offloadcount =" << offloadcount);
 
-        m_raw2->SetRawGroup (rawinfo);
-        m_rps->SetRawAssignment(*m_raw2);
-        delete m_raw2;
+        m_raw2.SetRawGroup (rawinfo);
+        m_rps.SetRawAssignment(m_raw2);
      }
 
 
     rpslist.rpsset.push_back (m_rps); //only one RPS in rpslist actually, update info every beacon in this algorithm.
     //printf("rpslist.rpsset.size is %u\n",  rpslist.rpsset.size());
 
-    //delete m_rps;
 }
 
 //what if lookup fails, is it possibile?
@@ -1258,8 +1273,42 @@ S1gRawCtr::LookupOffloadSta (uint16_t aid)
 void
 S1gRawCtr::calculateRawSlotDuration (uint16_t numsta, uint16_t successprob)
 {
+    if (m_slotDurationStrategy == PLANNED_SLOT_DURATION)
+      {
+        m_rawslotDuration = S1gRawSlotPlanner::GetSlotDuration (m_slotPlanner.GetSlotDurationCount (numsta, successprob, m_plannedMode, m_sensorPayloadSize));
+        m_offloadRawslotDuration = S1gRawSlotPlanner::GetSlotDuration (m_slotPlanner.GetSlotDurationCount (numsta, successprob, m_plannedMode, m_offloadPayloadSize));
+        return;
+      }
     m_rawslotDuration = (m_slotDurationCount*120)+500; //for test.
     m_offloadRawslotDuration = (m_slotDurationCount*120)+500;
 }
 
+void
+S1gRawCtr::SetSlotDurationStrategy (SlotDurationStrategy strategy)
+{
+    m_slotDurationStrategy = strategy;
+}
+
+S1gRawCtr::SlotDurationStrategy
+S1gRawCtr::GetSlotDurationStrategy (void) const
+{
+    return m_slotDurationStrategy;
+}
+
+S1gRawSlotPlanner &
+S1gRawCtr::GetSlotPlanner (void)
+{
+    return m_slotPlanner;
+}
+
+void
+S1gRawCtr::SetPlannedTraffic (WifiMode mode, uint16_t sensorPayloadSize, uint16_t offloadPayloadSize, uint16_t successprob)
+{
+    NS_ASSERT (successprob > 0 && successprob <= 100);
+    m_plannedMode = mode;
+    m_sensorPayloadSize = sensorPayloadSize;
+    m_offloadPayloadSize = offloadPayloadSize;
+    m_successProb = successprob;
+}
+
 } //namespace ns3
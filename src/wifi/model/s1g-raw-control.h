@@ -29,6 +29,7 @@
 #include "supported-rates.h"
 #include "ns3/random-variable-stream.h"
 #include "rps.h"
+#include "s1g-raw-slot-planner.h"
 
 namespace ns3 {
     
@@ -157,6 +158,17 @@ private:
 class S1gRawCtr
 {
 public:
+  /**
+   * How the duration of the RAW slots is chosen.
+   */
+  enum SlotDurationStrategy
+  {
+    /// the sensor slots share the beacon interval, the others last 500 us + 120 us * 15
+    FIXED_SLOT_DURATION,
+    /// the slots are as long as the exchanges they hold, see S1gRawSlotPlanner
+    PLANNED_SLOT_DURATION
+  };
+
   static TypeId GetTypeId (void);
 
   S1gRawCtr ();
@@ -176,6 +188,21 @@ public:
     
   void calculateRawSlotDuration (uint16_t numsta, uint16_t successprob); //nedd to be extended to support more felxibility.
 
+  void SetSlotDurationStrategy (SlotDurationStrategy strategy);
+  SlotDurationStrategy GetSlotDurationStrategy (void) const;
+  /**
+   * \return the planner of the PLANNED_SLOT_DURATION strategy, to be
+   *         given the PHY of the AP
+   */
+  S1gRawSlotPlanner & GetSlotPlanner (void);
+  /**
+   * \param mode the mode of the data frames of the stations
+   * \param sensorPayloadSize the size of the packets of the sensors
+   * \param offloadPayloadSize the size of the packets of the offload stations
+   * \param successprob the percentage of the attempts that succeed
+   */
+  void SetPlannedTraffic (WifiMode mode, uint16_t sensorPayloadSize, uint16_t offloadPayloadSize, uint16_t successprob);
+
   void calculateSensorNumWantToSend (void);
   void calculateMaybeAirtime (void);
   void SetSensorAllowedToSend (void);
@@ -229,12 +256,19 @@ private:
   std::vector<RPS::RawAssignment *> RawAssignmentList;
     
   uint16_t RpsIndex;
-  RPS * m_rps;
+  RPS m_rps;
   RPSVector rpslist;
     
     bool  m_receivedsuccess;
     
     std::string  sensorfile;
+
+  SlotDurationStrategy m_slotDurationStrategy;
+  S1gRawSlotPlanner m_slotPlanner;
+  WifiMode m_plannedMode;
+  uint16_t m_sensorPayloadSize;
+  uint16_t m_offloadPayloadSize;
+  uint16_t m_successProb;
 };
 
 } //namespace ns3
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "s1g-raw-slot-planner.h"
+#include "wifi-mac-header.h"
+#include "wifi-tx-vector.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("S1gRawSlotPlanner");
+
+/// the largest duration count and number of slots of each slot format
+static const uint32_t MAX_SLOT_DURATION_COUNT_OF_FORMAT[2] = {255, S1gRawSlotPlanner::MAX_SLOT_DURATION_COUNT};
+static const uint16_t MAX_SLOT_NUM[2] = {63, 7};
+
+const uint16_t S1gRawSlotPlanner::MAX_SLOT_DURATION_COUNT;
+
+S1gRawSlotPlanner::S1gRawSlotPlanner ()
+  : m_sifs (MicroSeconds (160)),
+    m_ackModeSet (false),
+    m_psPoll (false)
+{
+}
+
+void
+S1gRawSlotPlanner::SetPhy (Ptr<WifiPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  m_phy = phy;
+  m_exchangeDurations.clear ();
+}
+
+void
+S1gRawSlotPlanner::SetSifs (Time sifs)
+{
+  NS_LOG_FUNCTION (this << sifs);
+  m_sifs = sifs;
+  m_exchangeDurations.clear ();
+}
+
+void
+S1gRawSlotPlanner::SetAckMode (WifiMode mode)
+{
+  NS_LOG_FUNCTION (this << mode);
+  m_ackMode = mode;
+  m_ackModeSet = true;
+  m_exchangeDurations.clear ();
+}
+
+void
+S1gRawSlotPlanner::SetPsPoll (bool psPoll)
+{
+  NS_LOG_FUNCTION (this << psPoll);
+  m_psPoll = psPoll;
+  m_exchangeDurations.clear ();
+}
+
+bool
+S1gRawSlotPlanner::IsConfigured (void) const
+{
+  return m_phy != 0;
+}
+
+Time
+S1gRawSlotPlanner::GetPpduDuration (uint32_t size, WifiMode mode) const
+{
+  WifiPreamble preamble;
+  if (mode.GetModulationClass () == WIFI_MOD_CLASS_S1G)
+    {
+      preamble = m_phy->GetS1g1Mfield () ? WIFI_PREAMBLE_S1G_1M : WIFI_PREAMBLE_S1G_SHORT;
+    }
+  else if (mode.GetModulationClass () == WIFI_MOD_CLASS_HT)
+    {
+      preamble = WIFI_PREAMBLE_HT_MF;
+    }
+  else
+    {
+      preamble = WIFI_PREAMBLE_LONG;
+    }
+  WifiTxVector txVector;
+  txVector.SetMode (mode);
+  txVector.SetNss (1);
+  return m_phy->CalculateTxDuration (size, txVector, preamble, m_phy->GetFrequency (), 0, 0);
+}
+
+Time
+S1gRawSlotPlanner::GetExchangeDuration (WifiMode mode, uint32_t payloadSize)
+{
+  NS_ASSERT (IsConfigured ());
+  std::pair<uint32_t, uint32_t> key (mode.GetUid (), payloadSize);
+  std::map<std::pair<uint32_t, uint32_t>, Time>::const_iterator it = m_exchangeDurations.find (key);
+  if (it != m_exchangeDurations.end ())
+    {
+      return it->second;
+    }
+
+  WifiMode ackMode = m_ackModeSet ? m_ackMode : m_phy->GetMode (0);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  WifiMacHeader ack;
+  ack.SetType (WIFI_MAC_CTL_ACK);
+  Time duration = GetPpduDuration (hdr.GetSize () + payloadSize + 4, mode)
+    + m_sifs + GetPpduDuration (ack.GetSize () + 4, ackMode);
+  if (m_psPoll)
+    {
+      WifiMacHeader pspoll;
+      pspoll.SetType (WIFI_MAC_CTL_PSPOLL);
+      duration += GetPpduDuration (pspoll.GetSize () + 4, ackMode) + m_sifs;
+    }
+  NS_LOG_DEBUG ("exchange of " << payloadSize << " bytes at " << mode << " lasts " << duration);
+  m_exchangeDurations.insert (std::make_pair (key, duration));
+  return duration;
+}
+
+uint32_t
+S1gRawSlotPlanner::GetAttempts (uint32_t exchanges, uint16_t successProb)
+{
+  NS_ASSERT (successProb > 0 && successProb <= 100);
+  return (exchanges * 100 + successProb - 1) / successProb;
+}
+
+uint32_t
+S1gRawSlotPlanner::GetSlotDurationCount (uint32_t exchanges, uint16_t successProb, WifiMode mode, uint32_t payloadSize)
+{
+  uint64_t airtime = GetAttempts (exchanges, successProb) * GetExchangeDuration (mode, payloadSize).GetMicroSeconds ();
+  if (airtime <= 500)
+    {
+      return 0;
+    }
+  return (airtime - 500 + 119) / 120;
+}
+
+RawSlotPlan
+S1gRawSlotPlanner::PlanSlots (uint32_t exchanges, uint16_t successProb, WifiMode mode, uint32_t payloadSize)
+{
+  NS_LOG_FUNCTION (this << exchanges << successProb << mode << payloadSize);
+  RawSlotPlan plan;
+  uint32_t attempts = GetAttempts (exchanges, successProb);
+  for (uint16_t slotNum = 1; slotNum <= MAX_SLOT_NUM[0]; slotNum++)
+    {
+      uint8_t slotFormat = slotNum <= MAX_SLOT_NUM[1] ? 1 : 0;
+      uint32_t perSlot = (attempts + slotNum - 1) / slotNum;
+      uint32_t count = GetSlotDurationCount (perSlot, 100, mode, payloadSize);
+      if (count <= MAX_SLOT_DURATION_COUNT_OF_FORMAT[slotFormat])
+        {
+          plan.slotNum = slotNum;
+          plan.slotDurationCount = count;
+          plan.slotFormat = slotFormat;
+          return plan;
+        }
+    }
+  NS_LOG_WARN ("A RAW cannot hold " << attempts << " attempts, the longest one is used");
+  plan.slotNum = MAX_SLOT_NUM[0];
+  plan.slotDurationCount = MAX_SLOT_DURATION_COUNT_OF_FORMAT[0];
+  plan.slotFormat = 0;
+  return plan;
+}
+
+uint64_t
+S1gRawSlotPlanner::GetSlotDuration (uint32_t count)
+{
+  return 500 + count * 120;
+}
+
+} //namespace ns3
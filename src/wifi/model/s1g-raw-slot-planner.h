@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef S1G_RAW_SLOT_PLANNER_H
+#define S1G_RAW_SLOT_PLANNER_H
+
+#include <map>
+#include <utility>
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "wifi-phy.h"
+#include "wifi-mode.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * The slots of a RAW: their number, the slot format and the duration
+ * count of each slot, i.e. 500 us + count * 120 us.
+ */
+struct RawSlotPlan
+{
+  uint16_t slotNum;           //!< number of slots
+  uint16_t slotDurationCount; //!< duration count of each slot
+  uint8_t slotFormat;         //!< 1 for up to 7 slots of count <= 2047, 0 for up to 63 slots of count <= 255
+};
+
+/**
+ * \ingroup wifi
+ *
+ * Chooses the duration of RAW slots from the airtime of the frame
+ * exchanges they must hold, instead of dividing the beacon interval.
+ *
+ * The duration of an exchange, DATA + SIFS + ACK or PS-Poll + SIFS +
+ * DATA + SIFS + ACK, is computed once per data mode (the MCS) and
+ * payload size from the durations of the PHY and then looked up.
+ */
+class S1gRawSlotPlanner
+{
+public:
+  /// the largest slot duration count, that of slot format 1 (11 bits)
+  static const uint16_t MAX_SLOT_DURATION_COUNT = 2047;
+
+  S1gRawSlotPlanner ();
+
+  /**
+   * \param phy the PHY whose durations are used
+   *
+   * The ACK is sent at the first mode of the PHY unless SetAckMode is
+   * called.
+   */
+  void SetPhy (Ptr<WifiPhy> phy);
+  /**
+   * \param sifs the SIFS of the BSS (160 us by default)
+   */
+  void SetSifs (Time sifs);
+  /**
+   * \param mode the mode of the ACKs
+   */
+  void SetAckMode (WifiMode mode);
+  /**
+   * \param psPoll whether each exchange is started by a PS-Poll
+   */
+  void SetPsPoll (bool psPoll);
+  /**
+   * \return true if a PHY is set
+   */
+  bool IsConfigured (void) const;
+
+  /**
+   * \param mode the mode of the data frame
+   * \param payloadSize the size of the MSDU in bytes
+   * \return the duration of a frame exchange
+   */
+  Time GetExchangeDuration (WifiMode mode, uint32_t payloadSize);
+  /**
+   * \param exchanges the number of exchanges
+   * \param successProb the percentage of the attempts that succeed, an
+   *        exchange taking 100 / successProb attempts on average
+   * \param mode the mode of the data frames
+   * \param payloadSize the size of the MSDUs in bytes
+   * \return the smallest slot duration count holding the exchanges
+   */
+  uint32_t GetSlotDurationCount (uint32_t exchanges, uint16_t successProb, WifiMode mode, uint32_t payloadSize);
+  /**
+   * \param exchanges the number of exchanges of the RAW
+   * \param successProb the percentage of the attempts that succeed
+   * \param mode the mode of the data frames
+   * \param payloadSize the size of the MSDUs in bytes
+   * \return the fewest slots, with the shortest duration, among which
+   *         the exchanges can be spread
+   */
+  RawSlotPlan PlanSlots (uint32_t exchanges, uint16_t successProb, WifiMode mode, uint32_t payloadSize);
+
+  /**
+   * \param count a slot duration count
+   * \return the duration of the slot in us
+   */
+  static uint64_t GetSlotDuration (uint32_t count);
+
+private:
+  /**
+   * \param exchanges the number of exchanges
+   * \param successProb the percentage of the attempts that succeed
+   * \return the number of attempts of the exchanges
+   */
+  static uint32_t GetAttempts (uint32_t exchanges, uint16_t successProb);
+  /**
+   * \param size the size of the frame in bytes
+   * \param mode the mode of the frame
+   * \return the duration of the PPDU
+   */
+  Time GetPpduDuration (uint32_t size, WifiMode mode) const;
+
+  Ptr<WifiPhy> m_phy;
+  Time m_sifs;
+  WifiMode m_ackMode;
+  bool m_ackModeSet;
+  bool m_psPoll;
+  /// exchange durations, by uid of the data mode and payload size
+  std::map<std::pair<uint32_t, uint32_t>, Time> m_exchangeDurations;
+};
+
+} //namespace ns3
+
+#endif /* S1G_RAW_SLOT_PLANNER_H */
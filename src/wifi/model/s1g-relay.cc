@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "s1g-relay.h"
+#include "wifi-remote-station-manager.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("S1gRelay");
+
+NS_OBJECT_ENSURE_REGISTERED (S1gRelay);
+
+TypeId
+S1gRelay::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::S1gRelay")
+    .SetParent<Object> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<S1gRelay> ()
+    .AddTraceSource ("Uplink", "A packet of a station of the relay has been forwarded to the root AP.",
+                     MakeTraceSourceAccessor (&S1gRelay::m_uplinkTrace),
+                     "ns3::S1gRelay::ForwardTracedCallback")
+    .AddTraceSource ("Downlink", "A packet has been forwarded to a station of the relay.",
+                     MakeTraceSourceAccessor (&S1gRelay::m_downlinkTrace),
+                     "ns3::S1gRelay::ForwardTracedCallback")
+  ;
+  return tid;
+}
+
+S1gRelay::S1gRelay ()
+  : m_uplinkPackets (0),
+    m_downlinkPackets (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+S1gRelay::~S1gRelay ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+S1gRelay::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_staDevice = 0;
+  m_apDevice = 0;
+  Object::DoDispose ();
+}
+
+void
+S1gRelay::Install (Ptr<WifiNetDevice> staDevice, Ptr<WifiNetDevice> apDevice)
+{
+  NS_LOG_FUNCTION (this << staDevice << apDevice);
+  Ptr<Node> node = staDevice->GetNode ();
+  NS_ASSERT_MSG (node != 0 && node == apDevice->GetNode (),
+                 "The devices of a relay must be installed on the same node");
+  NS_ASSERT (staDevice->SupportsSendFrom () && apDevice->SupportsSendFrom ());
+  m_staDevice = staDevice;
+  m_apDevice = apDevice;
+  node->RegisterProtocolHandler (MakeCallback (&S1gRelay::ReceiveFromDevice, this),
+                                 0, staDevice, true);
+  node->RegisterProtocolHandler (MakeCallback (&S1gRelay::ReceiveFromDevice, this),
+                                 0, apDevice, true);
+}
+
+Ptr<WifiNetDevice>
+S1gRelay::GetStaDevice (void) const
+{
+  return m_staDevice;
+}
+
+Ptr<WifiNetDevice>
+S1gRelay::GetApDevice (void) const
+{
+  return m_apDevice;
+}
+
+uint32_t
+S1gRelay::GetNUplinkPackets (void) const
+{
+  return m_uplinkPackets;
+}
+
+uint32_t
+S1gRelay::GetNDownlinkPackets (void) const
+{
+  return m_downlinkPackets;
+}
+
+void
+S1gRelay::ReceiveFromDevice (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                             const Address &source, const Address &destination,
+                             NetDevice::PacketType packetType)
+{
+  NS_LOG_FUNCTION (this << device << packet << protocol << source << destination << packetType);
+  Mac48Address from = Mac48Address::ConvertFrom (source);
+  Mac48Address to = Mac48Address::ConvertFrom (destination);
+  if (packetType == NetDevice::PACKET_HOST)
+    {
+      //for the relay itself
+      return;
+    }
+  if (device == m_apDevice)
+    {
+      //the AP function already delivers the frames between its own stations
+      if (packetType == NetDevice::PACKET_OTHERHOST
+          && m_apDevice->GetRemoteStationManager ()->IsAssociated (to))
+        {
+          return;
+        }
+      NS_LOG_DEBUG ("uplink from=" << from << ", to=" << to);
+      m_uplinkPackets++;
+      m_uplinkTrace (packet, from, to);
+      m_staDevice->SendFrom (packet->Copy (), from, to, protocol);
+    }
+  else
+    {
+      NS_ASSERT (device == m_staDevice);
+      if (to.IsGroup ()
+          && m_apDevice->GetRemoteStationManager ()->IsAssociated (from))
+        {
+          //the root AP repeats a group addressed frame we have forwarded
+          return;
+        }
+      NS_LOG_DEBUG ("downlink from=" << from << ", to=" << to);
+      m_downlinkPackets++;
+      m_downlinkTrace (packet, from, to);
+      m_apDevice->SendFrom (packet->Copy (), from, to, protocol);
+    }
+}
+
+} //namespace ns3
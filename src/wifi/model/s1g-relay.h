@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef S1G_RELAY_H
+#define S1G_RELAY_H
+
+#include "ns3/object.h"
+#include "ns3/net-device.h"
+#include "ns3/traced-callback.h"
+#include "wifi-net-device.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * S1G relay: a node combining a station associated with the root AP and
+ * an AP serving the stations too far from the root AP. The stations of
+ * the relay use their usual three address frames; the relay forwards
+ * their frames to the root AP in four address frames, keeping the
+ * original source, and the root AP sends the frames for them to the
+ * relay in four address frames as well.
+ *
+ * Each function has its own WifiNetDevice; both are expected to be on
+ * the same channel, the relay AP beaconing with an SSID of its own so
+ * that the stations pick either the root AP or the relay.
+ */
+class S1gRelay : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  S1gRelay ();
+  virtual ~S1gRelay ();
+
+  /**
+   * \param staDevice the device associated with the root AP
+   * \param apDevice the device serving the stations of the relay
+   *
+   * Both devices must be installed on the same node.
+   */
+  void Install (Ptr<WifiNetDevice> staDevice, Ptr<WifiNetDevice> apDevice);
+
+  /**
+   * \return the device associated with the root AP
+   */
+  Ptr<WifiNetDevice> GetStaDevice (void) const;
+  /**
+   * \return the device serving the stations of the relay
+   */
+  Ptr<WifiNetDevice> GetApDevice (void) const;
+
+  /**
+   * \return the number of packets forwarded to the root AP
+   */
+  uint32_t GetNUplinkPackets (void) const;
+  /**
+   * \return the number of packets forwarded to the stations of the relay
+   */
+  uint32_t GetNDownlinkPackets (void) const;
+
+  /**
+   * TracedCallback signature for the forwarded packets.
+   *
+   * \param packet the packet forwarded
+   * \param from the source of the packet
+   * \param to the destination of the packet
+   */
+  typedef void (* ForwardTracedCallback)(Ptr<const Packet> packet,
+                                         Mac48Address from, Mac48Address to);
+
+protected:
+  virtual void DoDispose (void);
+
+
+private:
+  void ReceiveFromDevice (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                          const Address &source, const Address &destination,
+                          NetDevice::PacketType packetType);
+
+  Ptr<WifiNetDevice> m_staDevice; //!< Device associated with the root AP
+  Ptr<WifiNetDevice> m_apDevice;  //!< Device serving the stations of the relay
+  uint32_t m_uplinkPackets;       //!< Packets forwarded to the root AP
+  uint32_t m_downlinkPackets;     //!< Packets forwarded to the stations of the relay
+
+  TracedCallback<Ptr<const Packet>, Mac48Address, Mac48Address> m_uplinkTrace;
+  TracedCallback<Ptr<const Packet>, Mac48Address, Mac48Address> m_downlinkTrace;
+};
+
+} //namespace ns3
+
+#endif /* S1G_RELAY_H */
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "simple-frame-capture-model.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/nstime.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SimpleFrameCaptureModel");
+
+NS_OBJECT_ENSURE_REGISTERED (SimpleFrameCaptureModel);
+
+TypeId
+SimpleFrameCaptureModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SimpleFrameCaptureModel")
+    .SetParent<FrameCaptureModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<SimpleFrameCaptureModel> ()
+    .AddAttribute ("Margin",
+                   "The power of a new frame should be higher than the power of the "
+                   "frame being received by this margin (dB) to capture the PHY.",
+                   DoubleValue (5.0),
+                   MakeDoubleAccessor (&SimpleFrameCaptureModel::SetMargin,
+                                       &SimpleFrameCaptureModel::GetMargin),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("CaptureWindow",
+                   "The time after the start of the frame being received during "
+                   "which a new frame may capture the PHY.",
+                   TimeValue (MicroSeconds (16)),
+                   MakeTimeAccessor (&SimpleFrameCaptureModel::m_captureWindow),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+SimpleFrameCaptureModel::SimpleFrameCaptureModel ()
+  : m_margin (0),
+    m_marginRatio (1)
+{
+}
+
+void
+SimpleFrameCaptureModel::SetMargin (double margin)
+{
+  NS_LOG_FUNCTION (this << margin);
+  m_margin = margin;
+  m_marginRatio = std::pow (10.0, margin / 10.0);
+}
+
+double
+SimpleFrameCaptureModel::GetMargin (void) const
+{
+  return m_margin;
+}
+
+bool
+SimpleFrameCaptureModel::IsInCaptureWindow (Time timePreambleDetected) const
+{
+  return Simulator::Now () - timePreambleDetected <= m_captureWindow;
+}
+
+bool
+SimpleFrameCaptureModel::CaptureNewFrame (double currentRxPowerW, double newRxPowerW) const
+{
+  NS_LOG_FUNCTION (this << currentRxPowerW << newRxPowerW);
+  return newRxPowerW > currentRxPowerW * m_marginRatio;
+}
+
+} //namespace ns3
@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SIMPLE_FRAME_CAPTURE_MODEL_H
+#define SIMPLE_FRAME_CAPTURE_MODEL_H
+
+#include "frame-capture-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ * \brief a frame capture model switching to a new frame stronger than the
+ * current one by a margin
+ *
+ * The PHY switches to a new frame if it arrives within the capture window
+ * after the start of the current frame, i.e. while the PHY may still
+ * detect a new preamble, and if its power is higher than the power of the
+ * current frame by at least the margin.
+ */
+class SimpleFrameCaptureModel : public FrameCaptureModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  SimpleFrameCaptureModel ();
+
+  /**
+   * \param margin the margin (dB)
+   */
+  void SetMargin (double margin);
+  /**
+   * \return the margin (dB)
+   */
+  double GetMargin (void) const;
+
+  virtual bool IsInCaptureWindow (Time timePreambleDetected) const;
+  virtual bool CaptureNewFrame (double currentRxPowerW, double newRxPowerW) const;
+
+private:
+  double m_margin;       //!< margin (dB)
+  double m_marginRatio;  //!< margin (linear)
+  Time m_captureWindow;  //!< capture window
+};
+
+} //namespace ns3
+
+#endif /* SIMPLE_FRAME_CAPTURE_MODEL_H */
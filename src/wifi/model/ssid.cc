@@ -20,6 +20,7 @@
 
 #include "ssid.h"
 #include "ns3/assert.h"
+#include "ns3/crc32.h"
 
 namespace ns3 {
 
@@ -104,6 +105,12 @@ Ssid::PeekString (void) const
   return (char *)m_ssid;
 }
 
+uint32_t
+Ssid::GetCompressed (void) const
+{
+  return CRC32Calculate (m_ssid, m_length);
+}
+
 WifiInformationElementId
 Ssid::ElementId () const
 {
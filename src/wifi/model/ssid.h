@@ -77,6 +77,13 @@ public:
    * \return a pointer to SSID string
    */
   char* PeekString (void) const;
+  /**
+   * Compute the compressed SSID carried by S1G beacons, which is the
+   * CRC-32 of the SSID.
+   *
+   * \return the compressed SSID
+   */
+  uint32_t GetCompressed (void) const;
 
   WifiInformationElementId ElementId () const;
   uint8_t GetInformationFieldSize () const;
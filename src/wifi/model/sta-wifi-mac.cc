@@ -33,6 +33,7 @@
 #include "mac-rx-middle.h"
 #include "mac-tx-middle.h"
 #include "wifi-mac-header.h"
+#include "wifi-mac-trailer.h"
 #include "extension-headers.h"
 #include "msdu-aggregator.h"
 #include "amsdu-subframe-header.h"
@@ -108,6 +109,14 @@ StaWifiMac::GetTypeId (void)
                    MakeUintegerAccessor (&StaWifiMac::GetChannelWidth,
                                          &StaWifiMac::SetChannelWidth),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("DeterministicAuthentication",
+                   "If true, the value compared with the authentication control threshold of the beacons "
+                   "is derived from the address of the station instead of drawn at random, so that the AP "
+                   "admits the stations in AID order, and a deferred station sends its association request "
+                   "as soon as a beacon admits it.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&StaWifiMac::m_deterministicAuthen),
+                   MakeBooleanChecker ())
     .AddAttribute ("ActiveProbing",
                    "If true, we send probe requests. If false, we don't."
                    "NOTE: if more than one STA in your simulation is using active probing, "
@@ -155,8 +164,10 @@ StaWifiMac::StaWifiMac ()
   m_pspollDca->SetLow (m_low);
   m_pspollDca->SetManager (m_dcfManager);
   m_pspollDca->SetTxMiddle (m_txMiddle);
+  m_low->SetTriggerCallback (MakeCallback (&StaWifiMac::ReceiveTrigger, this));
   fasTAssocType = false; //centraied control
   fastAssocThreshold = 0; // allow some station to associate at the begining
+  m_assocDeferred = false;
     Ptr<UniformRandomVariable> m_rv = CreateObject<UniformRandomVariable> ();
   assocVaule = m_rv->GetValue (0, 999);
   
@@ -196,6 +207,9 @@ StaWifiMac::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   m_pspollDca = 0;
+  m_muAckTimeoutEvent.Cancel ();
+  m_muPacket = 0;
+  m_muQueue = 0;
   RegularWifiMac::DoDispose ();
 }
 
@@ -523,7 +537,7 @@ StaWifiMac::SendPspollIfnecessary (void)
 		m_DTIMPeriod = m_TIM.GetDTIMPeriod();
 		m_PageIndex = m_TIM.GetPageIndex();
 
-		uint8_t * partialVBitmap = m_TIM.GetPartialVBitmap();
+		const uint8_t * partialVBitmap = m_TIM.GetPartialVBitmap();
 		//length =  m_TIM.GetInformationFieldSize ();
 		NS_ASSERT(m_TIM.GetInformationFieldSize() >= 5);
 		//NS_ASSERT (m_TIM.GetInformationFieldSize () >= 2);
@@ -1041,6 +1055,16 @@ StaWifiMac::SendAssociationRequest (void)
         fastAssocThreshold = 1023;
     }
 
+  if (m_deterministicAuthen)
+    {
+      //same AID as the one the AP derives from our address
+      uint8_t mac[6];
+      GetAddress ().CopyTo (mac);
+      uint16_t aid = ((mac[4] & 0x1f) << 8) | mac[5];
+      assocVaule = (aid + 999) % 1000;
+    }
+  m_assocDeferred = (assocVaule >= fastAssocThreshold);
+
 if (assocVaule < fastAssocThreshold)
 {
   WifiMacHeader hdr;
@@ -1197,8 +1221,25 @@ StaWifiMac::IsWaitDisAssocTxOk (void) const
 
 void
 StaWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to)
-{    
+{
   NS_LOG_FUNCTION (this << packet << to);
+  //We're sending this packet with a from address that is our own. We
+  //get that address from the lower MAC and make use of the
+  //from-spoofing Enqueue() method to avoid duplicated code.
+  Enqueue (packet, to, m_low->GetAddress ());
+}
+
+bool
+StaWifiMac::SupportsSendFrom (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return true;
+}
+
+void
+StaWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to, Mac48Address from)
+{
+  NS_LOG_FUNCTION (this << packet << to << from);
     
     //in case a packet is added in the queue, it is check if the station should be awake in that slot
     //in case of shared or own slot, the station wakes up
@@ -1268,7 +1309,17 @@ StaWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to)
   hdr.SetAddr1 (GetBssid ());
   hdr.SetAddr2 (m_low->GetAddress ());
   hdr.SetAddr3 (to);
-  hdr.SetDsNotFrom ();
+  if (from == m_low->GetAddress ())
+    {
+      hdr.SetDsNotFrom ();
+    }
+  else
+    {
+      //we relay the packet of a station associated with us: the
+      //source goes in the fourth address
+      hdr.SetAddr4 (from);
+      hdr.SetDsFrom ();
+    }
   hdr.SetDsTo ();
 
   if (m_qosSupported)
@@ -1342,6 +1393,130 @@ StaWifiMac::S1gBeaconReceived (S1gBeaconHeader beacon)
     m_rawStart = false;
 }
 
+void
+StaWifiMac::ReceiveTrigger (const CtrlTriggerHeader &trigger)
+{
+  NS_LOG_FUNCTION (this << trigger);
+  if (!IsAssociated ())
+    {
+      return;
+    }
+  uint8_t ruIndex;
+  bool forMe = trigger.FindRuIndex (GetAID (), &ruIndex);
+  if (trigger.IsMultiStaAck ())
+    {
+      if (m_muPacket != 0 && forMe)
+        {
+          NS_LOG_DEBUG ("triggered uplink acknowledged");
+          m_muAckTimeoutEvent.Cancel ();
+          TxOk (m_muHdr);
+          m_muPacket = 0;
+          m_muQueue = 0;
+        }
+      else if (m_muPacket != 0)
+        {
+          m_muAckTimeoutEvent.Cancel ();
+          MuUplinkFailed ();
+        }
+      return;
+    }
+  if (!forMe)
+    {
+      return;
+    }
+  if (m_muPacket != 0)
+    {
+      m_muAckTimeoutEvent.Cancel ();
+      MuUplinkFailed ();
+    }
+
+  Ptr<WifiMacQueue> queue;
+  if (m_qosSupported)
+    {
+      const AcIndex acs[] = {AC_VO, AC_VI, AC_BE, AC_BK};
+      for (uint32_t i = 0; i < 4 && queue == 0; i++)
+        {
+          Ptr<WifiMacQueue> edcaQueue = m_edca.find (acs[i])->second->GetEdcaQueue ();
+          if (!edcaQueue->IsEmpty ())
+            {
+              queue = edcaQueue;
+            }
+        }
+    }
+  else if (!m_dca->GetQueue ()->IsEmpty ())
+    {
+      queue = m_dca->GetQueue ();
+    }
+  if (queue == 0)
+    {
+      NS_LOG_DEBUG ("triggered, but nothing to send");
+      return;
+    }
+
+  //the resource unit is modeled as a narrower S1G channel
+  uint32_t ruWidth = m_phy->GetChannelWidth () / trigger.GetNRus ();
+  WifiMode mode;
+  bool found = false;
+  for (uint32_t i = 0; i < m_phy->GetNModes () && !found; i++)
+    {
+      WifiMode candidate = m_phy->GetMode (i);
+      if (candidate.GetBandwidth () == ruWidth * 1000000
+          && m_phy->WifiModeToMcs (candidate) == trigger.GetUlMcs ())
+        {
+          mode = candidate;
+          found = true;
+        }
+    }
+  if (!found)
+    {
+      NS_LOG_DEBUG ("no mode for MCS " << (uint32_t)trigger.GetUlMcs () << " on a " << ruWidth << " MHz resource unit");
+      return;
+    }
+
+  WifiMacHeader hdr;
+  Ptr<const Packet> packet = queue->Dequeue (&hdr);
+  hdr.SetSequenceNumber (m_txMiddle->GetNextSequenceNumberfor (&hdr));
+  hdr.SetFragmentNumber (0);
+  hdr.SetNoMoreFragments ();
+  hdr.SetNoRetry ();
+  hdr.SetDuration (Seconds (0));
+  if (hdr.IsQosData ())
+    {
+      hdr.SetQosAckPolicy (WifiMacHeader::NO_ACK);
+    }
+  WifiMacTrailer fcs;
+  uint32_t size = packet->GetSize () + hdr.GetSize () + fcs.GetSerializedSize ();
+  WifiTxVector txVector = m_stationManager->GetDataTxVector (hdr.GetAddr1 (), &hdr, packet, size);
+  txVector.SetMode (mode);
+  txVector.SetRu (ruIndex, trigger.GetNRus ());
+  WifiPreamble preamble = (ruWidth == 1) ? WIFI_PREAMBLE_S1G_1M : WIFI_PREAMBLE_S1G_SHORT;
+  Time txDuration = m_phy->CalculateTxDuration (size, txVector, preamble, m_phy->GetFrequency (), 0, 0);
+  if (txDuration > MicroSeconds (trigger.GetUlLength ()))
+    {
+      NS_LOG_DEBUG ("packet of " << txDuration << " does not fit in the triggered uplink, mode=" << mode);
+      queue->PushFront (packet, hdr);
+      return;
+    }
+  m_muPacket = packet;
+  m_muHdr = hdr;
+  m_muQueue = queue;
+  m_low->StartTriggerBasedTransmission (packet, hdr, txVector, preamble);
+  //the multi-STA ack is not longer than the largest uplink PPDU
+  Time timeout = m_low->GetSifs () + MicroSeconds (trigger.GetUlLength ())
+    + m_low->GetSifs () + MicroSeconds (trigger.GetUlLength ());
+  m_muAckTimeoutEvent = Simulator::Schedule (timeout, &StaWifiMac::MuUplinkFailed, this);
+}
+
+void
+StaWifiMac::MuUplinkFailed (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_LOG_DEBUG ("triggered uplink not acknowledged");
+  m_muQueue->PushFront (m_muPacket, m_muHdr);
+  m_muPacket = 0;
+  m_muQueue = 0;
+}
+
 void
 StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
 {
@@ -1367,7 +1542,7 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
           NotifyRxDrop (packet);
           return;
         }
-      if (!(hdr->IsFromDs () && !hdr->IsToDs ()))
+      if (!hdr->IsFromDs ())
         {
           NS_LOG_LOGIC ("Received data frame not from the DS: ignore");
           NotifyRxDrop (packet);
@@ -1379,6 +1554,15 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
           NotifyRxDrop (packet);
           return;
         }
+      if (hdr->IsToDs ())
+        {
+          //four address frame sent by the AP for a station associated
+          //with us, which we relay
+          NS_LOG_DEBUG (GetAddress () << " received data to relay from " << hdr->GetAddr4 ()
+                        << " to " << hdr->GetAddr3 () << " @ " << Simulator::Now ().GetMicroSeconds ());
+          ForwardUp (packet, hdr->GetAddr4 (), hdr->GetAddr3 ());
+          return;
+        }
       if (hdr->IsQosData ())
         {
     	  NS_LOG_DEBUG (GetAddress () << " received qos data from " << hdr->GetAddr3 () << " @ " << Simulator::Now().GetMicroSeconds());
@@ -1447,29 +1631,30 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
     {
       S1gBeaconHeader beacon;
       packet->RemoveHeader (beacon);
-      bool goodBeacon = false;
-    if ((IsWaitAssocResp () || IsAssociated ()) && hdr->GetAddr3 () != GetBssid ()) // for debug
-     {
-       goodBeacon = false;
-     }
-    else
+    if (!GetSsid ().IsBroadcast ()
+        && beacon.GetCompressedSSID () != GetSsid ().GetCompressed ())
      {
-      goodBeacon = true;
+       //beacon of another BSS, e.g. of a relay: its RAW and TIM do not apply to us
+       NS_LOG_LOGIC ("S1G beacon of another BSS: ignore");
+       return;
      }
-    if (goodBeacon)
+    if ((IsWaitAssocResp () || IsAssociated ()) && hdr->GetAddr3 () != GetBssid ()) // for debug
      {
-       Time delay = MicroSeconds (beacon.GetBeaconCompatibility().GetBeaconInterval () * m_maxMissedBeacons);
-       RestartBeaconWatchdog (delay);
-       //SetBssid (beacon.GetSA ());
-       SetBssid (hdr->GetAddr3 ()); //for debug
+       //beacon of another AP of our SSID
+       S1gBeaconReceived (beacon);
+       waitingack = false;
+       outsideraw = false;
+       return;
      }
-    if (goodBeacon && m_state == BEACON_MISSED)
+    Time delay = MicroSeconds (beacon.GetBeaconCompatibility().GetBeaconInterval () * m_maxMissedBeacons);
+    RestartBeaconWatchdog (delay);
+    //SetBssid (beacon.GetSA ());
+    SetBssid (hdr->GetAddr3 ()); //for debug
+    if (m_state == BEACON_MISSED)
      {
        SetState (WAIT_ASSOC_RESP);
        SendAssociationRequest ();
      }
-    if (goodBeacon)
-     {
         timeDifferenceBeacon = Simulator::Now().GetMicroSeconds() - timeBeacon;
         timeBeacon = Simulator::Now().GetMicroSeconds();
         if(firstBeacon)
@@ -1491,9 +1676,8 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
 
         
         UnsetInRAWgroup ();
-        uint8_t * rawassign;
-        rawassign = beacon.GetRPS().GetRawAssignment();
-        uint16_t raw_len = beacon.GetRPS().GetInformationFieldSize();
+        RPS rps = beacon.GetRPS ();
+        uint16_t raw_len = rps.GetInformationFieldSize ();
         uint16_t rawAssignment_len = 6;
         if (raw_len % rawAssignment_len !=0)
           {
@@ -1507,7 +1691,7 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
          m_lastRawDurationus = MicroSeconds(0);
     for (uint8_t raw_index=0; raw_index < RAW_number; raw_index++)
       {
-        auto ass = beacon.GetRPS().GetRawAssigmentObj(raw_index);
+        auto ass = rps.GetRawAssigmentObj(raw_index);
 
         if (ass.GetRawTypeIndex() == 4) // only support Generic Raw (paged STA RAW or not)
           {
@@ -1560,7 +1744,11 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
            {
              fastAssocThreshold = AuthenCtrl.GetThreshold();
            }
-     }
+         if (m_deterministicAuthen && m_assocDeferred && !IsAssociated ()
+             && assocVaule < fastAssocThreshold)
+           {
+             SendAssociationRequest ();
+           }
     S1gBeaconReceived (beacon);
     waitingack = false;
     outsideraw = false;
@@ -1601,6 +1789,26 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
         }
       return;
     }
+  else if (hdr->IsAssocResp () && hdr->GetAddr1 ().IsGroup ())
+    {
+      if (m_state == WAIT_ASSOC_RESP)
+        {
+          MgtGroupAssocResponseHeader assocResp;
+          packet->RemoveHeader (assocResp);
+          uint16_t aid;
+          if (!assocResp.FindAid (GetAddress (), &aid))
+            {
+              return;
+            }
+          if (m_assocRequestEvent.IsRunning ())
+            {
+              m_assocRequestEvent.Cancel ();
+            }
+          CompleteAssociation (aid, assocResp.GetSupportedRates (), assocResp.GetHtCapabilities (),
+                               assocResp.GetS1gCapabilities (), hdr->GetAddr2 ());
+        }
+      return;
+    }
   else if (hdr->IsAssocResp ())
     {
       if (m_state == WAIT_ASSOC_RESP)
@@ -1613,64 +1821,9 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
             }
           if (assocResp.GetStatusCode ().IsSuccess ())
             {
-        	  SetAID (assocResp.GetAID ());
-              SetState (ASSOCIATED);
-	      NS_LOG_DEBUG("[" << this->GetAddress() <<"] is associated and has AID = " << this->GetAID());
-              SupportedRates rates = assocResp.GetSupportedRates ();
-              if (m_htSupported)
-                {
-                  HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
-                  m_stationManager->AddStationHtCapabilities (hdr->GetAddr2 (),htcapabilities);
-                }
-              
-              if (m_s1gSupported)
-                {
-                  S1gCapabilities s1gcapabilities = assocResp.GetS1gCapabilities ();
-                  NS_LOG_UNCOND (GetAddress () << ", receive " << uint16_t( s1gcapabilities.GetChannelWidth ()));
-                  m_stationManager->AddStationS1gCapabilities (hdr->GetAddr2 (),s1gcapabilities);
-                }
-
-              for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
-                {
-                  WifiMode mode = m_phy->GetMode (i);
-                  for (uint32_t j = 0; j < m_phy->m_deviceRateSet.size (); j++)
-                   {
-                    if (m_phy->m_deviceRateSet[j] == mode )
-                    {
-                       NS_LOG_UNCOND (GetAddress () << ", AddSupportedMode " << hdr->GetAddr2 () << ", " << mode);                        
-                        m_stationManager->AddSupportedMode (hdr->GetAddr2 (), mode);
-                        if (rates.IsBasicRate (mode.GetDataRate ()))
-                        {
-                            m_stationManager->AddBasicMode (mode);
-                        }
-                    }
-                  }
-                  if (rates.IsSupportedRate (mode.GetDataRate ()))
-                    {
-                      m_stationManager->AddSupportedMode (hdr->GetAddr2 (), mode);
-                      if (rates.IsBasicRate (mode.GetDataRate ()))
-                        {
-                          m_stationManager->AddBasicMode (mode);
-                        }
-                    }
-                }
-              if (m_htSupported)
-                {
-                  HtCapabilities htcapabilities = assocResp.GetHtCapabilities ();
-                  for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
-                    {
-                      uint8_t mcs = m_phy->GetMcs (i);
-                      if (htcapabilities.IsSupportedMcs (mcs))
-                        {
-                          m_stationManager->AddSupportedMcs (hdr->GetAddr2 (), mcs);
-                          //here should add a control to add basic MCS when it is implemented
-                        }
-                    }
-                }
-              if (!m_linkUp.IsNull ())
-                {
-                  m_linkUp ();
-                }
+              CompleteAssociation (assocResp.GetAID (), assocResp.GetSupportedRates (),
+                                   assocResp.GetHtCapabilities (), assocResp.GetS1gCapabilities (),
+                                   hdr->GetAddr2 ());
             }
           else
             {
@@ -1687,38 +1840,67 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
   RegularWifiMac::Receive (packet, hdr);
 }
 
-SupportedRates
-StaWifiMac::GetSupportedRates (void) const
+void
+StaWifiMac::CompleteAssociation (uint16_t aid, SupportedRates rates, HtCapabilities htcapabilities,
+                                 S1gCapabilities s1gcapabilities, Mac48Address ap)
 {
-  SupportedRates rates;
+  NS_LOG_FUNCTION (this << aid << ap);
+  SetAID (aid);
+  SetState (ASSOCIATED);
+  NS_LOG_DEBUG("[" << this->GetAddress() <<"] is associated and has AID = " << this->GetAID());
   if (m_htSupported)
     {
-      for (uint32_t i = 0; i < m_phy->GetNBssMembershipSelectors (); i++)
+      m_stationManager->AddStationHtCapabilities (ap,htcapabilities);
+    }
+  
+  if (m_s1gSupported)
+    {
+      NS_LOG_DEBUG (GetAddress () << ", receive " << uint16_t( s1gcapabilities.GetChannelWidth ()));
+      m_stationManager->AddStationS1gCapabilities (ap,s1gcapabilities);
+    }
+
+  //every mode of the PHY is in its device rate set, so every mode is
+  //added, whether the AP supports it or not
+  SupportedRates::RateSet basicRates = rates.GetBasicRateSet ();
+  const std::vector<uint8_t> &modeRates = GetPhyModeRateIndexes ();
+  for (uint32_t i = 0; i < modeRates.size (); i++)
+    {
+      WifiMode mode = m_phy->GetMode (i);
+      NS_LOG_DEBUG (GetAddress () << ", AddSupportedMode " << ap << ", " << mode);
+      m_stationManager->AddSupportedMode (ap, mode);
+      if (basicRates.test (modeRates[i]))
         {
-          rates.SetBasicRate (m_phy->GetBssMembershipSelector (i));
+          m_stationManager->AddBasicMode (mode);
         }
     }
-  for (uint32_t i = 0; i < m_phy->GetNModes (); i++)
+  if (m_htSupported)
     {
-      WifiMode mode = m_phy->GetMode (i);
-      rates.AddSupportedRate (mode.GetDataRate ());
+      for (uint32_t i = 0; i < m_phy->GetNMcs (); i++)
+        {
+          uint8_t mcs = m_phy->GetMcs (i);
+          if (htcapabilities.IsSupportedMcs (mcs))
+            {
+              m_stationManager->AddSupportedMcs (ap, mcs);
+              //here should add a control to add basic MCS when it is implemented
+            }
+        }
+    }
+  if (!m_linkUp.IsNull ())
+    {
+      m_linkUp ();
     }
-  return rates;
+}
+
+SupportedRates
+StaWifiMac::GetSupportedRates (void) const
+{
+  return GetPhySupportedRates ();
 }
 
 HtCapabilities
 StaWifiMac::GetHtCapabilities (void) const
 {
-  HtCapabilities capabilities;
-  capabilities.SetHtSupported (1);
-  capabilities.SetLdpc (m_phy->GetLdpc ());
-  capabilities.SetShortGuardInterval20 (m_phy->GetGuardInterval ());
-  capabilities.SetGreenfield (m_phy->GetGreenfield ());
-  for (uint8_t i = 0; i < m_phy->GetNMcs (); i++)
-    {
-      capabilities.SetRxMcsBitmask (m_phy->GetMcs (i));
-    }
-  return capabilities;
+  return GetPhyHtCapabilities ();
 }
 
 S1gCapabilities
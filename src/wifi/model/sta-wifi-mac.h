@@ -67,6 +67,21 @@ public:
    */
   virtual void Enqueue (Ptr<const Packet> packet, Mac48Address to);
 
+  /**
+   * \param packet the packet to send.
+   * \param to the address to which the packet should be sent.
+   * \param from the address from which the packet should be sent.
+   *
+   * The packet should be enqueued in a tx queue, and should be
+   * dequeued as soon as the channel access function determines that
+   * access is granted to this MAC. If \p from is not our own address,
+   * the packet is relayed to the AP in a four address frame, so that
+   * this station can serve as the uplink of a relay.
+   */
+  virtual void Enqueue (Ptr<const Packet> packet, Mac48Address to, Mac48Address from);
+
+  virtual bool SupportsSendFrom (void) const;
+
   /**
    * \param missed the number of beacons which must be missed
    * before a new association sequence is started.
@@ -246,6 +261,28 @@ private:
    */
   void WakeUp (void);
   void SleepIfQueueIsEmpty(bool);
+  /**
+   * Handle a trigger frame or a multi-STA ack sent by the AP.
+   *
+   * \param trigger the received trigger header
+   */
+  void ReceiveTrigger (const CtrlTriggerHeader &trigger);
+  /**
+   * Record the association granted by the AP.
+   *
+   * \param aid the AID assigned by the AP
+   * \param rates the rates supported by the AP
+   * \param htcapabilities the HT capabilities of the AP
+   * \param s1gcapabilities the S1G capabilities of the AP
+   * \param ap the address of the AP
+   */
+  void CompleteAssociation (uint16_t aid, SupportedRates rates, HtCapabilities htcapabilities,
+                            S1gCapabilities s1gcapabilities, Mac48Address ap);
+  /**
+   * Put the packet sent in response to a trigger frame back at the head
+   * of its queue because it was not acknowledged.
+   */
+  void MuUplinkFailed (void);
   bool HasPacketsInQueue();
   void BeaconWakeUp (void);
   void GoToSleepBinary (int value);
@@ -280,6 +317,8 @@ private:
   uint32_t m_aid;
   bool fasTAssocType;
   uint16_t fastAssocThreshold;
+  bool m_deterministicAuthen;  //!< Flag if the authentication control value is derived from the address
+  bool m_assocDeferred;        //!< Flag if the last association request was deferred by the authentication control
     uint16_t assocVaule;
   uint8_t m_slotCrossBoundary;
     
@@ -295,6 +334,10 @@ private:
 
   bool m_activeProbing;
   Ptr<DcaTxop> m_pspollDca;  //!< Dedicated DcaTxop for beacons
+  Ptr<const Packet> m_muPacket;    //!< Packet sent in response to the last trigger frame, waiting for the multi-STA ack
+  WifiMacHeader m_muHdr;           //!< Header of m_muPacket
+  Ptr<WifiMacQueue> m_muQueue;     //!< Queue m_muPacket was taken from
+  EventId m_muAckTimeoutEvent;     //!< Multi-STA ack timeout
   virtual void DoDispose (void);
   
   TIM m_TIM;
@@ -128,6 +128,42 @@ SupportedRates::GetRate (uint8_t i) const
   return (m_rates[i] & 0x7f) * 500000;
 }
 
+uint8_t
+SupportedRates::GetRateIndex (uint32_t bs)
+{
+  return bs / 500000;
+}
+
+SupportedRates::RateSet
+SupportedRates::GetSupportedRateSet (void) const
+{
+  RateSet set;
+  for (uint8_t i = 0; i < m_nRates; i++)
+    {
+      set.set (m_rates[i]);
+      if (m_rates[i] & 0x80)
+        {
+          set.set (m_rates[i] & 0x7f);
+        }
+    }
+  return set;
+}
+
+SupportedRates::RateSet
+SupportedRates::GetBasicRateSet (void) const
+{
+  RateSet set;
+  for (uint8_t i = 0; i < m_nRates; i++)
+    {
+      if (m_rates[i] & 0x80)
+        {
+          set.set (m_rates[i]);
+          set.set (m_rates[i] & 0x7f);
+        }
+    }
+  return set;
+}
+
 WifiInformationElementId
 SupportedRates::ElementId () const
 {
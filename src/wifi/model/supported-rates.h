@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <ostream>
+#include <bitset>
 #include "ns3/buffer.h"
 #include "ns3/wifi-information-element.h"
 
@@ -161,6 +162,30 @@ public:
    */
   uint32_t GetRate (uint8_t i) const;
 
+  /**
+   * A set of rates, with a bit per rate encoded as in the element, i.e.
+   * the rate divided by 500000 and truncated to 8 bits.
+   */
+  typedef std::bitset<256> RateSet;
+  /**
+   * \param bs a rate
+   *
+   * \return the index of the rate in a RateSet
+   */
+  static uint8_t GetRateIndex (uint32_t bs);
+  /**
+   * The rates of the set are those for which IsSupportedRate returns
+   * true, so that the rates supported by both ends are found with a
+   * bitwise AND.
+   *
+   * \return the set of the supported rates
+   */
+  RateSet GetSupportedRateSet (void) const;
+  /**
+   * \return the set of the rates for which IsBasicRate returns true
+   */
+  RateSet GetBasicRateSet (void) const;
+
   WifiInformationElementId ElementId () const;
   uint8_t GetInformationFieldSize () const;
   void SerializeInformationField (Buffer::Iterator start) const;
@@ -21,12 +21,17 @@
 #include "tim.h"
 #include "ns3/assert.h"
 #include "ns3/log.h" //for test
+#include <cstring>
 
 namespace ns3 {
     
 	NS_LOG_COMPONENT_DEFINE ("TIM");
 
 TIM::EncodedBlock::EncodedBlock ()
+  : m_blockcontrol (0),
+    m_blockoffset (0),
+    m_blockbitmap (0),
+    subb_length (0)
 {
 }
 
@@ -54,9 +59,9 @@ TIM::EncodedBlock::SetBlockBitmap (uint8_t encodedInfo)
 }
 
 void
-TIM::EncodedBlock::SetEncodedInfo (uint8_t * encodedInfo, uint8_t subblocklength)
+TIM::EncodedBlock::SetEncodedInfo (const uint8_t * encodedInfo, uint8_t subblocklength)
 {
-  //NS_ASSERT (1 <= subblocklength <= 8);
+  NS_ASSERT (subblocklength <= 8);
   uint8_t i = 0;
   uint8_t len = 0;
   while (i <= 7)
@@ -68,7 +73,7 @@ TIM::EncodedBlock::SetEncodedInfo (uint8_t * encodedInfo, uint8_t subblocklength
     i++;
   }
   NS_ASSERT (len == subblocklength);
-  m_subblock = encodedInfo;
+  std::memcpy (m_subblock, encodedInfo, subblocklength);
   subb_length = subblocklength;
 }
 
@@ -100,7 +105,7 @@ TIM::EncodedBlock::GetBlockBitmap (void) const
   return m_blockbitmap;
 }
 
-uint8_t *
+const uint8_t *
 TIM::EncodedBlock::GetSubblock (void) const
 {
   return m_subblock;
@@ -144,8 +149,14 @@ TIM::EncodedBlock::Is (uint8_t info, uint8_t n)
 }
 
 TIM::TIM ()
+  : m_length (0),
+    m_DTIMCount (0),
+    m_DTIMPeriod (0),
+    m_BitmapControl (0),
+    m_TrafficIndicator (0),
+    m_PageSliceNum (0),
+    m_PageIndex (0)
 {
-  m_length = 0;
 }
 
 TIM::~TIM ()
@@ -196,34 +207,54 @@ TIM::SetPageIndex (uint8_t control)
 }
   
 void
-TIM::SetPartialVBitmap (TIM::EncodedBlock block)
+TIM::SetPartialVBitmap (const TIM::EncodedBlock &block)
 {
-  m_encodeblock = block;
-  uint8_t offset = m_encodeblock.GetBlockOffset ();
-  uint8_t control = m_encodeblock.GetBlockControl ();
+  NS_ASSERT (m_length + block.GetSize () <= sizeof (m_partialVBitmap_arrary));
+  uint8_t offset = block.GetBlockOffset ();
+  uint8_t control = block.GetBlockControl ();
 
   uint8_t offcont = ((offset << 3) & 0xf8) | (control & 0x07);
   m_partialVBitmap_arrary[m_length] = offcont;
   m_length++;
-  
-  m_partialVBitmap_arrary[m_length] = m_encodeblock.GetBlockBitmap ();
+
+  m_partialVBitmap_arrary[m_length] = block.GetBlockBitmap ();
   m_length++;
-  NS_LOG_DEBUG ("Block Bitmap = " << (int)m_encodeblock.GetBlockBitmap ());
+  NS_LOG_DEBUG ("Block Bitmap = " << (int)block.GetBlockBitmap ());
 
-  subblock = m_encodeblock.GetSubblock ();
-  uint8_t len = m_encodeblock.GetSize ();  //size of EncodedBlock
-  uint8_t i=0;
-  while (i < len-2) //blockcotrol, blockoffset has already been added into m_partialVBitmap
-  {
-	NS_LOG_DEBUG ("Subblock " << (int)i << " = " << (int)(*subblock));
+  //blockcotrol, blockoffset has already been added into the partial virtual bitmap
+  uint8_t len = block.GetSize () - 2;
+  std::memcpy (m_partialVBitmap_arrary + m_length, block.GetSubblock (), len);
+  m_length += len;
+}
 
-    m_partialVBitmap_arrary[m_length] = *subblock;
-    m_length++;
-    subblock++;
-    i++;
-  }
-  m_partialVBitmap = m_partialVBitmap_arrary;
-  NS_ASSERT ( m_length < 252);
+void
+TIM::ClearPartialVBitmap (void)
+{
+  m_length = 0;
+}
+
+void
+TIM::AddEncodedBlocks (const AidBitmap &aids, uint8_t page, uint8_t blockOffset, uint8_t numBlocks)
+{
+  for (uint8_t i = 0; i < numBlocks; i++)
+    {
+      uint8_t block = (blockOffset + i) & 0x1f;
+      EncodedBlock encodedBlock;
+      encodedBlock.SetBlockOffset (block);
+      uint8_t blockBitmap = aids.GetSubblockBitmap (page, block);
+      encodedBlock.SetBlockBitmap (blockBitmap);
+      uint8_t subblocks[8];
+      uint8_t length = 0;
+      for (uint8_t subblock = 0; subblock < 8; subblock++)
+        {
+          if (blockBitmap & (1 << subblock))
+            {
+              subblocks[length++] = aids.GetAidBitmap (page, block, subblock);
+            }
+        }
+      encodedBlock.SetEncodedInfo (subblocks, length);
+      SetPartialVBitmap (encodedBlock);
+    }
 }
 
 
@@ -262,10 +293,10 @@ TIM::GetPageIndex(void) const
     return m_PageIndex;
 }
 
-uint8_t *
+const uint8_t *
 TIM::GetPartialVBitmap (void) const
 {
-  return m_partialVBitmap;
+  return m_partialVBitmap_arrary;
 }
 
 WifiInformationElementId
@@ -293,7 +324,7 @@ TIM::SerializeInformationField (Buffer::Iterator start) const
  if (m_BitmapControl || m_length != 0)
    {
      start.WriteU8 (m_BitmapControl);
-     start.Write (m_partialVBitmap, m_length);
+     start.Write (m_partialVBitmap_arrary, m_length);
      NS_LOG_DEBUG ("Bitmap Control field is " << (int)m_BitmapControl);
      NS_LOG_DEBUG ("Length of Partial Virtual Bitmap is " << (int)m_length);
    }
@@ -308,9 +339,9 @@ TIM::DeserializeInformationField (Buffer::Iterator start, uint8_t length)
   if (length > 2)
     {
 	  SetBitmapControl (start.ReadU8 ());
+	  NS_ASSERT (length - 3 <= (int)sizeof (m_partialVBitmap_arrary));
 	  start.Read (m_partialVBitmap_arrary, (length-3));
 	  m_length = length-3;
-	  m_partialVBitmap = m_partialVBitmap_arrary;
 
     }
   else
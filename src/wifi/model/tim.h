@@ -26,6 +26,7 @@
 #include "ns3/attribute-helper.h"
 #include "ns3/attribute.h"
 #include "ns3/wifi-information-element.h"
+#include "aid-bitmap.h"
 
 
 namespace ns3 {
@@ -35,6 +36,10 @@ namespace ns3 {
  *
  * The IEEE 802.11 TIM Element
  *
+ * The partial virtual bitmap and the subblocks of the encoded blocks are
+ * stored inline, so that a TIM is built, copied into a beacon and
+ * serialized without heap allocation.
+ *
  * \see attribute_Tim
  */
 class TIM : public WifiInformationElement
@@ -58,13 +63,18 @@ public:
 
         void SetBlockControl (enum BlockCoding coding);
         void SetBlockOffset (uint8_t offset);
-        void SetEncodedInfo (uint8_t * encodedInfo, uint8_t length);
+        /**
+         * \param encodedInfo the bitmaps of the subblocks set in the block
+         *        bitmap, copied into the block
+         * \param length the number of subblocks (at most 8)
+         */
+        void SetEncodedInfo (const uint8_t * encodedInfo, uint8_t length);
         void SetBlockBitmap (uint8_t offset);
       
         enum  TIM::BlockCoding GetBlockControl (void) const;
         uint8_t GetBlockOffset (void) const;
         uint8_t GetBlockBitmap (void) const;
-        uint8_t * GetSubblock (void) const;
+        const uint8_t * GetSubblock (void) const;
       
         uint8_t GetSize (void) const;
         //void Serialize (Buffer::Iterator start) const;
@@ -76,7 +86,7 @@ public:
         uint8_t m_blockcontrol;
         uint8_t m_blockoffset;
         uint8_t m_blockbitmap;
-        uint8_t * m_subblock;
+        uint8_t m_subblock[8]; //!< Subblock field, one byte per subblock
         uint8_t subb_length; //!< length of Subblock field
      };
     
@@ -105,7 +115,22 @@ public:
    *
    * \Set the Partial Virtual Bitmap
    */
-  void SetPartialVBitmap (TIM::EncodedBlock block);
+  void SetPartialVBitmap (const TIM::EncodedBlock &block);
+  /**
+   * Remove the encoded blocks of the Partial Virtual Bitmap.
+   */
+  void ClearPartialVBitmap (void);
+  /**
+   * Append the blocks of a page to the Partial Virtual Bitmap, encoded
+   * in block bitmap mode. Every block is encoded, the blocks without
+   * AIDs with an empty block bitmap.
+   *
+   * \param aids the AIDs to page
+   * \param page the page of the blocks
+   * \param blockOffset the first block
+   * \param numBlocks the number of blocks, wrapping around the 32 blocks of the page
+   */
+  void AddEncodedBlocks (const AidBitmap &aids, uint8_t page, uint8_t blockOffset, uint8_t numBlocks);
     
   /**
    * Return the TIM Count.
@@ -130,7 +155,7 @@ public:
    *
    * \Return the Partial Virtual Bitmap
    */
-  uint8_t * GetPartialVBitmap (void) const;
+  const uint8_t * GetPartialVBitmap (void) const;
   
    void SetTafficIndicator (uint8_t control);
    void SetPageSliceNum (uint8_t control);
@@ -156,11 +181,7 @@ private:
   uint8_t m_TrafficIndicator;
   uint8_t m_PageSliceNum;
   uint8_t m_PageIndex;
-  TIM::EncodedBlock m_encodeblock; //!< encoded block subfield of partial Virtual Bitmap field
   uint8_t m_partialVBitmap_arrary[251]; // see 9.4.2.6.1
-  uint8_t * m_partialVBitmap;
-
-  uint8_t * subblock; 
 };
 
 std::ostream &operator << (std::ostream &os, const TIM &pageS);
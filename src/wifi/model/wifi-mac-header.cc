@@ -65,7 +65,8 @@ enum
   SUBTYPE_CTL_CTS = 12,
   SUBTYPE_CTL_ACK = 13,
  
-  SUBTYPE_CTL_CTLWRAPPER = 7
+  SUBTYPE_CTL_CTLWRAPPER = 7,
+  SUBTYPE_CTL_TRIGGER = 2
 
 };
 
@@ -246,6 +247,10 @@ WifiMacHeader::SetType (enum WifiMacType type)
       m_ctrlType = TYPE_CTL;
       m_ctrlSubtype = SUBTYPE_CTL_CTLWRAPPER;
       break;
+    case WIFI_MAC_CTL_TRIGGER:
+      m_ctrlType = TYPE_CTL;
+      m_ctrlSubtype = SUBTYPE_CTL_TRIGGER;
+      break;
     case WIFI_MAC_MGT_ASSOCIATION_REQUEST:
       m_ctrlType = TYPE_MGT;
       m_ctrlSubtype = 0;
@@ -674,6 +679,9 @@ WifiMacHeader::GetType (void) const
         case SUBTYPE_CTL_PSPOLL:
           return WIFI_MAC_CTL_PSPOLL;
           break;
+        case SUBTYPE_CTL_TRIGGER:
+          return WIFI_MAC_CTL_TRIGGER;
+          break;
         }
       break;
     case TYPE_DATA:
@@ -823,6 +831,12 @@ WifiMacHeader::IsPsPoll (void) const
   return (GetType () == WIFI_MAC_CTL_PSPOLL);
 }
 
+bool
+WifiMacHeader::IsTrigger (void) const
+{
+  return (GetType () == WIFI_MAC_CTL_TRIGGER);
+}
+
 bool
 WifiMacHeader::IsAssocReq (void) const
 {
@@ -1210,6 +1224,7 @@ WifiMacHeader::GetSize (void) const
         {
         case SUBTYPE_CTL_RTS:
         case SUBTYPE_CTL_PSPOLL:
+        case SUBTYPE_CTL_TRIGGER:
           size = 2 + 2 + 6 + 6;
           break;
         case SUBTYPE_CTL_CTS:
@@ -1259,6 +1274,7 @@ case WIFI_MAC_ ## x: \
       FOO (CTL_ACK);
       FOO (CTL_BACKREQ);
       FOO (CTL_BACKRESP);
+      FOO (CTL_TRIGGER);
 
       FOO (MGT_BEACON);
       FOO (MGT_ASSOCIATION_REQUEST);
@@ -1348,6 +1364,7 @@ WifiMacHeader::Print (std::ostream &os) const  //to do, support S1G beacon frame
     case WIFI_MAC_CTL_CTLWRAPPER:
       break;
     case WIFI_MAC_CTL_PSPOLL:
+    case WIFI_MAC_CTL_TRIGGER:
     	os << "Duration/ID=" << m_duration << "us"
     	<< ", RA=" << m_addr1 << ", TA=" << m_addr2;
       break;
@@ -1450,6 +1467,7 @@ WifiMacHeader::Serialize (Buffer::Iterator i) const
         {
         case SUBTYPE_CTL_RTS:
         case SUBTYPE_CTL_PSPOLL:
+        case SUBTYPE_CTL_TRIGGER:
           WriteTo (i, m_addr2);
           break;
         case SUBTYPE_CTL_CTS:
@@ -1517,6 +1535,7 @@ WifiMacHeader::Deserialize (Buffer::Iterator start)
         {
         case SUBTYPE_CTL_RTS:
         case SUBTYPE_CTL_PSPOLL:
+        case SUBTYPE_CTL_TRIGGER:
           ReadFrom (i, m_addr2);
           break;
         case SUBTYPE_CTL_CTS:
@@ -73,6 +73,8 @@ enum WifiMacType
   WIFI_MAC_QOSDATA_NULL,
   WIFI_MAC_QOSDATA_NULL_CFPOLL,
   WIFI_MAC_QOSDATA_NULL_CFACK_CFPOLL,
+
+  WIFI_MAC_CTL_TRIGGER,
 };
     
 enum S1G_BSS_BW
@@ -473,6 +475,12 @@ public:
    * \return true if the header is a Block ACK header, false otherwise
    */
   bool IsBlockAck (void) const;
+  /**
+   * Return true if the header is a Trigger header.
+   *
+   * \return true if the header is a Trigger header, false otherwise
+   */
+  bool IsTrigger (void) const;
   /**
    * Return true if the header is an Association Request header.
    *
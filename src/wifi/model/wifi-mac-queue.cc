@@ -54,6 +54,10 @@ WifiMacQueue::GetTypeId (void)
                    TimeValue (MilliSeconds (500.0)),
                    MakeTimeAccessor (&WifiMacQueue::m_maxDelay),
                    MakeTimeChecker ())
+    .AddAttribute ("Quantum", "The number of bytes each station can send per round when the per-station scheduling is enabled.",
+                   UintegerValue (1500),
+                   MakeUintegerAccessor (&WifiMacQueue::m_quantum),
+                   MakeUintegerChecker<uint32_t> (1))
 	.AddTraceSource ("PacketDropped",
 					 "Trace source indicating a packet has been dropped from the queue",
 					 MakeTraceSourceAccessor (&WifiMacQueue::m_packetdropped),
@@ -63,7 +67,9 @@ WifiMacQueue::GetTypeId (void)
 }
 
 WifiMacQueue::WifiMacQueue ()
-  : m_size (0)
+  : m_size (0),
+    m_stationFair (false),
+    m_selection (0)
 {
 }
 
@@ -109,6 +115,7 @@ WifiMacQueue::Enqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
   Time now = Simulator::Now ();
   m_queue.push_back (Item (packet, hdr, now));
   m_size++;
+  NotifyQueued (hdr);
 }
 
 void
@@ -130,6 +137,7 @@ WifiMacQueue::Cleanup (void)
       else
         {
     	  m_packetdropped(i->packet->Copy(), DropReason::MacQueueDelayExceeded);
+          NotifyRemoved (i->hdr);
           i = m_queue.erase (i);
           n++;
         }
@@ -146,6 +154,7 @@ WifiMacQueue::Dequeue (WifiMacHeader *hdr)
       Item i = m_queue.front ();
       m_queue.pop_front ();
       m_size--;
+      NotifyRemoved (i.hdr);
       *hdr = i.hdr;
       return i.packet;
     }
@@ -183,6 +192,7 @@ WifiMacQueue::DequeueByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                 {
                   packet = it->packet;
                   *hdr = it->hdr;
+                  NotifyRemoved (it->hdr);
                   m_queue.erase (it);
                   m_size--;
                   break;
@@ -252,8 +262,18 @@ WifiMacQueue::GetSize (void)
 void
 WifiMacQueue::Flush (void)
 {
+  std::map<Mac48Address, Station> stations;
+  stations.swap (m_stations);
   m_queue.erase (m_queue.begin (), m_queue.end ());
   m_size = 0;
+  m_flows.clear ();
+  if (!m_buffered.IsNull ())
+    {
+      for (std::map<Mac48Address, Station>::const_iterator it = stations.begin (); it != stations.end (); ++it)
+        {
+          m_buffered (it->first, false);
+        }
+    }
 }
 
 Mac48Address
@@ -282,6 +302,7 @@ WifiMacQueue::Remove (Ptr<const Packet> packet)
     {
       if (it->packet == packet)
         {
+          NotifyRemoved (it->hdr);
           m_queue.erase (it);
           m_size--;
           return true;
@@ -302,6 +323,7 @@ WifiMacQueue::PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr)
   Time now = Simulator::Now ();
   m_queue.push_front (Item (packet, hdr, now));
   m_size++;
+  NotifyQueued (hdr);
 }
 
 uint32_t
@@ -333,6 +355,23 @@ WifiMacQueue::DequeueFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
 {
   Cleanup ();
   Ptr<const Packet> packet = 0;
+  if (m_stationFair)
+    {
+      uint32_t rounds;
+      uint32_t position;
+      PacketQueueI it = SelectStationFair (blockedPackets, &rounds, &position);
+      if (it != m_queue.end ())
+        {
+          *hdr = it->hdr;
+          timestamp = it->tstamp;
+          packet = it->packet;
+          ServeStationFair (rounds, position, packet->GetSize ());
+          NotifyRemoved (it->hdr);
+          m_queue.erase (it);
+          m_size--;
+        }
+      return packet;
+    }
   for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
     {
       if (!it->hdr.IsQosData ()
@@ -341,6 +380,7 @@ WifiMacQueue::DequeueFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
           *hdr = it->hdr;
           timestamp = it->tstamp;
           packet = it->packet;
+          NotifyRemoved (it->hdr);
           m_queue.erase (it);
           m_size--;
           return packet;
@@ -354,6 +394,19 @@ WifiMacQueue::PeekFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
                                   const QosBlockedDestinations *blockedPackets)
 {
   Cleanup ();
+  if (m_stationFair)
+    {
+      uint32_t rounds;
+      uint32_t position;
+      PacketQueueI it = SelectStationFair (blockedPackets, &rounds, &position);
+      if (it == m_queue.end ())
+        {
+          return 0;
+        }
+      *hdr = it->hdr;
+      timestamp = it->tstamp;
+      return it->packet;
+    }
   for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
     {
       if (!it->hdr.IsQosData ()
@@ -393,4 +446,183 @@ WifiMacQueue::PeekAvailable (WifiMacHeader *hdr, Time &timestamp,
   return 0;
 }
 
+void
+WifiMacQueue::SetStationFairQueueing (bool enable)
+{
+  m_stationFair = enable;
+  m_flows.clear ();
+  if (!m_stationFair)
+    {
+      return;
+    }
+  for (std::map<Mac48Address, Station>::iterator it = m_stations.begin (); it != m_stations.end (); ++it)
+    {
+      it->second.deficit = m_quantum;
+      it->second.flow = m_flows.insert (m_flows.end (), it->first);
+    }
+}
+
+bool
+WifiMacQueue::GetStationFairQueueing (void) const
+{
+  return m_stationFair;
+}
+
+void
+WifiMacQueue::SetDozingCallback (Callback<bool, Mac48Address> isDozing)
+{
+  m_isDozing = isDozing;
+}
+
+void
+WifiMacQueue::GetBufferedStations (std::set<Mac48Address> &stations)
+{
+  Cleanup ();
+  for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
+    {
+      stations.insert (it->hdr.GetAddr1 ());
+    }
+}
+
+void
+WifiMacQueue::SetBufferedCallback (Callback<void, Mac48Address, bool> buffered)
+{
+  m_buffered = buffered;
+  if (m_buffered.IsNull ())
+    {
+      return;
+    }
+  for (std::map<Mac48Address, Station>::const_iterator it = m_stations.begin (); it != m_stations.end (); ++it)
+    {
+      m_buffered (it->first, true);
+    }
+}
+
+void
+WifiMacQueue::RemoveExpired (void)
+{
+  Cleanup ();
+}
+
+void
+WifiMacQueue::NotifyQueued (const WifiMacHeader &hdr)
+{
+  std::pair<std::map<Mac48Address, Station>::iterator, bool> inserted =
+    m_stations.insert (std::make_pair (hdr.GetAddr1 (), Station ()));
+  Station &station = inserted.first->second;
+  if (!inserted.second)
+    {
+      station.packets++;
+      return;
+    }
+  station.packets = 1;
+  station.deficit = m_quantum;
+  station.selection = 0;
+  if (m_stationFair)
+    {
+      station.flow = m_flows.insert (m_flows.end (), hdr.GetAddr1 ());
+    }
+  if (!m_buffered.IsNull ())
+    {
+      m_buffered (hdr.GetAddr1 (), true);
+    }
+}
+
+void
+WifiMacQueue::NotifyRemoved (const WifiMacHeader &hdr)
+{
+  std::map<Mac48Address, Station>::iterator it = m_stations.find (hdr.GetAddr1 ());
+  NS_ASSERT (it != m_stations.end () && it->second.packets > 0);
+  if (--it->second.packets > 0)
+    {
+      return;
+    }
+  // stations without any queued packet leave the round robin
+  if (m_stationFair)
+    {
+      m_flows.erase (it->second.flow);
+    }
+  m_stations.erase (it);
+  if (!m_buffered.IsNull ())
+    {
+      m_buffered (hdr.GetAddr1 (), false);
+    }
+}
+
+WifiMacQueue::PacketQueueI
+WifiMacQueue::SelectStationFair (const QosBlockedDestinations *blockedPackets,
+                                 uint32_t *rounds, uint32_t *position)
+{
+  // first available packet of every station which is awake
+  m_selection++;
+  for (PacketQueueI it = m_queue.begin (); it != m_queue.end (); it++)
+    {
+      Mac48Address dest = it->hdr.GetAddr1 ();
+      Station &station = m_stations.find (dest)->second;
+      if (station.selection != m_selection)
+        {
+          station.selection = m_selection;
+          station.available = false;
+          station.dozing = !dest.IsGroup () && !m_isDozing.IsNull () && m_isDozing (dest);
+        }
+      if (station.available || station.dozing)
+        {
+          continue;
+        }
+      if (it->hdr.IsQosData ()
+          && blockedPackets->IsBlocked (dest, it->hdr.GetQosTid ()))
+        {
+          continue;
+        }
+      station.available = true;
+      station.head = it;
+    }
+
+  // every turn of the round robin credits a quantum to each station with
+  // an available packet, the first station whose deficit covers its
+  // packet being served
+  PacketQueueI selected = m_queue.end ();
+  uint32_t p = 0;
+  for (std::list<Mac48Address>::const_iterator i = m_flows.begin (); i != m_flows.end (); i++, p++)
+    {
+      const Station &station = m_stations.find (*i)->second;
+      if (station.selection != m_selection || !station.available)
+        {
+          continue;
+        }
+      uint32_t size = station.head->packet->GetSize ();
+      uint32_t r = station.deficit >= size ? 0 : (size - station.deficit + m_quantum - 1) / m_quantum;
+      if (selected == m_queue.end () || r < *rounds)
+        {
+          selected = station.head;
+          *rounds = r;
+          *position = p;
+        }
+    }
+  return selected;
+}
+
+void
+WifiMacQueue::ServeStationFair (uint32_t rounds, uint32_t position, uint32_t size)
+{
+  std::list<Mac48Address>::iterator served = m_flows.begin ();
+  uint32_t p = 0;
+  for (std::list<Mac48Address>::iterator i = m_flows.begin (); i != m_flows.end (); i++, p++)
+    {
+      Station &station = m_stations.find (*i)->second;
+      if (station.selection != m_selection || !station.available)
+        {
+          continue;
+        }
+      // the stations before the served one were passed over one more time
+      station.deficit += m_quantum * (p < position ? rounds + 1 : rounds);
+      if (p == position)
+        {
+          station.deficit -= size;
+          served = i;
+        }
+    }
+  m_flows.splice (m_flows.end (), m_flows, m_flows.begin (), served);
+}
+
 } //namespace ns3
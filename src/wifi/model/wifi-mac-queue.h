@@ -24,12 +24,15 @@
 #define WIFI_MAC_QUEUE_H
 
 #include <list>
+#include <map>
+#include <set>
 #include <utility>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "wifi-mac-header.h"
 #include "ns3/traced-callback.h"
+#include "ns3/callback.h"
 #include "drop-reason.h"
 
 namespace ns3 {
@@ -226,6 +229,49 @@ public:
    */
   uint32_t GetSize (void);
 
+  /**
+   * Enable or disable the per-station deficit round robin scheduling of
+   * DequeueFirstAvailable and PeekFirstAvailable. When enabled, packets
+   * are served station by station (address 1) in round robin, each
+   * station sending up to Quantum bytes per round, and the packets of a
+   * dozing station are held without blocking those queued behind them.
+   * When disabled (the default) the queue is served in FIFO order.
+   *
+   * \param enable true to enable the per-station scheduling
+   */
+  void SetStationFairQueueing (bool enable);
+  /**
+   * \return true if the per-station scheduling is enabled
+   */
+  bool GetStationFairQueueing (void) const;
+  /**
+   * \param isDozing callback telling whether a station is in doze state,
+   *        used by the per-station scheduling
+   */
+  void SetDozingCallback (Callback<bool, Mac48Address> isDozing);
+  /**
+   * Add the receiver address (address 1) of every queued packet to
+   * <i>stations</i>, after removing the expired packets. This allows to
+   * build the traffic indication map with one pass over the queue.
+   *
+   * \param stations the set to which the addresses are added
+   */
+  void GetBufferedStations (std::set<Mac48Address> &stations);
+  /**
+   * \param buffered callback invoked with the receiver address (address 1)
+   *        of a packet when the queue gets its first packet for this
+   *        address (true) and when it loses its last one (false). This
+   *        allows to keep the traffic indication map up to date without
+   *        scanning the queue.
+   */
+  void SetBufferedCallback (Callback<void, Mac48Address, bool> buffered);
+  /**
+   * Remove the packets that exceeded the maximum delay, so that the
+   * stations notified to the buffered callback only have packets that
+   * can still be sent.
+   */
+  void RemoveExpired (void);
+
 
 protected:
   /**
@@ -275,12 +321,71 @@ protected:
    * \return the address
    */
   Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI it);
+  /**
+   * The state of a station (address 1) with queued packets.
+   */
+  struct Station
+  {
+    uint32_t packets;                       //!< number of queued packets
+    uint32_t deficit;                       //!< deficit counter of the per-station scheduling
+    std::list<Mac48Address>::iterator flow; //!< position in m_flows, if the per-station scheduling is enabled
+    uint64_t selection;                     //!< last selection which looked at the station
+    bool dozing;                            //!< station dozing at this selection
+    bool available;                         //!< station with a packet available at this selection
+    PacketQueueI head;                      //!< first available packet at this selection
+  };
+  /**
+   * Deficit round robin selection among the stations which have a packet
+   * available. The deficits and the order of the round robin are left
+   * untouched, so that peeking does not change which station is served:
+   * the rounds of the round robin the selection took are returned, to be
+   * applied by ServeStationFair when the packet is dequeued.
+   *
+   * \param blockedPackets the destinations waiting for a block ack agreement
+   * \param rounds where the number of quanta each station is credited is stored
+   * \param position where the position in m_flows of the served station is stored
+   * \return the packet to serve, or the end of the queue if none
+   */
+  PacketQueueI SelectStationFair (const QosBlockedDestinations *blockedPackets,
+                                  uint32_t *rounds, uint32_t *position);
+  /**
+   * Credit the stations of the round robin as the last SelectStationFair
+   * did, charge the served station for its packet and move it to the
+   * front of the round robin.
+   *
+   * \param rounds the rounds returned by SelectStationFair
+   * \param position the position returned by SelectStationFair
+   * \param size the size of the served packet
+   */
+  void ServeStationFair (uint32_t rounds, uint32_t position, uint32_t size);
+  /**
+   * Count a packet added to the queue for the buffered callback and the
+   * per-station scheduling.
+   *
+   * \param hdr the header of the packet
+   */
+  void NotifyQueued (const WifiMacHeader &hdr);
+  /**
+   * Count a packet removed from the queue for the buffered callback and
+   * the per-station scheduling.
+   *
+   * \param hdr the header of the packet
+   */
+  void NotifyRemoved (const WifiMacHeader &hdr);
 
   PacketQueue m_queue; //!< Packet (struct Item) queue
   uint32_t m_size;     //!< Current queue size
   uint32_t m_maxSize;  //!< Queue capacity
   Time m_maxDelay;     //!< Time to live for packets in the queue
 
+  bool m_stationFair;                           //!< per-station scheduling enabled
+  uint32_t m_quantum;                           //!< bytes per station and round
+  Callback<bool, Mac48Address> m_isDozing;      //!< doze state of a station
+  std::list<Mac48Address> m_flows;              //!< round robin list of the stations with queued packets
+  uint64_t m_selection;                         //!< number of selections of the per-station scheduling
+  Callback<void, Mac48Address, bool> m_buffered; //!< buffered state of a station changed
+  std::map<Mac48Address, Station> m_stations;   //!< stations with queued packets
+
   TracedCallback<Ptr<const Packet>, DropReason> m_packetdropped;
 };
 
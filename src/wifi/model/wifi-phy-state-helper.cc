@@ -120,6 +120,7 @@ void
 WifiPhyStateHelper::RegisterListener (WifiPhyListener *listener)
 {
   m_listeners.push_back (listener);
+  UpdateDispatchTable ();
 }
 
 void
@@ -130,6 +131,27 @@ WifiPhyStateHelper::UnregisterListener (WifiPhyListener *listener)
     {
       m_listeners.erase (i);
     }
+  UpdateDispatchTable ();
+}
+
+void
+WifiPhyStateHelper::UpdateDispatchTable (void)
+{
+  for (uint32_t index = 0; index < N_NOTIFICATIONS; index++)
+    {
+      m_dispatch[index].clear ();
+    }
+  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+    {
+      uint32_t mask = (*i)->GetNotificationMask ();
+      for (uint32_t index = 0; index < N_NOTIFICATIONS; index++)
+        {
+          if (mask & (1 << index))
+            {
+              m_dispatch[index].push_back (*i);
+            }
+        }
+    }
 }
 
 bool
@@ -253,57 +275,78 @@ WifiPhyStateHelper::GetState (void)
 void
 WifiPhyStateHelper::NotifyTxStart (Time duration, double txPowerDbm)
 {
-  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+  const Listeners &listeners = m_dispatch[TX_START_INDEX];
+  for (Listeners::const_iterator i = listeners.begin (); i != listeners.end (); i++)
     {
       (*i)->NotifyTxStart (duration, txPowerDbm);
     }
-    m_TxStart (Simulator::Now (), duration, WifiPhy::TX);
+  if (!m_TxStart.IsEmpty ())
+    {
+      m_TxStart (Simulator::Now (), duration, WifiPhy::TX);
+    }
 }
 
 void
 WifiPhyStateHelper::NotifyRxStart (Time duration)
 {
-  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+  const Listeners &listeners = m_dispatch[RX_START_INDEX];
+  for (Listeners::const_iterator i = listeners.begin (); i != listeners.end (); i++)
     {
       (*i)->NotifyRxStart (duration);
     }
-   m_RxStart (Simulator::Now (), duration, WifiPhy::TX);
+  if (!m_RxStart.IsEmpty ())
+    {
+      m_RxStart (Simulator::Now (), duration, WifiPhy::TX);
+    }
 }
 
 void
 WifiPhyStateHelper::NotifyRxEndOk (void)
 {
-  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+  const Listeners &listeners = m_dispatch[RX_END_OK_INDEX];
+  for (Listeners::const_iterator i = listeners.begin (); i != listeners.end (); i++)
     {
       (*i)->NotifyRxEndOk ();
     }
-  m_RxEndOk (Simulator::Now (), Simulator::Now (), WifiPhy::RX);
+  if (!m_RxEndOk.IsEmpty ())
+    {
+      m_RxEndOk (Simulator::Now (), Simulator::Now (), WifiPhy::RX);
+    }
 }
 
 void
 WifiPhyStateHelper::NotifyRxEndError (void)
 {
-  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+  const Listeners &listeners = m_dispatch[RX_END_ERROR_INDEX];
+  for (Listeners::const_iterator i = listeners.begin (); i != listeners.end (); i++)
     {
       (*i)->NotifyRxEndError ();
     }
-  m_RxEndError (Simulator::Now (), Simulator::Now (), WifiPhy::RX);
+  if (!m_RxEndError.IsEmpty ())
+    {
+      m_RxEndError (Simulator::Now (), Simulator::Now (), WifiPhy::RX);
+    }
 }
 
 void
 WifiPhyStateHelper::NotifyMaybeCcaBusyStart (Time duration)
 {
-  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+  const Listeners &listeners = m_dispatch[MAYBE_CCA_BUSY_START_INDEX];
+  for (Listeners::const_iterator i = listeners.begin (); i != listeners.end (); i++)
     {
       (*i)->NotifyMaybeCcaBusyStart (duration);
     }
-   m_CcaBusyStart (Simulator::Now (), duration, WifiPhy::CCA_BUSY);
+  if (!m_CcaBusyStart.IsEmpty ())
+    {
+      m_CcaBusyStart (Simulator::Now (), duration, WifiPhy::CCA_BUSY);
+    }
 }
 
 void
 WifiPhyStateHelper::NotifySwitchingStart (Time duration)
 {
-  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+  const Listeners &listeners = m_dispatch[SWITCHING_START_INDEX];
+  for (Listeners::const_iterator i = listeners.begin (); i != listeners.end (); i++)
     {
       (*i)->NotifySwitchingStart (duration);
     }
@@ -312,7 +355,8 @@ WifiPhyStateHelper::NotifySwitchingStart (Time duration)
 void
 WifiPhyStateHelper::NotifySleep (void)
 {
-  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+  const Listeners &listeners = m_dispatch[SLEEP_INDEX];
+  for (Listeners::const_iterator i = listeners.begin (); i != listeners.end (); i++)
     {
       (*i)->NotifySleep ();
     }
@@ -321,7 +365,8 @@ WifiPhyStateHelper::NotifySleep (void)
 void
 WifiPhyStateHelper::NotifyWakeup (void)
 {
-  for (Listeners::const_iterator i = m_listeners.begin (); i != m_listeners.end (); i++)
+  const Listeners &listeners = m_dispatch[WAKEUP_INDEX];
+  for (Listeners::const_iterator i = listeners.begin (); i != listeners.end (); i++)
     {
       (*i)->NotifyWakeup ();
     }
@@ -330,6 +375,10 @@ WifiPhyStateHelper::NotifyWakeup (void)
 void
 WifiPhyStateHelper::LogPreviousIdleAndCcaBusyStates (void)
 {
+  if (m_stateLogger.IsEmpty ())
+    {
+      return;
+    }
   Time now = Simulator::Now ();
   Time idleStart = Max (m_endCcaBusy, m_endRx);
   idleStart = Max (idleStart, m_endTx);
@@ -481,6 +530,26 @@ WifiPhyStateHelper::SwitchFromRxEndOk (Ptr<Packet> packet, double snr, WifiTxVec
 
 }
 
+void
+WifiPhyStateHelper::ReportRxOk (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_rxOkTrace (packet, snr, txVector.GetMode (), preamble);
+  if (!m_rxOkCallback.IsNull ())
+    {
+      m_rxOkCallback (packet, snr, txVector, preamble);
+    }
+}
+
+void
+WifiPhyStateHelper::ReportRxError (Ptr<const Packet> packet, double snr)
+{
+  m_rxErrorTrace (packet, snr);
+  if (!m_rxErrorCallback.IsNull ())
+    {
+      m_rxErrorCallback (packet, snr);
+    }
+}
+
 void
 WifiPhyStateHelper::SwitchFromRxEndError (Ptr<const Packet> packet, double snr)
 {
@@ -493,6 +562,17 @@ WifiPhyStateHelper::SwitchFromRxEndError (Ptr<const Packet> packet, double snr)
     }
 }
 
+void
+WifiPhyStateHelper::SwitchFromRxAbort (void)
+{
+  NS_ASSERT (IsStateRx ());
+  //the medium stays busy: the listeners see the end of a reception
+  //without error, followed by the start of the new one
+  NotifyRxEndOk ();
+  m_endRx = Simulator::Now ();
+  DoSwitchFromRx ();
+}
+
 void
 WifiPhyStateHelper::DoSwitchFromRx (void)
 {
@@ -510,8 +590,12 @@ WifiPhyStateHelper::DoSwitchFromRx (void)
 void
 WifiPhyStateHelper::SwitchMaybeToCcaBusy (Time duration)
 {
-  NotifyMaybeCcaBusyStart (duration);
   Time now = Simulator::Now ();
+  if (now + duration > m_endCcaBusy)
+    {
+      //the listeners already know about a busy medium until m_endCcaBusy
+      NotifyMaybeCcaBusyStart (duration);
+    }
   switch (GetState ())
     {
     case WifiPhy::SWITCHING:
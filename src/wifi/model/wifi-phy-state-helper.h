@@ -170,7 +170,32 @@ public:
    */
   void SwitchFromRxEndError (Ptr<const Packet> packet, double snr);
   /**
-   * Switch to CCA busy.
+   * Switch from RX when the reception is given up for a stronger frame,
+   * which the PHY synchronizes to right after.
+   */
+  void SwitchFromRxAbort (void);
+  /**
+   * Report a packet received while the state is left unchanged: a packet
+   * sent on a resource unit in parallel with the reception the PHY is
+   * synchronized to, or an MPDU of an A-MPDU but the last one.
+   *
+   * \param packet the successfully received packet
+   * \param snr the SNR of the received packet
+   * \param txVector TXVECTOR of the packet
+   * \param preamble the preamble of the received packet
+   */
+  void ReportRxOk (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+  /**
+   * Report a packet that we failed to receive while the state is left
+   * unchanged, i.e. an MPDU of an A-MPDU but the last one.
+   *
+   * \param packet the packet that we failed to received
+   * \param snr the SNR of the received packet
+   */
+  void ReportRxError (Ptr<const Packet> packet, double snr);
+  /**
+   * Switch to CCA busy. The listeners are only notified when the busy
+   * period ends after the one they already know about.
    *
    * \param duration the duration of CCA busy state
    */
@@ -244,6 +269,28 @@ private:
   typedef std::vector<WifiPhyListener *> Listeners;
   typedef std::vector<WifiPhyListener *>::iterator ListenersI;
 
+  /**
+   * Index of each notification in the dispatch table. The order
+   * matches the bit order of WifiPhyListener::NotificationMask.
+   */
+  enum NotificationIndex
+  {
+    RX_START_INDEX = 0,
+    RX_END_OK_INDEX,
+    RX_END_ERROR_INDEX,
+    TX_START_INDEX,
+    MAYBE_CCA_BUSY_START_INDEX,
+    SWITCHING_START_INDEX,
+    SLEEP_INDEX,
+    WAKEUP_INDEX,
+    N_NOTIFICATIONS
+  };
+
+  /**
+   * Rebuild the per-notification dispatch table from m_listeners.
+   */
+  void UpdateDispatchTable (void);
+
   /**
    * Log the ideal and CCA states.
    */
@@ -311,6 +358,11 @@ private:
   Time m_previousStateChangeTime;
 
   Listeners m_listeners;
+  /**
+   * For each notification, the listeners whose notification mask
+   * requested it, so that a transition only reaches interested listeners.
+   */
+  Listeners m_dispatch[N_NOTIFICATIONS];
   TracedCallback<Ptr<const Packet>, double, WifiMode, enum WifiPreamble> m_rxOkTrace;
   TracedCallback<Ptr<const Packet>, double> m_rxErrorTrace;
   TracedCallback<Ptr<const Packet>,WifiMode,WifiPreamble,uint8_t> m_txTrace;
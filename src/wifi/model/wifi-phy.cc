@@ -44,6 +44,12 @@ WifiPhyListener::~WifiPhyListener ()
 {
 }
 
+uint32_t
+WifiPhyListener::GetNotificationMask (void) const
+{
+  return NOTIFY_ALL;
+}
+
 /****************************************************************
  *       The actual WifiPhy class
  ****************************************************************/
@@ -824,6 +830,32 @@ WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txvector, WifiPreamble
   return duration;
 }
 
+void
+WifiPhy::SendAmpdu (const std::vector<Ptr<const Packet> > &mpdus, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  NS_LOG_FUNCTION (this << mpdus.size () << txVector << preamble);
+  Time delay = Seconds (0);
+  for (uint32_t i = 0; i < mpdus.size (); i++)
+    {
+      //the first MPDU is never the last one, even in an A-MPDU of a single MPDU
+      uint8_t packetType = (i == 0 || i + 1 < mpdus.size ()) ? 1 : 2;
+      if (delay == Seconds (0))
+        {
+          NS_LOG_DEBUG ("Sending MPDU as part of A-MPDU");
+          SendPacket (mpdus[i], txVector, preamble, packetType);
+        }
+      else
+        {
+          Simulator::Schedule (delay, &WifiPhy::SendPacket, this, mpdus[i], txVector, preamble, packetType);
+        }
+      if (i + 1 < mpdus.size ())
+        {
+          delay = delay + CalculateTxDuration (mpdus[i]->GetSize (), txVector, preamble, GetFrequency (), packetType, 0);
+        }
+      preamble = WIFI_PREAMBLE_NONE;  //need to check 802.11ah
+    }
+}
+
 void
 WifiPhy::NotifyTxBegin (Ptr<const Packet> packet)
 {
@@ -22,6 +22,7 @@
 #define WIFI_PHY_H
 
 #include <stdint.h>
+#include <vector>
 #include "ns3/callback.h"
 #include "ns3/packet.h"
 #include "ns3/object.h"
@@ -45,8 +46,34 @@ class NetDevice;
 class WifiPhyListener
 {
 public:
+  /**
+   * Bits identifying the notifications a listener wants to receive.
+   */
+  enum NotificationMask
+  {
+    NOTIFY_RX_START = (1 << 0),
+    NOTIFY_RX_END_OK = (1 << 1),
+    NOTIFY_RX_END_ERROR = (1 << 2),
+    NOTIFY_TX_START = (1 << 3),
+    NOTIFY_MAYBE_CCA_BUSY_START = (1 << 4),
+    NOTIFY_SWITCHING_START = (1 << 5),
+    NOTIFY_SLEEP = (1 << 6),
+    NOTIFY_WAKEUP = (1 << 7),
+    NOTIFY_ALL = 0xff
+  };
+
   virtual ~WifiPhyListener ();
 
+  /**
+   * The mask is read once when the listener is registered with the
+   * WifiPhyStateHelper; notifications outside the mask are never
+   * dispatched to this listener. By default all notifications are
+   * delivered.
+   *
+   * \return a combination of NotificationMask bits
+   */
+  virtual uint32_t GetNotificationMask (void) const;
+
   /**
    * \param duration the expected duration of the packet reception.
    *
@@ -217,6 +244,16 @@ public:
    * \param packetType the type of the packet 0 is not A-MPDU, 1 is a MPDU that is part of an A-MPDU and 2 is the last MPDU in an A-MPDU
    */
   virtual void SendPacket (Ptr<const Packet> packet, WifiTxVector txvector, enum WifiPreamble preamble, uint8_t packetType) = 0;
+  /**
+   * Send the MPDUs of an A-MPDU. By default, each MPDU is given to
+   * SendPacket when the previous one ends, the first one with the
+   * preamble and the next ones without preamble.
+   *
+   * \param mpdus the MPDUs, with their A-MPDU subframe header and padding
+   * \param txvector the txvector of the A-MPDU
+   * \param preamble the type of preamble to use to send the A-MPDU
+   */
+  virtual void SendAmpdu (const std::vector<Ptr<const Packet> > &mpdus, WifiTxVector txvector, enum WifiPreamble preamble);
 
   /**
    * \param listener the new listener
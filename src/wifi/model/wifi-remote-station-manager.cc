@@ -346,7 +346,8 @@ WifiRemoteStationManager::GetTypeId (void)
 }
 
 WifiRemoteStationManager::WifiRemoteStationManager ()
-  : m_htSupported (false)
+  : m_basicModesGeneration (0),
+    m_htSupported (false)
 {
 }
 
@@ -1491,6 +1492,7 @@ WifiRemoteStationManager::Reset (void)
   m_stations.clear ();
   m_bssBasicRateSet.clear ();
   m_bssBasicRateSet.push_back (m_defaultTxMode);
+  m_basicModesGeneration++;
   m_bssBasicMcsSet.clear ();
   m_bssBasicMcsSet.push_back (m_defaultTxMcs);
   NS_ASSERT (m_defaultTxMode.IsMandatory ());
@@ -1512,6 +1514,7 @@ WifiRemoteStationManager::AddBasicMode (WifiMode mode)
         }
     }
   m_bssBasicRateSet.push_back (mode);
+  m_basicModesGeneration++;
 }
 
 uint32_t
@@ -1520,6 +1523,12 @@ WifiRemoteStationManager::GetNBasicModes (void) const
   return m_bssBasicRateSet.size ();
 }
 
+uint32_t
+WifiRemoteStationManager::GetBasicModesGeneration (void) const
+{
+  return m_basicModesGeneration;
+}
+
 WifiMode
 WifiRemoteStationManager::GetBasicMode (uint32_t i) const
 {
@@ -203,6 +203,14 @@ public:
    * \return the number of basic modes we support
    */
   uint32_t GetNBasicModes (void) const;
+  /**
+   * Return the generation of the set of basic modes. It changes each
+   * time the set changes, so that a copy of the set can be checked
+   * for staleness.
+   *
+   * \return the generation of the set of basic modes
+   */
+  uint32_t GetBasicModesGeneration (void) const;
   /**
    * Return a basic mode from the set of basic modes.
    *
@@ -1037,6 +1045,7 @@ private:
    */
   WifiModeList m_bssBasicRateSet;
   WifiMcsList m_bssBasicMcsSet;
+  uint32_t m_basicModesGeneration; //!< Number of changes of m_bssBasicRateSet
 
   StationStates m_states;  //!< States of known stations
   Stations m_stations;     //!< Information for each known stations
@@ -21,6 +21,7 @@
 
 #include "ns3/wifi-tx-vector.h"
 #include "ns3/fatal-error.h"
+#include "ns3/assert.h"
 
 namespace ns3 {
 
@@ -30,6 +31,8 @@ WifiTxVector::WifiTxVector ()
     m_nss (1),
     m_ness (0),
     m_stbc (false),
+    m_ruIndex (0),
+    m_nRus (1),
     m_modeInitialized (false),
     m_txPowerLevelInitialized (false)
 {
@@ -44,6 +47,8 @@ WifiTxVector::WifiTxVector (WifiMode mode, uint8_t powerLevel, uint8_t retries,
     m_nss (nss),
     m_ness (ness),
     m_stbc (stbc),
+    m_ruIndex (0),
+    m_nRus (1),
     m_modeInitialized (true),
     m_txPowerLevelInitialized (true)
 {
@@ -143,6 +148,26 @@ WifiTxVector::SetStbc (bool stbc)
   m_stbc = stbc;
 }
 
+void
+WifiTxVector::SetRu (uint8_t ruIndex, uint8_t nRus)
+{
+  NS_ASSERT (ruIndex < nRus);
+  m_ruIndex = ruIndex;
+  m_nRus = nRus;
+}
+
+uint8_t
+WifiTxVector::GetRuIndex (void) const
+{
+  return m_ruIndex;
+}
+
+uint8_t
+WifiTxVector::GetNRus (void) const
+{
+  return m_nRus;
+}
+
 std::ostream & operator << ( std::ostream &os, const WifiTxVector &v)
 {
   os << "mode:" << v.GetMode () <<
@@ -152,6 +177,10 @@ std::ostream & operator << ( std::ostream &os, const WifiTxVector &v)
     " Nss: " << (uint32_t)v.GetNss () <<
     " Ness: " << (uint32_t)v.GetNess () <<
     " STBC: " << v.IsStbc ();
+  if (v.GetNRus () > 1)
+    {
+      os << " RU: " << (uint32_t)v.GetRuIndex () << "/" << (uint32_t)v.GetNRus ();
+    }
   return os;
 }
 
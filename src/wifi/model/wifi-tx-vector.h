@@ -147,6 +147,23 @@ public:
    * \param stbc enable or disable STBC
    */
   void SetStbc (bool stbc);
+  /**
+   * Restrict the transmission to one resource unit (RU) of the
+   * channel, as done for the uplink PPDUs solicited by a trigger frame.
+   *
+   * \param ruIndex the index of the RU
+   * \param nRus the number of RUs the channel is split into
+   */
+  void SetRu (uint8_t ruIndex, uint8_t nRus);
+  /**
+   * \returns the index of the RU used for the transmission
+   */
+  uint8_t GetRuIndex (void) const;
+  /**
+   * \returns the number of RUs the channel is split into,
+   *          1 if the transmission uses the whole channel
+   */
+  uint8_t GetNRus (void) const;
 
 
 private:
@@ -163,6 +180,8 @@ private:
   uint8_t  m_nss;                /**< number of streams */
   uint8_t  m_ness;               /**< number of streams in beamforming */
   bool     m_stbc;               /**< STBC used or not */
+  uint8_t  m_ruIndex;            /**< RU index of the transmission */
+  uint8_t  m_nRus;               /**< number of RUs the channel is split into */
 
   bool     m_modeInitialized;         //*< Internal initialization flag */
   bool     m_txPowerLevelInitialized; //*< Internal initialization flag */
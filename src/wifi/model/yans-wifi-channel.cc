@@ -25,11 +25,17 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
 #include "ns3/object-factory.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
+#include "ampdu-ppdu.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
+#include <cmath>
+#include <cstdlib>
+#include <map>
 
 namespace ns3 {
 
@@ -52,6 +58,25 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("TileSize",
+                   "The size (m) of the square tiles the PHYs are partitioned into, "
+                   "0 to deliver every packet to every PHY.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_tileSize),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("NearTiles",
+                   "The PHYs of the tiles at most this number of tiles away from the one "
+                   "of the sender receive its packets; the other tiles only get the "
+                   "signal as interference.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&YansWifiChannel::m_nearTiles),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("FarTileThreshold",
+                   "The received power (dBm) below which a far tile does not get "
+                   "the signal as interference.",
+                   DoubleValue (-200.0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_farTileThreshold),
+                   MakeDoubleChecker<double> ())
 	.AddTraceSource("Transmission", "Fired when something is transmitted on the channel",
 				   MakeTraceSourceAccessor(&YansWifiChannel::m_channelTransmission), "ns3::YansWifiChannel::TransmissionCallback")
   ;
@@ -59,6 +84,7 @@ YansWifiChannel::GetTypeId (void)
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_tilesUpToDate (false)
 {
 }
 
@@ -86,45 +112,221 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
 
   m_channelTransmission(sender->GetDevice(), packet->Copy());
 
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++, j++)
+  if (m_tileSize > 0)
     {
-      if (sender != (*i))
+      UpdateTiles ();
+      std::pair<int64_t, int64_t> center = GetTileCoordinates (senderMobility->GetPosition ());
+      for (uint32_t t = 0; t < m_tiles.size (); t++)
         {
-          //For now don't account for inter channel interference
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
+          if (!IsNearTile (t, center))
             {
+              ScheduleTileInterference (t, sender, senderMobility, txPowerDbm, txVector, duration);
               continue;
             }
+          for (std::vector<uint32_t>::const_iterator j = m_tiles[t].phys.begin (); j != m_tiles[t].phys.end (); j++)
+            {
+              ScheduleReceive (*j, sender, senderMobility, packet, txPowerDbm, txVector, preamble, packetType, duration);
+            }
+        }
+      return;
+    }
+  for (uint32_t j = 0; j < m_phyList.size (); j++)
+    {
+      ScheduleReceive (j, sender, senderMobility, packet, txPowerDbm, txVector, preamble, packetType, duration);
+    }
+}
+
+void
+YansWifiChannel::ScheduleReceive (uint32_t j, Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility,
+                                  Ptr<const Packet> packet, double txPowerDbm, WifiTxVector txVector,
+                                  WifiPreamble preamble, uint8_t packetType, Time duration) const
+{
+  Ptr<YansWifiPhy> receiver = m_phyList[j];
+  //For now don't account for inter channel interference
+  if (sender == receiver || receiver->GetChannelNumber () != sender->GetChannelNumber ())
+    {
+      return;
+    }
+
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+  Ptr<Packet> copy = packet->Copy ();
+
+  double *atts = new double[3];
+  *atts = rxPowerDbm;
+  *(atts + 1) = packetType;
+  *(atts + 2) = duration.GetNanoSeconds ();
+
+  Simulator::ScheduleWithContext (GetNodeId (j),
+                                  delay, &YansWifiChannel::Receive, this,
+                                  j, copy, atts, txVector, preamble);
+}
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
+void
+YansWifiChannel::SendAmpdu (Ptr<YansWifiPhy> sender, Ptr<const AmpduPpdu> ppdu, double txPowerDbm,
+                            WifiTxVector txVector, WifiPreamble preamble) const
+{
+  Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
+  NS_ASSERT (senderMobility != 0);
+
+  for (uint32_t k = 0; k < ppdu->GetNMpdus (); k++)
+    {
+      m_channelTransmission (sender->GetDevice (), ppdu->GetMpdu (k)->Copy ());
+    }
+
+  if (m_tileSize > 0)
+    {
+      UpdateTiles ();
+      std::pair<int64_t, int64_t> center = GetTileCoordinates (senderMobility->GetPosition ());
+      for (uint32_t t = 0; t < m_tiles.size (); t++)
+        {
+          if (!IsNearTile (t, center))
             {
-              dstNode = 0xffffffff;
+              ScheduleTileInterference (t, sender, senderMobility, txPowerDbm, txVector, ppdu->GetDuration ());
+              continue;
             }
-          else
+          for (std::vector<uint32_t>::const_iterator j = m_tiles[t].phys.begin (); j != m_tiles[t].phys.end (); j++)
             {
-              dstNode = dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+              ScheduleReceiveAmpdu (*j, sender, senderMobility, ppdu, txPowerDbm, txVector, preamble);
             }
+        }
+      return;
+    }
+  for (uint32_t j = 0; j < m_phyList.size (); j++)
+    {
+      ScheduleReceiveAmpdu (j, sender, senderMobility, ppdu, txPowerDbm, txVector, preamble);
+    }
+}
 
-          double *atts = new double[3];
-          *atts = rxPowerDbm;
-          *(atts + 1) = packetType;
-          *(atts + 2) = duration.GetNanoSeconds ();
+void
+YansWifiChannel::ScheduleReceiveAmpdu (uint32_t j, Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility,
+                                       Ptr<const AmpduPpdu> ppdu, double txPowerDbm, WifiTxVector txVector,
+                                       WifiPreamble preamble) const
+{
+  Ptr<YansWifiPhy> receiver = m_phyList[j];
+  //For now don't account for inter channel interference
+  if (sender == receiver || receiver->GetChannelNumber () != sender->GetChannelNumber ())
+    {
+      return;
+    }
+
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation of an A-MPDU of " << ppdu->GetNMpdus () << " MPDUs: txPower=" << txPowerDbm <<
+                "dbm, rxPower=" << rxPowerDbm << "dbm, delay=" << delay);
+
+  //the MPDUs are only copied by the receivers which deliver them
+  Simulator::ScheduleWithContext (GetNodeId (j),
+                                  delay, &YansWifiChannel::ReceiveAmpdu, this,
+                                  j, ppdu, rxPowerDbm, txVector, preamble);
+}
 
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive, this,
-                                          j, copy, atts, txVector, preamble);
+void
+YansWifiChannel::ScheduleTileInterference (uint32_t tile, Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility,
+                                           double txPowerDbm, WifiTxVector txVector, Time duration) const
+{
+  uint32_t j = m_tiles[tile].representative;
+  Ptr<MobilityModel> receiverMobility = m_phyList[j]->GetMobility ()->GetObject<MobilityModel> ();
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  if (rxPowerDbm < m_farTileThreshold)
+    {
+      return;
+    }
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation to the " << m_tiles[tile].phys.size () << " PHYs of tile (" <<
+                m_tiles[tile].coordinates.first << "," << m_tiles[tile].coordinates.second <<
+                "): txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, delay=" << delay);
+  Simulator::ScheduleWithContext (GetNodeId (j),
+                                  delay, &YansWifiChannel::ReceiveTile, this,
+                                  tile, sender, rxPowerDbm, txVector, duration);
+}
+
+uint32_t
+YansWifiChannel::GetNodeId (uint32_t j) const
+{
+  Ptr<Object> dstNetDevice = m_phyList[j]->GetDevice ();
+  if (dstNetDevice == 0)
+    {
+      return 0xffffffff;
+    }
+  return dstNetDevice->GetObject<NetDevice> ()->GetNode ()->GetId ();
+}
+
+std::pair<int64_t, int64_t>
+YansWifiChannel::GetTileCoordinates (const Vector &position) const
+{
+  return std::make_pair (static_cast<int64_t> (std::floor (position.x / m_tileSize)),
+                         static_cast<int64_t> (std::floor (position.y / m_tileSize)));
+}
+
+void
+YansWifiChannel::UpdateTiles (void) const
+{
+  if (m_tilesUpToDate)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this << m_phyList.size ());
+  m_tiles.clear ();
+  std::map<std::pair<int64_t, int64_t>, uint32_t> indexes;
+  for (uint32_t j = 0; j < m_phyList.size (); j++)
+    {
+      Vector position = m_phyList[j]->GetMobility ()->GetObject<MobilityModel> ()->GetPosition ();
+      std::pair<int64_t, int64_t> coordinates = GetTileCoordinates (position);
+      std::map<std::pair<int64_t, int64_t>, uint32_t>::iterator it = indexes.find (coordinates);
+      if (it == indexes.end ())
+        {
+          it = indexes.insert (std::make_pair (coordinates, m_tiles.size ())).first;
+          Tile tile;
+          tile.coordinates = coordinates;
+          tile.representative = j;
+          m_tiles.push_back (tile);
+        }
+      Tile &tile = m_tiles[it->second];
+      tile.phys.push_back (j);
+      Vector center ((coordinates.first + 0.5) * m_tileSize, (coordinates.second + 0.5) * m_tileSize, position.z);
+      Vector representative = m_phyList[tile.representative]->GetMobility ()->GetObject<MobilityModel> ()->GetPosition ();
+      if (CalculateDistance (position, center) < CalculateDistance (representative, center))
+        {
+          tile.representative = j;
+        }
+    }
+  NS_LOG_DEBUG (m_phyList.size () << " PHYs in " << m_tiles.size () << " tiles of " << m_tileSize << "m");
+  m_tilesUpToDate = true;
+}
+
+bool
+YansWifiChannel::IsNearTile (uint32_t tile, std::pair<int64_t, int64_t> center) const
+{
+  const std::pair<int64_t, int64_t> &coordinates = m_tiles[tile].coordinates;
+  return std::abs (coordinates.first - center.first) <= static_cast<int64_t> (m_nearTiles)
+         && std::abs (coordinates.second - center.second) <= static_cast<int64_t> (m_nearTiles);
+}
+
+void
+YansWifiChannel::ReceiveAmpdu (uint32_t i, Ptr<const AmpduPpdu> ppdu, double rxPowerDbm,
+                               WifiTxVector txVector, WifiPreamble preamble) const
+{
+  m_phyList[i]->StartReceiveAmpdu (ppdu, rxPowerDbm, txVector, preamble);
+}
+
+void
+YansWifiChannel::ReceiveTile (uint32_t tile, Ptr<YansWifiPhy> sender, double rxPowerDbm,
+                              WifiTxVector txVector, Time duration) const
+{
+  for (std::vector<uint32_t>::const_iterator j = m_tiles[tile].phys.begin (); j != m_tiles[tile].phys.end (); j++)
+    {
+      Ptr<YansWifiPhy> receiver = m_phyList[*j];
+      if (receiver != sender && receiver->GetChannelNumber () == sender->GetChannelNumber ())
+        {
+          receiver->StartReceiveInterference (rxPowerDbm, txVector, duration);
         }
     }
 }
@@ -153,6 +355,7 @@ void
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   m_phyList.push_back (phy);
+  m_tilesUpToDate = false;
 }
 
 int64_t
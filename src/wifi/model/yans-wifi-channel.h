@@ -29,6 +29,7 @@
 #include "wifi-preamble.h"
 #include "wifi-tx-vector.h"
 #include "ns3/nstime.h"
+#include "ns3/vector.h"
 #include "ns3/traced-callback.h"
 
 namespace ns3 {
@@ -37,6 +38,8 @@ class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
+class AmpduPpdu;
+class MobilityModel;
 
 /**
  * \brief A Yans wifi channel
@@ -49,6 +52,15 @@ class YansWifiPhy;
  * class and contains a ns3::PropagationLossModel and a ns3::PropagationDelayModel.
  * By default, no propagation models are set so, it is the caller's responsability
  * to set them before using the channel.
+ *
+ * With a positive TileSize, the PHYs are partitioned into square tiles
+ * of that size, from their positions at the first transmission after a
+ * PHY was added: the PHYs are assumed not to move. Only the PHYs in the
+ * tiles near the one of the sender receive the packets themselves. The
+ * other tiles only get the signal as interference, with a single event
+ * per tile and the received power of the PHY closest to the centre of
+ * the tile, so that the cost of a transmission grows with the number of
+ * tiles instead of the number of PHYs.
  */
 class YansWifiChannel : public WifiChannel
 {
@@ -96,6 +108,19 @@ public:
    */
   void Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
              WifiTxVector txVector, WifiPreamble preamble, uint8_t packetType, Time duration) const;
+  /**
+   * \param sender the device from which the A-MPDU is originating.
+   * \param ppdu the MPDUs of the A-MPDU
+   * \param txPowerDbm the tx power associated to the A-MPDU
+   * \param txVector the TXVECTOR associated to the A-MPDU
+   * \param preamble the preamble associated to the A-MPDU
+   *
+   * Deliver a whole A-MPDU to each PHY with a single event, instead of
+   * an event per MPDU with Send. This method should not be invoked by
+   * normal users. It is currently invoked only from YansWifiPhy::SendAmpdu.
+   */
+  void SendAmpdu (Ptr<YansWifiPhy> sender, Ptr<const AmpduPpdu> ppdu, double txPowerDbm,
+                  WifiTxVector txVector, WifiPreamble preamble) const;
 
   /**
    * Assign a fixed random variable stream number to the random variables
@@ -127,11 +152,115 @@ private:
    */
   void Receive (uint32_t i, Ptr<Packet> packet, double *atts,
                 WifiTxVector txVector, WifiPreamble preamble) const;
+  /**
+   * This method is scheduled by SendAmpdu for each associated YansWifiPhy.
+   *
+   * \param i index of the corresponding YansWifiPhy in the PHY list
+   * \param ppdu the MPDUs of the A-MPDU
+   * \param rxPowerDbm the received power in dBm
+   * \param txVector the TXVECTOR of the A-MPDU
+   * \param preamble the type of preamble being used to send the A-MPDU
+   */
+  void ReceiveAmpdu (uint32_t i, Ptr<const AmpduPpdu> ppdu, double rxPowerDbm,
+                     WifiTxVector txVector, WifiPreamble preamble) const;
+  /**
+   * This method is scheduled by Send and SendAmpdu for each tile far from
+   * the sender. It adds the signal as interference to the PHYs of the tile.
+   *
+   * \param tile index of the tile in the tile list
+   * \param sender the PHY sending the signal
+   * \param rxPowerDbm the received power in dBm
+   * \param txVector the TXVECTOR of the signal
+   * \param duration the duration of the signal
+   */
+  void ReceiveTile (uint32_t tile, Ptr<YansWifiPhy> sender, double rxPowerDbm,
+                    WifiTxVector txVector, Time duration) const;
+
+  /**
+   * Schedule the reception of a packet by a PHY.
+   *
+   * \param j index of the receiving YansWifiPhy in the PHY list
+   * \param sender the PHY sending the packet
+   * \param senderMobility the mobility model of the sender
+   * \param packet the packet being sent
+   * \param txPowerDbm the tx power associated to the packet
+   * \param txVector the TXVECTOR of the packet
+   * \param preamble the preamble of the packet
+   * \param packetType the type of packet
+   * \param duration the transmission duration of the packet
+   */
+  void ScheduleReceive (uint32_t j, Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility,
+                        Ptr<const Packet> packet, double txPowerDbm, WifiTxVector txVector,
+                        WifiPreamble preamble, uint8_t packetType, Time duration) const;
+  /**
+   * Schedule the reception of an A-MPDU by a PHY.
+   *
+   * \param j index of the receiving YansWifiPhy in the PHY list
+   * \param sender the PHY sending the A-MPDU
+   * \param senderMobility the mobility model of the sender
+   * \param ppdu the MPDUs of the A-MPDU
+   * \param txPowerDbm the tx power associated to the A-MPDU
+   * \param txVector the TXVECTOR of the A-MPDU
+   * \param preamble the preamble of the A-MPDU
+   */
+  void ScheduleReceiveAmpdu (uint32_t j, Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility,
+                             Ptr<const AmpduPpdu> ppdu, double txPowerDbm, WifiTxVector txVector,
+                             WifiPreamble preamble) const;
+  /**
+   * Schedule the interference of a signal in a tile far from the sender.
+   *
+   * \param tile index of the tile in the tile list
+   * \param sender the PHY sending the signal
+   * \param senderMobility the mobility model of the sender
+   * \param txPowerDbm the tx power associated to the signal
+   * \param txVector the TXVECTOR of the signal
+   * \param duration the duration of the signal
+   */
+  void ScheduleTileInterference (uint32_t tile, Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility,
+                                 double txPowerDbm, WifiTxVector txVector, Time duration) const;
+  /**
+   * \param j index of a YansWifiPhy in the PHY list
+   *
+   * \return the id of the node of the PHY, used as the context of its events
+   */
+  uint32_t GetNodeId (uint32_t j) const;
+  /**
+   * \param position a position
+   *
+   * \return the coordinates of the tile of the position
+   */
+  std::pair<int64_t, int64_t> GetTileCoordinates (const Vector &position) const;
+  /**
+   * Partition the PHYs into tiles, if a PHY was added since they were.
+   */
+  void UpdateTiles (void) const;
+  /**
+   * \param tile index of a tile in the tile list
+   * \param center the coordinates of the tile of the sender
+   *
+   * \return whether the PHYs of the tile receive the packets of the sender
+   */
+  bool IsNearTile (uint32_t tile, std::pair<int64_t, int64_t> center) const;
+
+  /**
+   * The PHYs of a square of the plane.
+   */
+  struct Tile
+  {
+    std::pair<int64_t, int64_t> coordinates; //!< coordinates of the tile
+    std::vector<uint32_t> phys;              //!< indexes of the PHYs in the tile
+    uint32_t representative;                 //!< index of the PHY closest to the centre
+  };
 
 
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_tileSize;                   //!< size of the tiles (m), 0 for no tiles
+  uint32_t m_nearTiles;                //!< distance in tiles of the tiles receiving the packets
+  double m_farTileThreshold;           //!< power (dBm) below which far tiles get no interference
+  mutable std::vector<Tile> m_tiles;   //!< the tiles with at least one PHY
+  mutable bool m_tilesUpToDate;        //!< whether every PHY is in m_tiles
 
   TracedCallback<Ptr<NetDevice>, Ptr<Packet>> m_channelTransmission;
 };
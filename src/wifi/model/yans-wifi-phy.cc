@@ -38,6 +38,7 @@
 #include "ns3/boolean.h"
 #include "ns3/node.h"
 #include "ampdu-tag.h"
+#include "ampdu-ppdu.h"
 #include <cmath>
 
 namespace ns3 {
@@ -189,6 +190,20 @@ YansWifiPhy::GetTypeId (void)
                    MakeUintegerAccessor (&YansWifiPhy::GetChannelWidth,
                                          &YansWifiPhy::SetChannelWidth),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("FrameCaptureModel",
+                   "The frame capture model deciding whether a frame arriving during a "
+                   "reception captures the PHY. Without one, these frames are dropped.",
+                   PointerValue (),
+                   MakePointerAccessor (&YansWifiPhy::GetFrameCaptureModel,
+                                        &YansWifiPhy::SetFrameCaptureModel),
+                   MakePointerChecker<FrameCaptureModel> ())
+    .AddAttribute ("SinglePpduAmpdu",
+                   "Whether the MPDUs of an A-MPDU are sent to the channel as a single PPDU, "
+                   "rather than as one transmission per MPDU. The MPDUs of the PPDU are then "
+                   "delivered to the MAC at the end of the PPDU.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&YansWifiPhy::m_singlePpduAmpdu),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -200,7 +215,8 @@ YansWifiPhy::YansWifiPhy ()
     m_endPlcpRxEvent (),
     m_channelStartingFrequency (0),
     m_mpdusNum (0),
-    m_plcpSuccess (false)
+    m_plcpSuccess (false),
+    m_singlePpduAmpdu (false)
 {
   NS_LOG_FUNCTION (this);
   m_random = CreateObject<UniformRandomVariable> ();
@@ -222,6 +238,10 @@ YansWifiPhy::DoDispose (void)
   m_device = 0;
   m_mobility = 0;
   m_state = 0;
+  m_currentEvent = 0;
+  m_currentPacket = 0;
+  m_currentPpdu = 0;
+  m_frameCaptureModel = 0;
 }
 
 void
@@ -334,6 +354,12 @@ YansWifiPhy::SetErrorRateModel (Ptr<ErrorRateModel> rate)
   m_interference.SetErrorRateModel (rate);
 }
 
+void
+YansWifiPhy::SetFrameCaptureModel (Ptr<FrameCaptureModel> capture)
+{
+  m_frameCaptureModel = capture;
+}
+
 void
 YansWifiPhy::SetDevice (Ptr<NetDevice> device)
 {
@@ -394,6 +420,12 @@ YansWifiPhy::GetErrorRateModel (void) const
   return m_interference.GetErrorRateModel ();
 }
 
+Ptr<FrameCaptureModel>
+YansWifiPhy::GetFrameCaptureModel (void) const
+{
+  return m_frameCaptureModel;
+}
+
 Ptr<NetDevice>
 YansWifiPhy::GetDevice (void) const
 {
@@ -474,6 +506,7 @@ switchChannel:
 
   NS_LOG_DEBUG ("switching channel " << m_channelNumber << " -> " << nch);
   m_state->SwitchToChannelSwitching (m_channelSwitchDelay);
+  AbortMuReceptions ();
   m_interference.EraseEvents ();
   /*
    * Needed here to be able to correctly sensed the medium for the first
@@ -524,6 +557,7 @@ YansWifiPhy::SetSleepMode (void)
     case YansWifiPhy::CCA_BUSY:
     case YansWifiPhy::IDLE:
       NS_LOG_DEBUG ("setting sleep mode");
+      AbortMuReceptions ();
       m_state->SwitchToSleep ();
       break;
     case YansWifiPhy::SLEEP:
@@ -595,17 +629,18 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
   Time preambleAndHeaderDuration = CalculatePlcpPreambleAndHeaderDuration (txVector, preamble);
 
   Ptr<InterferenceHelper::Event> event;
-  event = m_interference.Add (packet->GetSize (),
-                              txVector,
-                              preamble,
-                              rxDuration,
-                              rxPowerW);
+
+  if (m_frameCaptureModel != 0 && m_state->IsStateRx ())
+    {
+      MaybeCaptureNewFrame (txVector, preamble, rxPowerW);
+    }
 
   switch (m_state->GetState ())
     {
     case YansWifiPhy::SWITCHING:
       NS_LOG_DEBUG ("drop packet because of channel switching");
       NotifyRxDrop (packet);
+      m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
       m_plcpSuccess = false;
       /*
        * Packets received on the upcoming channel are added to the event list
@@ -623,9 +658,37 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
         }
       break;
     case YansWifiPhy::RX:
+      if (txVector.GetNRus () > 1
+          && m_currentEvent->GetTxVector ().GetNRus () == txVector.GetNRus ()
+          && m_currentEvent->GetTxVector ().GetRuIndex () != txVector.GetRuIndex ()
+          && rxPowerW > m_edThresholdW)
+        {
+          //the PPDU is orthogonal to the one being received: receive it in parallel
+          NS_LOG_DEBUG ("receive PPDU on RU " << (uint32_t)txVector.GetRuIndex () << " in parallel (power=" <<
+                        rxPowerW << "W)");
+          std::vector<EventId>::iterator it = m_endMuRxEvents.begin ();
+          while (it != m_endMuRxEvents.end ())
+            {
+              if (it->IsExpired ())
+                {
+                  it = m_endMuRxEvents.erase (it);
+                }
+              else
+                {
+                  it++;
+                }
+            }
+          event = m_interference.Add (packet->GetSize (), txVector, preamble, rxDuration, rxPowerW);
+          NotifyRxBegin (packet);
+          m_interference.NotifyMuRxStart ();
+          m_endMuRxEvents.push_back (Simulator::Schedule (rxDuration, &YansWifiPhy::EndReceiveMu, this,
+                                                          packet, preamble, event));
+          break;
+        }
       NS_LOG_DEBUG ("drop packet because already in Rx (power=" <<
                     rxPowerW << "W)");
       NotifyRxDrop (packet);
+      m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
       if (endRx > Simulator::Now () + m_state->GetDelayUntilIdle ())
         {
           //that packet will be noise _after_ the reception of the
@@ -637,6 +700,7 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
       NS_LOG_DEBUG ("drop packet because already in Tx (power=" <<
                     rxPowerW << "W)");
       NotifyRxDrop (packet);
+      m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
       if (endRx > Simulator::Now () + m_state->GetDelayUntilIdle ())
         {
           //that packet will be noise _after_ the transmission of the
@@ -655,12 +719,14 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
             {
               NS_LOG_DEBUG ("drop packet because no preamble has been received");
               NotifyRxDrop (packet);
+              m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
               goto maybeCcaBusy;
             }
           else if (preamble == WIFI_PREAMBLE_NONE && m_plcpSuccess == false) //A-MPDU reception fails
             {
               NS_LOG_DEBUG ("Drop MPDU because no plcp has been received");
               NotifyRxDrop (packet);
+              m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
               goto maybeCcaBusy;
             }
           else if (preamble != WIFI_PREAMBLE_NONE && packet->PeekPacketTag (ampduTag) && m_mpdusNum == 0)
@@ -689,6 +755,10 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
 
           NS_LOG_DEBUG ("sync to signal (power=" << rxPowerW << "W)");
           //sync to signal
+          event = m_interference.Add (packet->GetSize (), txVector, preamble, rxDuration, rxPowerW);
+          m_currentEvent = event;
+          m_currentPacket = packet;
+          m_currentPpdu = 0;
           m_state->SwitchToRx (rxDuration);
           NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
           NotifyRxBegin (packet);
@@ -712,6 +782,7 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
             //NS_LOG_UNCOND ("drop packet because signal power too Small (" <<
             //              rxPowerW << "<" << m_edThresholdW << ")");
           NotifyRxDrop (packet);
+          m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
           m_plcpSuccess = false;
           goto maybeCcaBusy;
         }
@@ -719,6 +790,7 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
     case YansWifiPhy::SLEEP:
       NS_LOG_DEBUG ("drop packet because in sleep mode");
       NotifyRxDrop (packet);
+      m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
       m_plcpSuccess = false;
       break;
     }
@@ -726,6 +798,172 @@ YansWifiPhy::StartReceivePreambleAndHeader (Ptr<Packet> packet,
   return;
 
 maybeCcaBusy:
+  MaybeCcaBusy ();
+}
+
+void
+YansWifiPhy::StartReceiveInterference (double rxPowerDbm,
+                                       WifiTxVector txVector,
+                                       Time rxDuration)
+{
+  NS_LOG_FUNCTION (this << rxPowerDbm << txVector.GetMode () << rxDuration);
+  rxPowerDbm += m_rxGainDb;
+  double rxPowerW = DbmToW (rxPowerDbm);
+  Time endRx = Simulator::Now () + rxDuration;
+
+  m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
+  switch (m_state->GetState ())
+    {
+    case YansWifiPhy::SWITCHING:
+    case YansWifiPhy::RX:
+    case YansWifiPhy::TX:
+      if (endRx > Simulator::Now () + m_state->GetDelayUntilIdle ())
+        {
+          MaybeCcaBusy ();
+        }
+      break;
+    case YansWifiPhy::CCA_BUSY:
+    case YansWifiPhy::IDLE:
+      MaybeCcaBusy ();
+      break;
+    case YansWifiPhy::SLEEP:
+      break;
+    }
+}
+
+void
+YansWifiPhy::StartReceiveAmpdu (Ptr<const AmpduPpdu> ppdu,
+                                double rxPowerDbm,
+                                WifiTxVector txVector,
+                                enum WifiPreamble preamble)
+{
+  NS_LOG_FUNCTION (this << ppdu->GetNMpdus () << rxPowerDbm << txVector.GetMode () << preamble);
+  rxPowerDbm += m_rxGainDb;
+  double rxPowerW = DbmToW (rxPowerDbm);
+  Time rxDuration = ppdu->GetDuration ();
+  Time endRx = Simulator::Now () + rxDuration;
+
+  if (m_frameCaptureModel != 0 && m_state->IsStateRx ())
+    {
+      MaybeCaptureNewFrame (txVector, preamble, rxPowerW);
+    }
+
+  switch (m_state->GetState ())
+    {
+    case YansWifiPhy::SWITCHING:
+    case YansWifiPhy::RX:
+    case YansWifiPhy::TX:
+      NS_LOG_DEBUG ("drop A-MPDU because not idle (power=" << rxPowerW << "W)");
+      for (uint32_t i = 0; i < ppdu->GetNMpdus (); i++)
+        {
+          NotifyRxDrop (ppdu->GetMpdu (i));
+        }
+      m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
+      if (m_state->IsStateSwitching ())
+        {
+          m_plcpSuccess = false;
+        }
+      if (endRx > Simulator::Now () + m_state->GetDelayUntilIdle ())
+        {
+          //the A-MPDU will be noise after the end of the current state
+          MaybeCcaBusy ();
+        }
+      break;
+    case YansWifiPhy::CCA_BUSY:
+    case YansWifiPhy::IDLE:
+      if (rxPowerW > m_edThresholdW)
+        {
+          NS_LOG_DEBUG ("sync to A-MPDU (power=" << rxPowerW << "W)");
+          Ptr<InterferenceHelper::Event> event;
+          event = m_interference.Add (ppdu->GetSize (), txVector, preamble, rxDuration, rxPowerW);
+          m_mpdusNum = 0;
+          m_currentEvent = event;
+          m_currentPacket = 0;
+          m_currentPpdu = ppdu;
+          m_state->SwitchToRx (rxDuration);
+          for (uint32_t i = 0; i < ppdu->GetNMpdus (); i++)
+            {
+              NotifyRxBegin (ppdu->GetMpdu (i));
+            }
+          m_interference.NotifyRxStart ();
+
+          NS_ASSERT (m_endPlcpRxEvent.IsExpired ());
+          m_endPlcpRxEvent = Simulator::Schedule (CalculatePlcpPreambleAndHeaderDuration (txVector, preamble),
+                                                  &YansWifiPhy::StartReceivePacket, this,
+                                                  ppdu->GetMpdu (0), txVector, preamble, 1, event);
+          NS_ASSERT (m_endRxEvent.IsExpired ());
+          m_endRxEvent = Simulator::Schedule (rxDuration, &YansWifiPhy::EndReceiveAmpdu, this,
+                                              ppdu, event);
+        }
+      else
+        {
+          NS_LOG_DEBUG ("drop A-MPDU because signal power too Small (" <<
+                        rxPowerW << "<" << m_edThresholdW << ")");
+          for (uint32_t i = 0; i < ppdu->GetNMpdus (); i++)
+            {
+              NotifyRxDrop (ppdu->GetMpdu (i));
+            }
+          m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
+          m_plcpSuccess = false;
+          MaybeCcaBusy ();
+        }
+      break;
+    case YansWifiPhy::SLEEP:
+      NS_LOG_DEBUG ("drop A-MPDU because in sleep mode");
+      for (uint32_t i = 0; i < ppdu->GetNMpdus (); i++)
+        {
+          NotifyRxDrop (ppdu->GetMpdu (i));
+        }
+      m_interference.AddForeignSignal (txVector, rxDuration, rxPowerW);
+      m_plcpSuccess = false;
+      break;
+    }
+}
+
+bool
+YansWifiPhy::MaybeCaptureNewFrame (WifiTxVector txVector, enum WifiPreamble preamble, double rxPowerW)
+{
+  NS_ASSERT (IsStateRx ());
+  //only a frame with a preamble captures the PHY, and only while the PHY
+  //receives the preamble of a frame: neither the MPDUs of an A-MPDU but
+  //the first nor the PPDUs sent on resource units
+  if (preamble == WIFI_PREAMBLE_NONE
+      || txVector.GetNRus () > 1
+      || m_currentEvent->GetPreambleType () == WIFI_PREAMBLE_NONE
+      || m_currentEvent->GetTxVector ().GetNRus () > 1
+      || !m_frameCaptureModel->IsInCaptureWindow (m_currentEvent->GetStartTime ())
+      || !m_frameCaptureModel->CaptureNewFrame (m_currentEvent->GetRxPowerW (), rxPowerW))
+    {
+      return false;
+    }
+  NS_LOG_DEBUG ("switch to a new frame (power=" << rxPowerW << "W, current power=" <<
+                m_currentEvent->GetRxPowerW () << "W)");
+  m_endPlcpRxEvent.Cancel ();
+  m_endRxEvent.Cancel ();
+  m_interference.NotifyRxEnd ();
+  if (m_currentPpdu != 0)
+    {
+      for (uint32_t i = 0; i < m_currentPpdu->GetNMpdus (); i++)
+        {
+          NotifyRxDrop (m_currentPpdu->GetMpdu (i));
+        }
+    }
+  else
+    {
+      NotifyRxDrop (m_currentPacket);
+    }
+  m_state->SwitchFromRxAbort ();
+  m_currentEvent = 0;
+  m_currentPacket = 0;
+  m_currentPpdu = 0;
+  m_mpdusNum = 0;
+  m_plcpSuccess = false;
+  return true;
+}
+
+void
+YansWifiPhy::MaybeCcaBusy (void)
+{
   //We are here because we have received the first bit of a packet and we are
   //not going to be able to synchronize on it
   //In this model, CCA becomes busy when the aggregation of all signals as
@@ -739,7 +977,7 @@ maybeCcaBusy:
 }
 
 void
-YansWifiPhy::StartReceivePacket (Ptr<Packet> packet,
+YansWifiPhy::StartReceivePacket (Ptr<const Packet> packet,
                                  WifiTxVector txVector,
                                  enum WifiPreamble preamble,
                                  uint8_t packetType,
@@ -805,6 +1043,7 @@ YansWifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector, WifiPr
       m_endRxEvent.Cancel ();
       m_interference.NotifyRxEnd ();
     }
+  AbortMuReceptions ();
   NotifyTxBegin(packet, txDuration);
   uint32_t dataRate500KbpsUnits;
   if (txVector.GetMode ().GetModulationClass () == WIFI_MOD_CLASS_HT || txVector.GetMode ().GetModulationClass () == WIFI_MOD_CLASS_S1G)
@@ -821,6 +1060,65 @@ YansWifiPhy::SendPacket (Ptr<const Packet> packet, WifiTxVector txVector, WifiPr
   m_channel->Send (this, packet, GetPowerDbm (txVector.GetTxPowerLevel ()) + m_txGainDb, txVector, preamble, packetType, txDuration);
 }
 
+void
+YansWifiPhy::SendAmpdu (const std::vector<Ptr<const Packet> > &mpdus, WifiTxVector txVector, WifiPreamble preamble)
+{
+  NS_LOG_FUNCTION (this << mpdus.size () << txVector.GetMode () << preamble);
+  if (!m_singlePpduAmpdu || mpdus.size () < 2 || txVector.GetNRus () > 1)
+    {
+      WifiPhy::SendAmpdu (mpdus, txVector, preamble);
+      return;
+    }
+  NS_ASSERT (!m_state->IsStateTx () && !m_state->IsStateSwitching ());
+
+  if (m_state->IsStateSleep ())
+    {
+      NS_LOG_DEBUG ("Dropping A-MPDU because in sleep mode");
+      for (uint32_t i = 0; i < mpdus.size (); i++)
+        {
+          NotifyTxDrop (mpdus[i]);
+        }
+      return;
+    }
+
+  //the MPDUs after the first one are sent without preamble, the last one
+  //closing the A-MPDU: the durations are the ones of the per-MPDU
+  //transmissions, including the padding of the last symbol
+  Ptr<AmpduPpdu> ppdu = Create<AmpduPpdu> ();
+  for (uint32_t i = 0; i < mpdus.size (); i++)
+    {
+      uint8_t packetType = (i + 1 < mpdus.size ()) ? 1 : 2;
+      WifiPreamble mpduPreamble = (i == 0) ? preamble : WIFI_PREAMBLE_NONE;
+      ppdu->AddMpdu (mpdus[i], CalculateTxDuration (mpdus[i]->GetSize (), txVector, mpduPreamble,
+                                                    GetFrequency (), packetType, 1));
+    }
+
+  if (m_state->IsStateRx ())
+    {
+      m_endPlcpRxEvent.Cancel ();
+      m_endRxEvent.Cancel ();
+      m_interference.NotifyRxEnd ();
+    }
+  AbortMuReceptions ();
+  uint32_t dataRate500KbpsUnits;
+  if (txVector.GetMode ().GetModulationClass () == WIFI_MOD_CLASS_HT || txVector.GetMode ().GetModulationClass () == WIFI_MOD_CLASS_S1G)
+    {
+      dataRate500KbpsUnits = 128 + WifiModeToMcs (txVector.GetMode ());
+    }
+  else
+    {
+      dataRate500KbpsUnits = txVector.GetMode ().GetDataRate () * txVector.GetNss () / 500000;
+    }
+  for (uint32_t i = 0; i < mpdus.size (); i++)
+    {
+      NotifyTxBegin (mpdus[i], ppdu->GetMpduStart (i) + ppdu->GetMpduDuration (i));
+      bool isShortPreamble = (i == 0 && WIFI_PREAMBLE_SHORT == preamble);
+      NotifyMonitorSniffTx (mpdus[i], (uint16_t)GetChannelFrequencyMhz (), GetChannelNumber (), dataRate500KbpsUnits, isShortPreamble, txVector);
+    }
+  m_state->SwitchToTx (ppdu->GetDuration (), mpdus[0], GetPowerDbm (txVector.GetTxPowerLevel ()), txVector, preamble);
+  m_channel->SendAmpdu (this, ppdu, GetPowerDbm (txVector.GetTxPowerLevel ()) + m_txGainDb, txVector, preamble);
+}
+
 void
 OnTxEnd (YansWifiPhy* obj, Ptr<const Packet> packet)
 {
@@ -1288,6 +1586,123 @@ YansWifiPhy::EndReceive (Ptr<Packet> packet, enum WifiPreamble preamble, uint8_t
     }
 }
 
+void
+YansWifiPhy::EndReceiveAmpdu (Ptr<const AmpduPpdu> ppdu, Ptr<InterferenceHelper::Event> event)
+{
+  NS_LOG_FUNCTION (this << ppdu->GetNMpdus () << event);
+  NS_ASSERT (IsStateRx ());
+  NS_ASSERT (event->GetEndTime () == Simulator::Now ());
+
+  uint32_t nMpdus = ppdu->GetNMpdus ();
+  std::vector<struct InterferenceHelper::SnrPer> snrPers (nMpdus);
+  for (uint32_t i = 0; i < nMpdus; i++)
+    {
+      snrPers[i] = m_interference.CalculateAmpduSubframeSnrPer (event, ppdu->GetMpduStart (i),
+                                                                ppdu->GetMpduDuration (i));
+    }
+  m_interference.NotifyRxEnd ();
+
+  if (m_plcpSuccess == true)
+    {
+      for (uint32_t i = 0; i < nMpdus; i++)
+        {
+          bool last = (i + 1 == nMpdus);
+          WifiPreamble preamble = (i == 0) ? event->GetPreambleType () : WIFI_PREAMBLE_NONE;
+          Ptr<Packet> packet = ppdu->GetMpdu (i)->Copy ();
+          NS_LOG_DEBUG ("MPDU " << i << ": snr=" << snrPers[i].snr << ", per=" << snrPers[i].per << ", size=" << packet->GetSize ());
+          if (m_random->GetValue () > snrPers[i].per)
+            {
+              NotifyRxEnd (packet);
+              uint32_t dataRate500KbpsUnits;
+              if ((event->GetPayloadMode ().GetModulationClass () == WIFI_MOD_CLASS_HT) || (event->GetPayloadMode ().GetModulationClass () == WIFI_MOD_CLASS_S1G))
+                {
+                  dataRate500KbpsUnits = 128 + WifiModeToMcs (event->GetPayloadMode ());
+                }
+              else
+                {
+                  dataRate500KbpsUnits = event->GetPayloadMode ().GetDataRate () * event->GetTxVector ().GetNss () / 500000;
+                }
+              bool isShortPreamble = (WIFI_PREAMBLE_SHORT == preamble);
+              double signalDbm = RatioToDb (event->GetRxPowerW ()) + 30;
+              double noiseDbm = RatioToDb (event->GetRxPowerW () / snrPers[i].snr) - GetRxNoiseFigure () + 30;
+              NotifyMonitorSniffRx (packet, (uint16_t)GetChannelFrequencyMhz (), GetChannelNumber (), dataRate500KbpsUnits, isShortPreamble, event->GetTxVector (), signalDbm, noiseDbm);
+              if (last)
+                {
+                  m_state->SwitchFromRxEndOk (packet, snrPers[i].snr, event->GetTxVector (), preamble);
+                }
+              else
+                {
+                  m_state->ReportRxOk (packet, snrPers[i].snr, event->GetTxVector (), preamble);
+                }
+            }
+          else
+            {
+              NotifyRxDrop (packet);
+              if (last)
+                {
+                  m_state->SwitchFromRxEndError (packet, snrPers[i].snr);
+                }
+              else
+                {
+                  m_state->ReportRxError (packet, snrPers[i].snr);
+                }
+            }
+        }
+    }
+  else
+    {
+      NS_LOG_DEBUG ("drop A-MPDU because its plcp has not been received");
+      for (uint32_t i = 1; i < nMpdus; i++)
+        {
+          NotifyRxDrop (ppdu->GetMpdu (i));
+        }
+      m_state->SwitchFromRxEndError (ppdu->GetMpdu (0)->Copy (), snrPers[0].snr);
+    }
+  m_plcpSuccess = false;
+}
+
+void
+YansWifiPhy::EndReceiveMu (Ptr<Packet> packet, enum WifiPreamble preamble, Ptr<InterferenceHelper::Event> event)
+{
+  NS_LOG_FUNCTION (this << packet << event);
+  NS_ASSERT (event->GetEndTime () == Simulator::Now ());
+
+  struct InterferenceHelper::SnrPer plcpSnrPer;
+  plcpSnrPer = m_interference.CalculatePlcpHeaderSnrPer (event);
+  struct InterferenceHelper::SnrPer snrPer;
+  snrPer = m_interference.CalculatePlcpPayloadSnrPer (event);
+  m_interference.NotifyMuRxEnd ();
+
+  NS_LOG_DEBUG ("mode=" << (event->GetPayloadMode ().GetDataRate ()) << ", RU=" << (uint32_t)event->GetTxVector ().GetRuIndex () <<
+                ", snr=" << snrPer.snr << ", per=" << snrPer.per << ", size=" << packet->GetSize ());
+  if (m_random->GetValue () > plcpSnrPer.per
+      && (IsModeSupported (event->GetPayloadMode ()) || IsMcsSupported (event->GetPayloadMode ()))
+      && m_random->GetValue () > snrPer.per)
+    {
+      NotifyRxEnd (packet);
+      m_state->ReportRxOk (packet, snrPer.snr, event->GetTxVector (), preamble);
+    }
+  else
+    {
+      NotifyRxDrop (packet);
+    }
+}
+
+void
+YansWifiPhy::AbortMuReceptions (void)
+{
+  for (std::vector<EventId>::iterator it = m_endMuRxEvents.begin (); it != m_endMuRxEvents.end (); it++)
+    {
+      if (it->IsRunning ())
+        {
+          NS_LOG_DEBUG ("drop packet received on a resource unit");
+          it->Cancel ();
+          m_interference.NotifyMuRxEnd ();
+        }
+    }
+  m_endMuRxEvents.clear ();
+}
+
 int64_t
 YansWifiPhy::AssignStreams (int64_t stream)
 {
@@ -37,6 +37,7 @@
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
 #include "interference-helper.h"
+#include "frame-capture-model.h"
 
 namespace ns3 {
     
@@ -44,6 +45,7 @@ namespace ns3 {
 #define HT_PHY 127
 
 class YansWifiChannel;
+class AmpduPpdu;
 class WifiPhyStateHelper;
 
 
@@ -115,6 +117,30 @@ public:
                                       WifiPreamble preamble,
                                       uint8_t packetType,
                                       Time rxDuration);
+  /**
+   * Starting receiving an A-MPDU sent as a single PPDU (i.e. the first bit
+   * of its preamble has arrived).
+   *
+   * \param ppdu the MPDUs of the arriving A-MPDU
+   * \param rxPowerDbm the receive power in dBm
+   * \param txVector the TXVECTOR of the arriving A-MPDU
+   * \param preamble the preamble of the arriving A-MPDU
+   */
+  void StartReceiveAmpdu (Ptr<const AmpduPpdu> ppdu,
+                          double rxPowerDbm,
+                          WifiTxVector txVector,
+                          WifiPreamble preamble);
+  /**
+   * Start receiving a signal the PHY cannot synchronize to, only adding
+   * it to the interference (i.e. a signal from a far tile of the channel).
+   *
+   * \param rxPowerDbm the receive power in dBm
+   * \param txVector the TXVECTOR of the signal
+   * \param rxDuration the duration of the signal
+   */
+  void StartReceiveInterference (double rxPowerDbm,
+                                 WifiTxVector txVector,
+                                 Time rxDuration);
   /**
    * Starting receiving the payload of a packet (i.e. the first bit of the packet has arrived).
    *
@@ -124,7 +150,7 @@ public:
    * \param packetType The type of the received packet (values: 0 not an A-MPDU, 1 corresponds to any packets in an A-MPDU except the last one, 2 is the last packet in an A-MPDU)
    * \param event the corresponding event of the first time the packet arrives
    */
-  void StartReceivePacket (Ptr<Packet> packet,
+  void StartReceivePacket (Ptr<const Packet> packet,
                            WifiTxVector txVector,
                            WifiPreamble preamble,
                            uint8_t packetType,
@@ -190,6 +216,13 @@ public:
    * \param rate the error rate model
    */
   void SetErrorRateModel (Ptr<ErrorRateModel> rate);
+  /**
+   * Sets the frame capture model.
+   *
+   * \param capture the frame capture model, or 0 to drop the frames
+   *        arriving during a reception
+   */
+  void SetFrameCaptureModel (Ptr<FrameCaptureModel> capture);
   /**
    * Sets the device this PHY is associated with.
    *
@@ -243,6 +276,12 @@ public:
    * \return the error rate model this PHY is using
    */
   Ptr<ErrorRateModel> GetErrorRateModel (void) const;
+  /**
+   * Return the frame capture model this PHY is using.
+   *
+   * \return the frame capture model this PHY is using, if any
+   */
+  Ptr<FrameCaptureModel> GetFrameCaptureModel (void) const;
   /**
    * Return the device this PHY is associated with
    *
@@ -279,6 +318,15 @@ public:
   virtual void SetReceiveOkCallback (WifiPhy::RxOkCallback callback);
   virtual void SetReceiveErrorCallback (WifiPhy::RxErrorCallback callback);
   virtual void SendPacket (Ptr<const Packet> packet, WifiTxVector txvector, enum WifiPreamble preamble, uint8_t packetType);
+  /**
+   * Send the MPDUs of an A-MPDU. When SinglePpduAmpdu is set, they are sent
+   * to the channel as a single PPDU, otherwise as WifiPhy::SendAmpdu does.
+   *
+   * \param mpdus the MPDUs, with their A-MPDU subframe header and padding
+   * \param txvector the txvector of the A-MPDU
+   * \param preamble the type of preamble to use to send the A-MPDU
+   */
+  virtual void SendAmpdu (const std::vector<Ptr<const Packet> > &mpdus, WifiTxVector txvector, enum WifiPreamble preamble);
   virtual void RegisterListener (WifiPhyListener *listener);
   virtual void UnregisterListener (WifiPhyListener *listener);
   virtual void SetSleepMode (void);
@@ -532,6 +580,45 @@ void Configure80211ah (void);
    * \param event the corresponding event of the first time the packet arrives
    */
   void EndReceive (Ptr<Packet> packet, enum WifiPreamble preamble, uint8_t packetType, Ptr<InterferenceHelper::Event> event);
+  /**
+   * The last bit of an A-MPDU sent as a single PPDU has arrived: the
+   * success of each MPDU is drawn, in order, from the interference during
+   * this MPDU.
+   *
+   * \param ppdu the MPDUs of the A-MPDU
+   * \param event the corresponding event of the first time the A-MPDU arrives
+   */
+  void EndReceiveAmpdu (Ptr<const AmpduPpdu> ppdu, Ptr<InterferenceHelper::Event> event);
+  /**
+   * Switch to CCA busy if the energy on the medium is above the CCA
+   * threshold, after the arrival of a signal the PHY does not
+   * synchronize to.
+   */
+  void MaybeCcaBusy (void);
+  /**
+   * The last bit of a packet sent on a resource unit, and received in
+   * parallel with the reception the PHY is synchronized to, has arrived.
+   *
+   * \param packet the packet that the last bit has arrived
+   * \param preamble the preamble of the arriving packet
+   * \param event the corresponding event of the first time the packet arrives
+   */
+  void EndReceiveMu (Ptr<Packet> packet, enum WifiPreamble preamble, Ptr<InterferenceHelper::Event> event);
+  /**
+   * Drop the resource unit receptions in progress.
+   */
+  void AbortMuReceptions (void);
+  /**
+   * Give up the current reception for a new frame if the frame capture
+   * model lets the new frame capture the PHY.
+   *
+   * \param txVector the TXVECTOR of the new frame
+   * \param preamble the preamble of the new frame
+   * \param rxPowerW the receive power of the new frame (W)
+   *
+   * \return true if the current reception was given up
+   */
+  bool MaybeCaptureNewFrame (WifiTxVector txVector, enum WifiPreamble preamble, double rxPowerW);
 
   bool     m_initialized;         //!< Flag for runtime initialization
   double   m_edThresholdW;        //!< Energy detection threshold in watts
@@ -601,6 +688,11 @@ void Configure80211ah (void);
   std::vector<uint8_t> m_deviceMcsSet;
   EventId m_endRxEvent;
   EventId m_endPlcpRxEvent;
+  std::vector<EventId> m_endMuRxEvents;          //!< end of the resource unit receptions in progress
+  Ptr<InterferenceHelper::Event> m_currentEvent; //!< event of the reception the PHY is synchronized to
+  Ptr<const Packet> m_currentPacket;             //!< packet the PHY is synchronized to
+  Ptr<const AmpduPpdu> m_currentPpdu;            //!< A-MPDU the PHY is synchronized to, if sent as a single PPDU
+  Ptr<FrameCaptureModel> m_frameCaptureModel;    //!< frame capture model, if any
 
   Ptr<UniformRandomVariable> m_random;  //!< Provides uniform random variables.
   double m_channelStartingFrequency;    //!< Standard-dependent center frequency of 0-th channel in MHz
@@ -609,6 +701,7 @@ void Configure80211ah (void);
   Time m_channelSwitchDelay;            //!< Time required to switch between channel
   uint16_t m_mpdusNum;                  //!< carries the number of expected mpdus that are part of an A-MPDU
   bool m_plcpSuccess;                   //!< Flag if the PLCP of the packet or the first MPDU in an A-MPDU has been received
+  bool m_singlePpduAmpdu;               //!< Flag if the A-MPDUs are sent as a single PPDU
 };
 
 } //namespace ns3
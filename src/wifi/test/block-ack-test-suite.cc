@@ -22,7 +22,29 @@
 #include "ns3/log.h"
 #include "ns3/qos-utils.h"
 #include "ns3/ctrl-headers.h"
+#include "ns3/block-ack-cache.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-mac-trailer.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/config.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/ssid.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/s1g-wifi-mac-helper.h"
+#include "ns3/rps.h"
+#include "ns3/tim.h"
+#include "ns3/pageSlice.h"
 #include <list>
+#include <cstdlib>
 
 using namespace ns3;
 
@@ -275,6 +297,451 @@ CtrlBAckResponseHeaderTest::DoRun (void)
 }
 
 
+//Test for word level block ack bitmap operations
+class CtrlBAckResponseHeaderBulkTest : public TestCase
+{
+public:
+  CtrlBAckResponseHeaderBulkTest ();
+private:
+  virtual void DoRun ();
+};
+
+CtrlBAckResponseHeaderBulkTest::CtrlBAckResponseHeaderBulkTest ()
+  : TestCase ("Check the word level operations on the block ack compressed bitmap")
+{
+}
+
+void
+CtrlBAckResponseHeaderBulkTest::DoRun (void)
+{
+  CtrlBAckResponseHeader blockAckHdr;
+  blockAckHdr.SetType (COMPRESSED_BLOCK_ACK);
+
+  //Popcount and first missing across the sequence number wrap around
+  blockAckHdr.SetStartingSequence (4090);
+  for (uint32_t i = 4090; i != 10; i = (i + 1) % 4096)
+    {
+      blockAckHdr.SetReceivedPacket (i);
+    }
+  for (uint32_t i = 22; i < 25; i++)
+    {
+      blockAckHdr.SetReceivedPacket (i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (blockAckHdr.GetNReceivedPackets (), 19, "error in popcount");
+  NS_TEST_EXPECT_MSG_EQ (blockAckHdr.GetFirstMissingSequence (), 10, "error in first missing");
+
+  //The compressed bitmap is replaced, not merged
+  blockAckHdr.SetStartingSequence (100);
+  blockAckHdr.SetCompressedBitmap (0x7LL);
+  NS_TEST_EXPECT_MSG_EQ (blockAckHdr.GetCompressedBitmap (), 0x7LL, "error in compressed bitmap set");
+  NS_TEST_EXPECT_MSG_EQ (blockAckHdr.IsPacketReceived (102), true, "error in compressed bitmap set");
+  NS_TEST_EXPECT_MSG_EQ (blockAckHdr.IsPacketReceived (103), false, "error in compressed bitmap set");
+
+  //Full block ack
+  blockAckHdr.SetCompressedBitmap (~uint64_t (0));
+  NS_TEST_EXPECT_MSG_EQ (blockAckHdr.GetNReceivedPackets (), 64, "error in popcount");
+  NS_TEST_EXPECT_MSG_EQ (blockAckHdr.GetFirstMissingSequence (), 164, "error in first missing");
+
+  //The recipient scoreboard must produce the same bitmap as per packet updates
+  BlockAckCache cache;
+  cache.Init (4080, 64);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetFragmentNumber (0);
+  for (uint16_t seq = 4080; seq != 40; seq = (seq + 1) % 4096)
+    {
+      if (seq % 3 != 0)
+        {
+          hdr.SetSequenceNumber (seq);
+          cache.UpdateWithMpdu (&hdr);
+        }
+    }
+  CtrlBAckResponseHeader fromCache;
+  fromCache.SetType (COMPRESSED_BLOCK_ACK);
+  fromCache.SetStartingSequence (cache.GetWinStart ());
+  cache.FillBlockAckBitmap (&fromCache);
+  CtrlBAckResponseHeader expected;
+  expected.SetType (COMPRESSED_BLOCK_ACK);
+  expected.SetStartingSequence (cache.GetWinStart ());
+  for (uint16_t seq = cache.GetWinStart (); seq != 40; seq = (seq + 1) % 4096)
+    {
+      if (seq % 3 != 0)
+        {
+          expected.SetReceivedPacket (seq);
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (fromCache.GetCompressedBitmap (), expected.GetCompressedBitmap (), "error in scoreboard window");
+}
+
+
+//Test for trigger frame serialization
+class CtrlTriggerHeaderTest : public TestCase
+{
+public:
+  CtrlTriggerHeaderTest ();
+private:
+  virtual void DoRun ();
+};
+
+CtrlTriggerHeaderTest::CtrlTriggerHeaderTest ()
+  : TestCase ("Check the serialization of trigger frames")
+{
+}
+
+void
+CtrlTriggerHeaderTest::DoRun (void)
+{
+  CtrlTriggerHeader trigger;
+  trigger.SetType (TRIGGER_BASIC);
+  trigger.SetUlLength (5000);
+  trigger.SetNRus (4);
+  trigger.SetUlMcs (2);
+  trigger.AddUserInfo (1, 0);
+  trigger.AddUserInfo (8191, 3);
+  trigger.AddUserInfo (37, 1);
+  NS_TEST_EXPECT_MSG_EQ (trigger.GetSerializedSize (), 15, "error in trigger size");
+
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_CTL_TRIGGER);
+  hdr.SetAddr1 (Mac48Address::GetBroadcast ());
+  hdr.SetAddr2 (Mac48Address ("00:00:00:00:00:01"));
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (trigger);
+  packet->AddHeader (hdr);
+  WifiMacTrailer fcs;
+  packet->AddTrailer (fcs);
+
+  WifiMacHeader rxHdr;
+  packet->RemoveHeader (rxHdr);
+  NS_TEST_EXPECT_MSG_EQ (rxHdr.IsTrigger (), true, "error in trigger frame type");
+  NS_TEST_EXPECT_MSG_EQ (rxHdr.GetAddr2 (), Mac48Address ("00:00:00:00:00:01"), "error in trigger transmitter");
+  CtrlTriggerHeader rxTrigger;
+  packet->RemoveHeader (rxTrigger);
+  NS_TEST_EXPECT_MSG_EQ (rxTrigger.IsBasic (), true, "error in trigger type");
+  NS_TEST_EXPECT_MSG_EQ (rxTrigger.GetUlLength (), 5000, "error in uplink length");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)rxTrigger.GetNRus (), 4, "error in number of resource units");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)rxTrigger.GetUlMcs (), 2, "error in uplink MCS");
+  NS_TEST_EXPECT_MSG_EQ (rxTrigger.GetNUserInfo (), 3, "error in number of users");
+  uint8_t ruIndex;
+  NS_TEST_EXPECT_MSG_EQ (rxTrigger.FindRuIndex (8191, &ruIndex), true, "error in user lookup");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)ruIndex, 3, "error in resource unit");
+  NS_TEST_EXPECT_MSG_EQ (rxTrigger.FindRuIndex (37, &ruIndex), true, "error in user lookup");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)ruIndex, 1, "error in resource unit");
+  NS_TEST_EXPECT_MSG_EQ (rxTrigger.FindRuIndex (2, &ruIndex), false, "error in user lookup");
+}
+
+
+/**
+ * Install an AP soliciting triggered uplinks and two stations, which the
+ * AP gives the AIDs 1 and 2 and which share the only slot of the only
+ * RAW group.
+ *
+ * \param staDevices the devices of the stations
+ *
+ * \return the device of the AP
+ */
+static Ptr<WifiNetDevice>
+InstallTriggeredUplinkNetwork (NetDeviceContainer &staDevices)
+{
+  Config::SetDefault ("ns3::ApWifiMac::EnableBeaconJitter", BooleanValue (false));
+
+  NodeContainer staNodes;
+  staNodes.Create (2);
+  Ptr<Node> apNode = CreateObject<Node> ();
+  apNode->AggregateObject (CreateObject<ConstantPositionMobilityModel> ());
+  for (uint32_t i = 0; i < staNodes.GetN (); i++)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      //both stations receive the trigger frame at the same time
+      mobility->SetPosition (Vector (5.0 * i, 5.0 * (1 - i), 0.0));
+      staNodes.Get (i)->AggregateObject (mobility);
+    }
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("ChannelWidth", UintegerValue (2));
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ah);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate650KbpsBW2MHz"),
+                                "ControlMode", StringValue ("OfdmRate650KbpsBW2MHz"));
+  S1gWifiMacHelper mac = S1gWifiMacHelper::Default ();
+  Ssid ssid = Ssid ("trigger-test");
+
+  //AIDs 1 and 2 share the only slot of the only RAW group
+  RPS::RawAssignment raw;
+  raw.SetRawControl (0);
+  raw.SetSlotCrossBoundary (1);
+  raw.SetSlotFormat (1);
+  raw.SetSlotDurationCount (200);
+  raw.SetSlotNum (1);
+  raw.SetRawGroup ((2 << 13) | (1 << 2));
+  RPS rps;
+  rps.SetRawAssignment (raw);
+  RPSVector rpsVector;
+  rpsVector.rpsset.push_back (rps);
+  pageSlice slice;
+  slice.SetPageindex (0);
+  slice.SetPagePeriod (1);
+  slice.SetPageSliceLen (1);
+  slice.SetPageSliceCount (0);
+  slice.SetBlockOffset (0);
+  slice.SetTIMOffset (0);
+  TIM tim;
+  tim.SetPageIndex (0);
+  tim.SetDTIMPeriod (1);
+
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  //the AP derives the AIDs 1 and 2 from the addresses of the stations
+  staDevices = wifi.Install (phy, mac, staNodes);
+  staDevices.Get (0)->SetAddress (Mac48Address ("00:00:00:00:00:01"));
+  staDevices.Get (1)->SetAddress (Mac48Address ("00:00:00:00:00:02"));
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconInterval", TimeValue (MilliSeconds (100)),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (slice),
+               "TIMSet", TIMValue (tim),
+               "UplinkMuEnabled", BooleanValue (true),
+               "UplinkMuRus", UintegerValue (2),
+               "UplinkMuMcs", UintegerValue (0));
+  return DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, apNode).Get (0));
+}
+
+
+//Test for a trigger based uplink in a RAW slot: the AP triggers the two
+//stations of the slot, which answer at once on their resource units, and
+//acknowledges both frames with one multi-STA ack
+class TriggeredUplinkTest : public TestCase
+{
+public:
+  TriggeredUplinkTest ();
+private:
+  virtual void DoRun ();
+  void ApTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, uint16_t channelNumber,
+             uint32_t rate, bool isShortPreamble, WifiTxVector txVector);
+  void StaTx (std::string context, Ptr<const Packet> packet, uint16_t channelFreqMhz,
+              uint16_t channelNumber, uint32_t rate, bool isShortPreamble, WifiTxVector txVector);
+  void ApRx (Ptr<const Packet> packet);
+  void SendUplink (Ptr<NetDevice> device, Address ap);
+
+  /// A frame sent by a station on a resource unit
+  struct RuFrame
+  {
+    uint16_t aid;
+    Time time;
+    WifiTxVector txVector;
+  };
+
+  Time m_queued;                  //!< when the stations queued their frames
+  bool m_triggered;               //!< whether the AP triggered the two stations
+  CtrlTriggerHeader m_trigger;    //!< the first trigger frame of the two stations
+  bool m_acked;                   //!< whether the AP sent a multi-STA ack
+  CtrlTriggerHeader m_ack;        //!< the first multi-STA ack
+  std::vector<RuFrame> m_ruFrames; //!< the frames sent on a resource unit before the first ack
+  uint32_t m_received;            //!< number of data frames received by the AP
+};
+
+TriggeredUplinkTest::TriggeredUplinkTest ()
+  : TestCase ("Check a trigger based uplink of two stations"),
+    m_triggered (false),
+    m_acked (false),
+    m_received (0)
+{
+}
+
+void
+TriggeredUplinkTest::ApTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, uint16_t channelNumber,
+                           uint32_t rate, bool isShortPreamble, WifiTxVector txVector)
+{
+  WifiMacHeader hdr;
+  Ptr<Packet> copy = packet->Copy ();
+  copy->RemoveHeader (hdr);
+  if (!hdr.IsTrigger () || m_queued.IsZero ())
+    {
+      return;
+    }
+  CtrlTriggerHeader trigger;
+  copy->RemoveHeader (trigger);
+  if (trigger.IsBasic () && !m_triggered && trigger.GetNUserInfo () == 2)
+    {
+      m_triggered = true;
+      m_trigger = trigger;
+    }
+  else if (trigger.IsMultiStaAck () && m_triggered && !m_acked)
+    {
+      m_acked = true;
+      m_ack = trigger;
+    }
+}
+
+void
+TriggeredUplinkTest::StaTx (std::string context, Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                            uint16_t channelNumber, uint32_t rate, bool isShortPreamble, WifiTxVector txVector)
+{
+  WifiMacHeader hdr;
+  packet->PeekHeader (hdr);
+  if (hdr.IsData () && txVector.GetNRus () > 1 && !m_acked)
+    {
+      RuFrame frame;
+      frame.aid = std::atoi (context.c_str ());
+      frame.time = Simulator::Now ();
+      frame.txVector = txVector;
+      m_ruFrames.push_back (frame);
+    }
+}
+
+void
+TriggeredUplinkTest::ApRx (Ptr<const Packet> packet)
+{
+  m_received++;
+}
+
+void
+TriggeredUplinkTest::SendUplink (Ptr<NetDevice> device, Address ap)
+{
+  m_queued = Simulator::Now ();
+  //a backlog, so that frames are still queued when the AP triggers the stations
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      device->Send (Create<Packet> (50), ap, 0x0800);
+    }
+}
+
+void
+TriggeredUplinkTest::DoRun (void)
+{
+  NetDeviceContainer staDevices;
+  Ptr<WifiNetDevice> apDevice = InstallTriggeredUplinkNetwork (staDevices);
+
+  apDevice->GetPhy ()->TraceConnectWithoutContext ("MonitorSnifferTx",
+                                                   MakeCallback (&TriggeredUplinkTest::ApTx, this));
+  apDevice->GetMac ()->TraceConnectWithoutContext ("MacRx", MakeCallback (&TriggeredUplinkTest::ApRx, this));
+  for (uint32_t i = 0; i < staDevices.GetN (); i++)
+    {
+      std::ostringstream aid;
+      aid << i + 1;
+      DynamicCast<WifiNetDevice> (staDevices.Get (i))->GetPhy ()->TraceConnect ("MonitorSnifferTx", aid.str (),
+                                                                                 MakeCallback (&TriggeredUplinkTest::StaTx, this));
+      //the stations are associated, the frames are queued just before a beacon
+      Simulator::Schedule (MilliSeconds (1099), &TriggeredUplinkTest::SendUplink, this,
+                           staDevices.Get (i), apDevice->GetAddress ());
+    }
+
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_triggered, true, "the AP did not trigger the stations");
+  uint8_t ru1, ru2;
+  NS_TEST_ASSERT_MSG_EQ (m_trigger.FindRuIndex (1, &ru1), true, "station 1 not triggered");
+  NS_TEST_ASSERT_MSG_EQ (m_trigger.FindRuIndex (2, &ru2), true, "station 2 not triggered");
+  NS_TEST_EXPECT_MSG_NE ((uint32_t)ru1, (uint32_t)ru2, "the stations share a resource unit");
+
+  //each station answers once, on its resource unit of a 1 MHz channel
+  NS_TEST_ASSERT_MSG_EQ (m_ruFrames.size (), 2, "error in number of triggered frames");
+  NS_TEST_EXPECT_MSG_EQ (m_ruFrames[0].time, m_ruFrames[1].time, "the stations did not answer at once");
+  for (uint32_t i = 0; i < m_ruFrames.size (); i++)
+    {
+      uint8_t ru;
+      m_trigger.FindRuIndex (m_ruFrames[i].aid, &ru);
+      NS_TEST_EXPECT_MSG_EQ ((uint32_t)m_ruFrames[i].txVector.GetRuIndex (), (uint32_t)ru, "error in resource unit");
+      NS_TEST_EXPECT_MSG_EQ ((uint32_t)m_ruFrames[i].txVector.GetNRus (), 2, "error in number of resource units");
+      NS_TEST_EXPECT_MSG_EQ (m_ruFrames[i].txVector.GetMode (), WifiPhy::GetOfdmRate300KbpsBW1MHz (), "error in mode");
+    }
+  NS_TEST_EXPECT_MSG_NE (m_ruFrames[0].aid, m_ruFrames[1].aid, "a station answered twice");
+
+  //the AP acknowledges both frames on their resource units
+  NS_TEST_ASSERT_MSG_EQ (m_acked, true, "the AP did not send a multi-STA ack");
+  NS_TEST_EXPECT_MSG_EQ (m_ack.GetNUserInfo (), 2, "error in number of acknowledged stations");
+  uint8_t ackedRu;
+  NS_TEST_EXPECT_MSG_EQ (m_ack.FindRuIndex (1, &ackedRu), true, "station 1 not acknowledged");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)ackedRu, (uint32_t)ru1, "error in acknowledged resource unit");
+  NS_TEST_EXPECT_MSG_EQ (m_ack.FindRuIndex (2, &ackedRu), true, "station 2 not acknowledged");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)ackedRu, (uint32_t)ru2, "error in acknowledged resource unit");
+
+  NS_TEST_EXPECT_MSG_EQ (m_received, 100, "uplink frames lost");
+}
+
+
+//Test that the AP keeps triggering the stations of a RAW slot after an
+//uplink whose end is never reported: the AP switches its channel while
+//the stations answer its first trigger frame, which drops the multi-STA ack
+class TriggerDropTest : public TestCase
+{
+public:
+  TriggerDropTest ();
+private:
+  virtual void DoRun ();
+  void ApTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, uint16_t channelNumber,
+             uint32_t rate, bool isShortPreamble, WifiTxVector txVector);
+  void SwitchChannel (void);
+
+  Ptr<WifiPhy> m_apPhy;  //!< the PHY of the AP
+  Time m_dropped;        //!< when the first trigger frame was sent
+  Time m_retriggered;    //!< when the next trigger frame was sent
+};
+
+TriggerDropTest::TriggerDropTest ()
+  : TestCase ("Check that the AP triggers the stations again after a dropped trigger frame")
+{
+}
+
+void
+TriggerDropTest::ApTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, uint16_t channelNumber,
+                       uint32_t rate, bool isShortPreamble, WifiTxVector txVector)
+{
+  WifiMacHeader hdr;
+  Ptr<Packet> copy = packet->Copy ();
+  copy->RemoveHeader (hdr);
+  if (!hdr.IsTrigger ())
+    {
+      return;
+    }
+  CtrlTriggerHeader trigger;
+  copy->RemoveHeader (trigger);
+  if (!trigger.IsBasic ())
+    {
+      return;
+    }
+  if (m_dropped.IsZero ())
+    {
+      m_dropped = Simulator::Now ();
+      //switch while the stations answer, after the end of the trigger frame
+      Simulator::Schedule (MilliSeconds (2), &TriggerDropTest::SwitchChannel, this);
+    }
+  else if (m_retriggered.IsZero ())
+    {
+      m_retriggered = Simulator::Now ();
+    }
+}
+
+void
+TriggerDropTest::SwitchChannel (void)
+{
+  m_apPhy->SetChannelNumber (m_apPhy->GetChannelNumber ());
+}
+
+void
+TriggerDropTest::DoRun (void)
+{
+  NetDeviceContainer staDevices;
+  Ptr<WifiNetDevice> apDevice = InstallTriggeredUplinkNetwork (staDevices);
+  m_apPhy = apDevice->GetPhy ();
+  m_apPhy->TraceConnectWithoutContext ("MonitorSnifferTx", MakeCallback (&TriggerDropTest::ApTx, this));
+
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  m_apPhy = 0;
+
+  NS_TEST_ASSERT_MSG_EQ (m_dropped.IsZero (), false, "the AP did not trigger the stations");
+  NS_TEST_EXPECT_MSG_EQ (m_retriggered.IsZero (), false, "the AP stopped triggering the stations");
+}
+
 class BlockAckTestSuite : public TestSuite
 {
 public:
@@ -287,6 +754,10 @@ BlockAckTestSuite::BlockAckTestSuite ()
   AddTestCase (new PacketBufferingCaseA, TestCase::QUICK);
   AddTestCase (new PacketBufferingCaseB, TestCase::QUICK);
   AddTestCase (new CtrlBAckResponseHeaderTest, TestCase::QUICK);
+  AddTestCase (new CtrlBAckResponseHeaderBulkTest, TestCase::QUICK);
+  AddTestCase (new CtrlTriggerHeaderTest, TestCase::QUICK);
+  AddTestCase (new TriggeredUplinkTest, TestCase::QUICK);
+  AddTestCase (new TriggerDropTest, TestCase::QUICK);
 }
 
 static BlockAckTestSuite g_blockAckTestSuite;
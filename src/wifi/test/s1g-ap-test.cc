@@ -0,0 +1,814 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/config.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/s1g-wifi-mac-helper.h"
+#include "ns3/ap-wifi-mac.h"
+#include "ns3/s1g-relay.h"
+#include "ns3/extension-headers.h"
+#include "ns3/rps.h"
+#include "ns3/tim.h"
+#include "ns3/pageSlice.h"
+#include "ns3/mgt-headers.h"
+#include "ns3/supported-rates.h"
+#include "ns3/s1g-capabilities.h"
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * An AP which pages two pages in turn, one per DTIM interval, sends a
+ * frame to a station of page 1. The DTIM beacons alternate the pages in
+ * the page slice element and in the bitmap control of the TIM, and the
+ * frame buffered for the station is announced in the first DTIM beacon
+ * of page 1 which follows it, not in those of page 0.
+ */
+class ApPageRotationTest : public TestCase
+{
+public:
+  ApPageRotationTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Record a DTIM beacon of the AP.
+   *
+   * \param beacon the beacon
+   * \param raw the first RAW assignment of the beacon
+   */
+  void BeaconSent (S1gBeaconHeader beacon, RPS::RawAssignment raw);
+  /**
+   * \param address the address of the AP
+   */
+  void Associated (Mac48Address address);
+  /**
+   * Send a frame from the AP to the station.
+   */
+  void SendToStation (void);
+
+  /// A DTIM beacon
+  struct Dtim
+  {
+    Time time;          //!< when the beacon was sent
+    uint8_t slicePage;  //!< the page of the page slice element
+    uint8_t timPage;    //!< the page of the bitmap control of the TIM
+    uint8_t timSize;    //!< the size of the TIM
+    uint8_t blocks[3];  //!< the first bytes of the partial virtual bitmap
+  };
+
+  Ptr<WifiNetDevice> m_apDevice;  //!< the device of the AP
+  Mac48Address m_staAddress;      //!< the address of the station, of page 1
+  bool m_associated;              //!< whether the station associated
+  Time m_sent;                    //!< when the frame was sent to the station
+  std::vector<Dtim> m_dtims;      //!< the DTIM beacons
+};
+
+ApPageRotationTest::ApPageRotationTest ()
+  : TestCase ("Check the paging of several pages by the AP"),
+    m_staAddress ("00:00:00:00:08:01"),
+    m_associated (false)
+{
+}
+
+void
+ApPageRotationTest::BeaconSent (S1gBeaconHeader beacon, RPS::RawAssignment raw)
+{
+  TIM tim = beacon.GetTIM ();
+  if (tim.GetDTIMCount () != 0)
+    {
+      return;
+    }
+  Dtim dtim;
+  dtim.time = Simulator::Now ();
+  dtim.slicePage = beacon.GetpageSlice ().GetPageindex ();
+  dtim.timPage = tim.GetPageIndex ();
+  dtim.timSize = tim.GetInformationFieldSize ();
+  for (uint8_t i = 0; i < 3; i++)
+    {
+      dtim.blocks[i] = i + 3 < dtim.timSize ? tim.GetPartialVBitmap ()[i] : 0;
+    }
+  m_dtims.push_back (dtim);
+}
+
+void
+ApPageRotationTest::Associated (Mac48Address address)
+{
+  m_associated = true;
+}
+
+void
+ApPageRotationTest::SendToStation (void)
+{
+  m_sent = Simulator::Now ();
+  m_apDevice->Send (Create<Packet> (100), m_staAddress, 0x0800);
+}
+
+void
+ApPageRotationTest::DoRun (void)
+{
+  Config::SetDefault ("ns3::ApWifiMac::EnableBeaconJitter", BooleanValue (false));
+
+  Ptr<Node> apNode = CreateObject<Node> ();
+  Ptr<Node> staNode = CreateObject<Node> ();
+  apNode->AggregateObject (CreateObject<ConstantPositionMobilityModel> ());
+  Ptr<ConstantPositionMobilityModel> staMobility = CreateObject<ConstantPositionMobilityModel> ();
+  staMobility->SetPosition (Vector (10.0, 0.0, 0.0));
+  staNode->AggregateObject (staMobility);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("ChannelWidth", UintegerValue (1));
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ah);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate300KbpsBW1MHz"),
+                                "ControlMode", StringValue ("OfdmRate300KbpsBW1MHz"));
+  S1gWifiMacHelper mac = S1gWifiMacHelper::Default ();
+  Ssid ssid = Ssid ("s1g-ap-test");
+
+  //one RAW group of one slot for the whole page 1
+  RPS::RawAssignment raw;
+  raw.SetRawControl (0);
+  raw.SetSlotCrossBoundary (1);
+  raw.SetSlotFormat (1);
+  raw.SetSlotDurationCount (100);
+  raw.SetSlotNum (1);
+  raw.SetRawGroup ((2047 << 13) | (1 << 2) | 1);
+  RPS rps;
+  rps.SetRawAssignment (raw);
+  RPSVector rpsVector;
+  rpsVector.rpsset.push_back (rps);
+
+  //two page slices of one block, the last page slice has the other blocks
+  pageSlice slice;
+  slice.SetPageindex (0);
+  slice.SetPagePeriod (2);
+  slice.SetPageSliceLen (1);
+  slice.SetPageSliceCount (2);
+  slice.SetBlockOffset (0);
+  slice.SetTIMOffset (0);
+  TIM tim;
+  tim.SetPageIndex (0);
+  tim.SetDTIMPeriod (2);
+
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  Ptr<WifiNetDevice> staDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, staNode).Get (0));
+  //the AP derives the AID of the station, 2049, from its address
+  staDevice->GetMac ()->SetAddress (m_staAddress);
+
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconInterval", TimeValue (MilliSeconds (100)),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (slice),
+               "TIMSet", TIMValue (tim),
+               "NumberOfPages", UintegerValue (2));
+  m_apDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, apNode).Get (0));
+
+  m_apDevice->GetMac ()->TraceConnectWithoutContext ("S1gBeaconBroadcasted",
+                                                     MakeCallback (&ApPageRotationTest::BeaconSent, this));
+  staDevice->GetMac ()->TraceConnectWithoutContext ("Assoc",
+                                                    MakeCallback (&ApPageRotationTest::Associated, this));
+
+  Simulator::Schedule (MilliSeconds (2050), &ApPageRotationTest::SendToStation, this);
+  Simulator::Stop (Seconds (3));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_associated, true, "The station did not associate");
+  NS_TEST_ASSERT_MSG_GT (m_dtims.size (), 10, "Too few DTIM beacons");
+  bool announced = false;
+  for (uint32_t i = 0; i < m_dtims.size (); i++)
+    {
+      const Dtim &dtim = m_dtims[i];
+      NS_TEST_EXPECT_MSG_EQ ((int) dtim.slicePage, (int) (i % 2), "The DTIM beacons do not page the pages in turn");
+      NS_TEST_EXPECT_MSG_EQ ((int) dtim.timPage, (int) dtim.slicePage, "The TIM and the page slice element page different pages");
+      if (dtim.time < m_sent || announced || dtim.slicePage == 0)
+        {
+          //only the first DTIM beacon of page 1 after the frame encodes a block
+          NS_TEST_EXPECT_MSG_LT_OR_EQ ((int) dtim.timSize, 3, "A DTIM beacon announces a frame which is not buffered for its page");
+          continue;
+        }
+      //AID 2049 is bit 1 of subblock 0 of block 0 of page 1
+      NS_TEST_ASSERT_MSG_EQ ((int) dtim.timSize, 3 + 3, "The frame buffered for the station is not announced");
+      NS_TEST_EXPECT_MSG_EQ ((int) dtim.blocks[0], 0, "Wrong block offset");
+      NS_TEST_EXPECT_MSG_EQ ((int) dtim.blocks[1], 0x01, "Wrong block bitmap");
+      NS_TEST_EXPECT_MSG_EQ ((int) dtim.blocks[2], 0x02, "Wrong subblock bitmap");
+      announced = true;
+    }
+  NS_TEST_EXPECT_MSG_EQ (announced, true, "The frame buffered for the station is never announced");
+}
+
+
+/**
+ * A station of a relay sends a frame to the root AP, which answers it.
+ * The relay forwards the frame of its station to the root AP, keeping
+ * the station as the source, and forwards the answer of the root AP to
+ * the station, keeping the root AP as the source.
+ */
+class RelayForwardingTest : public TestCase
+{
+public:
+  RelayForwardingTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Receive a frame at the root AP or at the station.
+   *
+   * \param device the receiving device
+   * \param packet the packet
+   * \param protocol the protocol of the packet
+   * \param from the source of the packet
+   * \param to the destination of the packet
+   * \param packetType the type of the packet
+   */
+  void Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                const Address &from, const Address &to, NetDevice::PacketType packetType);
+  /**
+   * \param address the address of the AP
+   */
+  void Associated (Mac48Address address);
+  /**
+   * \param mac the MAC of the AP to start beaconing
+   */
+  void StartBeacons (Ptr<WifiMac> mac);
+  /**
+   * Send a frame from the station to the root AP.
+   */
+  void SendUplink (void);
+  /**
+   * Send a frame from the root AP to the station.
+   */
+  void SendDownlink (void);
+
+  Ptr<WifiNetDevice> m_apDevice;  //!< the device of the root AP
+  Ptr<WifiNetDevice> m_staDevice; //!< the device of the station of the relay
+  uint32_t m_associated;          //!< the number of associations
+  uint32_t m_uplink;              //!< the frames of the station received by the root AP
+  uint32_t m_downlink;            //!< the frames of the root AP received by the station
+};
+
+RelayForwardingTest::RelayForwardingTest ()
+  : TestCase ("Check the forwarding of the frames of a station by a relay"),
+    m_associated (0),
+    m_uplink (0),
+    m_downlink (0)
+{
+}
+
+void
+RelayForwardingTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                              const Address &from, const Address &to, NetDevice::PacketType packetType)
+{
+  if (device == m_apDevice)
+    {
+      NS_TEST_EXPECT_MSG_EQ (Mac48Address::ConvertFrom (from), m_staDevice->GetMac ()->GetAddress (),
+                             "The relay did not keep the station as the source");
+      m_uplink++;
+    }
+  else
+    {
+      NS_TEST_EXPECT_MSG_EQ (Mac48Address::ConvertFrom (from), m_apDevice->GetMac ()->GetAddress (),
+                             "The relay did not keep the root AP as the source");
+      m_downlink++;
+    }
+}
+
+void
+RelayForwardingTest::Associated (Mac48Address address)
+{
+  m_associated++;
+}
+
+void
+RelayForwardingTest::StartBeacons (Ptr<WifiMac> mac)
+{
+  mac->SetAttribute ("BeaconGeneration", BooleanValue (true));
+}
+
+void
+RelayForwardingTest::SendUplink (void)
+{
+  m_staDevice->Send (Create<Packet> (100), m_apDevice->GetAddress (), 0x0800);
+}
+
+void
+RelayForwardingTest::SendDownlink (void)
+{
+  m_apDevice->Send (Create<Packet> (100), m_staDevice->GetAddress (), 0x0800);
+}
+
+void
+RelayForwardingTest::DoRun (void)
+{
+  Config::SetDefault ("ns3::ApWifiMac::EnableBeaconJitter", BooleanValue (false));
+
+  NodeContainer nodes;
+  nodes.Create (3);
+  Ptr<Node> apNode = nodes.Get (0);
+  Ptr<Node> relayNode = nodes.Get (1);
+  Ptr<Node> staNode = nodes.Get (2);
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (10.0 * i, 0.0, 0.0));
+      nodes.Get (i)->AggregateObject (mobility);
+    }
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("ChannelWidth", UintegerValue (1));
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ah);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate300KbpsBW1MHz"),
+                                "ControlMode", StringValue ("OfdmRate300KbpsBW1MHz"));
+  S1gWifiMacHelper mac = S1gWifiMacHelper::Default ();
+  Ssid ssid = Ssid ("s1g-root-ap");
+  Ssid relaySsid = Ssid ("s1g-relay");
+
+  //one RAW group of one slot for the whole page 0
+  RPS::RawAssignment raw;
+  raw.SetRawControl (0);
+  raw.SetSlotCrossBoundary (1);
+  raw.SetSlotFormat (1);
+  raw.SetSlotDurationCount (100);
+  raw.SetSlotNum (1);
+  raw.SetRawGroup ((2047 << 13) | (1 << 2) | 0);
+  RPS rps;
+  rps.SetRawAssignment (raw);
+  RPSVector rpsVector;
+  rpsVector.rpsset.push_back (rps);
+  //two page slices of one block, the last page slice has the other blocks
+  pageSlice slice;
+  slice.SetPageindex (0);
+  slice.SetPagePeriod (2);
+  slice.SetPageSliceLen (1);
+  slice.SetPageSliceCount (2);
+  slice.SetBlockOffset (0);
+  slice.SetTIMOffset (0);
+  TIM tim;
+  tim.SetPageIndex (0);
+  tim.SetDTIMPeriod (2);
+
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (relaySsid),
+               "ActiveProbing", BooleanValue (false));
+  m_staDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, staNode).Get (0));
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  Ptr<WifiNetDevice> relayStaDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, relayNode).Get (0));
+
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconInterval", TimeValue (MilliSeconds (100)),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (slice),
+               "TIMSet", TIMValue (tim));
+  m_apDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, apNode).Get (0));
+  //the relay beacons half way between the beacons of the root AP
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (relaySsid),
+               "BeaconInterval", TimeValue (MilliSeconds (100)),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (slice),
+               "TIMSet", TIMValue (tim),
+               "BeaconGeneration", BooleanValue (false));
+  Ptr<WifiNetDevice> relayApDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, relayNode).Get (0));
+  Simulator::Schedule (MilliSeconds (50), &RelayForwardingTest::StartBeacons, this,
+                       relayApDevice->GetMac ());
+
+  Ptr<S1gRelay> relay = CreateObject<S1gRelay> ();
+  relay->Install (relayStaDevice, relayApDevice);
+
+  apNode->RegisterProtocolHandler (MakeCallback (&RelayForwardingTest::Receive, this), 0, m_apDevice);
+  staNode->RegisterProtocolHandler (MakeCallback (&RelayForwardingTest::Receive, this), 0, m_staDevice);
+  m_staDevice->GetMac ()->TraceConnectWithoutContext ("Assoc",
+                                                      MakeCallback (&RelayForwardingTest::Associated, this));
+  relayStaDevice->GetMac ()->TraceConnectWithoutContext ("Assoc",
+                                                         MakeCallback (&RelayForwardingTest::Associated, this));
+
+  //the root AP learns from the uplink frame that the relay serves the station
+  Simulator::Schedule (Seconds (2), &RelayForwardingTest::SendUplink, this);
+  Simulator::Schedule (Seconds (3), &RelayForwardingTest::SendDownlink, this);
+  Simulator::Stop (Seconds (4));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_associated, 2, "The relay and its station did not both associate");
+  NS_TEST_EXPECT_MSG_EQ (m_uplink, 1, "The frame of the station did not reach the root AP");
+  NS_TEST_EXPECT_MSG_EQ (m_downlink, 1, "The frame of the root AP did not reach the station");
+  NS_TEST_EXPECT_MSG_EQ (relay->GetNUplinkPackets (), 1, "Wrong number of frames forwarded to the root AP");
+  NS_TEST_EXPECT_MSG_EQ (relay->GetNDownlinkPackets (), 1, "Wrong number of frames forwarded to the station");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * A station associated with an AP hears the beacons of a second AP of
+ * the same SSID. It ignores them and keeps its AP while the beacons of
+ * its AP go on, and associates with the second AP once it missed them.
+ */
+class OtherApBeaconTest : public TestCase
+{
+public:
+  OtherApBeaconTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param address the address of the AP
+   */
+  void Associated (Mac48Address address);
+  /**
+   * \param mac the MAC of the AP
+   * \param enable whether the AP beacons
+   */
+  void SetBeacons (Ptr<WifiMac> mac, bool enable);
+  /**
+   * Record the AP of the station.
+   */
+  void CheckBssid (void);
+
+  Ptr<WifiNetDevice> m_staDevice; //!< the device of the station
+  uint32_t m_associated;          //!< the number of associations
+  Mac48Address m_firstAp;         //!< the AP of the first association
+  Mac48Address m_lastAp;          //!< the AP of the last association
+  Mac48Address m_bssid;           //!< the AP of the station while both APs beacon
+};
+
+OtherApBeaconTest::OtherApBeaconTest ()
+  : TestCase ("Check that a station ignores the beacons of another AP of its SSID"),
+    m_associated (0)
+{
+}
+
+void
+OtherApBeaconTest::Associated (Mac48Address address)
+{
+  if (m_associated == 0)
+    {
+      m_firstAp = address;
+    }
+  m_lastAp = address;
+  m_associated++;
+}
+
+void
+OtherApBeaconTest::SetBeacons (Ptr<WifiMac> mac, bool enable)
+{
+  mac->SetAttribute ("BeaconGeneration", BooleanValue (enable));
+}
+
+void
+OtherApBeaconTest::CheckBssid (void)
+{
+  m_bssid = m_staDevice->GetMac ()->GetBssid ();
+}
+
+void
+OtherApBeaconTest::DoRun (void)
+{
+  Config::SetDefault ("ns3::ApWifiMac::EnableBeaconJitter", BooleanValue (false));
+
+  NodeContainer nodes;
+  nodes.Create (3);
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (10.0 * i, 0.0, 0.0));
+      nodes.Get (i)->AggregateObject (mobility);
+    }
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("ChannelWidth", UintegerValue (1));
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ah);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate300KbpsBW1MHz"),
+                                "ControlMode", StringValue ("OfdmRate300KbpsBW1MHz"));
+  S1gWifiMacHelper mac = S1gWifiMacHelper::Default ();
+  Ssid ssid = Ssid ("s1g-two-aps");
+
+  //one RAW group of one slot for the whole page 0
+  RPS::RawAssignment raw;
+  raw.SetRawControl (0);
+  raw.SetSlotCrossBoundary (1);
+  raw.SetSlotFormat (1);
+  raw.SetSlotDurationCount (100);
+  raw.SetSlotNum (1);
+  raw.SetRawGroup ((2047 << 13) | (1 << 2) | 0);
+  RPS rps;
+  rps.SetRawAssignment (raw);
+  RPSVector rpsVector;
+  rpsVector.rpsset.push_back (rps);
+  pageSlice slice;
+  slice.SetPageindex (0);
+  slice.SetPagePeriod (2);
+  slice.SetPageSliceLen (1);
+  slice.SetPageSliceCount (2);
+  slice.SetBlockOffset (0);
+  slice.SetTIMOffset (0);
+  TIM tim;
+  tim.SetPageIndex (0);
+  tim.SetDTIMPeriod (2);
+
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  m_staDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, nodes.Get (0)).Get (0));
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconInterval", TimeValue (MilliSeconds (100)),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (slice),
+               "TIMSet", TIMValue (tim));
+  Ptr<WifiNetDevice> apDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, nodes.Get (1)).Get (0));
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconInterval", TimeValue (MilliSeconds (100)),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (slice),
+               "TIMSet", TIMValue (tim),
+               "BeaconGeneration", BooleanValue (false));
+  Ptr<WifiNetDevice> otherApDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, nodes.Get (2)).Get (0));
+
+  m_staDevice->GetMac ()->TraceConnectWithoutContext ("Assoc",
+                                                      MakeCallback (&OtherApBeaconTest::Associated, this));
+  //the second AP beacons half way between the beacons of the first AP,
+  //which stops beaconing once the station heard both
+  Simulator::Schedule (MilliSeconds (1050), &OtherApBeaconTest::SetBeacons, this,
+                       otherApDevice->GetMac (), true);
+  Simulator::Schedule (Seconds (2), &OtherApBeaconTest::CheckBssid, this);
+  Simulator::Schedule (Seconds (2), &OtherApBeaconTest::SetBeacons, this,
+                       apDevice->GetMac (), false);
+  Simulator::Stop (Seconds (4));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_bssid, apDevice->GetMac ()->GetAddress (),
+                         "The station followed the beacons of the other AP");
+  NS_TEST_EXPECT_MSG_EQ (m_associated, 2, "Wrong number of associations");
+  NS_TEST_EXPECT_MSG_EQ (m_firstAp, apDevice->GetMac ()->GetAddress (), "Wrong first AP");
+  NS_TEST_EXPECT_MSG_EQ (m_lastAp, otherApDevice->GetMac ()->GetAddress (),
+                         "The station did not associate with the other AP after missing the beacons of its AP");
+  NS_TEST_EXPECT_MSG_EQ (m_staDevice->GetMac ()->GetBssid (), otherApDevice->GetMac ()->GetAddress (),
+                         "Wrong AP at the end");
+  Simulator::Destroy ();
+}
+
+/**
+ * A group addressed association response is serialized and deserialized
+ * with the capabilities of the AP and the AID of each of its stations.
+ */
+class GroupAssocResponseHeaderTest : public TestCase
+{
+public:
+  GroupAssocResponseHeaderTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GroupAssocResponseHeaderTest::GroupAssocResponseHeaderTest ()
+  : TestCase ("Check the serialization of the group addressed association response")
+{
+}
+
+void
+GroupAssocResponseHeaderTest::DoRun (void)
+{
+  SupportedRates rates;
+  rates.AddSupportedRate (300000);
+  rates.AddSupportedRate (650000);
+  rates.SetBasicRate (300000);
+  S1gCapabilities capabilities;
+  capabilities.SetS1gSupported (1);
+  capabilities.SetChannelWidth (1);
+  MgtGroupAssocResponseHeader sent;
+  sent.SetSupportedRates (rates);
+  sent.SetS1gCapabilities (capabilities);
+  sent.AddStation (Mac48Address ("00:00:00:00:00:01"), 1);
+  sent.AddStation (Mac48Address ("00:00:00:00:00:02"), 2);
+  sent.AddStation (Mac48Address ("00:00:00:00:07:ff"), 2047);
+
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (sent);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), sent.GetSerializedSize (), "Wrong serialized size");
+  MgtGroupAssocResponseHeader received;
+  packet->RemoveHeader (received);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 0, "The header was not read entirely");
+
+  NS_TEST_ASSERT_MSG_EQ (received.GetNStations (), 3, "Wrong number of stations");
+  uint16_t aid;
+  NS_TEST_EXPECT_MSG_EQ (received.FindAid (Mac48Address ("00:00:00:00:00:01"), &aid), true, "Station 1 not listed");
+  NS_TEST_EXPECT_MSG_EQ (aid, 1, "Wrong AID of station 1");
+  NS_TEST_EXPECT_MSG_EQ (received.FindAid (Mac48Address ("00:00:00:00:00:02"), &aid), true, "Station 2 not listed");
+  NS_TEST_EXPECT_MSG_EQ (aid, 2, "Wrong AID of station 2");
+  NS_TEST_EXPECT_MSG_EQ (received.FindAid (Mac48Address ("00:00:00:00:07:ff"), &aid), true, "Station 2047 not listed");
+  NS_TEST_EXPECT_MSG_EQ (aid, 2047, "Wrong AID of station 2047");
+  NS_TEST_EXPECT_MSG_EQ (received.FindAid (Mac48Address ("00:00:00:00:00:03"), &aid), false, "Unknown station listed");
+
+  NS_TEST_EXPECT_MSG_EQ (received.GetSupportedRates ().IsSupportedRate (650000), true, "Rate not supported");
+  NS_TEST_EXPECT_MSG_EQ (received.GetSupportedRates ().IsBasicRate (300000), true, "Wrong basic rate");
+  NS_TEST_EXPECT_MSG_EQ (received.GetSupportedRates ().IsBasicRate (650000), false, "Wrong basic rate");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)received.GetS1gCapabilities ().GetChannelWidth (), 1, "Wrong channel width");
+}
+
+
+/**
+ * The stations associating with an AP answering with group addressed
+ * association responses of at most three stations all associate, without
+ * a unicast association response.
+ */
+class GroupAssociationTest : public TestCase
+{
+public:
+  GroupAssociationTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \param address the address of the AP
+   */
+  void Associated (Mac48Address address);
+  /**
+   * Record the association responses of the AP.
+   *
+   * \param packet the frame sent
+   */
+  void ApTx (Ptr<const Packet> packet);
+
+  uint32_t m_associated;     //!< the number of associations
+  uint32_t m_groupResponses; //!< the number of group addressed association responses
+  uint32_t m_responses;      //!< the number of unicast association responses
+};
+
+GroupAssociationTest::GroupAssociationTest ()
+  : TestCase ("Check the association of stations with group addressed association responses"),
+    m_associated (0),
+    m_groupResponses (0),
+    m_responses (0)
+{
+}
+
+void
+GroupAssociationTest::Associated (Mac48Address address)
+{
+  m_associated++;
+}
+
+void
+GroupAssociationTest::ApTx (Ptr<const Packet> packet)
+{
+  WifiMacHeader hdr;
+  packet->PeekHeader (hdr);
+  if (!hdr.IsAssocResp ())
+    {
+      return;
+    }
+  if (hdr.GetAddr1 ().IsGroup ())
+    {
+      m_groupResponses++;
+    }
+  else
+    {
+      m_responses++;
+    }
+}
+
+void
+GroupAssociationTest::DoRun (void)
+{
+  Config::SetDefault ("ns3::ApWifiMac::EnableBeaconJitter", BooleanValue (false));
+
+  NodeContainer staNodes;
+  staNodes.Create (7);
+  Ptr<Node> apNode = CreateObject<Node> ();
+  apNode->AggregateObject (CreateObject<ConstantPositionMobilityModel> ());
+  for (uint32_t i = 0; i < staNodes.GetN (); i++)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (5.0 + i, 0.0, 0.0));
+      staNodes.Get (i)->AggregateObject (mobility);
+    }
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  phy.Set ("ChannelWidth", UintegerValue (1));
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ah);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate300KbpsBW1MHz"),
+                                "ControlMode", StringValue ("OfdmRate300KbpsBW1MHz"));
+  S1gWifiMacHelper mac = S1gWifiMacHelper::Default ();
+  Ssid ssid = Ssid ("s1g-group-assoc");
+
+  //one RAW group of one slot for the whole page 0
+  RPS::RawAssignment raw;
+  raw.SetRawControl (0);
+  raw.SetSlotCrossBoundary (1);
+  raw.SetSlotFormat (1);
+  raw.SetSlotDurationCount (100);
+  raw.SetSlotNum (1);
+  raw.SetRawGroup ((2047 << 13) | (1 << 2) | 0);
+  RPS rps;
+  rps.SetRawAssignment (raw);
+  RPSVector rpsVector;
+  rpsVector.rpsset.push_back (rps);
+  pageSlice slice;
+  slice.SetPageindex (0);
+  slice.SetPagePeriod (2);
+  slice.SetPageSliceLen (1);
+  slice.SetPageSliceCount (2);
+  slice.SetBlockOffset (0);
+  slice.SetTIMOffset (0);
+  TIM tim;
+  tim.SetPageIndex (0);
+  tim.SetDTIMPeriod (2);
+
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNodes);
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconInterval", TimeValue (MilliSeconds (100)),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (slice),
+               "TIMSet", TIMValue (tim),
+               "GroupAssocResponse", BooleanValue (true),
+               "GroupAssocResponseMaxStations", UintegerValue (3));
+  Ptr<WifiNetDevice> apDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, apNode).Get (0));
+
+  apDevice->GetPhy ()->TraceConnectWithoutContext ("PhyTxBegin", MakeCallback (&GroupAssociationTest::ApTx, this));
+  for (uint32_t i = 0; i < staDevices.GetN (); i++)
+    {
+      DynamicCast<WifiNetDevice> (staDevices.Get (i))->GetMac ()->TraceConnectWithoutContext ("Assoc",
+                                                                                              MakeCallback (&GroupAssociationTest::Associated, this));
+    }
+
+  Simulator::Stop (Seconds (3));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_associated, staNodes.GetN (), "Not every station associated");
+  NS_TEST_EXPECT_MSG_GT (m_groupResponses, 0, "No group addressed association response sent");
+  NS_TEST_EXPECT_MSG_EQ (m_responses, 0, "Unicast association response sent");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief S1G AP Test Suite
+ */
+class S1gApTestSuite : public TestSuite
+{
+public:
+  S1gApTestSuite ();
+};
+
+S1gApTestSuite::S1gApTestSuite ()
+  : TestSuite ("wifi-s1g-ap", UNIT)
+{
+  AddTestCase (new ApPageRotationTest, TestCase::QUICK);
+  AddTestCase (new RelayForwardingTest, TestCase::QUICK);
+  AddTestCase (new OtherApBeaconTest, TestCase::QUICK);
+  AddTestCase (new GroupAssocResponseHeaderTest, TestCase::QUICK);
+  AddTestCase (new GroupAssociationTest, TestCase::QUICK);
+}
+
+static S1gApTestSuite g_s1gApTestSuite;
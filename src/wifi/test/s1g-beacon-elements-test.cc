@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/buffer.h"
+#include "ns3/tim.h"
+#include "ns3/rps.h"
+#include "ns3/extension-headers.h"
+#include "ns3/aid-bitmap.h"
+#include <cstdlib>
+#include <new>
+
+using namespace ns3;
+
+namespace {
+
+/// whether the calls to operator new are counted
+bool g_countAllocations = false;
+/// number of calls to operator new while counting
+uint32_t g_allocations = 0;
+
+} //unnamed namespace
+
+// Count the heap allocations of the code under test. The replacement
+// operators allocate with malloc like the default ones, so they can be
+// paired with them.
+void *
+operator new (std::size_t size)
+{
+  if (g_countAllocations)
+    {
+      g_allocations++;
+    }
+  void *p = std::malloc (size ? size : 1);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+/**
+ * The elements of an S1G beacon, a TIM of the encoded blocks of the
+ * buffered AIDs and the RPS of the beacon, built the way the AP builds
+ * them and copied into the beacon header.
+ */
+class BeaconElementsTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param name the name of the test case
+   */
+  BeaconElementsTestCase (std::string name);
+
+protected:
+  /// Set the buffered AIDs, the RPS and the page slice of the beacons.
+  void SetupElements (void);
+  /**
+   * Build, serialize and deserialize the beacons.
+   *
+   * \param beacons the number of beacons
+   */
+  void SendBeacons (uint32_t beacons);
+
+  AidBitmap m_aids;           //!< the buffered AIDs
+  RPSVector m_rpsVector;      //!< the RPS of the beacons, in turn
+  TIM m_tim;                  //!< the TIM of the AP
+  S1gBeaconHeader m_sent;     //!< the last beacon sent
+  S1gBeaconHeader m_received; //!< the last beacon received
+  Buffer m_buffer;            //!< the serialized beacon
+};
+
+BeaconElementsTestCase::BeaconElementsTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+void
+BeaconElementsTestCase::SetupElements (void)
+{
+  m_aids.Set (1);
+  m_aids.Set (9);
+  m_aids.Set (70);
+  m_aids.Set (2047);
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      RPS rps;
+      for (uint32_t j = 0; j < 10; j++)
+        {
+          RPS::RawAssignment raw;
+          raw.SetRawControl (0);
+          raw.SetSlotCrossBoundary (1);
+          raw.SetSlotFormat (1);
+          raw.SetSlotDurationCount (100 + j);
+          raw.SetSlotNum (1);
+          raw.SetRawGroup (((j + 1) << 13) | ((j + 1) << 2));
+          rps.SetRawAssignment (raw);
+        }
+      m_rpsVector.rpsset.push_back (rps);
+    }
+  m_tim.SetDTIMPeriod (1);
+  pageSlice slice;
+  slice.SetPageindex (0);
+  slice.SetPagePeriod (1);
+  slice.SetPageSliceLen (31);
+  slice.SetPageSliceCount (1);
+  slice.SetBlockOffset (0);
+  slice.SetTIMOffset (0);
+  slice.SetPageBitmap (0x80000003);
+  m_sent.SetpageSlice (slice);
+  m_buffer.AddAtStart (1024);
+}
+
+void
+BeaconElementsTestCase::SendBeacons (uint32_t beacons)
+{
+  for (uint32_t i = 0; i < beacons; i++)
+    {
+      m_tim.SetDTIMCount (0);
+      m_tim.SetBitmapControl (0);
+      m_tim.ClearPartialVBitmap ();
+      m_tim.AddEncodedBlocks (m_aids, 0, 0, 32);
+      m_sent.SetTIM (m_tim);
+      m_sent.SetRPS (m_rpsVector.rpsset.at (i % m_rpsVector.rpsset.size ()));
+      m_sent.Serialize (m_buffer.Begin ());
+      m_received.Deserialize (m_buffer.Begin ());
+    }
+}
+
+/**
+ * The elements of the beacons are built, serialized and deserialized
+ * without heap allocation.
+ */
+class BeaconElementsAllocationTest : public BeaconElementsTestCase
+{
+public:
+  BeaconElementsAllocationTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+BeaconElementsAllocationTest::BeaconElementsAllocationTest ()
+  : BeaconElementsTestCase ("Check that the TIM and RPS of a beacon are built without heap allocation")
+{
+}
+
+void
+BeaconElementsAllocationTest::DoRun (void)
+{
+  //the replacement operator new must be the one called, or nothing is counted
+  g_allocations = 0;
+  g_countAllocations = true;
+  TIM *tim = new TIM ();
+  g_countAllocations = false;
+  delete tim;
+  NS_TEST_ASSERT_MSG_EQ (g_allocations, 1, "The allocations are not counted");
+
+  SetupElements ();
+  //the time stamps of the beacons are recorded on the heap until the
+  //simulation runs, while the AP sends its beacons once it runs
+  Simulator::Run ();
+  g_allocations = 0;
+  g_countAllocations = true;
+  SendBeacons (10);
+  g_countAllocations = false;
+  NS_TEST_EXPECT_MSG_EQ (g_allocations, 0, "Building the elements of a beacon allocated memory");
+  Simulator::Destroy ();
+}
+
+/**
+ * The elements of the beacons are serialized and deserialized, and the
+ * copies own their content.
+ */
+class BeaconElementsTest : public BeaconElementsTestCase
+{
+public:
+  BeaconElementsTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+BeaconElementsTest::BeaconElementsTest ()
+  : BeaconElementsTestCase ("Check the TIM and RPS elements of a beacon")
+{
+}
+
+void
+BeaconElementsTest::DoRun (void)
+{
+  SetupElements ();
+  SendBeacons (10);
+
+  //AIDs 1 and 9 are in the subblocks 0 and 1 of block 0, AID 70 in subblock 0 of block 1
+  //and AID 2047 in subblock 7 of block 31, every block being encoded
+  TIM rxTim = m_received.GetTIM ();
+  NS_TEST_ASSERT_MSG_EQ (rxTim.GetInformationFieldSize (), 3 + 32 * 2 + 4, "Wrong size of the TIM");
+  const uint8_t *partialVBitmap = rxTim.GetPartialVBitmap ();
+  NS_TEST_EXPECT_MSG_EQ (partialVBitmap[1], 0x03, "Wrong block bitmap of block 0");
+  NS_TEST_EXPECT_MSG_EQ (partialVBitmap[2], 0x02, "Wrong bitmap of AID 1");
+  NS_TEST_EXPECT_MSG_EQ (partialVBitmap[3], 0x02, "Wrong bitmap of AID 9");
+  NS_TEST_EXPECT_MSG_EQ (partialVBitmap[4], 0x08, "Wrong block offset of block 1");
+  NS_TEST_EXPECT_MSG_EQ (partialVBitmap[6], 0x40, "Wrong bitmap of AID 70");
+
+  RPS rxRps = m_received.GetRPS ();
+  NS_TEST_ASSERT_MSG_EQ (rxRps.GetNumberOfRawGroups (), 10, "Wrong number of RAW groups");
+  NS_TEST_EXPECT_MSG_EQ (rxRps.GetRawAssigmentObj (9).GetSlotDurationCount (), 109, "Wrong RAW assignment");
+  NS_TEST_EXPECT_MSG_EQ (rxRps.GetRawAssigmentObj (9).GetRawGroupAIDEnd (), 10, "Wrong RAW assignment");
+
+  //the encoder wraps around the blocks of the page
+  TIM wrapped;
+  wrapped.AddEncodedBlocks (m_aids, 0, 31, 2);
+  NS_TEST_ASSERT_MSG_EQ (wrapped.GetInformationFieldSize (), 3 + 3 + 4, "Wrong size of the TIM");
+  NS_TEST_EXPECT_MSG_EQ (wrapped.GetPartialVBitmap ()[0], 31 << 3, "Wrong block offset of block 31");
+  NS_TEST_EXPECT_MSG_EQ (wrapped.GetPartialVBitmap ()[1], 0x80, "Wrong block bitmap of block 31");
+  NS_TEST_EXPECT_MSG_EQ (wrapped.GetPartialVBitmap ()[2], 0x80, "Wrong bitmap of AID 2047");
+  NS_TEST_EXPECT_MSG_EQ (wrapped.GetPartialVBitmap ()[3], 0, "Wrong block offset of block 0");
+
+  //the copies own their content
+  TIM *original = new TIM ();
+  *original = m_tim;
+  TIM copy = *original;
+  delete original;
+  NS_TEST_EXPECT_MSG_EQ (copy.GetPartialVBitmap ()[2], 0x02, "The copy of the TIM does not own its bitmap");
+  RPSVector rpsCopy = m_rpsVector;
+  m_rpsVector.rpsset.clear ();
+  NS_TEST_EXPECT_MSG_EQ (rpsCopy.rpsset.at (1).GetRawAssigmentObj (0).GetSlotDurationCount (), 100,
+                         "The copy of the RPS list does not own its elements");
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief S1G beacon elements Test Suite
+ */
+class S1gBeaconElementsTestSuite : public TestSuite
+{
+public:
+  S1gBeaconElementsTestSuite ();
+};
+
+S1gBeaconElementsTestSuite::S1gBeaconElementsTestSuite ()
+  : TestSuite ("wifi-s1g-beacon-elements", UNIT)
+{
+  AddTestCase (new BeaconElementsAllocationTest, TestCase::QUICK);
+  AddTestCase (new BeaconElementsTest, TestCase::QUICK);
+}
+
+static S1gBeaconElementsTestSuite g_s1gBeaconElementsTestSuite;
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/qos-blocked-destinations.h"
+
+using namespace ns3;
+
+/**
+ * Per-station deficit round robin of WifiMacQueue: stations are served in
+ * turn and the packets of a dozing station are held without blocking the
+ * packets queued behind them.
+ */
+class StationFairQueueTest : public TestCase
+{
+public:
+  StationFairQueueTest ();
+
+private:
+  virtual void DoRun (void);
+  bool IsDozing (Mac48Address address) const;
+  void Enqueue (Ptr<WifiMacQueue> queue, Mac48Address to, uint32_t size);
+
+  Mac48Address m_dozing;
+};
+
+StationFairQueueTest::StationFairQueueTest ()
+  : TestCase ("Check the per-station scheduling of the wifi MAC queue")
+{
+}
+
+bool
+StationFairQueueTest::IsDozing (Mac48Address address) const
+{
+  return address == m_dozing;
+}
+
+void
+StationFairQueueTest::Enqueue (Ptr<WifiMacQueue> queue, Mac48Address to, uint32_t size)
+{
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (0);
+  hdr.SetAddr1 (to);
+  queue->Enqueue (Create<Packet> (size), hdr);
+}
+
+void
+StationFairQueueTest::DoRun (void)
+{
+  Mac48Address a ("00:00:00:00:00:01");
+  Mac48Address b ("00:00:00:00:00:02");
+  Mac48Address c ("00:00:00:00:00:03");
+  QosBlockedDestinations blocked;
+
+  Ptr<WifiMacQueue> queue = CreateObject<WifiMacQueue> ();
+  queue->SetAttribute ("Quantum", UintegerValue (1000));
+  queue->SetStationFairQueueing (true);
+  queue->SetDozingCallback (MakeCallback (&StationFairQueueTest::IsDozing, this));
+  m_dozing = c;
+
+  // c, which is dozing, is at the head of the queue
+  Enqueue (queue, c, 1000);
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Enqueue (queue, a, 1000);
+    }
+  Enqueue (queue, b, 1000);
+  Enqueue (queue, b, 1000);
+
+  std::set<Mac48Address> buffered;
+  queue->GetBufferedStations (buffered);
+  NS_TEST_EXPECT_MSG_EQ (buffered.size (), 3, "all the stations have buffered packets");
+
+  Mac48Address expected[6] = {a, b, a, b, a, a};
+  WifiMacHeader hdr;
+  Time tstamp;
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      Ptr<const Packet> peeked = queue->PeekFirstAvailable (&hdr, tstamp, &blocked);
+      NS_TEST_ASSERT_MSG_NE (peeked, 0, "a packet is available");
+      //peeking does not move the round robin on
+      NS_TEST_EXPECT_MSG_EQ (queue->PeekFirstAvailable (&hdr, tstamp, &blocked), peeked,
+                             "peeking again gives another packet");
+      Ptr<const Packet> packet = queue->DequeueFirstAvailable (&hdr, tstamp, &blocked);
+      NS_TEST_EXPECT_MSG_EQ (packet, peeked, "dequeued packet differs from the peeked one");
+      NS_TEST_EXPECT_MSG_EQ (hdr.GetAddr1 (), expected[i], "wrong station served at round " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (queue->PeekFirstAvailable (&hdr, tstamp, &blocked), 0,
+                         "the packet of the dozing station must be held");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetSize (), 1, "the packet of the dozing station is still queued");
+
+  // once awake, the station is served
+  m_dozing = Mac48Address ();
+  Ptr<const Packet> packet = queue->DequeueFirstAvailable (&hdr, tstamp, &blocked);
+  NS_TEST_ASSERT_MSG_NE (packet, 0, "the awake station is served");
+  NS_TEST_EXPECT_MSG_EQ (hdr.GetAddr1 (), c, "wrong station served");
+  NS_TEST_EXPECT_MSG_EQ (queue->IsEmpty (), true, "queue should be empty");
+
+  // a station whose packet is larger than a quantum waits for the rounds
+  // it takes to cover it
+  Enqueue (queue, a, 1500);
+  Enqueue (queue, a, 1500);
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Enqueue (queue, b, 500);
+    }
+  Mac48Address expectedRounds[6] = {b, b, a, b, b, a};
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      queue->PeekFirstAvailable (&hdr, tstamp, &blocked);
+      queue->DequeueFirstAvailable (&hdr, tstamp, &blocked);
+      NS_TEST_EXPECT_MSG_EQ (hdr.GetAddr1 (), expectedRounds[i], "wrong station served at round " << i);
+    }
+
+  // without the per-station scheduling, the queue is served in FIFO order
+  queue->SetStationFairQueueing (false);
+  Enqueue (queue, a, 1000);
+  Enqueue (queue, a, 1000);
+  Enqueue (queue, b, 1000);
+  queue->DequeueFirstAvailable (&hdr, tstamp, &blocked);
+  queue->DequeueFirstAvailable (&hdr, tstamp, &blocked);
+  NS_TEST_EXPECT_MSG_EQ (hdr.GetAddr1 (), a, "FIFO order expected");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * Notifications of the buffered callback of WifiMacQueue: a station is
+ * buffered from its first queued packet to the removal of its last one.
+ */
+class BufferedCallbackTest : public TestCase
+{
+public:
+  BufferedCallbackTest ();
+
+private:
+  virtual void DoRun (void);
+  void NotifyBuffered (Mac48Address address, bool buffered);
+
+  std::map<Mac48Address, bool> m_buffered;
+  uint32_t m_nNotifications;
+};
+
+BufferedCallbackTest::BufferedCallbackTest ()
+  : TestCase ("Check the buffered stations notified by the wifi MAC queue")
+{
+}
+
+void
+BufferedCallbackTest::NotifyBuffered (Mac48Address address, bool buffered)
+{
+  NS_TEST_EXPECT_MSG_NE (m_buffered[address], buffered, "notification without change for " << address);
+  m_buffered[address] = buffered;
+  m_nNotifications++;
+}
+
+void
+BufferedCallbackTest::DoRun (void)
+{
+  Mac48Address a ("00:00:00:00:00:01");
+  Mac48Address b ("00:00:00:00:00:02");
+  QosBlockedDestinations blocked;
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (0);
+  m_nNotifications = 0;
+
+  Ptr<WifiMacQueue> queue = CreateObject<WifiMacQueue> ();
+  hdr.SetAddr1 (a);
+  queue->Enqueue (Create<Packet> (100), hdr);
+  // the packets queued before the callback is set are counted
+  queue->SetBufferedCallback (MakeCallback (&BufferedCallbackTest::NotifyBuffered, this));
+  NS_TEST_EXPECT_MSG_EQ (m_buffered[a], true, "a has a packet");
+  queue->Enqueue (Create<Packet> (100), hdr);
+  hdr.SetAddr1 (b);
+  Ptr<Packet> packet = Create<Packet> (100);
+  queue->PushFront (packet, hdr);
+  NS_TEST_EXPECT_MSG_EQ (m_nNotifications, 2, "one notification per station");
+
+  queue->Remove (packet);
+  NS_TEST_EXPECT_MSG_EQ (m_buffered[b], false, "b has no packet");
+  Time tstamp;
+  queue->DequeueFirstAvailable (&hdr, tstamp, &blocked);
+  NS_TEST_EXPECT_MSG_EQ (m_buffered[a], true, "a still has a packet");
+  queue->Dequeue (&hdr);
+  NS_TEST_EXPECT_MSG_EQ (m_buffered[a], false, "a has no packet");
+
+  hdr.SetAddr1 (a);
+  queue->Enqueue (Create<Packet> (100), hdr);
+  queue->Flush ();
+  NS_TEST_EXPECT_MSG_EQ (m_buffered[a], false, "the queue was flushed");
+  NS_TEST_EXPECT_MSG_EQ (m_nNotifications, 6, "wrong number of notifications");
+
+  Simulator::Destroy ();
+}
+
+
+class WifiMacQueueTestSuite : public TestSuite
+{
+public:
+  WifiMacQueueTestSuite ();
+};
+
+WifiMacQueueTestSuite::WifiMacQueueTestSuite ()
+  : TestSuite ("wifi-mac-queue", UNIT)
+{
+  AddTestCase (new StationFairQueueTest, TestCase::QUICK);
+  AddTestCase (new BufferedCallbackTest, TestCase::QUICK);
+}
+
+static WifiMacQueueTestSuite g_wifiMacQueueTestSuite;
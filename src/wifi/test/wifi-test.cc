@@ -41,6 +41,14 @@
 #include "ns3/edca-txop-n.h"
 #include "ns3/config.h"
 #include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/ampdu-tag.h"
+#include "ns3/interference-helper.h"
+#include "ns3/simple-frame-capture-model.h"
+#include "ns3/supported-rates.h"
+#include "ns3/s1g-raw-slot-planner.h"
+#include "ns3/aid-bitmap.h"
 
 using namespace ns3;
 
@@ -471,17 +479,705 @@ Bug555TestCase::DoRun (void)
   Simulator::Run ();
   Simulator::Destroy ();
 
-  //First packet has 1408 us of transmit time.   Slot time is 9 us.
+  //First packet has 1404 us of transmit time (WifiPhy counts 8 service
+  //bits, so the 1036 bytes take 346 symbols).   Slot time is 9 us.
   //Backoff is 0 slots.  SIFS is 16 us.  AIFS is 2 slots = 18 us.
-  //Should send next packet at 1408 us + (0 * 9 us) + 16 us + 18 us
-  //1442 us after the first one.
-  uint32_t expectedWait1 = 1408 + (0 * 9) + 16 + 18;
+  //Should send next packet at 1404 us + (0 * 9 us) + 16 us + 18 us
+  //1438 us after the first one.
+  uint32_t expectedWait1 = 1404 + (0 * 9) + 16 + 18;
   Time expectedSecondTransmissionTime = MicroSeconds (expectedWait1) + Seconds (1.0);
 
   NS_TEST_ASSERT_MSG_EQ (m_secondTransmissionTime, expectedSecondTransmissionTime, "The second transmission time not correct!");
 }
 
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that an A-MPDU sent as a single PPDU, with the SinglePpduAmpdu
+ * attribute, is received as the same A-MPDU sent as one transmission per
+ * MPDU: the MPDUs hit by an interferer fail and the others are received.
+ */
+class SinglePpduAmpduTest : public TestCase
+{
+public:
+  SinglePpduAmpduTest ();
+
+  virtual void DoRun (void);
+
+private:
+  Ptr<YansWifiPhy> CreatePhy (Vector pos, Ptr<YansWifiChannel> channel, bool singlePpdu);
+  void RunOne (bool singlePpdu);
+  void SendAmpdu (Ptr<YansWifiPhy> phy);
+  void SendInterference (Ptr<YansWifiPhy> phy);
+  void RxOk (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+  void RxError (Ptr<const Packet> packet, double snr);
+
+  WifiTxVector m_txVector;
+  std::vector<uint32_t> m_rxOk;    //!< sizes of the MPDUs received
+  std::vector<uint32_t> m_rxError; //!< sizes of the MPDUs received in error
+};
+
+SinglePpduAmpduTest::SinglePpduAmpduTest ()
+  : TestCase ("A-MPDU sent as a single PPDU")
+{
+}
+
+Ptr<YansWifiPhy>
+SinglePpduAmpduTest::CreatePhy (Vector pos, Ptr<YansWifiChannel> channel, bool singlePpdu)
+{
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (pos);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetAttribute ("SinglePpduAmpdu", BooleanValue (singlePpdu));
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+  phy->SetChannelWidth (20);
+  return phy;
+}
+
+void
+SinglePpduAmpduTest::SendAmpdu (Ptr<YansWifiPhy> phy)
+{
+  std::vector<Ptr<const Packet> > mpdus;
+  AmpduTag tag;
+  tag.SetAmpdu (true);
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<Packet> mpdu = Create<Packet> (1000 + i);
+      tag.SetNoOfMpdus (3 - i);
+      mpdu->AddPacketTag (tag);
+      mpdus.push_back (mpdu);
+    }
+  phy->SendAmpdu (mpdus, m_txVector, WIFI_PREAMBLE_HT_MF);
+}
+
+void
+SinglePpduAmpduTest::SendInterference (Ptr<YansWifiPhy> phy)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetNss (1);
+  txVector.SetTxPowerLevel (0);
+  phy->SendPacket (Create<Packet> (100), txVector, WIFI_PREAMBLE_LONG, 0);
+}
+
+void
+SinglePpduAmpduTest::RxOk (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_rxOk.push_back (packet->GetSize ());
+}
+
+void
+SinglePpduAmpduTest::RxError (Ptr<const Packet> packet, double snr)
+{
+  m_rxError.push_back (packet->GetSize ());
+}
+
+void
+SinglePpduAmpduTest::RunOne (bool singlePpdu)
+{
+  m_rxOk.clear ();
+  m_rxError.clear ();
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+
+  Ptr<YansWifiPhy> tx = CreatePhy (Vector (0.0, 0.0, 0.0), channel, singlePpdu);
+  Ptr<YansWifiPhy> rx = CreatePhy (Vector (5.0, 0.0, 0.0), channel, singlePpdu);
+  Ptr<YansWifiPhy> interferer = CreatePhy (Vector (6.0, 0.0, 0.0), channel, singlePpdu);
+  rx->SetReceiveOkCallback (MakeCallback (&SinglePpduAmpduTest::RxOk, this));
+  rx->SetReceiveErrorCallback (MakeCallback (&SinglePpduAmpduTest::RxError, this));
+
+  //the interferer overlaps the middle of the second MPDU only
+  Ptr<YansWifiPhy> timing = CreatePhy (Vector (0.0, 0.0, 0.0), CreateObject<YansWifiChannel> (), false);
+  Time first = timing->CalculateTxDuration (1000, m_txVector, WIFI_PREAMBLE_HT_MF, timing->GetFrequency (), 1, 1);
+  Time second = timing->CalculateTxDuration (1001, m_txVector, WIFI_PREAMBLE_NONE, timing->GetFrequency (), 1, 1);
+
+  Simulator::Schedule (Seconds (1.0), &SinglePpduAmpduTest::SendAmpdu, this, tx);
+  Simulator::Schedule (Seconds (1.0) + first + second / 2, &SinglePpduAmpduTest::SendInterference, this, interferer);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+SinglePpduAmpduTest::DoRun (void)
+{
+  m_txVector.SetMode (WifiPhy::GetOfdmRate6_5MbpsBW20MHz ());
+  m_txVector.SetNss (1);
+  m_txVector.SetStbc (0);
+  m_txVector.SetNess (0);
+  m_txVector.SetTxPowerLevel (0);
+
+  RunOne (false);
+  std::vector<uint32_t> rxOk = m_rxOk;
+  std::vector<uint32_t> rxError = m_rxError;
+  NS_TEST_ASSERT_MSG_EQ (rxOk.size (), 2, "Two MPDUs should be received");
+  NS_TEST_ASSERT_MSG_EQ (rxError.size (), 1, "One MPDU should be received in error");
+  NS_TEST_EXPECT_MSG_EQ (rxError[0], 1001, "The second MPDU should be received in error");
+
+  RunOne (true);
+  NS_TEST_EXPECT_MSG_EQ ((m_rxOk == rxOk), true, "The single PPDU delivered other MPDUs");
+  NS_TEST_EXPECT_MSG_EQ ((m_rxError == rxError), true, "The single PPDU lost other MPDUs");
+}
+
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the InterferenceHelper reuses the storage of the events
+ * without references, that its events may outlive it, and that the
+ * signals added without an event count as interference.
+ */
+class InterferenceHelperEventPoolTest : public TestCase
+{
+public:
+  InterferenceHelperEventPoolTest ();
+
+  virtual void DoRun (void);
+};
+
+InterferenceHelperEventPoolTest::InterferenceHelperEventPoolTest ()
+  : TestCase ("InterferenceHelper event pool")
+{
+}
+
+void
+InterferenceHelperEventPoolTest::DoRun (void)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetNss (1);
+
+  InterferenceHelper *interference = new InterferenceHelper ();
+  interference->SetNoiseFigure (1.0);
+  interference->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  Ptr<const InterferenceHelper::EventPool> pool = interference->GetEventPool ();
+
+  Ptr<InterferenceHelper::Event> event = interference->Add (100, txVector, WIFI_PREAMBLE_LONG,
+                                                            MicroSeconds (100), 1e-9);
+  InterferenceHelper::Event *storage = PeekPointer (event);
+  event = 0;
+  event = interference->Add (200, txVector, WIFI_PREAMBLE_LONG, MicroSeconds (100), 1e-9);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (event), storage, "The storage of the released event is not reused");
+  NS_TEST_EXPECT_MSG_EQ (event->GetSize (), 200, "The reused event is not the new one");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetNAllocated (), 1, "A single event should have been allocated");
+
+  //the foreign signal only adds to the energy on the medium
+  interference->AddForeignSignal (txVector, MicroSeconds (300), 1e-9);
+  Time energyDuration = interference->GetEnergyDuration (1.5e-9);
+  NS_TEST_EXPECT_MSG_EQ (energyDuration, MicroSeconds (100), "Wrong duration above the threshold");
+  energyDuration = interference->GetEnergyDuration (0.5e-9);
+  NS_TEST_EXPECT_MSG_EQ (energyDuration, MicroSeconds (300), "The foreign signal is not on the medium");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetNAllocated (), 1, "The foreign signal should not have an event");
+
+  //the event outlives its InterferenceHelper
+  delete interference;
+  NS_TEST_EXPECT_MSG_EQ (event->GetSize (), 200, "The event did not outlive its InterferenceHelper");
+  event = 0;
+  Simulator::Destroy ();
+}
+
+
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that a frame much stronger than the frame being received
+ * captures the PHY with a frame capture model, as long as it arrives
+ * within the capture window.
+ */
+class FrameCaptureTest : public TestCase
+{
+public:
+  FrameCaptureTest ();
+
+  virtual void DoRun (void);
+
+private:
+  Ptr<YansWifiPhy> CreatePhy (Vector pos, Ptr<YansWifiChannel> channel);
+  void RunOne (Ptr<FrameCaptureModel> capture, Time delay);
+  void SendPacket (Ptr<YansWifiPhy> phy, uint32_t size);
+  void RxOk (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+  void RxError (Ptr<const Packet> packet, double snr);
+
+  std::vector<uint32_t> m_rxOk;    //!< sizes of the packets received
+  std::vector<uint32_t> m_rxError; //!< sizes of the packets received in error
+};
+
+FrameCaptureTest::FrameCaptureTest ()
+  : TestCase ("Frame capture")
+{
+}
+
+Ptr<YansWifiPhy>
+FrameCaptureTest::CreatePhy (Vector pos, Ptr<YansWifiChannel> channel)
+{
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (pos);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  return phy;
+}
+
+void
+FrameCaptureTest::SendPacket (Ptr<YansWifiPhy> phy, uint32_t size)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetNss (1);
+  txVector.SetTxPowerLevel (0);
+  phy->SendPacket (Create<Packet> (size), txVector, WIFI_PREAMBLE_LONG, 0);
+}
+
+void
+FrameCaptureTest::RxOk (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_rxOk.push_back (packet->GetSize ());
+}
+
+void
+FrameCaptureTest::RxError (Ptr<const Packet> packet, double snr)
+{
+  m_rxError.push_back (packet->GetSize ());
+}
+
+void
+FrameCaptureTest::RunOne (Ptr<FrameCaptureModel> capture, Time delay)
+{
+  m_rxOk.clear ();
+  m_rxError.clear ();
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+
+  //the weak frame arrives first, the strong one after the delay
+  Ptr<YansWifiPhy> rx = CreatePhy (Vector (0.0, 0.0, 0.0), channel);
+  Ptr<YansWifiPhy> weak = CreatePhy (Vector (100.0, 0.0, 0.0), channel);
+  Ptr<YansWifiPhy> strong = CreatePhy (Vector (5.0, 0.0, 0.0), channel);
+  rx->SetFrameCaptureModel (capture);
+  rx->SetReceiveOkCallback (MakeCallback (&FrameCaptureTest::RxOk, this));
+  rx->SetReceiveErrorCallback (MakeCallback (&FrameCaptureTest::RxError, this));
+
+  Simulator::Schedule (Seconds (1.0), &FrameCaptureTest::SendPacket, this, weak, 1000);
+  Simulator::Schedule (Seconds (1.0) + delay, &FrameCaptureTest::SendPacket, this, strong, 1001);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+FrameCaptureTest::DoRun (void)
+{
+  Ptr<SimpleFrameCaptureModel> capture = CreateObject<SimpleFrameCaptureModel> ();
+
+  RunOne (0, MicroSeconds (5));
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk.size (), 0, "The weak frame should not be received");
+  NS_TEST_EXPECT_MSG_EQ (m_rxError.size (), 1, "The weak frame should be received in error");
+
+  RunOne (capture, MicroSeconds (5));
+  NS_TEST_EXPECT_MSG_EQ (m_rxError.size (), 0, "The weak frame should be dropped");
+  NS_TEST_ASSERT_MSG_EQ (m_rxOk.size (), 1, "The strong frame should be received");
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk[0], 1001, "The strong frame should be received");
+
+  //after the capture window
+  RunOne (capture, MicroSeconds (50));
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk.size (), 0, "The strong frame should not capture the PHY");
+  NS_TEST_EXPECT_MSG_EQ (m_rxError.size (), 1, "The weak frame should be received in error");
+
+  //below the margin
+  capture->SetMargin (60);
+  RunOne (capture, MicroSeconds (5));
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk.size (), 0, "The strong frame should not capture the PHY");
+}
+
+
+//-----------------------------------------------------------------------------
+/**
+ * Counts the CCA busy notifications of a PHY.
+ */
+class CcaBusyListener : public WifiPhyListener
+{
+public:
+  CcaBusyListener ()
+    : m_notifications (0)
+  {
+  }
+  virtual void NotifyRxStart (Time duration)
+  {
+  }
+  virtual void NotifyRxEndOk (void)
+  {
+  }
+  virtual void NotifyRxEndError (void)
+  {
+  }
+  virtual void NotifyTxStart (Time duration, double txPowerDbm)
+  {
+  }
+  virtual void NotifyMaybeCcaBusyStart (Time duration)
+  {
+    m_notifications++;
+    m_busyEnd = Simulator::Now () + duration;
+  }
+  virtual void NotifySwitchingStart (Time duration)
+  {
+  }
+  virtual void NotifySleep (void)
+  {
+  }
+  virtual void NotifyWakeup (void)
+  {
+  }
+
+  uint32_t m_notifications; //!< number of CCA busy notifications
+  Time m_busyEnd;           //!< end of the last CCA busy period notified
+};
+
+/**
+ * A signal ending before the CCA busy period already notified does not
+ * notify the listeners again, a signal extending it does.
+ */
+class CcaBusyHorizonTest : public TestCase
+{
+public:
+  CcaBusyHorizonTest ();
+
+  virtual void DoRun (void);
+
+private:
+  Ptr<YansWifiPhy> CreatePhy (Vector pos, Ptr<YansWifiChannel> channel);
+  void SendPacket (Ptr<YansWifiPhy> phy, uint32_t size);
+  void CheckBusy (Ptr<YansWifiPhy> phy, bool busy);
+
+  CcaBusyListener m_listener; //!< listener of the receiving PHY
+};
+
+CcaBusyHorizonTest::CcaBusyHorizonTest ()
+  : TestCase ("CCA busy notifications of overlapping signals")
+{
+}
+
+Ptr<YansWifiPhy>
+CcaBusyHorizonTest::CreatePhy (Vector pos, Ptr<YansWifiChannel> channel)
+{
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (pos);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  return phy;
+}
+
+void
+CcaBusyHorizonTest::SendPacket (Ptr<YansWifiPhy> phy, uint32_t size)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetNss (1);
+  txVector.SetTxPowerLevel (0);
+  phy->SendPacket (Create<Packet> (size), txVector, WIFI_PREAMBLE_LONG, 0);
+}
+
+void
+CcaBusyHorizonTest::CheckBusy (Ptr<YansWifiPhy> phy, bool busy)
+{
+  bool ccaBusy = phy->IsStateCcaBusy ();
+  bool notified = m_listener.m_busyEnd > Simulator::Now ();
+  NS_TEST_EXPECT_MSG_EQ (ccaBusy, busy, "Wrong CCA state");
+  NS_TEST_EXPECT_MSG_EQ (notified, busy, "Wrong CCA busy period notified");
+}
+
+void
+CcaBusyHorizonTest::DoRun (void)
+{
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+
+  //the receiver cannot synchronize on any of the signals
+  Ptr<YansWifiPhy> rx = CreatePhy (Vector (0.0, 0.0, 0.0), channel);
+  rx->SetEdThreshold (0.0);
+  rx->RegisterListener (&m_listener);
+  Ptr<YansWifiPhy> first = CreatePhy (Vector (10.0, 0.0, 0.0), channel);
+  Ptr<YansWifiPhy> inner = CreatePhy (Vector (0.0, 10.0, 0.0), channel);
+  Ptr<YansWifiPhy> last = CreatePhy (Vector (-10.0, 0.0, 0.0), channel);
+
+  //the second signal ends within the first one, the third one ends after it
+  Simulator::Schedule (Seconds (1.0), &CcaBusyHorizonTest::SendPacket, this, first, 1000);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (100), &CcaBusyHorizonTest::SendPacket, this, inner, 100);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (500), &CcaBusyHorizonTest::SendPacket, this, last, 1500);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (2200), &CcaBusyHorizonTest::CheckBusy, this, rx, true);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (3000), &CcaBusyHorizonTest::CheckBusy, this, rx, false);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_listener.m_notifications, 2, "Wrong number of CCA busy notifications");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * With tiles, only the PHYs near the sender receive its packets, the
+ * PHYs of far tiles only sense the signal.
+ */
+class TiledChannelTest : public TestCase
+{
+public:
+  TiledChannelTest ();
+
+  virtual void DoRun (void);
+
+private:
+  Ptr<YansWifiPhy> CreatePhy (Vector pos, Ptr<YansWifiChannel> channel);
+  void RunOne (uint32_t nearTiles, double farTileThreshold);
+  void SendPacket (Ptr<YansWifiPhy> phy);
+  void RxOk (uint32_t phy, Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble);
+  void CheckCcaBusy (Ptr<YansWifiPhy> phy);
+
+  uint32_t m_rxOk[2];   //!< packets received by the near and the far PHYs
+  bool m_farCcaBusy;    //!< whether the far PHY sensed the packet
+};
+
+TiledChannelTest::TiledChannelTest ()
+  : TestCase ("Tiled YansWifiChannel")
+{
+}
+
+Ptr<YansWifiPhy>
+TiledChannelTest::CreatePhy (Vector pos, Ptr<YansWifiChannel> channel)
+{
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (pos);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetChannel (channel);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  return phy;
+}
+
+void
+TiledChannelTest::SendPacket (Ptr<YansWifiPhy> phy)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+  txVector.SetNss (1);
+  txVector.SetTxPowerLevel (0);
+  phy->SendPacket (Create<Packet> (1000), txVector, WIFI_PREAMBLE_LONG, 0);
+}
+
+void
+TiledChannelTest::RxOk (uint32_t phy, Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
+{
+  m_rxOk[phy]++;
+}
+
+void
+TiledChannelTest::CheckCcaBusy (Ptr<YansWifiPhy> phy)
+{
+  m_farCcaBusy = phy->IsStateCcaBusy ();
+}
+
+void
+TiledChannelTest::RunOne (uint32_t nearTiles, double farTileThreshold)
+{
+  m_rxOk[0] = 0;
+  m_rxOk[1] = 0;
+  m_farCcaBusy = false;
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetAttribute ("TileSize", DoubleValue (50.0));
+  channel->SetAttribute ("NearTiles", UintegerValue (nearTiles));
+  channel->SetAttribute ("FarTileThreshold", DoubleValue (farTileThreshold));
+
+  //the far PHY is in the next tile, close enough to receive the packet
+  Ptr<YansWifiPhy> sender = CreatePhy (Vector (10.0, 10.0, 0.0), channel);
+  Ptr<YansWifiPhy> nearPhy = CreatePhy (Vector (20.0, 10.0, 0.0), channel);
+  Ptr<YansWifiPhy> farPhy = CreatePhy (Vector (60.0, 10.0, 0.0), channel);
+  nearPhy->SetReceiveOkCallback (MakeCallback (&TiledChannelTest::RxOk, this).Bind (0));
+  farPhy->SetReceiveOkCallback (MakeCallback (&TiledChannelTest::RxOk, this).Bind (1));
+
+  Simulator::Schedule (Seconds (1.0), &TiledChannelTest::SendPacket, this, sender);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (500), &TiledChannelTest::CheckCcaBusy, this, farPhy);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+TiledChannelTest::DoRun (void)
+{
+  RunOne (0, -200.0);
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk[0], 1, "The near PHY should receive the packet");
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk[1], 0, "The far PHY should not receive the packet");
+  NS_TEST_EXPECT_MSG_EQ (m_farCcaBusy, true, "The far PHY should sense the packet");
+
+  RunOne (0, -70.0);
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk[1], 0, "The far PHY should not receive the packet");
+  NS_TEST_EXPECT_MSG_EQ (m_farCcaBusy, false, "The far PHY should not sense the packet");
+
+  RunOne (1, -200.0);
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk[0], 1, "The near PHY should receive the packet");
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk[1], 1, "The PHY of the next tile should receive the packet");
+}
+
+//-----------------------------------------------------------------------------
+/**
+ * The rate sets of a supported rates element agree with IsSupportedRate
+ * and IsBasicRate.
+ */
+class SupportedRatesSetTest : public TestCase
+{
+public:
+  SupportedRatesSetTest ();
+
+  virtual void DoRun (void);
+};
+
+SupportedRatesSetTest::SupportedRatesSetTest ()
+  : TestCase ("Rate sets of a supported rates element")
+{
+}
+
+void
+SupportedRatesSetTest::DoRun (void)
+{
+  SupportedRates rates;
+  rates.AddSupportedRate (300000);
+  rates.AddSupportedRate (6000000);
+  rates.AddSupportedRate (54000000);
+  rates.AddSupportedRate (150000000);
+  rates.SetBasicRate (12000000);
+  rates.SetBasicRate (127 * 500000);
+  SupportedRates::RateSet supported = rates.GetSupportedRateSet ();
+  SupportedRates::RateSet basic = rates.GetBasicRateSet ();
+  for (uint32_t bs = 0; bs < 160000000; bs += 250000)
+    {
+      uint8_t index = SupportedRates::GetRateIndex (bs);
+      bool isSupported = supported.test (index);
+      bool isBasic = basic.test (index);
+      NS_TEST_EXPECT_MSG_EQ (isSupported, rates.IsSupportedRate (bs), "Wrong supported rate set for " << bs);
+      NS_TEST_EXPECT_MSG_EQ (isBasic, rates.IsBasicRate (bs), "Wrong basic rate set for " << bs);
+    }
+}
+
+//-----------------------------------------------------------------------------
+class RawSlotPlannerTest : public TestCase
+{
+public:
+  RawSlotPlannerTest ();
+
+  virtual void DoRun (void);
+};
+
+RawSlotPlannerTest::RawSlotPlannerTest ()
+  : TestCase ("RAW slot durations from the airtime of the exchanges")
+{
+}
+
+void
+RawSlotPlannerTest::DoRun (void)
+{
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211a);
+  WifiMode mode = WifiPhy::GetOfdmRate6Mbps ();
+
+  S1gRawSlotPlanner planner;
+  planner.SetPhy (phy);
+  // DATA of 24 + 100 + 4 bytes in 196 us, SIFS and ACK of 14 bytes in 44 us
+  Time exchange = planner.GetExchangeDuration (mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (exchange, MicroSeconds (400), "Wrong exchange duration");
+  exchange = planner.GetExchangeDuration (mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (exchange, MicroSeconds (400), "Wrong memoized exchange duration");
+
+  uint32_t count = planner.GetSlotDurationCount (1, 100, mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (count, 0, "An exchange fits in the shortest slot");
+  count = planner.GetSlotDurationCount (20, 100, mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (count, 63, "Wrong slot duration count for 8000 us");
+  count = planner.GetSlotDurationCount (10, 50, mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (count, 63, "Wrong slot duration count with retransmissions");
+
+  RawSlotPlan plan = planner.PlanSlots (20, 100, mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (plan.slotNum, 1, "Wrong number of slots");
+  NS_TEST_EXPECT_MSG_EQ (plan.slotDurationCount, 63, "Wrong slot duration count");
+  // 400 ms of exchanges do not fit in a slot of count 2047
+  plan = planner.PlanSlots (1000, 100, mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (plan.slotNum, 2, "Wrong number of slots");
+  NS_TEST_EXPECT_MSG_EQ (plan.slotDurationCount, 1663, "Wrong slot duration count");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t) plan.slotFormat, 1, "Wrong slot format");
+  // 246000 us of exchanges fit in a slot of count 2046, the largest being 2047
+  plan = planner.PlanSlots (615, 100, mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (plan.slotNum, 1, "Wrong number of slots at the largest count");
+  NS_TEST_EXPECT_MSG_EQ (plan.slotDurationCount, 2046, "Wrong slot duration count at the largest count");
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (plan.slotDurationCount, S1gRawSlotPlanner::MAX_SLOT_DURATION_COUNT, "Slot duration count past the largest one");
+  // one more exchange needs a count of 2050
+  plan = planner.PlanSlots (616, 100, mode, 100);
+  NS_TEST_EXPECT_MSG_EQ (plan.slotNum, 2, "Wrong number of slots past the largest count");
+  NS_TEST_EXPECT_MSG_EQ (plan.slotDurationCount, 1023, "Wrong slot duration count past the largest count");
+
+  planner.SetPsPoll (true);
+  exchange = planner.GetExchangeDuration (mode, 100);
+  // PS-Poll of 20 bytes in 52 us and SIFS
+  NS_TEST_EXPECT_MSG_EQ (exchange, MicroSeconds (612), "Wrong exchange duration with PS-Poll");
+}
+
+//-----------------------------------------------------------------------------
+class AidBitmapTest : public TestCase
+{
+public:
+  AidBitmapTest ();
+
+  virtual void DoRun (void);
+};
+
+AidBitmapTest::AidBitmapTest ()
+  : TestCase ("Hierarchical bitmap of the AIDs of a TIM")
+{
+}
+
+void
+AidBitmapTest::DoRun (void)
+{
+  AidBitmap aids;
+  NS_TEST_EXPECT_MSG_EQ (aids.IsEmpty (), true, "A new bitmap is empty");
+
+  // page 3, block 31, subblock 7, AID 7 and page 0, block 1, subblocks 0 and 2
+  aids.Set (8191);
+  aids.Set (AidBitmap::GetAid (0, 1, 0, 5));
+  aids.Set (AidBitmap::GetAid (0, 1, 2, 0));
+  aids.Set (AidBitmap::GetAid (0, 1, 2, 3));
+  uint32_t pages = aids.GetPageBitmap ();
+  NS_TEST_EXPECT_MSG_EQ (pages, 0x09, "Wrong page bitmap");
+  uint32_t blocks = aids.GetBlockBitmap (3);
+  NS_TEST_EXPECT_MSG_EQ (blocks, 0x80000000u, "Wrong block bitmap of page 3");
+  blocks = aids.GetBlockBitmap (0);
+  NS_TEST_EXPECT_MSG_EQ (blocks, 0x02, "Wrong block bitmap of page 0");
+  uint32_t subblocks = aids.GetSubblockBitmap (0, 1);
+  NS_TEST_EXPECT_MSG_EQ (subblocks, 0x05, "Wrong subblock bitmap");
+  uint32_t bitmap = aids.GetAidBitmap (0, 1, 2);
+  NS_TEST_EXPECT_MSG_EQ (bitmap, 0x09, "Wrong AID bitmap");
+  NS_TEST_EXPECT_MSG_EQ (aids.IsSet (8191), true, "AID 8191 is set");
+  NS_TEST_EXPECT_MSG_EQ (aids.IsSet (8190), false, "AID 8190 is not set");
+
+  // the summaries are cleared with their last AID only
+  aids.Clear (AidBitmap::GetAid (0, 1, 2, 0));
+  subblocks = aids.GetSubblockBitmap (0, 1);
+  NS_TEST_EXPECT_MSG_EQ (subblocks, 0x05, "Subblock 2 still has an AID");
+  aids.Clear (AidBitmap::GetAid (0, 1, 2, 3));
+  subblocks = aids.GetSubblockBitmap (0, 1);
+  NS_TEST_EXPECT_MSG_EQ (subblocks, 0x01, "Subblock 2 is empty");
+  aids.Clear (AidBitmap::GetAid (0, 1, 0, 5));
+  pages = aids.GetPageBitmap ();
+  NS_TEST_EXPECT_MSG_EQ (pages, 0x08, "Page 0 is empty");
+  aids.Clear (8191);
+  NS_TEST_EXPECT_MSG_EQ (aids.IsEmpty (), true, "The bitmap is empty");
+}
+
 //-----------------------------------------------------------------------------
 class WifiTestSuite : public TestSuite
 {
@@ -496,6 +1192,14 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new QosUtilsIsOldPacketTest, TestCase::QUICK);
   AddTestCase (new InterferenceHelperSequenceTest, TestCase::QUICK); //Bug 991
   AddTestCase (new Bug555TestCase, TestCase::QUICK); //Bug 555
+  AddTestCase (new InterferenceHelperEventPoolTest, TestCase::QUICK);
+  AddTestCase (new SinglePpduAmpduTest, TestCase::QUICK);
+  AddTestCase (new FrameCaptureTest, TestCase::QUICK);
+  AddTestCase (new CcaBusyHorizonTest, TestCase::QUICK);
+  AddTestCase (new TiledChannelTest, TestCase::QUICK);
+  AddTestCase (new SupportedRatesSetTest, TestCase::QUICK);
+  AddTestCase (new RawSlotPlannerTest, TestCase::QUICK);
+  AddTestCase (new AidBitmapTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite;
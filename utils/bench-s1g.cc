@@ -0,0 +1,596 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Benchmarks of the 802.11ah code paths.
+ *
+ * Each run prints one JSON object per line, e.g.
+ *
+ *   {"bench": "tim", "stations": 1024, "events": 1000, "wallMs": 12, ...}
+ *
+ * where "events" counts the operations of the benchmark (the beacons
+ * built, the simulator events scheduled, ...), "peakRssKb" is the peak
+ * resident size of the process so far and "allocations" and
+ * "allocatedBytes" count the calls to operator new during the run.
+ * utils/bench-s1g.py runs each benchmark in a process of its own, as
+ * well as a short s1g-rca scenario, and collects the results.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/extension-headers.h"
+#include "ns3/interference-helper.h"
+#include "ns3/rps.h"
+#include "ns3/pageSlice.h"
+#include "ns3/tim.h"
+#include "ns3/aid-bitmap.h"
+#include <sys/resource.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+static uint64_t g_allocations = 0;    //!< Calls to operator new
+static uint64_t g_allocatedBytes = 0; //!< Bytes requested from operator new
+
+void *
+operator new (size_t size)
+{
+  g_allocations++;
+  g_allocatedBytes += size;
+  void *p = malloc (size == 0 ? 1 : size);
+  if (p == 0)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void
+operator delete (void *p) throw ()
+{
+  free (p);
+}
+
+/**
+ * Measures a benchmark run and prints its result as a JSON object.
+ */
+class BenchRun
+{
+public:
+  /**
+   * Start measuring.
+   * \param bench the name of the benchmark
+   * \param parameters the parameters of the run, as JSON members
+   */
+  BenchRun (std::string bench, std::string parameters);
+  /**
+   * Stop measuring and print the result.
+   * \param events the operations done by the benchmark
+   */
+  void Report (uint64_t events);
+
+private:
+  std::string m_bench;
+  std::string m_parameters;
+  SystemWallClockMs m_clock;
+  uint64_t m_allocations;
+  uint64_t m_allocatedBytes;
+};
+
+BenchRun::BenchRun (std::string bench, std::string parameters)
+  : m_bench (bench),
+    m_parameters (parameters),
+    m_allocations (g_allocations),
+    m_allocatedBytes (g_allocatedBytes)
+{
+  m_clock.Start ();
+}
+
+void
+BenchRun::Report (uint64_t events)
+{
+  int64_t wallMs = m_clock.End ();
+  uint64_t allocations = g_allocations - m_allocations;
+  uint64_t allocatedBytes = g_allocatedBytes - m_allocatedBytes;
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+  std::cout << "{\"bench\": \"" << m_bench << "\", " << m_parameters
+            << ", \"events\": " << events
+            << ", \"wallMs\": " << wallMs
+            << ", \"eventsPerSec\": " << (wallMs > 0 ? uint64_t (events * 1000.0 / wallMs) : events * 1000)
+            << ", \"peakRssKb\": " << usage.ru_maxrss
+            << ", \"allocations\": " << allocations
+            << ", \"allocatedBytes\": " << allocatedBytes
+            << "}" << std::endl;
+}
+
+static void
+DoNothing (void)
+{
+}
+
+/**
+ * \return the number of events scheduled since the simulator was created
+ */
+static uint64_t
+GetScheduledEvents (void)
+{
+  return Simulator::ScheduleNow (&DoNothing).GetUid ();
+}
+
+/**
+ * \param list comma separated numbers
+ * \return the numbers
+ */
+static std::vector<uint32_t>
+ParseList (std::string list)
+{
+  std::vector<uint32_t> values;
+  std::istringstream iss (list);
+  std::string value;
+  while (std::getline (iss, value, ','))
+    {
+      values.push_back (atoi (value.c_str ()));
+    }
+  return values;
+}
+
+// ===========================================================================
+// Beacon TIM construction, with the encoder of ApWifiMac::SendOneBeacon:
+// every page of the stations is split in slices of sliceLength blocks,
+// each slice being announced in the TIM of a beacon of its own. The run
+// aborts if building the elements of a beacon allocates memory.
+// ===========================================================================
+
+static void
+BenchTim (uint32_t stations, uint32_t beacons, uint32_t pagedPeriod, uint32_t sliceLength)
+{
+  std::ostringstream parameters;
+  parameters << "\"stations\": " << stations << ", \"pagedPeriod\": " << pagedPeriod
+             << ", \"sliceLength\": " << sliceLength;
+  BenchRun run ("tim", parameters.str ());
+
+  // 8 stations per subblock, 8 subblocks per block, 32 blocks per page
+  uint32_t pages = (stations + 2047) / 2048;
+  uint32_t slices = (32 + sliceLength - 1) / sliceLength;
+  uint64_t built = 0;
+  uint64_t elementAllocations = 0;
+  AidBitmap buffered;
+  for (uint32_t beacon = 0; beacon < beacons; beacon++)
+    {
+      for (uint32_t aid = 1; aid <= stations; aid++)
+        {
+          if ((aid + beacon) % pagedPeriod == 0)
+            {
+              buffered.Set (aid);
+            }
+          else
+            {
+              buffered.Clear (aid);
+            }
+        }
+      for (uint32_t page = 0; page < pages; page++)
+        {
+          // the page slice element of the DTIM beacon tells which blocks are paged
+          pageSlice slice;
+          slice.SetPageindex (page);
+          slice.SetPagePeriod (slices);
+          slice.SetPageSliceLen (sliceLength);
+          slice.SetPageSliceCount (slices);
+          slice.SetPageBitmap (buffered.GetBlockBitmap (page));
+
+          for (uint32_t s = 0; s < slices; s++)
+            {
+              // the elements are built the way the AP builds them, with
+              // the encoder it calls, and must not allocate
+              uint64_t allocations = g_allocations;
+              TIM tim;
+              tim.SetPageIndex (page);
+              tim.SetPageSliceNum (s);
+              tim.SetDTIMPeriod (slices);
+              tim.SetDTIMCount (s);
+              uint32_t offset = s * sliceLength;
+              tim.AddEncodedBlocks (buffered, page, offset, std::min<uint32_t> (sliceLength, 32 - offset));
+              S1gBeaconHeader header;
+              header.SetTIM (tim);
+              if (s == 0)
+                {
+                  header.SetpageSlice (slice);
+                }
+              elementAllocations += g_allocations - allocations;
+              Ptr<Packet> packet = Create<Packet> ();
+              packet->AddHeader (header);
+              built++;
+            }
+        }
+    }
+  NS_ABORT_MSG_IF (elementAllocations != 0, "The TIM and page slice elements of the beacons allocated memory "
+                   << elementAllocations << " times");
+  run.Report (built);
+}
+
+// ===========================================================================
+// Uplink contention of the stations of a single RAW group.
+// ===========================================================================
+
+/**
+ * A station sending a frame to the AP every interval while it is
+ * associated.
+ */
+class RawStation : public SimpleRefCount<RawStation>
+{
+public:
+  RawStation (Ptr<WifiNetDevice> device, Address ap, Time interval);
+
+private:
+  void Associated (Mac48Address address);
+  void Deassociated (Mac48Address address);
+  void Send (void);
+
+  Ptr<WifiNetDevice> m_device;
+  Address m_ap;
+  Time m_interval;
+  bool m_associated;
+};
+
+RawStation::RawStation (Ptr<WifiNetDevice> device, Address ap, Time interval)
+  : m_device (device),
+    m_ap (ap),
+    m_interval (interval),
+    m_associated (false)
+{
+  device->GetMac ()->TraceConnectWithoutContext ("Assoc", MakeCallback (&RawStation::Associated, this));
+  device->GetMac ()->TraceConnectWithoutContext ("DeAssoc", MakeCallback (&RawStation::Deassociated, this));
+  Ptr<UniformRandomVariable> start = CreateObject<UniformRandomVariable> ();
+  Simulator::Schedule (Seconds (start->GetValue (0, interval.GetSeconds ())), &RawStation::Send, this);
+}
+
+void
+RawStation::Associated (Mac48Address address)
+{
+  m_associated = true;
+}
+
+void
+RawStation::Deassociated (Mac48Address address)
+{
+  m_associated = false;
+}
+
+void
+RawStation::Send (void)
+{
+  if (m_associated)
+    {
+      m_device->Send (Create<Packet> (100), m_ap, 0x88b5);
+    }
+  Simulator::Schedule (m_interval, &RawStation::Send, this);
+}
+
+static void
+BenchRaw (uint32_t stations, uint32_t slots, double seconds, Time interval)
+{
+  std::ostringstream parameters;
+  parameters << "\"stations\": " << stations << ", \"slots\": " << slots
+             << ", \"simulatedSec\": " << seconds;
+  BenchRun run ("raw", parameters.str ());
+
+  NodeContainer staNodes;
+  staNodes.Create (stations);
+  NodeContainer apNode;
+  apNode.Create (1);
+
+  YansWifiChannelHelper channelBuilder;
+  channelBuilder.AddPropagationLoss ("ns3::LogDistancePropagationLossModel",
+                                     "Exponent", DoubleValue (3.76),
+                                     "ReferenceLoss", DoubleValue (8.0),
+                                     "ReferenceDistance", DoubleValue (1.0));
+  channelBuilder.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetErrorRateModel ("ns3::YansErrorRateModel");
+  phy.SetChannel (channelBuilder.Create ());
+  phy.Set ("ChannelWidth", UintegerValue (1));
+  phy.Set ("EnergyDetectionThreshold", DoubleValue (-110.0));
+  phy.Set ("CcaMode1Threshold", DoubleValue (-113.0));
+  phy.Set ("TxPowerEnd", DoubleValue (0.0));
+  phy.Set ("TxPowerStart", DoubleValue (0.0));
+  phy.Set ("RxNoiseFigure", DoubleValue (6.8));
+
+  WifiHelper wifi = WifiHelper::Default ();
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ah);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate300KbpsBW1MHz"),
+                                "ControlMode", StringValue ("OfdmRate300KbpsBW1MHz"));
+  S1gWifiMacHelper mac = S1gWifiMacHelper::Default ();
+  Ssid ssid ("bench-s1g");
+  mac.SetType ("ns3::StaWifiMac", "Ssid", SsidValue (ssid), "ActiveProbing", BooleanValue (false));
+  NetDeviceContainer staDevices = wifi.Install (phy, mac, staNodes);
+
+  // a single RAW group of all the stations, whose slots fill the beacon interval
+  uint32_t beaconInterval = 102400;
+  RPS::RawAssignment raw;
+  raw.SetRawControl (0);
+  raw.SetSlotCrossBoundary (1);
+  raw.SetSlotFormat (1);
+  raw.SetSlotDurationCount (std::min<uint32_t> ((beaconInterval / slots - 500) / 120, 2047));
+  raw.SetSlotNum (slots);
+  raw.SetRawGroup ((stations << 13) | (1 << 2));
+  RPS rps;
+  rps.SetRawAssignment (raw);
+  RPSVector rpsVector;
+  rpsVector.rpsset.push_back (rps);
+  pageSlice slice;
+  slice.SetPageindex (0);
+  slice.SetPagePeriod (1);
+  slice.SetPageSliceLen (1);
+  slice.SetPageSliceCount (1);
+  slice.SetBlockOffset (0);
+  slice.SetTIMOffset (0);
+  TIM tim;
+  tim.SetPageIndex (0);
+  tim.SetDTIMPeriod (1);
+  mac.SetType ("ns3::ApWifiMac",
+               "Ssid", SsidValue (ssid),
+               "BeaconInterval", TimeValue (MicroSeconds (beaconInterval)),
+               "NRawStations", UintegerValue (stations),
+               "RPSsetup", RPSVectorValue (rpsVector),
+               "PageSliceSet", pageSliceValue (slice),
+               "TIMSet", TIMValue (tim));
+  phy.Set ("TxPowerEnd", DoubleValue (30.0));
+  phy.Set ("TxPowerStart", DoubleValue (30.0));
+  NetDeviceContainer apDevice = wifi.Install (phy, mac, apNode);
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::UniformDiscPositionAllocator",
+                                 "X", StringValue ("0"), "Y", StringValue ("0"),
+                                 "rho", StringValue ("50"));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (staNodes);
+  MobilityHelper apMobility;
+  apMobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  apMobility.Install (apNode);
+
+  std::vector<Ptr<RawStation> > traffic;
+  for (uint32_t i = 0; i < stations; i++)
+    {
+      traffic.push_back (Create<RawStation> (DynamicCast<WifiNetDevice> (staDevices.Get (i)),
+                                             apDevice.Get (0)->GetAddress (), interval));
+    }
+  Simulator::Stop (Seconds (seconds));
+  Simulator::Run ();
+  uint64_t events = GetScheduledEvents ();
+  Simulator::Destroy ();
+  run.Report (events);
+}
+
+// ===========================================================================
+// Reception through the InterferenceHelper, with a given number of
+// signals overlapping at any time.
+// ===========================================================================
+
+/**
+ * A receiver locking on a frame when idle and adding all the others to
+ * the interference, as YansWifiPhy does.
+ */
+class InterferenceBench
+{
+public:
+  InterferenceBench (uint32_t overlap, uint32_t frames);
+  /** \return the number of signals added and receptions evaluated */
+  uint64_t Run (void);
+
+private:
+  void StartFrame (void);
+  void EndReception (Ptr<InterferenceHelper::Event> event);
+
+  InterferenceHelper m_interference;
+  WifiTxVector m_txVector;
+  Time m_duration;
+  uint32_t m_overlap;
+  uint32_t m_frames;
+  uint32_t m_sent;
+  uint64_t m_operations;
+  bool m_rxing;
+};
+
+InterferenceBench::InterferenceBench (uint32_t overlap, uint32_t frames)
+  : m_duration (MicroSeconds (4000)),
+    m_overlap (overlap),
+    m_frames (frames),
+    m_sent (0),
+    m_operations (0),
+    m_rxing (false)
+{
+  m_interference.SetNoiseFigure (std::pow (10.0, 0.68));
+  m_interference.SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  m_txVector.SetMode (WifiPhy::GetOfdmRate300KbpsBW1MHz ());
+  m_txVector.SetNss (1);
+}
+
+uint64_t
+InterferenceBench::Run (void)
+{
+  Simulator::ScheduleNow (&InterferenceBench::StartFrame, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return m_operations;
+}
+
+void
+InterferenceBench::StartFrame (void)
+{
+  // the power of the signals alternates between a strong and a weak one
+  double rxPowerW = (m_sent % 2 == 0) ? 1e-9 : 1e-11;
+  if (!m_rxing)
+    {
+      Ptr<InterferenceHelper::Event> event = m_interference.Add (100, m_txVector, WIFI_PREAMBLE_S1G_SHORT,
+                                                                 m_duration, rxPowerW);
+      m_rxing = true;
+      m_interference.NotifyRxStart ();
+      Simulator::Schedule (m_duration, &InterferenceBench::EndReception, this, event);
+    }
+  else
+    {
+      m_interference.AddForeignSignal (m_txVector, m_duration, rxPowerW);
+    }
+  m_interference.GetEnergyDuration (5e-17);
+  m_operations++;
+  if (++m_sent < m_frames)
+    {
+      Simulator::Schedule (m_duration / m_overlap, &InterferenceBench::StartFrame, this);
+    }
+}
+
+void
+InterferenceBench::EndReception (Ptr<InterferenceHelper::Event> event)
+{
+  m_interference.CalculatePlcpHeaderSnrPer (event);
+  m_interference.CalculatePlcpPayloadSnrPer (event);
+  m_interference.NotifyRxEnd ();
+  m_rxing = false;
+  m_operations++;
+}
+
+static void
+BenchInterference (uint32_t overlap, uint32_t frames)
+{
+  std::ostringstream parameters;
+  parameters << "\"overlap\": " << overlap;
+  BenchRun run ("interference", parameters.str ());
+  InterferenceBench bench (overlap, frames);
+  run.Report (bench.Run ());
+}
+
+// ===========================================================================
+// Lookups of the remote station manager of an AP with many stations.
+// ===========================================================================
+
+static void
+BenchStationManager (uint32_t stations, uint32_t lookups)
+{
+  std::ostringstream parameters;
+  parameters << "\"stations\": " << stations;
+  BenchRun run ("station-manager", parameters.str ());
+
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211ah);
+  Ptr<WifiRemoteStationManager> manager = CreateObjectWithAttributes<ConstantRateWifiManager>
+      ("DataMode", StringValue ("OfdmRate300KbpsBW1MHz"),
+       "ControlMode", StringValue ("OfdmRate300KbpsBW1MHz"));
+  manager->SetupPhy (phy);
+
+  std::vector<Mac48Address> addresses;
+  for (uint32_t i = 0; i < stations; i++)
+    {
+      addresses.push_back (Mac48Address::Allocate ());
+      manager->RecordGotAssocTxOk (addresses.back ());
+    }
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  Ptr<Packet> packet = Create<Packet> (100);
+  Ptr<UniformRandomVariable> pick = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < lookups; i++)
+    {
+      Mac48Address address = addresses[pick->GetInteger (0, stations - 1)];
+      hdr.SetAddr1 (address);
+      NS_ABORT_IF (!manager->IsAssociated (address));
+      WifiTxVector txVector = manager->GetDataTxVector (address, &hdr, packet, 128);
+      manager->ReportDataOk (address, &hdr, 10.0, txVector.GetMode (), 10.0);
+    }
+  manager->Dispose ();
+  phy->Dispose ();
+  run.Report (lookups);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  std::string bench = "all";
+  std::string timStations = "1024,4096,8192";
+  uint32_t beacons = 10000;
+  uint32_t pagedPeriod = 10;
+  uint32_t sliceLength = 8;
+  std::string rawStations = "32,128";
+  uint32_t slots = 4;
+  double rawSeconds = 10;
+  double interval = 1;
+  std::string overlaps = "1,4,16";
+  uint32_t frames = 100000;
+  std::string managerStations = "64,1024,8192";
+  uint32_t lookups = 1000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the 802.11ah code paths.\n"
+             "\n"
+             "The result of each benchmark is printed as a JSON object per line.");
+  cmd.AddValue ("bench", "benchmark to run: tim, raw, interference, station-manager or all", bench);
+  cmd.AddValue ("timStations", "stations of the TIM benchmarks", timStations);
+  cmd.AddValue ("beacons", "beacons built by the TIM benchmarks", beacons);
+  cmd.AddValue ("pagedPeriod", "one station out of pagedPeriod has buffered frames", pagedPeriod);
+  cmd.AddValue ("sliceLength", "blocks announced by the TIM of a beacon", sliceLength);
+  cmd.AddValue ("rawStations", "stations of the RAW benchmarks", rawStations);
+  cmd.AddValue ("slots", "slots of the RAW group", slots);
+  cmd.AddValue ("rawSeconds", "simulated time of the RAW benchmarks", rawSeconds);
+  cmd.AddValue ("interval", "seconds between two frames of a station in the RAW benchmarks", interval);
+  cmd.AddValue ("overlaps", "signals overlapping in the interference benchmarks", overlaps);
+  cmd.AddValue ("frames", "signals of the interference benchmarks", frames);
+  cmd.AddValue ("managerStations", "stations of the station manager benchmarks", managerStations);
+  cmd.AddValue ("lookups", "lookups of the station manager benchmarks", lookups);
+  cmd.Parse (argc, argv);
+
+  if (bench == "tim" || bench == "all")
+    {
+      std::vector<uint32_t> stations = ParseList (timStations);
+      for (uint32_t i = 0; i < stations.size (); i++)
+        {
+          BenchTim (stations[i], beacons, pagedPeriod, sliceLength);
+        }
+    }
+  if (bench == "raw" || bench == "all")
+    {
+      std::vector<uint32_t> stations = ParseList (rawStations);
+      for (uint32_t i = 0; i < stations.size (); i++)
+        {
+          BenchRaw (stations[i], slots, rawSeconds, Seconds (interval));
+        }
+    }
+  if (bench == "interference" || bench == "all")
+    {
+      std::vector<uint32_t> overlap = ParseList (overlaps);
+      for (uint32_t i = 0; i < overlap.size (); i++)
+        {
+          BenchInterference (overlap[i], frames);
+        }
+    }
+  if (bench == "station-manager" || bench == "all")
+    {
+      std::vector<uint32_t> stations = ParseList (managerStations);
+      for (uint32_t i = 0; i < stations.size (); i++)
+        {
+          BenchStationManager (stations[i], lookups);
+        }
+    }
+  return 0;
+}
@@ -0,0 +1,111 @@
+#!/usr/bin/env python
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+
+# Runs the 802.11ah benchmarks of utils/bench-s1g.cc, each of them in a
+# process of its own so that the peak RSS is the one of the benchmark,
+# and a short s1g-rca scenario, and writes their results as a JSON
+# document so that they can be compared from one revision to another:
+#
+#   ./waf build
+#   ./utils/bench-s1g.py --output=bench-$(git rev-parse --short HEAD).json
+
+import glob
+import json
+import optparse
+import os
+import subprocess
+import sys
+import time
+
+# (benchmark, option giving its sizes, sizes)
+BENCHMARKS = [
+    ('tim', 'timStations', ['1024', '4096', '8192']),
+    ('raw', 'rawStations', ['32', '128']),
+    ('interference', 'overlaps', ['1', '4', '16']),
+    ('station-manager', 'managerStations', ['64', '1024', '8192']),
+]
+
+QUICK_OPTIONS = {
+    'tim': ['--beacons=1000'],
+    'raw': ['--rawSeconds=2'],
+    'interference': ['--frames=10000'],
+    'station-manager': ['--lookups=100000'],
+}
+
+RCA_ARGS = ['--simulationTime=10', '--Nsta=32', '--NRawSta=32',
+            '--RAWConfigFile=./OptimalRawGroup/RawConfig-32-2-2-51200-1-0.txt',
+            '--TrafficPath=./OptimalRawGroup/traffic/data-32-0.82.txt',
+            '--BeaconInterval=51200', '--pageSliceCount=1', '--pageSliceLength=1',
+            '--pagePeriod=1']
+
+
+def run(command, env):
+    """Run a command, returning its output, its wall time in ms and its
+    peak RSS in kB."""
+    start = time.time()
+    process = subprocess.Popen(command, stdout=subprocess.PIPE,
+                               stderr=open(os.devnull, 'w'), env=env)
+    output = process.stdout.read()
+    status, usage = os.wait4(process.pid, 0)[1:]
+    wall = int((time.time() - start) * 1000)
+    if status != 0:
+        sys.stderr.write('%s failed with status %d\n' % (' '.join(command), status))
+    return output.decode('utf-8', 'replace'), wall, usage.ru_maxrss
+
+
+def main(argv):
+    parser = optparse.OptionParser()
+    parser.add_option('--build-dir', default='build',
+                      help='directory of the ns-3 build (default: build)')
+    parser.add_option('--output', default='',
+                      help='file of the results (default: standard output)')
+    parser.add_option('--quick', action='store_true', default=False,
+                      help='run shorter benchmarks')
+    parser.add_option('--no-rca', action='store_true', default=False,
+                      help='do not run the s1g-rca scenario')
+    options, args = parser.parse_args(argv)
+
+    programs = glob.glob(os.path.join(options.build_dir, 'utils', 'ns3-*-bench-s1g-*'))
+    if not programs:
+        sys.exit('bench-s1g not found in %s, build ns-3 first' % options.build_dir)
+    env = dict(os.environ)
+    env['LD_LIBRARY_PATH'] = os.pathsep.join(filter(None, [os.path.abspath(options.build_dir),
+                                                           env.get('LD_LIBRARY_PATH')]))
+
+    results = []
+    for bench, sizeOption, sizes in BENCHMARKS:
+        for size in sizes:
+            command = [programs[0], '--bench=' + bench, '--%s=%s' % (sizeOption, size)]
+            if options.quick:
+                command += QUICK_OPTIONS[bench]
+            output = run(command, env)[0]
+            for line in output.splitlines():
+                # the wifi models print a lot on the standard output
+                if line.startswith('{"bench"'):
+                    results.append(json.loads(line))
+
+    if not options.no_rca:
+        rca = os.path.join(options.build_dir, 'scratch', 'rca', 'rca')
+        args = list(RCA_ARGS)
+        if options.quick:
+            args[0] = '--simulationTime=2'
+        output, wall, peak = run([rca] + args, env)
+        results.append({'bench': 's1g-rca', 'args': ' '.join(args), 'events': None,
+                        'wallMs': wall, 'eventsPerSec': None, 'peakRssKb': peak,
+                        'allocations': None, 'allocatedBytes': None})
+
+    try:
+        revision = subprocess.check_output(['git', 'rev-parse', 'HEAD']).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        revision = None
+    document = {'revision': revision, 'date': time.strftime('%Y-%m-%dT%H:%M:%S'),
+                'program': os.path.basename(programs[0]), 'results': results}
+    text = json.dumps(document, indent=2, sort_keys=True) + '\n'
+    if options.output:
+        open(options.output, 'w').write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
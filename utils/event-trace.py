@@ -0,0 +1,188 @@
+#!/usr/bin/env python
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+
+# Inspects the logs of executed events written by DefaultSimulatorImpl
+# when its EventTraceFile attribute is set, e.g.
+#
+#   ./waf --run "rca --ns3::DefaultSimulatorImpl::EventTraceFile=run.evt"
+#
+#   ./utils/event-trace.py summary run.evt --from=2220 --to=2280
+#       the events executed and the random numbers drawn per event type
+#       and per stream between 37 min and 38 min of simulated time
+#   ./utils/event-trace.py dump run.evt --from=2220 --to=2221
+#       the events themselves
+#   ./utils/event-trace.py diff before.evt after.evt
+#       the first event where two runs diverge, with the events before it
+#
+# See DefaultSimulatorImpl for the format of the log.
+
+import collections
+import optparse
+import re
+import struct
+import sys
+
+Event = collections.namedtuple('Event', ['index', 'ts', 'context', 'type', 'draws'])
+
+EVENT = struct.Struct('=qIHH')
+DRAW = struct.Struct('=QI')
+TYPE = struct.Struct('=HH')
+NO_CONTEXT = 0xffffffff
+
+# the types of the events created by MakeEvent() for methods and functions
+MEMBER_EVENT = re.compile(r'^ns3::MakeEvent<[^(]*\(([\w:]+)::\*\)\(([^()]*)\)')
+FUNCTION_EVENT = re.compile(r'>\([^(]*\(\*\)\(([^()]*)\)')
+
+
+def short_name(name):
+    """Shorten the name of an event type to the class of its method, or
+    to 'function', and the types of its arguments."""
+    match = MEMBER_EVENT.match(name)
+    if match:
+        name = '%s::*(%s)' % match.groups()
+    else:
+        match = FUNCTION_EVENT.search(name)
+        if match:
+            name = 'function(%s)' % match.group(1)
+    return name.replace('ns3::', '')
+
+
+class EventTrace(object):
+    """Reads the events of a log, the type of each event being its name."""
+
+    def __init__(self, filename, fullNames=False):
+        self.fullNames = fullNames
+        self.file = open(filename, 'rb')
+        if self.file.read(8) != b'ns3evtr1':
+            raise ValueError('%s is not an event trace' % filename)
+        self.stepsPerSecond = struct.unpack('=Q', self.file.read(8))[0]
+        self.types = {}
+
+    def seconds(self, ts):
+        return float(ts) / self.stepsPerSecond
+
+    def events(self, start=None, end=None):
+        """Yield the events whose time in s is in [start, end)."""
+        read = self.file.read
+        index = 0
+        while True:
+            tag = read(1)
+            if not tag:
+                return
+            if tag == b'T':
+                typeId, length = TYPE.unpack(read(TYPE.size))
+                name = read(length).decode('utf-8', 'replace')
+                self.types[typeId] = name if self.fullNames else short_name(name)
+                continue
+            if tag != b'E':
+                raise ValueError('corrupted event trace at offset %d' % (self.file.tell() - 1))
+            ts, context, typeId, streams = EVENT.unpack(read(EVENT.size))
+            draws = tuple(DRAW.unpack(read(DRAW.size)) for i in range(streams))
+            index += 1
+            seconds = self.seconds(ts)
+            if end is not None and seconds >= end:
+                return
+            if start is None or seconds >= start:
+                yield Event(index, ts, context, self.types[typeId], draws)
+
+
+def format_event(trace, event):
+    context = '-' if event.context == NO_CONTEXT else str(event.context)
+    text = '#%d %.9fs context=%s %s' % (event.index, trace.seconds(event.ts), context, event.type)
+    if event.draws:
+        text += ' draws=' + ','.join('%d:%d' % draw for draw in event.draws)
+    return text
+
+
+def summary(options, filename):
+    trace = EventTrace(filename, options.fullNames)
+    counts = collections.Counter()
+    typeDraws = collections.Counter()
+    streamDraws = collections.Counter()
+    first = last = None
+    for event in trace.events(options.start, options.end):
+        counts[event.type] += 1
+        for stream, draws in event.draws:
+            typeDraws[event.type] += draws
+            streamDraws[stream] += draws
+        if first is None:
+            first = event
+        last = event
+    if first is None:
+        print('no event')
+        return 0
+    print('%d events from #%d at %.9fs to #%d at %.9fs' %
+          (sum(counts.values()), first.index, trace.seconds(first.ts),
+           last.index, trace.seconds(last.ts)))
+    print('')
+    print('%10s %10s  %s' % ('events', 'draws', 'event type'))
+    for eventType, count in counts.most_common(options.top):
+        print('%10d %10d  %s' % (count, typeDraws[eventType], eventType))
+    if streamDraws:
+        print('')
+        print('%10s  %s' % ('draws', 'stream'))
+        for stream, draws in streamDraws.most_common(options.top):
+            print('%10d  %d' % (draws, stream))
+    return 0
+
+
+def dump(options, filename):
+    trace = EventTrace(filename, options.fullNames)
+    for event in trace.events(options.start, options.end):
+        print(format_event(trace, event))
+    return 0
+
+
+def diff(options, filenames):
+    traces = [EventTrace(filename, options.fullNames) for filename in filenames]
+    streams = [trace.events(options.start, options.end) for trace in traces]
+    previous = collections.deque(maxlen=options.context)
+    count = 0
+    while True:
+        events = [next(stream, None) for stream in streams]
+        if events[0] is None and events[1] is None:
+            print('no divergence in %d events' % count)
+            return 0
+        same = (events[0] is not None and events[1] is not None and
+                events[0][1:] == events[1][1:] and
+                traces[0].stepsPerSecond == traces[1].stepsPerSecond)
+        if not same:
+            break
+        previous.append(events[0])
+        count += 1
+    print('the runs diverge after %d identical events' % count)
+    for event in previous:
+        print('  ' + format_event(traces[0], event))
+    for filename, trace, event in zip(filenames, traces, events):
+        if event is None:
+            print('%s: no more events' % filename)
+        else:
+            print('%s: %s' % (filename, format_event(trace, event)))
+    return 1
+
+
+def main(argv):
+    parser = optparse.OptionParser(usage='%prog summary|dump FILE | diff FILE1 FILE2 [options]')
+    parser.add_option('--from', dest='start', type='float', default=None,
+                      help='ignore the events before this time, in s')
+    parser.add_option('--to', dest='end', type='float', default=None,
+                      help='ignore the events from this time, in s')
+    parser.add_option('--top', type='int', default=30,
+                      help='lines of the summary tables (default: 30)')
+    parser.add_option('--full-names', dest='fullNames', action='store_true', default=False,
+                      help='print the full names of the event types')
+    parser.add_option('--context', type='int', default=10,
+                      help='events printed before a divergence (default: 10)')
+    options, args = parser.parse_args(argv)
+    if len(args) == 2 and args[0] == 'summary':
+        return summary(options, args[1])
+    if len(args) == 2 and args[0] == 'dump':
+        return dump(options, args[1])
+    if len(args) == 3 and args[0] == 'diff':
+        return diff(options, args[1:])
+    parser.print_help()
+    return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))